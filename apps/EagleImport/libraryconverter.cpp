@@ -0,0 +1,199 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtConcurrent/QtConcurrent>
+#include "libraryconverter.h"
+#include <parseagle/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/libraryelementbatchwriter.h>
+#include <librepcb/eagleimport/converterdb.h>
+#include <librepcb/eagleimport/symbolconverter.h>
+#include <librepcb/eagleimport/packageconverter.h>
+#include <librepcb/eagleimport/devicesetconverter.h>
+#include <librepcb/eagleimport/deviceconverter.h>
+#include "polygonsimplifier.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+using namespace library;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryConverter::LibraryConverter(eagleimport::ConverterDb& db,
+                                   const FilePath& outputDir) noexcept :
+    mDb(db), mOutputDir(outputDir), mWriter(new LibraryElementBatchWriter())
+{
+}
+
+LibraryConverter::~LibraryConverter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+LibraryConverter::Result LibraryConverter::convertSymbols(const parseagle::Library& library,
+                                                          const ProgressCallback& progress)
+{
+    return convertAll(library.getSymbols(), progress, &LibraryConverter::convertSymbol);
+}
+
+LibraryConverter::Result LibraryConverter::convertPackages(const parseagle::Library& library,
+                                                           const ProgressCallback& progress)
+{
+    return convertAll(library.getPackages(), progress, &LibraryConverter::convertPackage);
+}
+
+LibraryConverter::Result LibraryConverter::convertDeviceSets(const parseagle::Library& library,
+                                                             const ProgressCallback& progress)
+{
+    return convertAll(library.getDeviceSets(), progress, &LibraryConverter::convertDeviceSet);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+template <typename Container>
+LibraryConverter::Result LibraryConverter::convertAll(const Container& elements,
+    const ProgressCallback& progress,
+    JobResult (LibraryConverter::*convert)(const typename Container::value_type&) const)
+{
+    // start all jobs at once, the thread pool limits the number of parallel jobs
+    QList<QFuture<JobResult>> futures;
+    for (const auto& element : elements) {
+        const auto* elementPtr = &element;
+        futures.append(QtConcurrent::run([this, convert, elementPtr]() {
+            return (this->*convert)(*elementPtr);
+        }));
+    }
+
+    // collect the results in the original order to get deterministic error messages
+    Result result{0, 0, QStringList()};
+    for (int i = 0; i < futures.count(); ++i) {
+        JobResult jobResult = futures[i].result(); // blocks until finished
+        result.readElements++;
+        if (jobResult.converted) result.convertedElements++;
+        if (!jobResult.error.isEmpty()) result.errors.append(jobResult.error);
+        if (progress) progress(i + 1, futures.count());
+    }
+
+    // write all converted elements at once, a failed element is skipped by commit()
+    while (mWriter->getPendingElementsCount() > 0) {
+        try {
+            mWriter->commit(); // can throw
+        } catch (const Exception& e) {
+            result.errors.append(e.getMsg());
+        }
+    }
+
+    mDb.flush(); // can throw
+    return result;
+}
+
+LibraryConverter::JobResult LibraryConverter::convertSymbol(
+    const parseagle::Symbol& symbol) const noexcept
+{
+    try {
+        // create symbol
+        eagleimport::SymbolConverter converter(symbol, mDb);
+        std::unique_ptr<Symbol> newSymbol = converter.generate();
+
+        // convert line rects to polygon rects
+        PolygonSimplifier<Symbol> polygonSimplifier(*newSymbol);
+        polygonSimplifier.convertLineRectsToPolygonRects(false, true);
+
+        // serialize symbol (written later in one go)
+        mWriter->addElementIntoParentDirectory(*newSymbol, mOutputDir.getPathTo("sym"));
+    } catch (const std::exception& e) {
+        return JobResult{false, e.what()};
+    }
+    return JobResult{true, QString()};
+}
+
+LibraryConverter::JobResult LibraryConverter::convertPackage(
+    const parseagle::Package& package) const noexcept
+{
+    try {
+        // create package
+        eagleimport::PackageConverter converter(package, mDb);
+        std::unique_ptr<Package> newPackage = converter.generate();
+
+        // convert line rects to polygon rects
+        Q_ASSERT(newPackage->getFootprints().count() == 1);
+        PolygonSimplifier<Footprint> polygonSimplifier(*newPackage->getFootprints().first());
+        polygonSimplifier.convertLineRectsToPolygonRects(false, true);
+
+        // serialize package (written later in one go)
+        mWriter->addElementIntoParentDirectory(*newPackage, mOutputDir.getPathTo("pkg"));
+    } catch (const std::exception& e) {
+        return JobResult{false, e.what()};
+    }
+    return JobResult{true, QString()};
+}
+
+LibraryConverter::JobResult LibraryConverter::convertDeviceSet(
+    const parseagle::DeviceSet& deviceSet) const noexcept
+{
+    try {
+        // abort if device name ends with "-US" or "-US_"
+        if (deviceSet.getName().endsWith("-US")) return JobResult{false, QString()};
+        if (deviceSet.getName().endsWith("-US_")) return JobResult{false, QString()};
+
+        // create component
+        eagleimport::DeviceSetConverter converter(deviceSet, mDb);
+        std::unique_ptr<Component> newComponent = converter.generate();
+
+        // create devices
+        foreach (const parseagle::Device& device, deviceSet.getDevices()) {
+            if (device.getPackage().isNull()) continue;
+
+            eagleimport::DeviceConverter devConverter(deviceSet, device, mDb);
+            std::unique_ptr<Device> newDevice = devConverter.generate();
+
+            // serialize device
+            mWriter->addElementIntoParentDirectory(*newDevice, mOutputDir.getPathTo("dev"));
+        }
+
+        // serialize component
+        mWriter->addElementIntoParentDirectory(*newComponent, mOutputDir.getPathTo("cmp"));
+    } catch (const std::exception& e) {
+        return JobResult{false, e.what()};
+    }
+    return JobResult{true, QString()};
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,127 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBRARYCONVERTER_H
+#define LIBRARYCONVERTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <functional>
+#include <memory>
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+
+namespace parseagle {
+class Library;
+class Symbol;
+class Package;
+class DeviceSet;
+}
+
+namespace librepcb {
+
+namespace eagleimport {
+class ConverterDb;
+}
+
+namespace library {
+class LibraryElementBatchWriter;
+}
+
+/*****************************************************************************************
+ *  Class LibraryConverter
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryConverter class converts the elements of Eagle libraries into
+ *        LibrePCB library elements without any user interface
+ *
+ * The elements of a library are converted in parallel in the global thread pool. Since
+ * device sets refer to symbols and packages, all symbols and packages should be
+ * converted before the device sets. The UUIDs are obtained from the (thread-safe)
+ * eagleimport::ConverterDb, which is flushed after each call. The converted elements
+ * are only serialized in the worker threads and then written to the output directory
+ * at once with a library::LibraryElementBatchWriter.
+ */
+class LibraryConverter final
+{
+    public:
+
+        // Types
+        struct Result {
+            int readElements;
+            int convertedElements;
+            QStringList errors;
+        };
+        typedef std::function<void(int finished, int total)> ProgressCallback;
+
+        // Constructors / Destructor
+        LibraryConverter() = delete;
+        LibraryConverter(const LibraryConverter& other) = delete;
+        LibraryConverter(eagleimport::ConverterDb& db, const FilePath& outputDir) noexcept;
+        ~LibraryConverter() noexcept;
+
+        // General Methods
+        Result convertSymbols(const parseagle::Library& library,
+                              const ProgressCallback& progress = ProgressCallback());
+        Result convertPackages(const parseagle::Library& library,
+                               const ProgressCallback& progress = ProgressCallback());
+        Result convertDeviceSets(const parseagle::Library& library,
+                                 const ProgressCallback& progress = ProgressCallback());
+
+        // Operator Overloadings
+        LibraryConverter& operator=(const LibraryConverter& rhs) = delete;
+
+
+    private: // Types
+        struct JobResult {
+            bool converted;
+            QString error;
+        };
+
+
+    private: // Methods
+        template <typename Container>
+        Result convertAll(const Container& elements, const ProgressCallback& progress,
+                          JobResult (LibraryConverter::*convert)(
+                              const typename Container::value_type&) const);
+        JobResult convertSymbol(const parseagle::Symbol& symbol) const noexcept;
+        JobResult convertPackage(const parseagle::Package& package) const noexcept;
+        JobResult convertDeviceSet(const parseagle::DeviceSet& deviceSet) const noexcept;
+
+
+    private: // Data
+        eagleimport::ConverterDb& mDb;
+        FilePath mOutputDir;
+        std::unique_ptr<library::LibraryElementBatchWriter> mWriter; ///< thread-safe
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBRARYCONVERTER_H
@@ -23,25 +23,110 @@
 
 #include <QtCore>
 #include <QtWidgets>
+#include <memory>
+#include <parseagle/library.h>
 #include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/eagleimport/converterdb.h>
+#include "libraryconverter.h"
 #include "mainwindow.h"
 
 using namespace librepcb;
 
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static int convertHeadless(const QStringList& inputFiles, const FilePath& outputDir,
+                           const FilePath& uuidList) noexcept;
+
 /*****************************************************************************************
  *  main()
  ****************************************************************************************/
 
 int main(int argc, char* argv[])
 {
+    // without input files, the graphical user interface is shown
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Converts Eagle libraries to LibrePCB libraries.");
+    parser.addHelpOption();
+    QCommandLineOption outputOption(QStringList{"o", "output"},
+        "Output directory of the converted library elements.", "directory");
+    QCommandLineOption uuidListOption(QStringList{"u", "uuid-list"},
+        "Database (*.sqlite or legacy *.ini) with the UUIDs of converted elements.", "file");
+    parser.addOption(outputOption);
+    parser.addOption(uuidListOption);
+    parser.addPositionalArgument("files", "Eagle libraries (*.lbr) to convert headless.",
+                                 "[files...]");
+    Application::useOffscreenPlatformIfHeadless(parser, argc, argv);
+
     Application app(argc, argv);
 
     Application::setOrganizationName("LibrePCB");
     Application::setOrganizationDomain("librepcb.org");
     Application::setApplicationName("EagleImport");
 
+    parser.process(app);
+
+    if (!parser.positionalArguments().isEmpty()) {
+        if ((!parser.isSet(outputOption)) || (!parser.isSet(uuidListOption))) {
+            qCritical() << "The options --output and --uuid-list are required.";
+            return 1;
+        }
+        return convertHeadless(parser.positionalArguments(),
+                               FilePath(QFileInfo(parser.value(outputOption)).absoluteFilePath()),
+                               FilePath(QFileInfo(parser.value(uuidListOption)).absoluteFilePath()));
+    }
+
     MainWindow w;
     w.show();
 
     return QApplication::exec();
 }
+
+/*****************************************************************************************
+ *  convertHeadless()
+ ****************************************************************************************/
+
+static int convertHeadless(const QStringList& inputFiles, const FilePath& outputDir,
+                           const FilePath& uuidList) noexcept
+{
+    try {
+        FileUtils::makePath(outputDir); // can throw
+        eagleimport::ConverterDb db(uuidList); // can throw
+        LibraryConverter converter(db, outputDir);
+
+        // load all libraries first since device sets depend on symbols and packages
+        QList<std::shared_ptr<parseagle::Library>> libraries;
+        QList<FilePath> filepaths;
+        foreach (const QString& file, inputFiles) {
+            FilePath filepath(QFileInfo(file).absoluteFilePath());
+            libraries.append(std::make_shared<parseagle::Library>(filepath.toStr()));
+            filepaths.append(filepath);
+        }
+
+        int read = 0, converted = 0, errors = 0;
+        auto addResult = [&](const LibraryConverter::Result& result) {
+            read += result.readElements;
+            converted += result.convertedElements;
+            errors += result.errors.count();
+            foreach (const QString& error, result.errors) {
+                qCritical("%s", qPrintable(error));
+            }
+        };
+        for (int i = 0; i < libraries.count(); ++i) {
+            db.setCurrentLibraryFilePath(filepaths[i]);
+            addResult(converter.convertSymbols(*libraries[i])); // can throw
+            addResult(converter.convertPackages(*libraries[i])); // can throw
+        }
+        for (int i = 0; i < libraries.count(); ++i) {
+            db.setCurrentLibraryFilePath(filepaths[i]);
+            addResult(converter.convertDeviceSets(*libraries[i])); // can throw
+        }
+        qInfo("Converted %d of %d elements.", converted, read);
+        return (errors > 0) ? 1 : 0;
+    } catch (const std::exception& e) {
+        qCritical("Fatal Error: %s", e.what());
+        return 1;
+    }
+}
@@ -1,24 +1,15 @@
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include <parseagle/library.h>
 #include <librepcb/common/fileio/fileutils.h>
-#include <librepcb/library/sym/symbol.h>
-#include <librepcb/library/pkg/footprint.h>
-#include <librepcb/library/pkg/package.h>
-#include <librepcb/library/dev/device.h>
-#include <librepcb/library/cmp/component.h>
 #include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/eagleimport/converterdb.h>
-#include <librepcb/eagleimport/symbolconverter.h>
-#include <librepcb/eagleimport/packageconverter.h>
-#include <librepcb/eagleimport/devicesetconverter.h>
-#include <librepcb/eagleimport/deviceconverter.h>
-#include "polygonsimplifier.h"
+#include "libraryconverter.h"
 
 namespace librepcb {
-using namespace library;
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent), ui(new Ui::MainWindow)
@@ -86,7 +77,14 @@ void MainWindow::convertAllFiles(ConvertFileType_t type)
         addError("Fatal Error: " % e.getMsg());
     }
 
-    eagleimport::ConverterDb db(FilePath(ui->uuidList->text()));
+    std::unique_ptr<eagleimport::ConverterDb> db;
+    try {
+        db.reset(new eagleimport::ConverterDb(FilePath(ui->uuidList->text()))); // can throw
+    } catch (const Exception& e) {
+        addError("Fatal Error: " % e.getMsg());
+        return;
+    }
+    LibraryConverter converter(*db, outputDir);
 
     for (int i = 0; i < ui->input->count(); i++) {
         FilePath filepath(ui->input->item(i)->text());
@@ -95,7 +93,7 @@ void MainWindow::convertAllFiles(ConvertFileType_t type)
             continue;
         }
 
-        convertFile(type, db, filepath);
+        convertFile(type, *db, converter, filepath);
         ui->pbarFiles->setValue(i + 1);
 
         if (mAbortConversion)
@@ -104,134 +102,44 @@ void MainWindow::convertAllFiles(ConvertFileType_t type)
 }
 
 void MainWindow::convertFile(ConvertFileType_t type, eagleimport::ConverterDb& db,
-                             const FilePath& filepath)
+                             LibraryConverter& converter, const FilePath& filepath)
 {
+    auto progress = [this](int finished, int total) {
+        ui->pbarElements->setMaximum(total);
+        ui->pbarElements->setValue(finished);
+    };
+
     try {
         parseagle::Library library(filepath.toStr());
         db.setCurrentLibraryFilePath(filepath);
 
+        ui->pbarElements->setValue(0);
+        LibraryConverter::Result result;
         switch (type) {
             case ConvertFileType_t::Symbols_to_Symbols:
-                ui->pbarElements->setValue(0);
-                ui->pbarElements->setMaximum(library.getSymbols().count());
-                foreach (const parseagle::Symbol& symbol, library.getSymbols()) {
-                    bool success = convertSymbol(db, symbol);
-                    mReadedElementsCount++;
-                    if (success) mConvertedElementsCount++;
-                    ui->pbarElements->setValue(ui->pbarElements->value() + 1);
-                    ui->lblConvertedElements->setText(QString("%1 of %2").arg(mConvertedElementsCount)
-                                                                         .arg(mReadedElementsCount));
-                }
+                result = converter.convertSymbols(library, progress); // can throw
                 break;
             case ConvertFileType_t::Packages_to_PackagesAndDevices:
-                ui->pbarElements->setValue(0);
-                ui->pbarElements->setMaximum(library.getPackages().count());
-                foreach (const parseagle::Package& package, library.getPackages()) {
-                    bool success = convertPackage(db, package);
-                    mReadedElementsCount++;
-                    if (success) mConvertedElementsCount++;
-                    ui->pbarElements->setValue(ui->pbarElements->value() + 1);
-                    ui->lblConvertedElements->setText(QString("%1 of %2").arg(mConvertedElementsCount)
-                                                                         .arg(mReadedElementsCount));
-                }
+                result = converter.convertPackages(library, progress); // can throw
                 break;
             case ConvertFileType_t::Devices_to_Components:
-                ui->pbarElements->setValue(0);
-                ui->pbarElements->setMaximum(library.getDeviceSets().count());
-                foreach (const parseagle::DeviceSet& deviceSet, library.getDeviceSets()) {
-                    bool success = convertDevice(db, deviceSet);
-                    mReadedElementsCount++;
-                    if (success) mConvertedElementsCount++;
-                    ui->pbarElements->setValue(ui->pbarElements->value() + 1);
-                    ui->lblConvertedElements->setText(QString("%1 of %2").arg(mConvertedElementsCount)
-                                                                         .arg(mReadedElementsCount));
-                }
+                result = converter.convertDeviceSets(library, progress); // can throw
                 break;
             default:
                 throw Exception(__FILE__, __LINE__);
         }
-    } catch (const std::exception& e) {
-        addError(e.what());
-        return;
-    }
-}
-
-bool MainWindow::convertSymbol(eagleimport::ConverterDb& db,
-                               const parseagle::Symbol& symbol)
-{
-    try {
-        // create symbol
-        eagleimport::SymbolConverter converter(symbol, db);
-        std::unique_ptr<Symbol> newSymbol = converter.generate();
-
-        // convert line rects to polygon rects
-        PolygonSimplifier<Symbol> polygonSimplifier(*newSymbol);
-        polygonSimplifier.convertLineRectsToPolygonRects(false, true);
-
-        // save symbol to file
-        newSymbol->saveIntoParentDirectory(FilePath(QString("%1/sym").arg(ui->output->text())));
-    } catch (const std::exception& e) {
-        addError(e.what());
-        return false;
-    }
 
-    return true;
-}
-
-bool MainWindow::convertPackage(eagleimport::ConverterDb& db,
-                                const parseagle::Package& package)
-{
-    try {
-        // create package
-        eagleimport::PackageConverter converter(package, db);
-        std::unique_ptr<Package> newPackage = converter.generate();
-
-        // convert line rects to polygon rects
-        Q_ASSERT(newPackage->getFootprints().count() == 1);
-        PolygonSimplifier<Footprint> polygonSimplifier(*newPackage->getFootprints().first());
-        polygonSimplifier.convertLineRectsToPolygonRects(false, true);
-
-        // save package to file
-        newPackage->saveIntoParentDirectory(FilePath(QString("%1/pkg").arg(ui->output->text())));
-    } catch (const std::exception& e) {
-        addError(e.what());
-        return false;
-    }
-
-    return true;
-}
-
-bool MainWindow::convertDevice(eagleimport::ConverterDb& db,
-                               const parseagle::DeviceSet& deviceSet)
-{
-    try {
-        // abort if device name ends with "-US" or "-US_"
-        if (deviceSet.getName().endsWith("-US")) return false;
-        if (deviceSet.getName().endsWith("-US_")) return false;
-
-        // create component
-        eagleimport::DeviceSetConverter converter(deviceSet, db);
-        std::unique_ptr<Component> newComponent = converter.generate();
-
-        // create devices
-        foreach (const parseagle::Device& device, deviceSet.getDevices()) {
-            if (device.getPackage().isNull()) continue;
-
-            eagleimport::DeviceConverter devConverter(deviceSet, device, db);
-            std::unique_ptr<Device> newDevice = devConverter.generate();
-
-            // save device
-            newDevice->saveIntoParentDirectory(FilePath(QString("%1/dev").arg(ui->output->text())));
+        mReadedElementsCount += result.readElements;
+        mConvertedElementsCount += result.convertedElements;
+        foreach (const QString& error, result.errors) {
+            addError(error);
         }
-
-        // save component to file
-        newComponent->saveIntoParentDirectory(FilePath(QString("%1/cmp").arg(ui->output->text())));
+        ui->lblConvertedElements->setText(QString("%1 of %2").arg(mConvertedElementsCount)
+                                                             .arg(mReadedElementsCount));
     } catch (const std::exception& e) {
         addError(e.what());
-        return false;
+        return;
     }
-
-    return true;
 }
 
 void MainWindow::on_inputBtn_clicked()
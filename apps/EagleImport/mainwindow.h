@@ -22,6 +22,8 @@ namespace eagleimport {
 class ConverterDb;
 }
 
+class LibraryConverter;
+
 class MainWindow : public QMainWindow
 {
         Q_OBJECT
@@ -56,13 +58,7 @@ class MainWindow : public QMainWindow
         void addError(const QString& msg, const librepcb::FilePath& inputFile = librepcb::FilePath(), int inputLine = 0);
         void convertAllFiles(ConvertFileType_t type);
         void convertFile(ConvertFileType_t type, eagleimport::ConverterDb& db,
-                         const librepcb::FilePath& filepath);
-        bool convertSymbol(eagleimport::ConverterDb& db,
-                           const parseagle::Symbol& symbol);
-        bool convertPackage(eagleimport::ConverterDb& db,
-                            const parseagle::Package& package);
-        bool convertDevice(eagleimport::ConverterDb& db,
-                           const parseagle::DeviceSet& deviceSet);
+                         LibraryConverter& converter, const librepcb::FilePath& filepath);
 
         // Attributes
         Ui::MainWindow *ui;
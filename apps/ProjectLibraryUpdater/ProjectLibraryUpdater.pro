@@ -13,7 +13,7 @@ GENERATED_DIR = ../../generated
 # Use common project definitions
 include(../../common.pri)
 
-QT += core widgets network xml sql printsupport opengl
+QT += core widgets network xml sql printsupport opengl concurrent
 
 LIBS += \
     -L$${DESTDIR} \
@@ -46,9 +46,11 @@ PRE_TARGETDEPS += \
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
+    projectlibraryupdater.cpp \
 
 HEADERS += \
     mainwindow.h \
+    projectlibraryupdater.h \
 
 FORMS += \
     mainwindow.ui \
@@ -24,21 +24,88 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/application.h>
+#include <librepcb/workspace/workspace.h>
+#include "projectlibraryupdater.h"
 #include "mainwindow.h"
 
+using namespace librepcb;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static int updateHeadless(const FilePath& workspacePath, const QStringList& projectFiles,
+                          bool allowHardLinks) noexcept;
+
 /*****************************************************************************************
  *  main()
  ****************************************************************************************/
 
 int main(int argc, char* argv[])
 {
-    librepcb::Application app(argc, argv);
+    // without project files, the graphical user interface is shown
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Updates the library elements of projects to the "
+                                     "latest versions from the workspace libraries.");
+    parser.addHelpOption();
+    QCommandLineOption workspaceOption(QStringList{"w", "workspace"},
+        "Workspace directory to take the library elements from.", "directory");
+    QCommandLineOption hardLinksOption("hard-links",
+        "Allow hard links to the workspace library files if reflinks are not supported. "
+        "Files must then never be modified in-place!");
+    parser.addOption(workspaceOption);
+    parser.addOption(hardLinksOption);
+    parser.addPositionalArgument("projects", "Projects (*.lpp) to update headless.",
+                                 "[projects...]");
+    Application::useOffscreenPlatformIfHeadless(parser, argc, argv);
+
+    Application app(argc, argv);
 
     QCoreApplication::setOrganizationName("LibrePCB");
     QCoreApplication::setApplicationName("ProjectLibraryUpdater");
 
+    parser.process(app);
+
+    if (!parser.positionalArguments().isEmpty()) {
+        if (!parser.isSet(workspaceOption)) {
+            qCritical() << "The option --workspace is required.";
+            return 1;
+        }
+        return updateHeadless(FilePath(QFileInfo(parser.value(workspaceOption)).absoluteFilePath()),
+                              parser.positionalArguments(), parser.isSet(hardLinksOption));
+    }
+
     MainWindow w;
     w.show();
 
     return QApplication::exec();
 }
+
+/*****************************************************************************************
+ *  updateHeadless()
+ ****************************************************************************************/
+
+static int updateHeadless(const FilePath& workspacePath, const QStringList& projectFiles,
+                          bool allowHardLinks) noexcept
+{
+    try {
+        workspace::Workspace workspace(workspacePath); // can throw
+        QList<FilePath> filepaths;
+        foreach (const QString& file, projectFiles) {
+            filepaths.append(FilePath(QFileInfo(file).absoluteFilePath()));
+        }
+
+        ProjectLibraryUpdater updater(workspace, allowHardLinks);
+        ProjectLibraryUpdater::Result result = updater.update(filepaths);
+        foreach (const QString& error, result.errors) {
+            qCritical("%s", qPrintable(error));
+        }
+        qInfo("Updated %d of %d projects (%d elements updated, %d unchanged, %d files copied).",
+              result.updatedProjects, filepaths.count(), result.updatedElements,
+              result.unchangedElements, result.copiedFiles);
+        return result.errors.isEmpty() ? 0 : 1;
+    } catch (const std::exception& e) {
+        qCritical("Fatal Error: %s", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,369 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtConcurrent/QtConcurrent>
+#include "projectlibraryupdater.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+using namespace library;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectLibraryUpdater::ProjectLibraryUpdater(const workspace::Workspace& workspace,
+                                             bool allowHardLinks) noexcept :
+    mWorkspace(workspace), mAllowHardLinks(allowHardLinks)
+{
+}
+
+ProjectLibraryUpdater::~ProjectLibraryUpdater() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+ProjectLibraryUpdater::Result ProjectLibraryUpdater::update(
+    const QList<FilePath>& projectFiles, const ProgressCallback& progress)
+{
+    // read the used components and devices of all projects
+    QList<QFuture<UsedElements>> usedFutures;
+    foreach (const FilePath& projectFile, projectFiles) {
+        usedFutures.append(QtConcurrent::run(&ProjectLibraryUpdater::readUsedElements,
+                                             projectFile));
+    }
+    QList<UsedElements> usedElements;
+    QSet<Uuid> componentUuids, deviceUuids;
+    for (QFuture<UsedElements>& future : usedFutures) {
+        usedElements.append(future.result()); // blocks until finished
+        componentUuids.unite(usedElements.last().components);
+        deviceUuids.unite(usedElements.last().devices);
+    }
+
+    // resolve the used components and devices through the workspace library database
+    resolveElements(mComponents, componentUuids, &ProjectLibraryUpdater::getLatestComponent);
+    resolveElements(mDevices, deviceUuids, &ProjectLibraryUpdater::getLatestDevice);
+
+    // read the symbols and packages required by each component and device only once
+    QHash<Uuid, QFuture<Dependencies>> dependencyFutures;
+    foreach (const Uuid& uuid, componentUuids) {
+        if (mComponentDependencies.contains(uuid)) continue;
+        dependencyFutures.insert(uuid, QtConcurrent::run(
+            &ProjectLibraryUpdater::readComponentDependencies, mComponents.value(uuid)));
+    }
+    for (auto it = dependencyFutures.begin(); it != dependencyFutures.end(); ++it) {
+        mComponentDependencies.insert(it.key(), it.value().result());
+    }
+    dependencyFutures.clear();
+    foreach (const Uuid& uuid, deviceUuids) {
+        if (mDeviceDependencies.contains(uuid)) continue;
+        dependencyFutures.insert(uuid, QtConcurrent::run(
+            &ProjectLibraryUpdater::readDeviceDependencies, mDevices.value(uuid)));
+    }
+    for (auto it = dependencyFutures.begin(); it != dependencyFutures.end(); ++it) {
+        mDeviceDependencies.insert(it.key(), it.value().result());
+    }
+
+    // resolve the symbols and packages
+    QSet<Uuid> symbolUuids, packageUuids;
+    foreach (const Dependencies& dependencies, mComponentDependencies) {
+        symbolUuids.unite(dependencies.symbols);
+    }
+    foreach (const Dependencies& dependencies, mDeviceDependencies) {
+        if (!dependencies.package.isNull()) packageUuids.insert(dependencies.package);
+    }
+    resolveElements(mSymbols, symbolUuids, &ProjectLibraryUpdater::getLatestSymbol);
+    resolveElements(mPackages, packageUuids, &ProjectLibraryUpdater::getLatestPackage);
+
+    // update the library directories of all projects (the caches are not modified anymore)
+    QList<QFuture<ProjectResult>> projectFutures;
+    for (int i = 0; i < projectFiles.count(); ++i) {
+        const FilePath projectFile = projectFiles.at(i);
+        const UsedElements used = usedElements.at(i);
+        projectFutures.append(QtConcurrent::run([this, projectFile, used]() {
+            return updateProject(projectFile, used);
+        }));
+    }
+
+    // collect the results in the original order to get a deterministic log
+    Result result{0, 0, 0, 0, QStringList(), QStringList()};
+    for (int i = 0; i < projectFutures.count(); ++i) {
+        ProjectResult projectResult = projectFutures[i].result(); // blocks until finished
+        result.log.append(projectResult.log);
+        if (projectResult.error.isEmpty()) {
+            result.updatedProjects++;
+        } else {
+            result.errors.append(QString("%1: %2").arg(projectFiles.at(i).toNative(),
+                                                       projectResult.error));
+        }
+        result.unchangedElements += projectResult.unchangedElements;
+        result.updatedElements += projectResult.updatedElements;
+        result.copiedFiles += projectResult.copiedFiles;
+        if (progress) progress(i + 1, projectFutures.count());
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+ProjectLibraryUpdater::UsedElements ProjectLibraryUpdater::readUsedElements(
+    const FilePath& projectFile) noexcept
+{
+    UsedElements used;
+    try {
+        // components
+        FilePath circuitFilePath = projectFile.getParentDir().getPathTo("core/circuit.lp");
+        SmartSExprFile circuitFile(circuitFilePath, false, true);
+        SExpression circuitRoot = circuitFile.parseFileAndBuildDomTree();
+        foreach (const SExpression& node, circuitRoot.getChildren("component")) {
+            used.components.insert(node.getValueByPath<Uuid>("lib_component", true));
+        }
+
+        // devices
+        FilePath boardsFilePath = projectFile.getParentDir().getPathTo("core/boards.lp");
+        SmartSExprFile boardsFile(boardsFilePath, false, true);
+        SExpression boardsRoot = boardsFile.parseFileAndBuildDomTree();
+        foreach (const SExpression& node, boardsRoot.getChildren("board")) {
+            FilePath boardFilePath = projectFile.getParentDir().getPathTo(
+                node.getValueOfFirstChild<QString>(true));
+            SmartSExprFile boardFile(boardFilePath, false, true);
+            SExpression boardRoot = boardFile.parseFileAndBuildDomTree();
+            foreach (const SExpression& node, boardRoot.getChildren("device")) {
+                used.devices.insert(node.getValueByPath<Uuid>("lib_device", true));
+            }
+        }
+    } catch (const Exception& e) {
+        used.error = e.getMsg();
+    }
+    return used;
+}
+
+ProjectLibraryUpdater::Dependencies ProjectLibraryUpdater::readComponentDependencies(
+    const FilePath& componentDir) noexcept
+{
+    Dependencies dependencies;
+    if (!componentDir.isValid()) return dependencies; // missing component
+    try {
+        Component component(componentDir, true);
+        for (const ComponentSymbolVariant& symbvar : component.getSymbolVariants()) {
+            dependencies.symbols.unite(symbvar.getAllSymbolUuids());
+        }
+    } catch (const Exception& e) {
+        dependencies.error = e.getMsg();
+    }
+    return dependencies;
+}
+
+ProjectLibraryUpdater::Dependencies ProjectLibraryUpdater::readDeviceDependencies(
+    const FilePath& deviceDir) noexcept
+{
+    Dependencies dependencies;
+    if (!deviceDir.isValid()) return dependencies; // missing device
+    try {
+        // the package UUID is part of the metadata, no need to parse the whole device
+        dependencies.package = LibraryBaseElement::readMetadata<Device>(deviceDir).packageUuid;
+    } catch (const Exception& e) {
+        dependencies.error = e.getMsg();
+    }
+    return dependencies;
+}
+
+void ProjectLibraryUpdater::resolveElements(QHash<Uuid, FilePath>& cache,
+    const QSet<Uuid>& uuids,
+    FilePath (ProjectLibraryUpdater::*getLatest)(const Uuid&) const)
+{
+    foreach (const Uuid& uuid, uuids) {
+        if (cache.contains(uuid)) continue;
+        FilePath filepath;
+        try {
+            filepath = (this->*getLatest)(uuid);
+        } catch (const Exception& e) {
+            qWarning() << "Could not resolve library element" << uuid.toStr() << ":" << e.getMsg();
+        }
+        // invalid paths are cached too, they are reported as missing elements later
+        cache.insert(uuid, filepath.isExistingDir() ? filepath : FilePath());
+    }
+}
+
+FilePath ProjectLibraryUpdater::getLatestSymbol(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestSymbol(uuid); // can throw
+}
+
+FilePath ProjectLibraryUpdater::getLatestPackage(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestPackage(uuid); // can throw
+}
+
+FilePath ProjectLibraryUpdater::getLatestComponent(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestComponent(uuid); // can throw
+}
+
+FilePath ProjectLibraryUpdater::getLatestDevice(const Uuid& uuid) const
+{
+    return mWorkspace.getLibraryDb().getLatestDevice(uuid); // can throw
+}
+
+ProjectLibraryUpdater::ProjectResult ProjectLibraryUpdater::updateProject(
+    const FilePath& projectFile, const UsedElements& used) const noexcept
+{
+    ProjectResult result{0, 0, 0, QStringList(), used.error};
+    if (!result.error.isEmpty()) return result;
+
+    try {
+        // determine all required elements, abort if any of them is missing
+        QHash<Uuid, FilePath> symbols, packages, components, devices;
+        foreach (const Uuid& uuid, used.components) {
+            Dependencies dependencies = mComponentDependencies.value(uuid);
+            components.insert(uuid, mComponents.value(uuid));
+            if (!dependencies.error.isEmpty()) {
+                throw RuntimeError(__FILE__, __LINE__, dependencies.error);
+            }
+            foreach (const Uuid& symbolUuid, dependencies.symbols) {
+                symbols.insert(symbolUuid, mSymbols.value(symbolUuid));
+            }
+        }
+        foreach (const Uuid& uuid, used.devices) {
+            Dependencies dependencies = mDeviceDependencies.value(uuid);
+            devices.insert(uuid, mDevices.value(uuid));
+            if (!dependencies.error.isEmpty()) {
+                throw RuntimeError(__FILE__, __LINE__, dependencies.error);
+            }
+            if (!dependencies.package.isNull()) {
+                packages.insert(dependencies.package, mPackages.value(dependencies.package));
+            }
+        }
+        QList<QPair<QString, const QHash<Uuid, FilePath>*>> types = {
+            qMakePair(QString("Symbol"), &symbols), qMakePair(QString("Package"), &packages),
+            qMakePair(QString("Component"), &components), qMakePair(QString("Device"), &devices)};
+        for (const auto& type : types) {
+            for (auto it = type.second->constBegin(); it != type.second->constEnd(); ++it) {
+                if (!it.value().isValid()) {
+                    throw RuntimeError(__FILE__, __LINE__, QString(tr("Missing %1: %2"))
+                                       .arg(type.first.toLower(), it.key().toStr()));
+                }
+            }
+        }
+
+        // synchronize the library directory
+        FilePath libDir = projectFile.getParentDir().getPathTo("library");
+        syncElements(libDir.getPathTo("sym"), symbols, result); // can throw
+        syncElements(libDir.getPathTo("pkg"), packages, result); // can throw
+        syncElements(libDir.getPathTo("cmp"), components, result); // can throw
+        syncElements(libDir.getPathTo("dev"), devices, result); // can throw
+    } catch (const Exception& e) {
+        result.error = e.getMsg();
+    }
+    return result;
+}
+
+void ProjectLibraryUpdater::syncElements(const FilePath& dir,
+                                         const QHash<Uuid, FilePath>& elements,
+                                         ProjectResult& result) const
+{
+    QSet<QString> requiredDirNames;
+    foreach (const FilePath& source, elements) {
+        requiredDirNames.insert(source.getFilename());
+    }
+
+    // remove elements which are no longer used
+    QDir qDir(dir.toStr());
+    foreach (const QString& dirname, qDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
+        if (!requiredDirNames.contains(dirname)) {
+            FileUtils::removeDirRecursively(dir.getPathTo(dirname)); // can throw
+        }
+    }
+
+    // add or update the required elements, leave unchanged elements untouched
+    foreach (const FilePath& source, elements) {
+        FilePath dest = dir.getPathTo(source.getFilename());
+        if (dest.isExistingDir()) {
+            if (isElementUpToDate(source, dest)) {
+                result.unchangedElements++;
+                continue;
+            }
+            FileUtils::removeDirRecursively(dest); // can throw
+        }
+        result.copiedFiles += FileUtils::cloneDirRecursively(source, dest,
+                                                             mAllowHardLinks); // can throw
+        result.updatedElements++;
+        result.log.append(source.toNative());
+    }
+}
+
+bool ProjectLibraryUpdater::isElementUpToDate(const FilePath& source,
+                                              const FilePath& dest) noexcept
+{
+    try {
+        QStringList sourceFiles, destFiles;
+        QDirIterator sourceIt(source.toStr(), QDir::Files | QDir::Hidden,
+                              QDirIterator::Subdirectories);
+        while (sourceIt.hasNext()) {
+            sourceFiles.append(FilePath(sourceIt.next()).toRelative(source));
+        }
+        QDirIterator destIt(dest.toStr(), QDir::Files | QDir::Hidden,
+                            QDirIterator::Subdirectories);
+        while (destIt.hasNext()) {
+            destFiles.append(FilePath(destIt.next()).toRelative(dest));
+        }
+        sourceFiles.sort();
+        destFiles.sort();
+        if (sourceFiles != destFiles) return false;
+
+        foreach (const QString& file, sourceFiles) {
+            FilePath sourceFile = source.getPathTo(file);
+            FilePath destFile = dest.getPathTo(file);
+            if (QFileInfo(sourceFile.toStr()).size() != QFileInfo(destFile.toStr()).size()) {
+                return false;
+            }
+            if (FileUtils::readFile(sourceFile) != FileUtils::readFile(destFile)) { // can throw
+                return false;
+            }
+        }
+        return true;
+    } catch (const Exception& e) {
+        qWarning() << "Could not compare library elements:" << e.getMsg();
+        return false;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
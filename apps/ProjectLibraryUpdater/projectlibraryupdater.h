@@ -0,0 +1,150 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROJECTLIBRARYUPDATER_H
+#define PROJECTLIBRARYUPDATER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <functional>
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+
+namespace librepcb {
+
+namespace workspace {
+class Workspace;
+}
+
+/*****************************************************************************************
+ *  Class ProjectLibraryUpdater
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectLibraryUpdater class replaces the library elements of projects by
+ *        the latest versions from the workspace libraries, without any user interface
+ *
+ * All projects are processed in parallel in the global thread pool:
+ *
+ *  1. The circuit and boards of all projects are parsed to get the used components
+ *     and devices.
+ *  2. The paths of all used elements are resolved once through the workspace library
+ *     database (which must only be accessed from the main thread) and kept in a cache
+ *     shared by all projects. The same applies to the symbols and packages which are
+ *     determined by reading each used component and device only once.
+ *  3. The library directory of each project is synchronized with the resolved
+ *     elements: Elements which are already up to date are not touched at all,
+ *     outdated or missing elements are cloned with librepcb::FileUtils::cloneFile()
+ *     (reflink, optionally hard link, or copy) and no longer used elements are removed.
+ */
+class ProjectLibraryUpdater final
+{
+        Q_DECLARE_TR_FUNCTIONS(ProjectLibraryUpdater)
+
+    public:
+
+        // Types
+        struct Result {
+            int updatedProjects;
+            int unchangedElements;
+            int updatedElements;
+            int copiedFiles;     ///< files which could neither be reflinked nor hard linked
+            QStringList log;
+            QStringList errors;
+        };
+        typedef std::function<void(int finished, int total)> ProgressCallback;
+
+        // Constructors / Destructor
+        ProjectLibraryUpdater() = delete;
+        ProjectLibraryUpdater(const ProjectLibraryUpdater& other) = delete;
+        ProjectLibraryUpdater(const workspace::Workspace& workspace, bool allowHardLinks) noexcept;
+        ~ProjectLibraryUpdater() noexcept;
+
+        // General Methods
+        Result update(const QList<FilePath>& projectFiles,
+                      const ProgressCallback& progress = ProgressCallback());
+
+        // Operator Overloadings
+        ProjectLibraryUpdater& operator=(const ProjectLibraryUpdater& rhs) = delete;
+
+
+    private: // Types
+        struct UsedElements {
+            QSet<Uuid> components;
+            QSet<Uuid> devices;
+            QString error;
+        };
+        struct Dependencies {
+            QSet<Uuid> symbols;
+            Uuid package;
+            QString error;
+        };
+        struct ProjectResult {
+            int unchangedElements;
+            int updatedElements;
+            int copiedFiles;
+            QStringList log;
+            QString error;
+        };
+
+
+    private: // Methods
+        static UsedElements readUsedElements(const FilePath& projectFile) noexcept;
+        static Dependencies readComponentDependencies(const FilePath& componentDir) noexcept;
+        static Dependencies readDeviceDependencies(const FilePath& deviceDir) noexcept;
+        void resolveElements(QHash<Uuid, FilePath>& cache, const QSet<Uuid>& uuids,
+                             FilePath (ProjectLibraryUpdater::*getLatest)(const Uuid&) const);
+        FilePath getLatestSymbol(const Uuid& uuid) const;
+        FilePath getLatestPackage(const Uuid& uuid) const;
+        FilePath getLatestComponent(const Uuid& uuid) const;
+        FilePath getLatestDevice(const Uuid& uuid) const;
+        ProjectResult updateProject(const FilePath& projectFile,
+                                    const UsedElements& used) const noexcept;
+        void syncElements(const FilePath& dir, const QHash<Uuid, FilePath>& elements,
+                          ProjectResult& result) const;
+        static bool isElementUpToDate(const FilePath& source, const FilePath& dest) noexcept;
+
+
+    private: // Data
+        const workspace::Workspace& mWorkspace;
+        bool mAllowHardLinks;
+
+        // caches (only modified in the main thread between the parallel steps)
+        QHash<Uuid, FilePath> mSymbols;
+        QHash<Uuid, FilePath> mPackages;
+        QHash<Uuid, FilePath> mComponents;
+        QHash<Uuid, FilePath> mDevices;
+        QHash<Uuid, Dependencies> mComponentDependencies;
+        QHash<Uuid, Dependencies> mDeviceDependencies;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // PROJECTLIBRARYUPDATER_H
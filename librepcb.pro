@@ -3,7 +3,11 @@ TEMPLATE = subdirs
 SUBDIRS = \
     apps \
     libs \
-    tests
+    tests \
+    benchmarks
+
+benchmarks.subdir = tests/benchmarks
 
 apps.depends = libs
 tests.depends = libs
+benchmarks.depends = libs
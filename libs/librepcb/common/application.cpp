@@ -124,6 +124,19 @@ Application* Application::instance() noexcept
     return app;
 }
 
+void Application::useOffscreenPlatformIfHeadless(QCommandLineParser& parser, int argc,
+                                                 char* argv[]) noexcept
+{
+    QStringList arguments;
+    for (int i = 0; i < argc; ++i) {
+        arguments.append(QString::fromLocal8Bit(argv[i]));
+    }
+    if (parser.parse(arguments) && (!parser.positionalArguments().isEmpty()) &&
+        (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
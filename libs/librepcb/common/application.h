@@ -86,6 +86,26 @@ class Application final : public QApplication
         // Static Methods
         static Application* instance() noexcept;
 
+        /**
+         * @brief Select the "offscreen" platform plugin for command line tools which are
+         *        run without graphical user interface
+         *
+         * Some tools show a graphical user interface if they are started without
+         * positional arguments, but work headless otherwise. Since many classes require
+         * an Application (which is a QApplication), the headless mode needs a platform
+         * plugin which works without a display server. Thus this method parses the
+         * arguments and must be called before the Application is created.
+         *
+         * If the environment variable `QT_QPA_PLATFORM` is already set, it is not
+         * overridden.
+         *
+         * @param parser    The fully configured command line parser of the tool.
+         * @param argc      The argument count passed to main().
+         * @param argv      The arguments passed to main().
+         */
+        static void useOffscreenPlatformIfHeadless(QCommandLineParser& parser, int argc,
+                                                   char* argv[]) noexcept;
+
 
     private: // Data
         Version mAppVersion;
@@ -30,6 +30,8 @@
  ****************************************************************************************/
 namespace librepcb {
 
+class AttributeSubstitutionCache;
+
 /*****************************************************************************************
  *  Interface AttributeProvider
  ****************************************************************************************/
@@ -109,6 +111,19 @@ class AttributeProvider
             return QVector<const AttributeProvider*>();
         }
 
+        /**
+         * @brief Get the cache for substitutions with this provider (if available)
+         *
+         * Providers which are used often for substitutions may own a
+         * librepcb::AttributeSubstitutionCache to speed up
+         * librepcb::AttributeSubstitutor::substitute().
+         *
+         * @return The cache of this provider, or nullptr if there is no cache
+         */
+        virtual AttributeSubstitutionCache* getAttributeSubstitutionCache() const noexcept {
+            return nullptr;
+        }
+
 
     signals:
 
@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_ATTRIBUTESUBSTITUTIONCACHE_H
+#define LIBREPCB_ATTRIBUTESUBSTITUTIONCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class AttributeSubstitutionCache
+ ****************************************************************************************/
+
+/**
+ * @brief The AttributeSubstitutionCache class caches the results of
+ *        librepcb::AttributeSubstitutor::substitute() for a specific attribute provider
+ *
+ * An attribute provider which is used very often for substitutions (e.g. a component
+ * instance) can own such a cache and return it in
+ * librepcb::AttributeProvider::getAttributeSubstitutionCache().
+ *
+ * Since substituted values may also depend on other providers (parents like the
+ * project, or children like the device of a component), the provider's signal alone is
+ * not enough to detect outdated results. Therefore a global generation counter is
+ * incremented whenever *any* provider which owns a cache emits
+ * librepcb::AttributeProvider::attributesChanged(), and all caches discard their results
+ * lazily as soon as they see a new generation. Attributes are changed rarely compared to
+ * how often they are substituted (e.g. on every repaint), so this is still very
+ * effective.
+ *
+ * @warning The cache must be constructed in the member initializer list of the provider
+ *          (i.e. before any other object connects to the provider's
+ *          librepcb::AttributeProvider::attributesChanged() signal). Otherwise other
+ *          objects could get outdated values when they substitute attributes in a slot
+ *          connected to that signal, since the generation would not be incremented yet.
+ *
+ * @note This class is thread-safe.
+ */
+class AttributeSubstitutionCache final
+{
+    public:
+
+        // Constructors / Destructor
+        AttributeSubstitutionCache() = delete;
+        AttributeSubstitutionCache(const AttributeSubstitutionCache& other) = delete;
+        template <typename T>
+        explicit AttributeSubstitutionCache(const T& provider) noexcept :
+            mGeneration(getGlobalGeneration().load())
+        {
+            QObject::connect(&provider, &T::attributesChanged, [](){invalidateAll();});
+        }
+        ~AttributeSubstitutionCache() noexcept {}
+
+        // General Methods
+        bool lookup(const QString& str, QString& result) const noexcept {
+            QMutexLocker lock(&mMutex);
+            int generation = getGlobalGeneration().load();
+            if (generation != mGeneration) {
+                mResults.clear();
+                mGeneration = generation;
+                return false;
+            }
+            auto it = mResults.constFind(str);
+            if (it == mResults.constEnd()) return false;
+            result = *it;
+            return true;
+        }
+        void insert(const QString& str, const QString& result, int generation) noexcept {
+            QMutexLocker lock(&mMutex);
+            if (generation == mGeneration) mResults.insert(str, result);
+        }
+
+        // Static Methods
+
+        /**
+         * @brief Get the current generation, to be passed to #insert() later
+         *
+         * The generation must be fetched *before* the substitution is done, to not cache
+         * results which got outdated while they were substituted.
+         */
+        static int currentGeneration() noexcept {return getGlobalGeneration().load();}
+
+        /**
+         * @brief Discard the results of all caches
+         */
+        static void invalidateAll() noexcept {getGlobalGeneration().ref();}
+
+        // Operator Overloadings
+        AttributeSubstitutionCache& operator=(const AttributeSubstitutionCache& rhs) = delete;
+
+
+    private: // Methods
+        static QAtomicInt& getGlobalGeneration() noexcept {
+            static QAtomicInt generation(0);
+            return generation;
+        }
+
+
+    private: // Data
+        mutable QMutex mMutex;
+        mutable int mGeneration; ///< the generation of all results in #mResults
+        mutable QHash<QString, QString> mResults; ///< key: input, value: substituted string
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_ATTRIBUTESUBSTITUTIONCACHE_H
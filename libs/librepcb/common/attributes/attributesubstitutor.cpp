@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "attributesubstitutor.h"
 #include "attributeprovider.h"
+#include "attributesubstitutioncache.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -35,6 +36,102 @@ namespace librepcb {
 
 QString AttributeSubstitutor::substitute(QString str, const AttributeProvider* ap,
                                          FilterFunction filter) noexcept
+{
+    // the result of filtered substitutions depends on the filter, so don't cache them
+    AttributeSubstitutionCache* cache = (ap && (!filter)) ? ap->getAttributeSubstitutionCache()
+                                                          : nullptr;
+    int generation = AttributeSubstitutionCache::currentGeneration();
+    QString result;
+    if (cache && cache->lookup(str, result)) {
+        return result;
+    }
+    if (!substituteCompiled(compile(str), ap, filter, result)) {
+        result = substituteDynamically(str, ap, filter);
+    }
+    if (cache) {
+        cache->insert(str, result, generation);
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+AttributeSubstitutor::Template AttributeSubstitutor::compile(const QString& str) noexcept
+{
+    static QMutex mutex;
+    static QHash<QString, Template> cache;
+
+    QMutexLocker lock(&mutex);
+    auto it = cache.constFind(str);
+    if (it != cache.constEnd()) {
+        return *it;
+    }
+
+    Template tmpl;
+    int startPos = 0;
+    int pos = 0;
+    int length = 0;
+    QStringList keys;
+    while (searchVariablesInText(str, startPos, pos, length, keys)) {
+        if (pos > startPos) {
+            tmpl.append(Token{str.mid(startPos, pos - startPos), QStringList()});
+        }
+        tmpl.append(Token{QString(), keys});
+        startPos = pos + length;
+    }
+    if (startPos < str.length()) {
+        tmpl.append(Token{str.mid(startPos), QStringList()});
+    }
+
+    // the number of different strings is usually small, but avoid unlimited growing
+    if (cache.count() >= 10000) {
+        cache.clear();
+    }
+    cache.insert(str, tmpl);
+    return tmpl;
+}
+
+bool AttributeSubstitutor::substituteCompiled(const Template& tmpl,
+                                              const AttributeProvider* ap,
+                                              FilterFunction filter,
+                                              QString& result) noexcept
+{
+    QString output;
+    QString value;
+    QSet<QString> keyBacktrace; // same behavior as substituteDynamically()
+    for (const Token& token : tmpl) {
+        if (token.keys.isEmpty()) {
+            output.append(token.text);
+            continue;
+        }
+        bool keyFound = false;
+        foreach (const QString& key, token.keys) {
+            if (key.startsWith('\'') && key.endsWith('\'')) {
+                value = key.mid(1, key.length()-2);
+                keyFound = true;
+                break;
+            } else if ((getValueOfKey(key, value, ap)) && (!keyBacktrace.contains(key))) {
+                if (value.contains("{{") || value.endsWith('{')) {
+                    return false; // value may contain variables which must be substituted
+                }
+                keyBacktrace.insert(key);
+                keyFound = true;
+                break;
+            }
+        }
+        if (!keyFound) {
+            value.clear();
+        }
+        output.append(filter ? filter(value) : value);
+    }
+    result = output;
+    return true;
+}
+
+QString AttributeSubstitutor::substituteDynamically(QString str, const AttributeProvider* ap,
+                                                    FilterFunction filter) noexcept
 {
     int startPos = 0;
     int length = 0;
@@ -78,14 +175,10 @@ QString AttributeSubstitutor::substitute(QString str, const AttributeProvider* a
     return str;
 }
 
-/*****************************************************************************************
- *  Private Methods
- ****************************************************************************************/
-
 bool AttributeSubstitutor::searchVariablesInText(const QString& text, int startPos, int& pos,
                                                  int& length, QStringList& keys) noexcept
 {
-    QRegularExpression re("\\{\\{(.*?)\\}\\}");
+    static const QRegularExpression re("\\{\\{(.*?)\\}\\}");
     QRegularExpressionMatch match = re.match(text, startPos);
     if (match.hasMatch() && match.capturedLength() > 0) {
         pos = match.capturedStart();
@@ -44,7 +44,12 @@ class AttributeProvider;
  * Please read the documentation about the @ref doc_attributes_system to get an idea how
  * the @ref doc_attributes_system works in detail.
  *
+ * Strings are compiled once into a list of literal texts and variables, which is cached
+ * globally, so the same string is never parsed twice. If the attribute provider has a
+ * librepcb::AttributeSubstitutionCache, the substituted strings are cached too.
+ *
  * @see librepcb::AttributeProvider
+ * @see librepcb::AttributeSubstitutionCache
  * @see @ref doc_attributes_system
  *
  * @author ubruhin
@@ -84,8 +89,44 @@ class AttributeSubstitutor final
                                   FilterFunction filter = nullptr) noexcept;
 
 
+    private: // Types
+
+        /**
+         * @brief A part of a compiled string, either a literal text or a variable
+         */
+        struct Token {
+            QString text;       ///< the literal text (only if keys is empty)
+            QStringList keys;   ///< the keys of a variable (empty for literal texts)
+        };
+        typedef QVector<Token> Template;
+
+
     private: // Methods
 
+        /**
+         * @brief Split a string into literal texts and variables (with global cache)
+         */
+        static Template compile(const QString& str) noexcept;
+
+        /**
+         * @brief Substitute the variables of a compiled string
+         *
+         * This is the fast path of #substitute(). It doesn't support values which
+         * contain variables themselves (since they would need to be substituted too).
+         *
+         * @retval true     On success, the substituted string is written to result.
+         * @retval false    If a value contains a variable, the string has to be
+         *                  substituted by #substituteDynamically() instead.
+         */
+        static bool substituteCompiled(const Template& tmpl, const AttributeProvider* ap,
+                                       FilterFunction filter, QString& result) noexcept;
+
+        /**
+         * @brief Substitute variables recursively (used if values contain variables)
+         */
+        static QString substituteDynamically(QString str, const AttributeProvider* ap,
+                                             FilterFunction filter) noexcept;
+
         /**
          * @brief Search the next variables (e.g. "{{KEY or FALLBACK}}") in a given text
          *
@@ -90,6 +90,10 @@ BoardDesignRules::BoardDesignRules(const SExpression& node) :
     if (const SExpression* e = node.tryGetChildByPath("restring_via_max")) {
         mRestringViaMax = e->getValueOfFirstChild<Length>(true);
     }
+    // clearances
+    if (const SExpression* e = node.tryGetChildByPath("copper_clearance")) {
+        mCopperClearance = e->getValueOfFirstChild<Length>(true);
+    }
 }
 
 BoardDesignRules::~BoardDesignRules() noexcept
@@ -121,6 +125,8 @@ void BoardDesignRules::restoreDefaults() noexcept
     mRestringViaRatio = Ratio(250000);              // 25%
     mRestringViaMin = Length(200000);               // 0.2mm
     mRestringViaMax = Length(2000000);              // 2.0mm
+    // clearances
+    mCopperClearance = Length(sDefaultCopperClearance);
 }
 
 void BoardDesignRules::serialize(SExpression& root) const
@@ -146,6 +152,10 @@ void BoardDesignRules::serialize(SExpression& root) const
     root.appendTokenChild("restring_via_ratio",                  mRestringViaRatio, true);
     root.appendTokenChild("restring_via_min",                    mRestringViaMin, true);
     root.appendTokenChild("restring_via_max",                    mRestringViaMax, true);
+    // clearances (only written if not default to keep existing boards unmodified)
+    if (mCopperClearance != Length(sDefaultCopperClearance)) {
+        root.appendTokenChild("copper_clearance",                mCopperClearance, true);
+    }
 }
 
 /*****************************************************************************************
@@ -210,6 +220,8 @@ BoardDesignRules& BoardDesignRules::operator=(const BoardDesignRules& rhs) noexc
     mRestringViaRatio               = rhs.mRestringViaRatio;
     mRestringViaMin                 = rhs.mRestringViaMin;
     mRestringViaMax                 = rhs.mRestringViaMax;
+    // clearances
+    mCopperClearance                = rhs.mCopperClearance;
     return *this;
 }
 
@@ -237,6 +249,8 @@ bool BoardDesignRules::checkAttributesValidity() const noexcept
     if (mRestringViaRatio < 0)                              return false;
     if (mRestringViaMin < 0)                                return false;
     if (mRestringViaMax < mRestringViaMin)                  return false;
+    // clearances
+    if (mCopperClearance < 0)                               return false;
     return true;
 }
 
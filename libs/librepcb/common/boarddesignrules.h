@@ -78,6 +78,9 @@ class BoardDesignRules final : public SerializableObject
         const Length& getRestringViaMin() const noexcept {return mRestringViaMin;}
         const Length& getRestringViaMax() const noexcept {return mRestringViaMax;}
 
+        // Getters: Clearances
+        const Length& getCopperClearance() const noexcept {return mCopperClearance;}
+
 
         // Setters: General Attributes
         void setName(const QString& name) noexcept {if (!name.isEmpty()) mName = name;}
@@ -102,6 +105,9 @@ class BoardDesignRules final : public SerializableObject
         void setRestringViaMin(const Length& min) noexcept {if (min >= 0) mRestringViaMin = min;}
         void setRestringViaMax(const Length& max) noexcept {if (max >= 0) mRestringViaMax = max;}
 
+        // Setters: Clearances
+        void setCopperClearance(const Length& clearance) noexcept {if (clearance >= 0) mCopperClearance = clearance;}
+
         // General Methods
         void restoreDefaults() noexcept;
 
@@ -145,6 +151,12 @@ class BoardDesignRules final : public SerializableObject
         Ratio mRestringViaRatio;
         Length mRestringViaMin;
         Length mRestringViaMax;
+
+        // Clearances
+        Length mCopperClearance; ///< min. clearance between copper objects of different nets
+
+        // Default value of the optional copper clearance (not written to the file)
+        static constexpr LengthBase_t sDefaultCopperClearance = 200000; // 0.2mm
 };
 
 /*****************************************************************************************
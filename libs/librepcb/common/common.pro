@@ -80,6 +80,7 @@ SOURCES += \
     geometry/vertex.cpp \
     graphics/defaultgraphicslayerprovider.cpp \
     graphics/ellipsegraphicsitem.cpp \
+    graphics/graphicsitemsmovepreview.cpp \
     graphics/graphicslayer.cpp \
     graphics/graphicsscene.cpp \
     graphics/graphicsview.cpp \
@@ -111,8 +112,11 @@ SOURCES += \
     units/point.cpp \
     units/ratio.cpp \
     utils/clipperhelpers.cpp \
+    utils/clipperpathcache.cpp \
     utils/exclusiveactiongroup.cpp \
+    utils/geometrykernel.cpp \
     utils/graphicslayerstackappearancesettings.cpp \
+    utils/hatchlattice.cpp \
     utils/toolbarproxy.cpp \
     utils/undostackactiongroup.cpp \
     uuid.cpp \
@@ -132,6 +136,7 @@ HEADERS += \
     application.h \
     attributes/attribute.h \
     attributes/attributeprovider.h \
+    attributes/attributesubstitutioncache.h \
     attributes/attributesubstitutor.h \
     attributes/attributetype.h \
     attributes/attributeunit.h \
@@ -184,6 +189,7 @@ HEADERS += \
     geometry/vertex.h \
     graphics/defaultgraphicslayerprovider.h \
     graphics/ellipsegraphicsitem.h \
+    graphics/graphicsitemsmovepreview.h \
     graphics/graphicslayer.h \
     graphics/graphicsscene.h \
     graphics/graphicsview.h \
@@ -219,10 +225,16 @@ HEADERS += \
     units/point.h \
     units/ratio.h \
     utils/clipperhelpers.h \
+    utils/clipperpathcache.h \
+    utils/connectivitygraph.h \
     utils/exclusiveactiongroup.h \
+    utils/geometrykernel.h \
     utils/graphicslayerstackappearancesettings.h \
+    utils/hatchlattice.h \
+    utils/rectselectionindex.h \
     utils/toolbarproxy.h \
     utils/undostackactiongroup.h \
+    utils/unionfind.h \
     uuid.h \
     version.h \
     widgets/alignmentselector.h \
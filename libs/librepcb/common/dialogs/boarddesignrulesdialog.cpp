@@ -96,6 +96,8 @@ void BoardDesignRulesDialog::updateWidgets() noexcept
     mUi->spbxRestringViasRatio->setValue(mDesignRules.getRestringViaRatio().toPercent());
     mUi->spbxRestringViasMin->setValue(mDesignRules.getRestringViaMin().toMm());
     mUi->spbxRestringViasMax->setValue(mDesignRules.getRestringViaMax().toMm());
+    // clearances
+    mUi->spbxCopperClearance->setValue(mDesignRules.getCopperClearance().toMm());
 }
 
 void BoardDesignRulesDialog::applyRules() noexcept
@@ -119,6 +121,8 @@ void BoardDesignRulesDialog::applyRules() noexcept
     mDesignRules.setRestringViaRatio(Ratio::fromPercent(mUi->spbxRestringViasRatio->value()));
     mDesignRules.setRestringViaMin(Length::fromMm(mUi->spbxRestringViasMin->value()));
     mDesignRules.setRestringViaMax(Length::fromMm(mUi->spbxRestringViasMax->value()));
+    // clearances
+    mDesignRules.setCopperClearance(Length::fromMm(mUi->spbxCopperClearance->value()));
 }
 
 /*****************************************************************************************
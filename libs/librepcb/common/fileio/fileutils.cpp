@@ -24,6 +24,21 @@
 #include "fileutils.h"
 #include "filepath.h"
 
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#elif defined(Q_OS_OSX)
+#include <unistd.h>
+#include <sys/attr.h>
+#include <sys/clonefile.h>
+#elif defined(Q_OS_UNIX)
+#include <unistd.h>
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)
+#include <windows.h>
+#endif
+
 /*****************************************************************************************
  *  Namespace
  ****************************************************************************************/
@@ -111,6 +126,92 @@ void FileUtils::copyDirRecursively(const FilePath& source, const FilePath& dest)
     }
 }
 
+FileUtils::CloneMethod FileUtils::cloneFile(const FilePath& source, const FilePath& dest,
+                                            bool allowHardLink)
+{
+    if (!source.isExistingFile()) {
+        throw LogicError(__FILE__, __LINE__,
+            QString(tr("The file \"%1\" does not exist."))
+            .arg(source.toNative()));
+    }
+    if (dest.isExistingFile() || dest.isExistingDir()) {
+        throw LogicError(__FILE__, __LINE__,
+            QString(tr("The file or directory \"%1\" exists already."))
+            .arg(dest.toNative()));
+    }
+
+    QByteArray src = QFile::encodeName(source.toStr());
+    QByteArray dst = QFile::encodeName(dest.toStr());
+
+    // try to create a reflink (failures are ignored, we fall back to other methods)
+#if defined(Q_OS_LINUX) && defined(FICLONE)
+    int srcFd = ::open(src.constData(), O_RDONLY);
+    if (srcFd >= 0) {
+        int dstFd = ::open(dst.constData(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (dstFd >= 0) {
+            bool cloned = (::ioctl(dstFd, FICLONE, srcFd) == 0);
+            ::close(dstFd);
+            if (!cloned) ::unlink(dst.constData()); // remove the created empty file
+            ::close(srcFd);
+            if (cloned) return CloneMethod::Reflink;
+        } else {
+            ::close(srcFd);
+        }
+    }
+#elif defined(Q_OS_OSX)
+    if (::clonefile(src.constData(), dst.constData(), 0) == 0) {
+        return CloneMethod::Reflink;
+    }
+#endif
+
+    // try to create a hard link
+    if (allowHardLink) {
+#if defined(Q_OS_UNIX)
+        if (::link(src.constData(), dst.constData()) == 0) {
+            return CloneMethod::HardLink;
+        }
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)
+        if (::CreateHardLinkW(reinterpret_cast<LPCWSTR>(dest.toNative().utf16()),
+                              reinterpret_cast<LPCWSTR>(source.toNative().utf16()),
+                              nullptr)) {
+            return CloneMethod::HardLink;
+        }
+#endif
+    }
+
+    // fall back to an ordinary copy
+    copyFile(source, dest); // can throw
+    return CloneMethod::Copy;
+}
+
+int FileUtils::cloneDirRecursively(const FilePath& source, const FilePath& dest,
+                                   bool allowHardLink)
+{
+    if (!source.isExistingDir()) {
+        throw LogicError(__FILE__, __LINE__,
+            QString(tr("The directory \"%1\" does not exist."))
+            .arg(source.toNative()));
+    }
+    if (dest.isExistingFile() || dest.isExistingDir()) {
+        throw LogicError(__FILE__, __LINE__,
+            QString(tr("The file or directory \"%1\" exists already."))
+            .arg(dest.toNative()));
+    }
+    makePath(dest); // can throw
+    int copiedFiles = 0;
+    QDir sourceDir(source.toStr());
+    foreach (const QString& file, sourceDir.entryList(QDir::Files | QDir::Hidden)) {
+        CloneMethod method = cloneFile(source.getPathTo(file), dest.getPathTo(file),
+                                       allowHardLink); // can throw
+        if (method == CloneMethod::Copy) ++copiedFiles;
+    }
+    foreach (const QString& dir, sourceDir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot)) {
+        copiedFiles += cloneDirRecursively(source.getPathTo(dir), dest.getPathTo(dir),
+                                           allowHardLink); // can throw
+    }
+    return copiedFiles;
+}
+
 void FileUtils::move(const FilePath& source, const FilePath& dest)
 {
     if ((!source.isExistingFile()) && (!source.isExistingDir())) {
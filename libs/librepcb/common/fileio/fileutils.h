@@ -49,6 +49,17 @@ class FileUtils final
 
     public:
 
+        // Types
+
+        /**
+         * @brief The ways how #cloneFile() can create the destination file
+         */
+        enum class CloneMethod {
+            Reflink,    ///< copy-on-write clone, no data duplicated (if supported by the FS)
+            HardLink,   ///< hard link to the same data (only if explicitly allowed)
+            Copy,       ///< ordinary copy of the data
+        };
+
         // Constructors / Destructor
         FileUtils() = delete;
         FileUtils(const FileUtils& other) = delete;
@@ -101,6 +112,47 @@ class FileUtils final
          */
         static void copyDirRecursively(const FilePath& source, const FilePath& dest);
 
+        /**
+         * @brief Create a file with the same content as another file, without copying
+         *        the data if possible
+         *
+         * First tries to create a copy-on-write clone (reflink), which is supported by
+         * some file systems (e.g. Btrfs, XFS, APFS). If that's not possible and hard
+         * links are allowed, tries to create a hard link. Otherwise the file is copied.
+         *
+         * @warning A hard link shares the data with the source file, i.e. modifying one
+         *          of the files in-place also modifies the other one! It's only safe if
+         *          the files are replaced instead of modified in-place, like
+         *          #writeFile() does.
+         *
+         * @param source        Filepath to an existing file.
+         * @param dest          Filepath to a non-existing file (if it exists already,
+         *                      an exception will be thrown).
+         * @param allowHardLink Whether a hard link may be created.
+         *
+         * @return The method which was used to create the file
+         *
+         * @throws Exception    If an error occurs.
+         */
+        static CloneMethod cloneFile(const FilePath& source, const FilePath& dest,
+                                     bool allowHardLink);
+
+        /**
+         * @brief Same as #copyDirRecursively(), but using #cloneFile() for each file
+         *
+         * @param source        Filepath to an existing directory.
+         * @param dest          Filepath to a non-existing directory (if it exists
+         *                      already, an exception will be thrown).
+         * @param allowHardLink Whether hard links may be created.
+         *
+         * @return The number of files which had to be copied (i.e. neither reflinked
+         *         nor hard linked)
+         *
+         * @throws Exception    If an error occurs.
+         */
+        static int cloneDirRecursively(const FilePath& source, const FilePath& dest,
+                                       bool allowHardLink);
+
         /**
          * @brief Move/rename a file or directory
          *
@@ -31,6 +31,39 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Function serializeToDomElement()
+ ****************************************************************************************/
+
+/**
+ * @brief Serialize an object to a new S-Expression node
+ *
+ * This function creates a new S-Expression node, serializes the whole object into it and
+ * then returns the whole S-Expression node. It works for all librepcb::SerializableObject
+ * subclasses as well as for value types which provide a compatible (non-virtual)
+ * `serialize(SExpression&) const` method, like librepcb::Point or librepcb::Path.
+ *
+ * @param object        The object to serialize
+ * @param name          The root name of the returned S-Expression node
+ *
+ * @return The created S-Expression node
+ *
+ * @throw Exception     This function throws an exception if an error occurs.
+ *
+ * @note Subclasses which override #SerializableObject::serialize() as private need to
+ *       pass themselves as SerializableObject, i.e.
+ *       `serializeToDomElement<SerializableObject>(*this, name)`.
+ *
+ * @see librepcb::SerializableObject::serialize()
+ */
+template <typename T>
+SExpression serializeToDomElement(const T& object, const QString& name)
+{
+    SExpression root = SExpression::createList(name);
+    object.serialize(root); // can throw
+    return root;
+}
+
 /*****************************************************************************************
  *  Class SerializableObject
  ****************************************************************************************/
@@ -49,26 +82,6 @@ class SerializableObject
         virtual ~SerializableObject() noexcept {}
 
 
-        /**
-         * @brief Serialize the object to a new S-Expression node
-         *
-         * This method creates a new S-Expression node, serializes the whole object into
-         * it and then returns the whole S-Expression node. See #serialize() for details.
-         *
-         * @param name          The root name of the returned S-Expression node
-         *
-         * @return The created S-Expression node (the caller takes the ownership!)
-         *
-         * @throw Exception     This method throws an exception if an error occurs.
-         *
-         * @see #serialize()
-         */
-        SExpression serializeToDomElement(const QString& name) const {
-            SExpression root = SExpression::createList(name);
-            serialize(root);
-            return root;
-        }
-
         /**
          * @brief Serialize the object into an existing S-Expression node
          *
@@ -91,7 +104,7 @@ class SerializableObject
             const QString& itemName)
         {
             for (const auto& object : container) {
-                root.appendChild(object.serializeToDomElement(itemName), true); // can throw
+                root.appendChild(serializeToDomElement(object, itemName), true); // can throw
             }
         }
 
@@ -100,7 +113,7 @@ class SerializableObject
             const QString& itemName)
         {
             for (const auto& pointer : container) {
-                root.appendChild(pointer->serializeToDomElement(itemName), true); // can throw
+                root.appendChild(serializeToDomElement(*pointer, itemName), true); // can throw
             }
         }
 };
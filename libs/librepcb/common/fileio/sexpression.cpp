@@ -304,6 +304,49 @@ SExpression SExpression::parse(const QString& str, const FilePath& filePath)
     }
 }
 
+SExpression SExpression::parse(const QString& str, const FilePath& filePath,
+                               const QSet<QString>& childListNames)
+{
+    // Copy everything on the root level, but only the requested child lists, into a
+    // reduced string. Skipped lists are only scanned for quotes and parentheses.
+    QString reduced;
+    int depth = 0;
+    int rootRunStart = 0;
+    int childStart = 0;
+    bool inString = false;
+    for (int i = 0; i < str.length(); ++i) {
+        const QChar c = str.at(i);
+        if (inString) {
+            if (c == '\\') {
+                ++i; // skip escaped character
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '(') {
+            if (++depth == 2) {
+                reduced.append(str.midRef(rootRunStart, i - rootRunStart));
+                childStart = i;
+            }
+        } else if (c == ')') {
+            if (--depth == 1) {
+                int nameEnd = childStart + 1;
+                while ((nameEnd < str.length()) && (str.at(nameEnd).isLetterOrNumber()
+                                                    || (str.at(nameEnd) == '_'))) {
+                    ++nameEnd;
+                }
+                if (childListNames.contains(str.mid(childStart + 1, nameEnd - childStart - 1))) {
+                    reduced.append(str.midRef(childStart, i - childStart + 1));
+                }
+                rootRunStart = i + 1;
+            }
+        }
+    }
+    reduced.append(str.midRef(rootRunStart));
+    return parse(reduced, filePath); // can throw
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
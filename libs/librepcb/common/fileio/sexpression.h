@@ -147,6 +147,24 @@ class SExpression final
         static SExpression createLineBreak();
         static SExpression parse(const QString& str, const FilePath& filePath);
 
+        /**
+         * @brief Parse only the root node and some of its child lists
+         *
+         * All other children of the root node are skipped without building a tree
+         * for them, which is much faster than #parse() if only a few small nodes of a
+         * large file are needed (e.g. the metadata of a library element).
+         *
+         * @param str               The S-Expression string to parse.
+         * @param filePath          The file path (only used for error messages).
+         * @param childListNames    Names of the root's child lists to parse.
+         *
+         * @return The root node with all its tokens/strings and the requested lists
+         *
+         * @throws FileParseError if the string could not be parsed
+         */
+        static SExpression parse(const QString& str, const FilePath& filePath,
+                                 const QSet<QString>& childListNames);
+
 
     private: // Methods
         SExpression(Type type, const QString& value);
@@ -205,8 +205,8 @@ void Ellipse::serialize(SExpression& root) const
     root.appendTokenChild("width", mLineWidth, false);
     root.appendTokenChild("fill", mIsFilled, true);
     root.appendTokenChild("grab", mIsGrabArea, false);
-    root.appendChild(Point(mRadiusX * 2, mRadiusY * 2).serializeToDomElement("size"), false);
-    root.appendChild(mCenter.serializeToDomElement("pos"), false);
+    root.appendChild(serializeToDomElement(Point(mRadiusX * 2, mRadiusY * 2), "size"), false);
+    root.appendChild(serializeToDomElement(mCenter, "pos"), false);
     root.appendTokenChild("rot", mRotation, false);
 }
 
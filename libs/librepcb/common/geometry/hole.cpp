@@ -109,7 +109,7 @@ void Hole::serialize(SExpression& root) const
 
     root.appendToken(mUuid);
     root.appendTokenChild("dia", mDiameter, false);
-    root.appendChild(mPosition.serializeToDomElement("pos"), false);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), false);
 }
 
 /*****************************************************************************************
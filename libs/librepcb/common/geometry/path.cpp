@@ -22,7 +22,9 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "path.h"
+#include "../fileio/serializableobject.h"
 #include "../toolbox.h"
+#include "../utils/geometrykernel.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -33,11 +35,6 @@ namespace librepcb {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-Path::Path(const Path& other) noexcept :
-    mVertices(other.mVertices), mPainterPathPx(other.mPainterPathPx)
-{
-}
-
 Path::Path(const SExpression& node)
 {
     foreach (const SExpression& child, node.getChildren("vertex")) {
@@ -45,6 +42,10 @@ Path::Path(const SExpression& node)
     }
 }
 
+Path::~Path() noexcept
+{
+}
+
 /*****************************************************************************************
  *  Getters
  ****************************************************************************************/
@@ -60,18 +61,19 @@ bool Path::isClosed() const noexcept
 
 const QPainterPath& Path::toQPainterPathPx(bool close) const noexcept
 {
-    if (mPainterPathPx.isEmpty()) {
+    if (!mPainterPathPx) {
+        mPainterPathPx.reset(new QPainterPath());
         int count = mVertices.count();
         if (close && (!isClosed()) && (count > 0)) ++count; // add implicit last point
         for (int i = 0; i < count; ++i) {
             const Vertex& v = mVertices.at(i % mVertices.count()); // wrap around!
             if (i == 0) {
-                mPainterPathPx.moveTo(v.getPos().toPxQPointF());
+                mPainterPathPx->moveTo(v.getPos().toPxQPointF());
                 continue;
             }
             const Vertex& v0 = mVertices.at(i-1);
             if (v0.getAngle() == 0) {
-                mPainterPathPx.lineTo(v.getPos().toPxQPointF());
+                mPainterPathPx->lineTo(v.getPos().toPxQPointF());
             } else {
                 QPointF centerPx = Toolbox::arcCenter(v0.getPos(), v.getPos(),
                                                       v0.getAngle()).toPxQPointF();
@@ -79,13 +81,13 @@ const QPainterPath& Path::toQPainterPathPx(bool close) const noexcept
                                                     v0.getAngle()).abs().toPx();
                 QPointF diffPx = v0.getPos().toPxQPointF() - centerPx;
                 qreal startAngleDeg = -qRadiansToDegrees(qAtan2(diffPx.y(), diffPx.x()));
-                mPainterPathPx.arcTo(centerPx.x() - radiusPx, centerPx.y() - radiusPx,
+                mPainterPathPx->arcTo(centerPx.x() - radiusPx, centerPx.y() - radiusPx,
                                      radiusPx * 2, radiusPx * 2,
                                      startAngleDeg, v0.getAngle().toDeg());
             }
         }
     }
-    return mPainterPathPx;
+    return *mPainterPathPx;
 }
 
 /*****************************************************************************************
@@ -174,7 +176,7 @@ bool Path::close() noexcept
 
 void Path::serialize(SExpression& root) const
 {
-    serializeObjectContainer(root, mVertices, "vertex");
+    SerializableObject::serializeObjectContainer(root, mVertices, "vertex");
 }
 
 /*****************************************************************************************
@@ -184,7 +186,7 @@ void Path::serialize(SExpression& root) const
 Path& Path::operator=(const Path& rhs) noexcept
 {
     mVertices = rhs.mVertices;
-    mPainterPathPx = rhs.mPainterPathPx;
+    invalidatePainterPath();
     return *this;
 }
 
@@ -282,29 +284,13 @@ Path Path::octagon(const Length& width, const Length& height) noexcept
 Path Path::flatArc(const Point& p1, const Point& p2, const Angle& angle,
                    const Length& maxTolerance) noexcept
 {
-    // return straight line if radius is smaller than half of the allowed tolerance
-    Length radiusAbs = Toolbox::arcRadius(p1, p2, angle).abs();
-    if (radiusAbs <= maxTolerance.abs() / 2) {
-        return line(p1, p2);
-    }
-
-    // calculate how many lines we need to create
-    qreal radiusAbsNm = static_cast<qreal>(radiusAbs.toNm());
-    qreal y = qBound(0.0, static_cast<qreal>(maxTolerance.toNm()), radiusAbsNm / 4);
-    qreal stepsPerRad = qMin(0.5 / qAcos(1 - y / radiusAbsNm), radiusAbsNm / 2);
-    int steps = qCeil(stepsPerRad * angle.abs().toRad());
-
-    // some other very complex calculations...
-    qreal angleDelta = angle.toMicroDeg() / (qreal)steps;
-    Point center = Toolbox::arcCenter(p1, p2, angle);
-
-    // create line segments
+    QVector<Point> points;
+    GeometryKernel::flattenArc(p1, p2, angle, maxTolerance, points);
     Path p;
-    p.addVertex(p1);
-    for (int i = 1; i < steps; ++i) {
-        p.addVertex(p1.rotated(Angle(angleDelta * i), center));
+    p.mVertices.reserve(points.count());
+    foreach (const Point& point, points) {
+        p.mVertices.append(Vertex(point));
     }
-    p.addVertex(p2);
     return p;
 }
 
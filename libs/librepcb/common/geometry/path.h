@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include "vertex.h"
 
@@ -47,17 +48,23 @@ namespace librepcb {
  *
  * For a valid path, minimum two vertices are required. Paths with less than two vertices
  * are useless and thus considered as invalid.
+ *
+ * @note To keep paths compact (there may be millions of them in plane fragments), this
+ *       class has no vptr and the QPainterPath returned by #toQPainterPathPx() is only
+ *       allocated when it is used. The cache is not copied together with the vertices,
+ *       so copying a path is not more expensive than copying its vertex list.
  */
-class Path final : public SerializableObject
+class Path final
 {
     public:
 
         // Constructors / Destructor
         Path() noexcept : mVertices(), mPainterPathPx() {}
-        Path(const Path& other) noexcept;
+        Path(const Path& other) noexcept : mVertices(other.mVertices), mPainterPathPx() {}
+        Path(Path&& other) noexcept = default;
         explicit Path(const QVector<Vertex>& vertices) noexcept : mVertices(vertices) {}
         explicit Path(const SExpression& node);
-        ~Path() noexcept {}
+        ~Path() noexcept;
 
         // Getters
         bool isClosed() const noexcept;
@@ -81,12 +88,13 @@ class Path final : public SerializableObject
         bool close() noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
-        void serialize(SExpression& root) const override;
+        void serialize(SExpression& root) const;
 
         // Operator Overloadings
         bool operator==(const Path& rhs) const noexcept {return mVertices == rhs.mVertices;}
         bool operator!=(const Path& rhs) const noexcept {return !(*this == rhs);}
         Path& operator=(const Path& rhs) noexcept;
+        Path& operator=(Path&& rhs) noexcept = default;
 
         // Static Methods
         static Path line(const Point& p1, const Point& p2, const Angle& angle = Angle::deg0()) noexcept;
@@ -102,12 +110,12 @@ class Path final : public SerializableObject
 
 
     private: // Methods
-        void invalidatePainterPath() const noexcept {mPainterPathPx = QPainterPath();}
+        void invalidatePainterPath() const noexcept {mPainterPathPx.reset();}
 
 
     private: // Data
         QVector<Vertex> mVertices;
-        mutable QPainterPath mPainterPathPx; // cached path for #toQPainterPathPx()
+        mutable std::unique_ptr<QPainterPath> mPainterPathPx; // cache for #toQPainterPathPx()
 };
 
 /*****************************************************************************************
@@ -360,8 +360,8 @@ void StrokeText::serialize(SExpression& root) const
     root.appendTokenChild("stroke_width", mStrokeWidth, false);
     root.appendTokenChild("letter_spacing", mLetterSpacing, false);
     root.appendTokenChild("line_spacing", mLineSpacing, false);
-    root.appendChild(mAlign.serializeToDomElement("align"), true);
-    root.appendChild(mPosition.serializeToDomElement("pos"), false);
+    root.appendChild(serializeToDomElement(mAlign, "align"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), false);
     root.appendTokenChild("rot", mRotation, false);
     root.appendTokenChild("auto_rotate", mAutoRotate, false);
     root.appendTokenChild("mirror", mMirrored, true);
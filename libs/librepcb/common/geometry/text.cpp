@@ -163,9 +163,9 @@ void Text::serialize(SExpression& root) const
     root.appendToken(mUuid);
     root.appendTokenChild("layer", mLayerName, false);
     root.appendStringChild("value", mText, false);
-    root.appendChild(mAlign.serializeToDomElement("align"), true);
+    root.appendChild(serializeToDomElement(mAlign, "align"), true);
     root.appendTokenChild("height", mHeight, false);
-    root.appendChild(mPosition.serializeToDomElement("pos"), false);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), false);
     root.appendTokenChild("rot", mRotation, false);
 }
 
@@ -49,7 +49,7 @@ Vertex::Vertex(const SExpression& node)
 
 void Vertex::serialize(SExpression& root) const
 {
-    root.appendChild(mPos.serializeToDomElement("pos"), false);
+    root.appendChild(serializeToDomElement(mPos, "pos"), false);
     root.appendTokenChild("angle", mAngle, false);
 }
 
@@ -62,13 +62,6 @@ bool Vertex::operator==(const Vertex& rhs) const noexcept
     return mPos == rhs.mPos && mAngle == rhs.mAngle;
 }
 
-Vertex& Vertex::operator=(const Vertex& rhs) noexcept
-{
-    mPos = rhs.mPos;
-    mAngle = rhs.mAngle;
-    return *this;
-}
-
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
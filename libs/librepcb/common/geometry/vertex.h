@@ -38,18 +38,21 @@ namespace librepcb {
 
 /**
  * @brief The Vertex class
+ *
+ * Like librepcb::Point, this is a trivially copyable value type without vptr to keep
+ * librepcb::Path as compact as possible.
  */
-class Vertex final : public SerializableObject
+class Vertex final
 {
     public:
 
         // Constructors / Destructor
         Vertex() noexcept : mPos(), mAngle() {}
-        Vertex(const Vertex& other) noexcept : mPos(other.mPos), mAngle(other.mAngle) {}
+        Vertex(const Vertex& other) = default;
         explicit Vertex(const Point& pos, const Angle& angle = Angle::deg0()) noexcept :
             mPos(pos), mAngle(angle) {}
         explicit Vertex(const SExpression& node);
-        ~Vertex() noexcept {}
+        ~Vertex() = default;
 
         // Getters
         const Point& getPos() const noexcept {return mPos;}
@@ -61,12 +64,12 @@ class Vertex final : public SerializableObject
 
         // General Methods
         /// @copydoc librepcb::SerializableObject::serialize()
-        void serialize(SExpression& root) const override;
+        void serialize(SExpression& root) const;
 
         // Operator Overloadings
         bool operator==(const Vertex& rhs) const noexcept;
         bool operator!=(const Vertex& rhs) const noexcept {return !(*this == rhs);}
-        Vertex& operator=(const Vertex& rhs) noexcept;
+        Vertex& operator=(const Vertex& rhs) = default;
 
 
     private: // Data
@@ -82,10 +85,15 @@ inline uint qHash(const Vertex& key, uint seed = 0) noexcept {
     return ::qHash(qMakePair(key.getPos(), key.getAngle()), seed);
 }
 
+static_assert(sizeof(Vertex) <= sizeof(Point) + sizeof(LengthBase_t),
+              "Vertex must not contain a vptr!");
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
 
 } // namespace librepcb
 
+Q_DECLARE_TYPEINFO(librepcb::Vertex, Q_MOVABLE_TYPE);
+
 #endif // LIBREPCB_VERTEX_H
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "graphicsitemsmovepreview.h"
+#include "graphicsscene.h"
+#include "linegraphicsitem.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GraphicsItemsMovePreview::GraphicsItemsMovePreview(GraphicsScene& scene) noexcept :
+    mScene(scene), mDelta(0, 0)
+{
+}
+
+GraphicsItemsMovePreview::~GraphicsItemsMovePreview() noexcept
+{
+    restore();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void GraphicsItemsMovePreview::addMovedItem(QGraphicsItem* item,
+                                            const Point& offset) noexcept
+{
+    if (item && (!mMovedItems.contains(item))) {
+        MovedItem movedItem{item->pos(), offset.toPxQPointF()};
+        mMovedItems.insert(item, movedItem);
+        item->setPos(movedItem.originalPos + movedItem.offset + mDelta.toPxQPointF());
+    }
+}
+
+void GraphicsItemsMovePreview::addRubberBandLine(QGraphicsItem* original,
+    const Point& fixedPos, const Point& movedPos, const Length& width,
+    const GraphicsLayer* layer) noexcept
+{
+    if (!original) return;
+    RubberBandLine rbl;
+    rbl.original = original;
+    rbl.originalVisible = original->isVisible();
+    rbl.fixedPos = fixedPos;
+    rbl.movedPos = movedPos;
+    rbl.line.reset(new LineGraphicsItem());
+    rbl.line->setZValue(original->zValue());
+    rbl.line->setLineWidth(width);
+    rbl.line->setLayer(layer);
+    rbl.line->setLine(fixedPos, movedPos + mDelta);
+    original->setVisible(false);
+    mScene.addItem(*rbl.line);
+    mRubberBandLines.append(rbl);
+}
+
+void GraphicsItemsMovePreview::setDelta(const Point& delta) noexcept
+{
+    if (delta == mDelta) return;
+    QPointF deltaPx = delta.toPxQPointF();
+    for (auto it = mMovedItems.constBegin(); it != mMovedItems.constEnd(); ++it) {
+        it.key()->setPos(it.value().originalPos + it.value().offset + deltaPx);
+    }
+    foreach (const RubberBandLine& rbl, mRubberBandLines) {
+        rbl.line->setLine(rbl.fixedPos, rbl.movedPos + delta);
+    }
+    mDelta = delta;
+}
+
+void GraphicsItemsMovePreview::restore() noexcept
+{
+    for (auto it = mMovedItems.constBegin(); it != mMovedItems.constEnd(); ++it) {
+        it.key()->setPos(it.value().originalPos);
+    }
+    foreach (const RubberBandLine& rbl, mRubberBandLines) {
+        mScene.removeItem(*rbl.line);
+        rbl.original->setVisible(rbl.originalVisible);
+    }
+    mMovedItems.clear();
+    mRubberBandLines.clear();
+    mDelta = Point(0, 0);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,137 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_GRAPHICSITEMSMOVEPREVIEW_H
+#define LIBREPCB_GRAPHICSITEMSMOVEPREVIEW_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class GraphicsScene;
+class GraphicsLayer;
+class LineGraphicsItem;
+
+/*****************************************************************************************
+ *  Class GraphicsItemsMovePreview
+ ****************************************************************************************/
+
+/**
+ * @brief The GraphicsItemsMovePreview class shows items at a new position without
+ *        modifying the items they represent
+ *
+ * While dragging items around, modifying the real model objects on every mouse move
+ * would trigger lots of expensive updates (attributes, airwires, graphics caches, ...).
+ * Instead, this class only translates the graphics items of the moved objects and
+ * replaces lines which are connected to exactly one moved object by temporary
+ * "rubber band" lines. The real modification has to be done by the caller afterwards.
+ *
+ * All graphics items are restored to their original state by #restore() or when the
+ * preview is destroyed. This must happen *before* the real objects are modified.
+ */
+class GraphicsItemsMovePreview final
+{
+    public:
+
+        // Constructors / Destructor
+        GraphicsItemsMovePreview() = delete;
+        GraphicsItemsMovePreview(const GraphicsItemsMovePreview& other) = delete;
+        explicit GraphicsItemsMovePreview(GraphicsScene& scene) noexcept;
+        ~GraphicsItemsMovePreview() noexcept;
+
+        // Getters
+        const Point& getDelta() const noexcept {return mDelta;}
+
+        // General Methods
+
+        /**
+         * @brief Add a graphics item which is translated by the delta (added only once)
+         */
+        void addMovedItem(QGraphicsItem* item) noexcept {addMovedItem(item, Point(0, 0));}
+
+        /**
+         * @brief Add a graphics item which is translated by an individual offset in
+         *        addition to the delta (added only once)
+         */
+        void addMovedItem(QGraphicsItem* item, const Point& offset) noexcept;
+
+        /**
+         * @brief Replace a line by a rubber band line while previewing
+         *
+         * @param original      The graphics item of the line (hidden while previewing)
+         * @param fixedPos      The position of the end which does not move
+         * @param movedPos      The original position of the end which moves
+         * @param width         Width of the rubber band line
+         * @param layer         Layer of the rubber band line
+         */
+        void addRubberBandLine(QGraphicsItem* original, const Point& fixedPos,
+                               const Point& movedPos, const Length& width,
+                               const GraphicsLayer* layer) noexcept;
+
+        /**
+         * @brief Move all items by a delta relative to their original positions
+         */
+        void setDelta(const Point& delta) noexcept;
+
+        /**
+         * @brief Restore the original state of all graphics items and remove all
+         *        temporary items
+         */
+        void restore() noexcept;
+
+        // Operator Overloadings
+        GraphicsItemsMovePreview& operator=(const GraphicsItemsMovePreview& rhs) = delete;
+
+
+    private: // Types
+        struct MovedItem {
+            QPointF originalPos;
+            QPointF offset;
+        };
+        struct RubberBandLine {
+            QGraphicsItem* original;
+            bool originalVisible;
+            Point fixedPos;
+            Point movedPos;
+            QSharedPointer<LineGraphicsItem> line;
+        };
+
+
+    private: // Data
+        GraphicsScene& mScene;
+        Point mDelta;
+        QHash<QGraphicsItem*, MovedItem> mMovedItems;
+        QList<RubberBandLine> mRubberBandLines;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GRAPHICSITEMSMOVEPREVIEW_H
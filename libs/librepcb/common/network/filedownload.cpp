@@ -22,6 +22,8 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <quazip/JlCompress.h>
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
 #include "filedownload.h"
 #include "scopeguard.h"
 
@@ -30,6 +32,91 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Class ZipExtractionWorker
+ ****************************************************************************************/
+
+/**
+ * @brief Extracts some files of a ZIP file (used by #FileDownload in a thread pool)
+ *
+ * Every worker opens the ZIP file on its own since QuaZip is not thread-safe. The
+ * workers iterate sequentially over all entries and each one extracts every n-th entry,
+ * since looking up entries by name would be a linear search for each entry.
+ */
+class ZipExtractionWorker final : public QRunnable
+{
+    public:
+        ZipExtractionWorker(const QString& zipFile, int workerIndex, int workerCount,
+                            const QDir& destination, QAtomicInt& extractedCount,
+                            QAtomicInt& abort, QMutex& errorMutex, QString& error) noexcept :
+            mZipFile(zipFile), mWorkerIndex(workerIndex), mWorkerCount(workerCount),
+            mDestination(destination),
+            mExtractedCount(extractedCount), mAbort(abort), mErrorMutex(errorMutex),
+            mError(error) {}
+
+        void run() override {
+            QuaZip zip(mZipFile);
+            if (!zip.open(QuaZip::mdUnzip)) {
+                setError(QString(FileDownload::tr("Could not open ZIP file \"%1\"."))
+                         .arg(QDir::toNativeSeparators(mZipFile)));
+                return;
+            }
+            int index = 0;
+            for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile(), ++index) {
+                if (mAbort.load()) return;
+                if ((index % mWorkerCount) != mWorkerIndex) continue;
+                QString filename = zip.getCurrentFileName();
+                if (!extractCurrentFile(zip, filename)) {
+                    setError(QString(FileDownload::tr("Could not extract \"%1\" from the ZIP file."))
+                             .arg(filename));
+                    return;
+                }
+                mExtractedCount.fetchAndAddRelaxed(1);
+            }
+            if (zip.getZipError() != UNZ_OK) {
+                setError(QString(FileDownload::tr("Could not read ZIP file \"%1\"."))
+                         .arg(QDir::toNativeSeparators(mZipFile)));
+            }
+        }
+
+    private:
+        bool extractCurrentFile(QuaZip& zip, const QString& filename) noexcept {
+            // do not allow writing outside of the destination directory
+            QString destPath = QDir::cleanPath(mDestination.absoluteFilePath(filename));
+            QString destDir = mDestination.absolutePath() % "/";
+            if (!destPath.startsWith(destDir)) return false;
+            if (filename.endsWith("/")) {
+                return QDir().mkpath(destPath);
+            }
+            if (!QDir().mkpath(QFileInfo(destPath).absolutePath())) return false;
+            QuaZipFile in(&zip);
+            QFile out(destPath);
+            if (!in.open(QIODevice::ReadOnly)) return false;
+            if (!out.open(QIODevice::WriteOnly)) return false;
+            QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+            qint64 size;
+            while ((size = in.read(buffer.data(), buffer.size())) > 0) {
+                if (out.write(buffer.constData(), size) != size) return false;
+            }
+            return (size == 0) && (in.getZipError() == UNZ_OK);
+        }
+
+        void setError(const QString& error) noexcept {
+            QMutexLocker locker(&mErrorMutex);
+            if (mError.isEmpty()) mError = error;
+            mAbort.store(1); // no need to extract the other files
+        }
+
+        QString mZipFile;
+        int mWorkerIndex;
+        int mWorkerCount;
+        QDir mDestination;
+        QAtomicInt& mExtractedCount;
+        QAtomicInt& mAbort;
+        QMutex& mErrorMutex;
+        QString& mError;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -91,6 +178,11 @@ void FileDownload::prepareRequest()
             QString("Could not open file \"%1\": %2")
             .arg(mDestination.toNative(), mFile->errorString()));
     }
+
+    // the checksum is calculated while receiving the data to avoid reading the file again
+    if (!mExpectedChecksum.isEmpty()) {
+        mHash.reset(new QCryptographicHash(mHashAlgorithm));
+    }
 }
 
 void FileDownload::finalizeRequest()
@@ -102,28 +194,10 @@ void FileDownload::finalizeRequest()
             .arg(mDestination.toNative()));
     }
 
-    // save to destination file
-    if (!mFile->commit()) {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("Error while writing file \"%1\": %2"))
-            .arg(mDestination.toNative(), mFile->errorString()));
-    }
-
-    // if an error occurs below this line, remove the downloaded file
-    auto sg = scopeGuard([this](){QFile::remove(mDestination.toStr());});
-
-    // verify checksum of downloaded file
-    if (!mExpectedChecksum.isEmpty()) {
+    // verify checksum of downloaded file (before writing it to the destination)
+    if (mHash) {
         emit progressState(tr("Verify checksum..."));
-        QFile file(mDestination.toStr());
-        if (!file.open(QFile::ReadOnly)) {
-            throw RuntimeError(__FILE__, __LINE__,
-                QString(tr("Error while readback file \"%1\": %2"))
-                .arg(mDestination.toNative(), file.errorString()));
-        }
-        QCryptographicHash hash(mHashAlgorithm);
-        hash.addData(&file);
-        QString result = hash.result().toHex();
+        QString result = mHash->result().toHex();
         QString expected = mExpectedChecksum.toHex();
         if (result != expected) {
             qDebug() << "expected" << expected << "but got" << result;
@@ -134,16 +208,19 @@ void FileDownload::finalizeRequest()
         }
     }
 
+    // save to destination file
+    if (!mFile->commit()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Error while writing file \"%1\": %2"))
+            .arg(mDestination.toNative(), mFile->errorString()));
+    }
+
+    // if an error occurs below this line, remove the downloaded file
+    auto sg = scopeGuard([this](){QFile::remove(mDestination.toStr());});
+
     // extract zip file if neccessary
     if (mExtractZipToDir.isValid()) {
-        emit progressState(tr("Extract files..."));
-        QStringList files = JlCompress::extractDir(mDestination.toStr(),
-                                                   mExtractZipToDir.toStr());
-        if (files.isEmpty()) {
-            throw RuntimeError(__FILE__, __LINE__,
-                QString(tr("Error while extracting the ZIP file \"%1\"."))
-                .arg(mDestination.toNative()));
-        }
+        extractZipFile(); // can throw
     } else {
         // do NOT remove the downloaded file
         sg.dismiss();
@@ -158,9 +235,54 @@ void FileDownload::emitSuccessfullyFinishedSignals() noexcept
     }
 }
 
+void FileDownload::extractZipFile()
+{
+    emit progressState(tr("Extract files..."));
+    emit progressPercent(0);
+
+    QStringList files = JlCompress::getFileList(mDestination.toStr());
+    QDir destination(mExtractZipToDir.toStr());
+    if (files.isEmpty() || (!destination.mkpath("."))) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Error while extracting the ZIP file \"%1\"."))
+            .arg(mDestination.toNative()));
+    }
+
+    // Extract the files with a few threads. Decompressing is CPU bound, but more threads
+    // than that would only compete for the disk.
+    QThreadPool pool;
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), sMaxExtractionThreads));
+    QAtomicInt extractedCount(0);
+    QAtomicInt abort(0);
+    QMutex errorMutex;
+    QString error;
+    int workerCount = qMin(pool.maxThreadCount(), files.count());
+    for (int i = 0; i < workerCount; ++i) {
+        pool.start(new ZipExtractionWorker(mDestination.toStr(), i, workerCount, destination,
+                                           extractedCount, abort, errorMutex, error));
+    }
+    while (!pool.waitForDone(100)) {
+        emit progressPercent((100 * extractedCount.load()) / files.count());
+    }
+    emit progressPercent(100);
+
+    if (!error.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Error while extracting the ZIP file \"%1\": %2"))
+            .arg(mDestination.toNative(), error));
+    }
+}
+
 void FileDownload::fetchNewData() noexcept
 {
-    mFile->write(mReply->readAll());
+    QByteArray data = mReply->readAll();
+    if (mReply->attribute(QNetworkRequest::RedirectionTargetAttribute).isValid()) {
+        return; // ignore the content of redirection replies
+    }
+    mFile->write(data);
+    if (mHash) {
+        mHash->addData(data);
+    }
 }
 
 /*****************************************************************************************
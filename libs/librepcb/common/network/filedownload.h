@@ -121,16 +121,20 @@ class FileDownload final : public NetworkRequestBase
         void finalizeRequest() override;
         void emitSuccessfullyFinishedSignals() noexcept override;
         void fetchNewData() noexcept override;
+        void extractZipFile();
 
 
     private: // Data
 
         FilePath mDestination;
         QScopedPointer<QSaveFile> mFile;
+        QScopedPointer<QCryptographicHash> mHash;
         QCryptographicHash::Algorithm mHashAlgorithm;
         QByteArray mExpectedChecksum;
         FilePath mExtractZipToDir;
 
+        static constexpr int sMaxExtractionThreads = 4;
+
 };
 
 /*****************************************************************************************
@@ -91,7 +91,7 @@ class Angle
          *
          * @param angle         Another Angle object
          */
-        Angle(const Angle& angle) noexcept : mMicrodegrees(angle.mMicrodegrees) {}
+        Angle(const Angle& angle) = default;
 
         /**
          * @brief Constructor with an angle in microdegrees
@@ -103,7 +103,7 @@ class Angle
         /**
          * @brief Destructor
          */
-        ~Angle() noexcept {}
+        ~Angle() = default;
 
 
         // Setters
@@ -318,7 +318,7 @@ class Angle
 
 
         // Operators
-        Angle&   operator=(const Angle& rhs)        {mMicrodegrees = rhs.mMicrodegrees; return *this;}
+        Angle&   operator=(const Angle& rhs)        = default;
         Angle&   operator+=(const Angle& rhs)       {mMicrodegrees = (mMicrodegrees + rhs.mMicrodegrees) % 360000000; return *this;}
         Angle&   operator-=(const Angle& rhs)       {mMicrodegrees = (mMicrodegrees - rhs.mMicrodegrees) % 360000000; return *this;}
         Angle    operator+(const Angle& rhs) const  {return Angle(mMicrodegrees + rhs.mMicrodegrees);}
@@ -386,4 +386,6 @@ inline uint qHash(const Angle& key, uint seed = 0) noexcept {
 
 } // namespace librepcb
 
+Q_DECLARE_TYPEINFO(librepcb::Angle, Q_MOVABLE_TYPE);
+
 #endif // LIBREPCB_ANGLE_H
@@ -94,7 +94,7 @@ class Length
          *
          * @param length        Another Length object
          */
-        Length(const Length& length) noexcept : mNanometers(length.mNanometers) {}
+        Length(const Length& length) = default;
 
         /**
          * @brief Constructor with length in nanometers
@@ -106,7 +106,7 @@ class Length
         /**
          * @brief Destructor
          */
-        ~Length() noexcept {}
+        ~Length() = default;
 
 
         // Setters
@@ -453,7 +453,7 @@ class Length
 
 
         // Operators
-        Length& operator=(const Length& rhs)        {mNanometers = rhs.mNanometers; return *this;}
+        Length& operator=(const Length& rhs)        = default;
         Length& operator+=(const Length& rhs)       {mNanometers += rhs.mNanometers; return *this;}
         Length& operator-=(const Length& rhs)       {mNanometers -= rhs.mNanometers; return *this;}
         Length& operator*=(const Length& rhs)       {mNanometers *= rhs.mNanometers; return *this;}
@@ -564,4 +564,6 @@ inline uint qHash(const Length& key, uint seed = 0) noexcept {
 
 } // namespace librepcb
 
+Q_DECLARE_TYPEINFO(librepcb::Length, Q_MOVABLE_TYPE);
+
 #endif // LIBREPCB_LENGTH_H
@@ -66,12 +66,19 @@ class Angle;
  * Point.getY().toPx(), this way the sign of the value in pixels is also wrong! You should
  * use Point.toPxQPointF().y() instead for this purpose.
  *
+ * @note This class intentionally does not inherit from librepcb::SerializableObject to
+ *       avoid the vptr. It is a trivially copyable value type (just two lengths) since
+ *       huge amounts of points are stored in paths, polygons and plane fragments. The
+ *       serialization methods have the same signature as those of
+ *       librepcb::SerializableObject, so the template helpers like
+ *       librepcb::SerializableObject::serializeObjectContainer() work anyway.
+ *
  * @see class Length
  *
  * @author ubruhin
  * @date 2014-06-21
  */
-class Point final : public SerializableObject
+class Point final
 {
     public:
 
@@ -89,7 +96,7 @@ class Point final : public SerializableObject
          *
          * @param point     Another Point object
          */
-        Point(const Point& point) noexcept : mX(point.mX), mY(point.mY) {}
+        Point(const Point& point) = default;
 
         /**
          * @brief Constructor for passing two Length objects
@@ -104,7 +111,7 @@ class Point final : public SerializableObject
         /**
          * @brief Destructor
          */
-        ~Point() noexcept {}
+        ~Point() = default;
 
 
         // Setters
@@ -350,7 +357,7 @@ class Point final : public SerializableObject
         Point& mirror(Qt::Orientation orientation, const Point& center = Point(0, 0)) noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
-        void serialize(SExpression& root) const override;
+        void serialize(SExpression& root) const;
 
 
         // Static Functions
@@ -374,7 +381,7 @@ class Point final : public SerializableObject
         static Point fromPx(const QPointF& pixels,                  const Length& gridInterval = Length(0));
 
         // Operators
-        Point&  operator=(const Point& rhs)        {mX = rhs.mX;  mY = rhs.mY;  return *this;}
+        Point&  operator=(const Point& rhs)        = default;
         Point&  operator+=(const Point& rhs)       {mX += rhs.mX; mY += rhs.mY; return *this;}
         Point&  operator-=(const Point& rhs)       {mX -= rhs.mX; mY -= rhs.mY; return *this;}
         Point&  operator*=(const Point& rhs)       {mX *= rhs.mX; mY *= rhs.mY; return *this;}
@@ -409,6 +416,8 @@ inline uint qHash(const Point& key, uint seed = 0) noexcept {
     return ::qHash(qMakePair(key.getX(), key.getY()), seed);
 }
 
+static_assert(sizeof(Point) == 2 * sizeof(Length), "Point must not contain a vptr!");
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -416,5 +425,6 @@ inline uint qHash(const Point& key, uint seed = 0) noexcept {
 } // namespace librepcb
 
 Q_DECLARE_METATYPE(librepcb::Point)
+Q_DECLARE_TYPEINFO(librepcb::Point, Q_MOVABLE_TYPE);
 
 #endif // LIBREPCB_POINT_H
@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "clipperhelpers.h"
+#include "geometrykernel.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -45,20 +46,24 @@ void ClipperHelpers::offset(ClipperLib::Paths& paths, const Length& offset,
     }
 }
 
+void ClipperHelpers::offsetToTree(const ClipperLib::Paths& paths, const Length& offset,
+                                  const Length& maxArcTolerance, ClipperLib::PolyTree& result)
+{
+    try {
+        ClipperLib::ClipperOffset o(2.0, maxArcTolerance.toNm());
+        o.AddPaths(paths, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
+        o.Execute(result, offset.toNm());
+    } catch (const std::exception& e) {
+        throw LogicError(__FILE__, __LINE__,
+            QString(tr("Failed to offset a path: %1")).arg(e.what()));
+    }
+}
+
 ClipperLib::Paths ClipperHelpers::flattenTree(const ClipperLib::PolyNode& node)
 {
     ClipperLib::Paths paths;
-    for (const ClipperLib::PolyNode* outlineChild : node.Childs) { Q_ASSERT(outlineChild);
-        if (outlineChild->IsHole()) throw LogicError(__FILE__, __LINE__);
-        ClipperLib::Paths holes;
-        for (ClipperLib::PolyNode* holeChild : outlineChild->Childs) { Q_ASSERT(holeChild);
-            if (!holeChild->IsHole()) throw LogicError(__FILE__, __LINE__);
-            holes.push_back(holeChild->Contour);
-            ClipperLib::Paths subpaths = flattenTree(*holeChild); // can throw
-            paths.insert(paths.end(), subpaths.begin(), subpaths.end());
-        }
-        paths.push_back(convertHolesToCutIns(outlineChild->Contour, holes)); // can throw
-    }
+    ClipperLib::Paths holesBuffer; // reused for all outlines to avoid reallocations
+    flattenTree(node, paths, holesBuffer); // can throw
     return paths;
 }
 
@@ -105,6 +110,8 @@ ClipperLib::Paths ClipperHelpers::convert(const QVector<Path>& paths,
 ClipperLib::Path ClipperHelpers::convert(const Path& path, const Length& maxArcTolerance) noexcept
 {
     ClipperLib::Path p;
+    p.reserve(path.getVertices().count());
+    QVector<Point> arc; // reused for all arcs of the path
     for (int i = 0; i < path.getVertices().count(); ++i) {
         const Vertex& v = path.getVertices().at(i);
         const Vertex& v0 = path.getVertices().at(qMax(i-1, 0));
@@ -112,10 +119,11 @@ ClipperLib::Path ClipperHelpers::convert(const Path& path, const Length& maxArcT
             p.push_back(convert(v.getPos()));
         } else {
             // approximate arcs by many short straight line segments
-            Path arc = Path::flatArc(v0.getPos(), v.getPos(), v0.getAngle(), maxArcTolerance);
+            int count = GeometryKernel::flattenArc(v0.getPos(), v.getPos(), v0.getAngle(),
+                                                   maxArcTolerance, arc);
             // skip first point as it is would be a duplicate
-            for (int k = 1; k < arc.getVertices().count(); ++k) {
-                p.push_back(convert(arc.getVertices().at(k).getPos()));
+            for (int k = 1; k < count; ++k) {
+                p.push_back(convert(arc.at(k)));
             }
         }
     }
@@ -135,43 +143,69 @@ ClipperLib::IntPoint ClipperHelpers::convert(const Point& point) noexcept
  *  Internal Helper Methods
  ****************************************************************************************/
 
+void ClipperHelpers::flattenTree(const ClipperLib::PolyNode& node, ClipperLib::Paths& paths,
+                                 ClipperLib::Paths& holesBuffer)
+{
+    for (const ClipperLib::PolyNode* outlineChild : node.Childs) { Q_ASSERT(outlineChild);
+        if (outlineChild->IsHole()) throw LogicError(__FILE__, __LINE__);
+        for (const ClipperLib::PolyNode* holeChild : outlineChild->Childs) { Q_ASSERT(holeChild);
+            if (!holeChild->IsHole()) throw LogicError(__FILE__, __LINE__);
+            flattenTree(*holeChild, paths, holesBuffer); // can throw
+        }
+        holesBuffer.clear();
+        for (const ClipperLib::PolyNode* holeChild : outlineChild->Childs) {
+            holesBuffer.push_back(holeChild->Contour);
+        }
+        paths.push_back(convertHolesToCutIns(outlineChild->Contour, holesBuffer)); // can throw
+    }
+}
+
 ClipperLib::Path ClipperHelpers::convertHolesToCutIns(const ClipperLib::Path& outline,
-                                                      const ClipperLib::Paths& holes)
+                                                      ClipperLib::Paths& holes)
 {
-    ClipperLib::Path path = outline;
-    ClipperLib::Paths preparedHoles = prepareHoles(holes);
-    for (const ClipperLib::Path& hole : preparedHoles) {
+    prepareHoles(holes);
+
+    // allocate the resulting path only once (each cut-in adds 3 connection points)
+    std::size_t size = outline.size();
+    for (const ClipperLib::Path& hole : holes) {
+        size += hole.size() + 3;
+    }
+    ClipperLib::Path path;
+    path.reserve(size);
+    path.insert(path.end(), outline.begin(), outline.end());
+    for (const ClipperLib::Path& hole : holes) {
         addCutInToPath(path, hole); // can throw
     }
     return path;
 }
 
-ClipperLib::Paths ClipperHelpers::prepareHoles(const ClipperLib::Paths& holes) noexcept
+void ClipperHelpers::prepareHoles(ClipperLib::Paths& holes) noexcept
 {
-    ClipperLib::Paths preparedHoles;
-    for (const ClipperLib::Path& hole : holes) {
-        if (hole.size() > 2) {
-            preparedHoles.push_back(rotateCutInHole(hole));
-        } else {
-            qWarning() << "Detected invalid hole in path flattening algorithm, ignoring it...";
-        }
+    holes.erase(std::remove_if(holes.begin(), holes.end(),
+        [](const ClipperLib::Path& hole){
+            if (hole.size() <= 2) {
+                qWarning() << "Detected invalid hole in path flattening algorithm, ignoring it...";
+                return true;
+            }
+            return false;
+        }),
+        holes.end());
+    for (ClipperLib::Path& hole : holes) {
+        rotateCutInHole(hole);
     }
     // important: sort holes by the y coordinate of their connection point
     // (to make sure no cut-ins are overlapping in the resulting plane)
-    std::sort(preparedHoles.begin(), preparedHoles.end(),
+    std::sort(holes.begin(), holes.end(),
               [](const ClipperLib::Path& p1, const ClipperLib::Path& p2)
               {return p1.front().Y < p2.front().Y;});
-    return preparedHoles;
 }
 
-ClipperLib::Path ClipperHelpers::rotateCutInHole(const ClipperLib::Path& hole) noexcept
+void ClipperHelpers::rotateCutInHole(ClipperLib::Path& hole) noexcept
 {
-    ClipperLib::Path p = hole;
-    if (p.back() == p.front()) {
-        p.pop_back();
+    if (hole.back() == hole.front()) {
+        hole.pop_back();
     }
-    std::rotate(p.begin(), p.begin() + getHoleConnectionPointIndex(p), p.end());
-    return p;
+    std::rotate(hole.begin(), hole.begin() + getHoleConnectionPointIndex(hole), hole.end());
 }
 
 int ClipperHelpers::getHoleConnectionPointIndex(const ClipperLib::Path& hole) noexcept
@@ -52,7 +52,11 @@ class ClipperHelpers final
         // General Methods
         static void offset(ClipperLib::Paths& paths, const Length& offset,
                            const Length& maxArcTolerance);
+        static void offsetToTree(const ClipperLib::Paths& paths, const Length& offset,
+                                 const Length& maxArcTolerance, ClipperLib::PolyTree& result);
         static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
+        static ClipperLib::Path convertHolesToCutIns(const ClipperLib::Path& outline,
+                                                     ClipperLib::Paths& holes);
 
         // Type Conversions
         static QVector<Path> convert(const ClipperLib::Paths& paths) noexcept;
@@ -66,10 +70,10 @@ class ClipperHelpers final
 
 
     private: // Internal Helper Methods
-        static ClipperLib::Path convertHolesToCutIns(const ClipperLib::Path& outline,
-                                                     const ClipperLib::Paths& holes);
-        static ClipperLib::Paths prepareHoles(const ClipperLib::Paths& holes) noexcept;
-        static ClipperLib::Path rotateCutInHole(const ClipperLib::Path& hole) noexcept;
+        static void flattenTree(const ClipperLib::PolyNode& node, ClipperLib::Paths& paths,
+                                ClipperLib::Paths& holesBuffer);
+        static void prepareHoles(ClipperLib::Paths& holes) noexcept;
+        static void rotateCutInHole(ClipperLib::Path& hole) noexcept;
         static int getHoleConnectionPointIndex(const ClipperLib::Path& hole) noexcept;
         static void addCutInToPath(ClipperLib::Path& outline, const ClipperLib::Path& hole);
         static int insertConnectionPointToPath(ClipperLib::Path& path,
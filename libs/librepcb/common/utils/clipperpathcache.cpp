@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "clipperpathcache.h"
+#include "clipperhelpers.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ClipperPathCache::ClipperPathCache(int maxEntries) noexcept :
+    mMutex(), mCache(maxEntries)
+{
+}
+
+ClipperPathCache::~ClipperPathCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int ClipperPathCache::getCount() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mCache.count();
+}
+
+int ClipperPathCache::getMaxEntries() const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mCache.maxCost();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+ClipperLib::Path ClipperPathCache::convert(const Path& path, const Length& maxArcTolerance,
+                                           const Angle& rotation,
+                                           const Point& translation) noexcept
+{
+    bool hasArcs = std::any_of(path.getVertices().begin(), path.getVertices().end(),
+                               [](const Vertex& v){return v.getAngle() != 0;});
+    if (!hasArcs) {
+        return ClipperHelpers::convert(path.rotated(rotation).translated(translation),
+                                       maxArcTolerance);
+    }
+
+    Key key{path, rotation, maxArcTolerance.toNm()};
+    ClipperLib::Path result;
+    bool cached = false;
+    {
+        QMutexLocker locker(&mMutex);
+        if (const ClipperLib::Path* p = mCache.object(key)) {
+            result = *p;
+            cached = true;
+        }
+    }
+    if (!cached) {
+        // rotate the path before flattening it (outside of the lock to not block other
+        // threads), rotating the flattened points would round them a second time
+        result = ClipperHelpers::convert(path.rotated(rotation), maxArcTolerance);
+        QMutexLocker locker(&mMutex);
+        mCache.insert(key, new ClipperLib::Path(result));
+    }
+
+    // the translation is exact, so it doesn't need to be cached
+    ClipperLib::cInt dx = translation.getX().toNm();
+    ClipperLib::cInt dy = translation.getY().toNm();
+    for (ClipperLib::IntPoint& p : result) {
+        p.X += dx;
+        p.Y += dy;
+    }
+    return result;
+}
+
+void ClipperPathCache::clear() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    mCache.clear();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
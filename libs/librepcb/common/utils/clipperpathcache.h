@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLIPPERPATHCACHE_H
+#define LIBREPCB_CLIPPERPATHCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <clipper/clipper.hpp>
+#include "../geometry/path.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ClipperPathCache
+ ****************************************************************************************/
+
+/**
+ * @brief The ClipperPathCache class memoizes the conversion of paths with arcs to
+ *        ClipperLib paths
+ *
+ * Flattening arcs (see librepcb::Path::flatArc()) is relatively expensive, but most
+ * arc-shaped outlines (pads, vias, holes) are identical for many items and only differ
+ * in their position. Therefore the flattened path is cached in local coordinates (keyed
+ * by the path itself, its rotation and the arc tolerance) and only the translation of the
+ * instance is applied on every conversion. Since the rotation is applied to the path
+ * before flattening it, the result is the same as without the cache.
+ *
+ * Paths without arcs are not cached at all since their conversion is trivial anyway.
+ *
+ * All methods are thread-safe. The number of cached paths is limited, if the cache is
+ * full the least recently used paths are removed.
+ */
+class ClipperPathCache final
+{
+    public:
+
+        // Constructors / Destructor
+        ClipperPathCache(const ClipperPathCache& other) = delete;
+        explicit ClipperPathCache(int maxEntries = 10000) noexcept;
+        ~ClipperPathCache() noexcept;
+
+        // Getters
+        int getCount() const noexcept;
+        int getMaxEntries() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Convert a path given in local coordinates and transform it to the scene
+         *
+         * This is equivalent to (but much faster than) converting
+         * `path.rotated(rotation).translated(translation)` with
+         * librepcb::ClipperHelpers::convert(const Path&, const Length&) since the
+         * flattened path is reused.
+         *
+         * @param path              The path in local coordinates.
+         * @param maxArcTolerance   Maximum tolerance of flattened arcs.
+         * @param rotation          Rotation around the origin (applied first).
+         * @param translation       Translation (applied after the rotation).
+         *
+         * @return The flattened and transformed path
+         */
+        ClipperLib::Path convert(const Path& path, const Length& maxArcTolerance,
+                                 const Angle& rotation, const Point& translation) noexcept;
+
+        /**
+         * @brief Remove all cached paths
+         */
+        void clear() noexcept;
+
+        // Operator Overloadings
+        ClipperPathCache& operator=(const ClipperPathCache& rhs) = delete;
+
+
+    private: // Types
+        struct Key {
+            Path path;
+            Angle rotation;
+            LengthBase_t tolerance;
+            bool operator==(const Key& rhs) const noexcept {
+                return (tolerance == rhs.tolerance) && (rotation == rhs.rotation) &&
+                       (path == rhs.path);
+            }
+        };
+        friend uint qHash(const Key& key, uint seed) noexcept {
+            return qHash(key.path, seed) ^ qHash(key.rotation, seed) ^
+                   qHash(key.tolerance, seed);
+        }
+
+
+    private: // Data
+        mutable QMutex mMutex; ///< QCache::object() modifies the LRU order, even reads need it
+        QCache<Key, ClipperLib::Path> mCache;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CLIPPERPATHCACHE_H
@@ -0,0 +1,232 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CONNECTIVITYGRAPH_H
+#define LIBREPCB_CONNECTIVITYGRAPH_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "unionfind.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ConnectivityGraph
+ ****************************************************************************************/
+
+/**
+ * @brief The ConnectivityGraph class keeps track of connected groups of items while
+ *        items and connections are added and removed
+ *
+ * The graph consists of nodes (e.g. netpoints and vias) and undirected edges between
+ * them (e.g. netlines). Multiple edges between the same nodes are allowed, an edge is
+ * only removed completely after it was removed as many times as it was added.
+ *
+ * Besides the adjacency lists, a UnionFind of all nodes is kept up to date while nodes
+ * and edges are added, so connectivity queries (#areConnected(), #getGroupCount()) run
+ * in nearly constant time. Since a union-find can't split groups, removing nodes or
+ * edges only marks it as outdated. It is then rebuilt from the adjacency lists on the
+ * next query, i.e. only once per batch of removals.
+ *
+ * All results which contain several nodes are ordered by the time the nodes were added
+ * to make them deterministic.
+ *
+ * @tparam T    The node type. Must be copyable and usable as a key of QHash.
+ */
+template <typename T>
+class ConnectivityGraph final
+{
+    public:
+
+        // Constructors / Destructor
+        ConnectivityGraph() noexcept : mNextSequenceNumber(0), mGroupsOutdated(false) {}
+        ConnectivityGraph(const ConnectivityGraph& other) = default;
+        ~ConnectivityGraph() noexcept {}
+
+        // Getters
+        int getNodeCount() const noexcept {return mNodes.count();}
+        bool containsNode(const T& node) const noexcept {return mNodes.contains(node);}
+        int getEdgeCount(const T& a, const T& b) const noexcept {
+            auto it = mNodes.constFind(a);
+            return (it != mNodes.constEnd()) ? it->neighbors.value(b, 0) : 0;
+        }
+
+        // General Methods
+
+        /**
+         * @brief Add a node without any edges (does nothing if it was already added)
+         */
+        void addNode(const T& node) noexcept {
+            if (mNodes.contains(node)) return;
+            mNodes.insert(node, Node{mNextSequenceNumber++, QHash<T, int>()});
+            if (!mGroupsOutdated) mGroups.add(node);
+        }
+
+        /**
+         * @brief Remove a node together with all its edges
+         */
+        void removeNode(const T& node) noexcept {
+            auto it = mNodes.find(node);
+            if (it == mNodes.end()) return;
+            for (auto n = it->neighbors.constBegin(); n != it->neighbors.constEnd(); ++n) {
+                if (n.key() != node) mNodes[n.key()].neighbors.remove(node);
+            }
+            mNodes.erase(it);
+            mGroupsOutdated = true;
+        }
+
+        /**
+         * @brief Add an edge between two nodes (nodes are added if not yet done)
+         */
+        void addEdge(const T& a, const T& b) noexcept {
+            addNode(a);
+            addNode(b);
+            ++mNodes[a].neighbors[b];
+            if (a != b) ++mNodes[b].neighbors[a];
+            if (!mGroupsOutdated) mGroups.unite(a, b);
+        }
+
+        /**
+         * @brief Remove one edge between two nodes (the nodes are kept)
+         */
+        void removeEdge(const T& a, const T& b) noexcept {
+            if ((!removeNeighbor(a, b)) || (a == b)) return;
+            removeNeighbor(b, a);
+            mGroupsOutdated = true;
+        }
+
+        /**
+         * @brief Check whether two nodes are connected together (directly or indirectly)
+         *
+         * @return False if one of the nodes doesn't exist.
+         */
+        bool areConnected(const T& a, const T& b) const noexcept {
+            return getUpToDateGroups().areConnected(a, b);
+        }
+
+        /**
+         * @brief Get the number of separate groups of connected nodes
+         */
+        int getGroupCount() const noexcept {return getUpToDateGroups().getGroupCount();}
+
+        /**
+         * @brief Get all groups of connected nodes
+         */
+        QList<QList<T>> getGroups() const noexcept {return getUpToDateGroups().getGroups();}
+
+        /**
+         * @brief Get all nodes which are connected to a node (including the node itself)
+         *
+         * Only the nodes of the requested group are visited, so this is much faster
+         * than #getGroups() for small groups in a large graph.
+         */
+        QList<T> getConnectedNodes(const T& node) const noexcept {
+            if (!mNodes.contains(node)) return QList<T>();
+            QList<T> nodes{node};
+            QSet<T> visited{node};
+            for (int i = 0; i < nodes.count(); ++i) {
+                const QHash<T, int>& neighbors = mNodes.constFind(nodes.at(i))->neighbors;
+                for (auto it = neighbors.constBegin(); it != neighbors.constEnd(); ++it) {
+                    if (!visited.contains(it.key())) {
+                        visited.insert(it.key());
+                        nodes.append(it.key());
+                    }
+                }
+            }
+            return sortedBySequenceNumber(nodes);
+        }
+
+        // Operator Overloadings
+        ConnectivityGraph& operator=(const ConnectivityGraph& rhs) = default;
+
+
+    private: // Types
+        struct Node {
+            qint64 sequenceNumber; ///< to order nodes by the time they were added
+            QHash<T, int> neighbors; ///< neighbors with their count of edges
+        };
+
+
+    private: // Methods
+        bool removeNeighbor(const T& node, const T& neighbor) noexcept {
+            auto it = mNodes.find(node);
+            if (it == mNodes.end()) return false;
+            auto n = it->neighbors.find(neighbor);
+            if (n == it->neighbors.end()) return false;
+            if (--(*n) <= 0) it->neighbors.erase(n);
+            return true;
+        }
+
+        QList<T> sortedBySequenceNumber(const QList<T>& nodes) const noexcept {
+            QVector<QPair<qint64, T>> sequence;
+            sequence.reserve(nodes.count());
+            foreach (const T& node, nodes) {
+                sequence.append(qMakePair(mNodes.constFind(node)->sequenceNumber, node));
+            }
+            std::sort(sequence.begin(), sequence.end(),
+                [](const QPair<qint64, T>& a, const QPair<qint64, T>& b) {
+                    return a.first < b.first;
+                });
+            QList<T> sorted;
+            sorted.reserve(sequence.count());
+            for (const auto& pair : sequence) {
+                sorted.append(pair.second);
+            }
+            return sorted;
+        }
+
+        const UnionFind<T>& getUpToDateGroups() const noexcept {
+            if (mGroupsOutdated) {
+                QList<T> nodes = sortedBySequenceNumber(mNodes.keys());
+                mGroups = UnionFind<T>();
+                foreach (const T& node, nodes) {
+                    mGroups.add(node);
+                }
+                foreach (const T& node, nodes) {
+                    const QHash<T, int>& neighbors = mNodes.constFind(node)->neighbors;
+                    for (auto it = neighbors.constBegin(); it != neighbors.constEnd(); ++it) {
+                        mGroups.unite(node, it.key());
+                    }
+                }
+                mGroupsOutdated = false;
+            }
+            return mGroups;
+        }
+
+
+    private: // Data
+        QHash<T, Node> mNodes;
+        qint64 mNextSequenceNumber;
+        mutable UnionFind<T> mGroups; ///< mutable since it is rebuilt lazily
+        mutable bool mGroupsOutdated;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CONNECTIVITYGRAPH_H
@@ -0,0 +1,305 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "geometrykernel.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class SegmentArray
+ ****************************************************************************************/
+
+void GeometryKernel::SegmentArray::reserve(int size) noexcept
+{
+    mX1.reserve(size);
+    mY1.reserve(size);
+    mDx.reserve(size);
+    mDy.reserve(size);
+    mInvLengthSq.reserve(size);
+}
+
+void GeometryKernel::SegmentArray::clear() noexcept
+{
+    mX1.resize(0);
+    mY1.resize(0);
+    mDx.resize(0);
+    mDy.resize(0);
+    mInvLengthSq.resize(0);
+}
+
+void GeometryKernel::SegmentArray::append(const Point& p1, const Point& p2) noexcept
+{
+    qreal x1 = p1.getX().toNm();
+    qreal y1 = p1.getY().toNm();
+    qreal dx = p2.getX().toNm() - x1;
+    qreal dy = p2.getY().toNm() - y1;
+    qreal lengthSq = dx * dx + dy * dy;
+    mX1.append(x1);
+    mY1.append(y1);
+    mDx.append(dx);
+    mDy.append(dy);
+    mInvLengthSq.append((lengthSq > 0) ? (1 / lengthSq) : 0);
+}
+
+/*****************************************************************************************
+ *  Arcs
+ ****************************************************************************************/
+
+qreal GeometryKernel::arcRadiusNm(const Point& p1, const Point& p2, const Angle& angle) noexcept
+{
+    if (angle == 0) {
+        return 0;
+    }
+    qreal dx = p2.getX().toNm() - p1.getX().toNm();
+    qreal dy = p2.getY().toNm() - p1.getY().toNm();
+    qreal d = qSqrt(dx * dx + dy * dy);
+    return d / (2 * qSin(angle.mappedTo180deg().toRad() / 2));
+}
+
+QPointF GeometryKernel::arcCenterNm(const Point& p1, const Point& p2, const Angle& angle) noexcept
+{
+    qreal x0 = p1.getX().toNm();
+    qreal y0 = p1.getY().toNm();
+    qreal x1 = p2.getX().toNm();
+    qreal y1 = p2.getY().toNm();
+    qreal dx = x1 - x0;
+    qreal dy = y1 - y0;
+    qreal d = qSqrt(dx * dx + dy * dy);
+    if ((angle == 0) || (d <= 0)) {
+        // there is no arc center...just return the middle of start- and endpoint
+        return QPointF((x0 + x1) / 2, (y0 + y1) / 2);
+    }
+    qreal rad = angle.mappedTo180deg().toRad();
+    qreal sign = (rad >= 0) ? 1 : -1;
+    qreal r = d / (2 * qSin(rad / 2));
+    qreal h = qSqrt(qMax(r * r - d * d / 4, qreal(0))); // avoid NaN for 180° arcs
+    return QPointF(((x0 + x1) / 2) - h * (dy / d) * sign,
+                   ((y0 + y1) / 2) + h * (dx / d) * sign);
+}
+
+int GeometryKernel::flattenArc(const Point& p1, const Point& p2, const Angle& angle,
+                               const Length& maxTolerance, QVector<Point>& buffer) noexcept
+{
+    // return straight line if radius is smaller than half of the allowed tolerance
+    // (the radius is rounded to nanometers to get exactly the same number of vertices as
+    // Path::flatArc() always did)
+    qint64 radiusAbs = qAbs(qRound64(arcRadiusNm(p1, p2, angle)));
+    if (radiusAbs <= maxTolerance.abs().toNm() / 2) {
+        buffer.resize(2);
+        buffer[0] = p1;
+        buffer[1] = p2;
+        return 2;
+    }
+
+    // calculate how many lines we need to create
+    qreal radiusAbsNm = static_cast<qreal>(radiusAbs);
+    qreal y = qBound(qreal(0), static_cast<qreal>(maxTolerance.toNm()), radiusAbsNm / 4);
+    qreal stepsPerRad = qMin(qreal(0.5) / qAcos(1 - y / radiusAbsNm), radiusAbsNm / 2);
+    int steps = qMax(1, qCeil(stepsPerRad * angle.abs().toRad()));
+
+    // rotate the start point around the center, without any Point/Angle conversions
+    QPointF center = arcCenterNm(p1, p2, angle);
+    qreal dx = p1.getX().toNm() - center.x();
+    qreal dy = p1.getY().toNm() - center.y();
+    qreal angleDelta = angle.toRad() / steps;
+    buffer.resize(steps + 1);
+    Point* points = buffer.data();
+    points[0] = p1;
+    for (int i = 1; i < steps; ++i) {
+        qreal sin = qSin(angleDelta * i);
+        qreal cos = qCos(angleDelta * i);
+        points[i] = Point(Length(qRound64(center.x() + cos * dx - sin * dy)),
+                          Length(qRound64(center.y() + sin * dx + cos * dy)));
+    }
+    points[steps] = p2;
+    return steps + 1;
+}
+
+/*****************************************************************************************
+ *  Point/Segment Distances
+ ****************************************************************************************/
+
+void GeometryKernel::squaredDistancesToSegments(const Point& p, const SegmentArray& segments,
+                                                qreal* distances) noexcept
+{
+    const qreal px = p.getX().toNm();
+    const qreal py = p.getY().toNm();
+    const qreal* x1 = segments.mX1.constData();
+    const qreal* y1 = segments.mY1.constData();
+    const qreal* dx = segments.mDx.constData();
+    const qreal* dy = segments.mDy.constData();
+    const qreal* inv = segments.mInvLengthSq.constData();
+    const int count = segments.count();
+
+    // keep this loop free of branches and function calls so it gets vectorized
+    for (int i = 0; i < count; ++i) {
+        qreal t = ((px - x1[i]) * dx[i] + (py - y1[i]) * dy[i]) * inv[i];
+        t = (t < 0) ? 0 : ((t > 1) ? 1 : t);
+        qreal ex = x1[i] + t * dx[i] - px;
+        qreal ey = y1[i] + t * dy[i] - py;
+        distances[i] = ex * ex + ey * ey;
+    }
+}
+
+int GeometryKernel::nearestSegment(const Point& p, const SegmentArray& segments,
+                                   Point* nearest, Length* distance) noexcept
+{
+    const int count = segments.count();
+    if (count == 0) {
+        return -1;
+    }
+
+    QVarLengthArray<qreal, 256> distances(count);
+    squaredDistancesToSegments(p, segments, distances.data());
+    int index = 0;
+    for (int i = 1; i < count; ++i) {
+        if (distances[i] < distances[index]) {
+            index = i;
+        }
+    }
+
+    if (nearest) {
+        qreal t = ((p.getX().toNm() - segments.mX1.at(index)) * segments.mDx.at(index) +
+                   (p.getY().toNm() - segments.mY1.at(index)) * segments.mDy.at(index)) *
+                  segments.mInvLengthSq.at(index);
+        t = qBound(qreal(0), t, qreal(1));
+        *nearest = Point(Length(qRound64(segments.mX1.at(index) + t * segments.mDx.at(index))),
+                         Length(qRound64(segments.mY1.at(index) + t * segments.mDy.at(index))));
+    }
+    if (distance) {
+        *distance = Length(qRound64(qSqrt(distances[index])));
+    }
+    return index;
+}
+
+qreal GeometryKernel::squaredDistanceBetweenSegments(const Point& a1, const Point& a2,
+                                                     const Point& b1, const Point& b2) noexcept
+{
+    if (segmentsIntersect(a1, a2, b1, b2)) {
+        return 0;
+    }
+    // without intersection, the nearest points always include an end point
+    return qMin(qMin(squaredDistanceToSegment(a1, b1, b2), squaredDistanceToSegment(a2, b1, b2)),
+                qMin(squaredDistanceToSegment(b1, a1, a2), squaredDistanceToSegment(b2, a1, a2)));
+}
+
+/*****************************************************************************************
+ *  Exact Predicates
+ ****************************************************************************************/
+
+int GeometryKernel::orientation(const Point& a, const Point& b, const Point& c) noexcept
+{
+    qint64 abx = b.getX().toNm() - a.getX().toNm();
+    qint64 aby = b.getY().toNm() - a.getY().toNm();
+    qint64 acx = c.getX().toNm() - a.getX().toNm();
+    qint64 acy = c.getY().toNm() - a.getY().toNm();
+    return compareProducts(abx, acy, aby, acx); // sign of the cross product
+}
+
+bool GeometryKernel::isPointOnSegment(const Point& p, const Point& l1, const Point& l2) noexcept
+{
+    return (orientation(l1, l2, p) == 0) && isInBoundingBox(p, l1, l2);
+}
+
+bool GeometryKernel::segmentsIntersect(const Point& a1, const Point& a2,
+                                       const Point& b1, const Point& b2) noexcept
+{
+    int o1 = orientation(a1, a2, b1);
+    int o2 = orientation(a1, a2, b2);
+    int o3 = orientation(b1, b2, a1);
+    int o4 = orientation(b1, b2, a2);
+    if ((o1 != o2) && (o3 != o4) && (o1 != 0) && (o2 != 0) && (o3 != 0) && (o4 != 0)) {
+        return true; // proper intersection
+    }
+    // touching or collinear segments
+    return ((o1 == 0) && isInBoundingBox(b1, a1, a2))
+        || ((o2 == 0) && isInBoundingBox(b2, a1, a2))
+        || ((o3 == 0) && isInBoundingBox(a1, b1, b2))
+        || ((o4 == 0) && isInBoundingBox(a2, b1, b2));
+}
+
+/*****************************************************************************************
+ *  Internal Helper Methods
+ ****************************************************************************************/
+
+int GeometryKernel::compareProducts(qint64 a, qint64 b, qint64 c, qint64 d) noexcept
+{
+    // Returns the sign of (a*b - c*d). The products may overflow 64 bits, so they are
+    // calculated as unsigned 128 bit numbers (hi/lo) with separate signs.
+    auto sign = [](qint64 x, qint64 y) {
+        return ((x == 0) || (y == 0)) ? 0 : (((x < 0) != (y < 0)) ? -1 : 1);
+    };
+    auto magnitude = [](qint64 x) {
+        return (x < 0) ? (quint64(-(x + 1)) + 1) : quint64(x);
+    };
+    auto multiply = [](quint64 x, quint64 y, quint64& hi, quint64& lo) {
+        quint64 xLo = x & 0xFFFFFFFFu, xHi = x >> 32;
+        quint64 yLo = y & 0xFFFFFFFFu, yHi = y >> 32;
+        quint64 p0 = xLo * yLo, p1 = xLo * yHi, p2 = xHi * yLo, p3 = xHi * yHi;
+        quint64 mid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+        lo = (p0 & 0xFFFFFFFFu) | (mid << 32);
+        hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    };
+
+    int s1 = sign(a, b);
+    int s2 = sign(c, d);
+    if (s1 != s2) {
+        return (s1 > s2) ? 1 : -1;
+    } else if (s1 == 0) {
+        return 0;
+    }
+    quint64 hi1, lo1, hi2, lo2;
+    multiply(magnitude(a), magnitude(b), hi1, lo1);
+    multiply(magnitude(c), magnitude(d), hi2, lo2);
+    int cmp = (hi1 != hi2) ? ((hi1 > hi2) ? 1 : -1) : ((lo1 != lo2) ? ((lo1 > lo2) ? 1 : -1) : 0);
+    return cmp * s1; // both products have the same sign here
+}
+
+bool GeometryKernel::isInBoundingBox(const Point& p, const Point& l1, const Point& l2) noexcept
+{
+    return (p.getX() >= qMin(l1.getX(), l2.getX())) && (p.getX() <= qMax(l1.getX(), l2.getX()))
+        && (p.getY() >= qMin(l1.getY(), l2.getY())) && (p.getY() <= qMax(l1.getY(), l2.getY()));
+}
+
+qreal GeometryKernel::squaredDistanceToSegment(const Point& p, const Point& l1,
+                                               const Point& l2) noexcept
+{
+    qreal dx = l2.getX().toNm() - l1.getX().toNm();
+    qreal dy = l2.getY().toNm() - l1.getY().toNm();
+    qreal px = p.getX().toNm() - l1.getX().toNm();
+    qreal py = p.getY().toNm() - l1.getY().toNm();
+    qreal lengthSq = dx * dx + dy * dy;
+    qreal t = (lengthSq > 0) ? qBound(qreal(0), (px * dx + py * dy) / lengthSq, qreal(1)) : 0;
+    qreal ex = t * dx - px;
+    qreal ey = t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
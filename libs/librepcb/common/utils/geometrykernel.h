@@ -0,0 +1,189 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_GEOMETRYKERNEL_H
+#define LIBREPCB_GEOMETRYKERNEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class GeometryKernel
+ ****************************************************************************************/
+
+/**
+ * @brief The GeometryKernel class provides fast line and arc calculations which work
+ *        directly on nanometers
+ *
+ * In contrast to the corresponding methods of librepcb::Toolbox, no conversion to
+ * millimeters and back is done, and the methods are designed to process many segments
+ * or points at once (e.g. all netlines of a net segment, or all points of a flattened
+ * arc), reusing preallocated buffers.
+ *
+ * The predicates #orientation(), #isPointOnSegment() and #segmentsIntersect() are
+ * exact (no floating point arithmetic involved) as long as all coordinates are within
+ * +/-2^62 nanometers.
+ */
+class GeometryKernel final
+{
+    public:
+
+        /**
+         * @brief Line segments in a structure-of-arrays layout
+         *
+         * Storing every coordinate in its own contiguous array allows the compiler to
+         * vectorize the loops of #squaredDistancesToSegments().
+         */
+        class SegmentArray final
+        {
+            public:
+                SegmentArray() noexcept {}
+                int count() const noexcept {return mX1.count();}
+                void reserve(int size) noexcept;
+                void clear() noexcept;
+                void append(const Point& p1, const Point& p2) noexcept;
+
+            private:
+                friend class GeometryKernel;
+                QVector<qreal> mX1;             ///< start point X [nm]
+                QVector<qreal> mY1;             ///< start point Y [nm]
+                QVector<qreal> mDx;             ///< end point X - start point X [nm]
+                QVector<qreal> mDy;             ///< end point Y - start point Y [nm]
+                QVector<qreal> mInvLengthSq;    ///< 1/length^2, or 0 for zero-length segments
+        };
+
+        // Disable instantiation
+        GeometryKernel() = delete;
+        ~GeometryKernel() = delete;
+
+        // Arcs
+
+        /**
+         * @brief Calculate the (signed) radius of an arc in nanometers
+         *
+         * @see librepcb::Toolbox::arcRadius()
+         */
+        static qreal arcRadiusNm(const Point& p1, const Point& p2, const Angle& angle) noexcept;
+
+        /**
+         * @brief Calculate the center of an arc in nanometers (not rounded)
+         *
+         * @see librepcb::Toolbox::arcCenter()
+         */
+        static QPointF arcCenterNm(const Point& p1, const Point& p2, const Angle& angle) noexcept;
+
+        /**
+         * @brief Approximate an arc by straight line segments
+         *
+         * This calculates the same vertices as librepcb::Path::flatArc(), but writes them
+         * into a buffer which can be reused for many arcs to avoid memory allocations.
+         *
+         * @param p1            Start point of the arc
+         * @param p2            End point of the arc
+         * @param angle         Angle of the arc
+         * @param maxTolerance  Maximum allowed deviation from the exact arc
+         * @param buffer        Receives all points (including p1 and p2). The previous
+         *                      content is replaced, but its allocation is reused.
+         *
+         * @return Number of points written to the buffer (>=2)
+         */
+        static int flattenArc(const Point& p1, const Point& p2, const Angle& angle,
+                              const Length& maxTolerance, QVector<Point>& buffer) noexcept;
+
+        // Point/Segment Distances
+
+        /**
+         * @brief Calculate the squared distances between a point and many segments
+         *
+         * @param p             An arbitrary point
+         * @param segments      The segments
+         * @param distances     Receives the squared distances [nm^2], must provide space
+         *                      for at least segments.count() values
+         */
+        static void squaredDistancesToSegments(const Point& p, const SegmentArray& segments,
+                                               qreal* distances) noexcept;
+
+        /**
+         * @brief Find the segment which is nearest to a given point
+         *
+         * @param p         An arbitrary point
+         * @param segments  The segments
+         * @param nearest   If not `nullptr` and segments is not empty, the nearest point
+         *                  on the nearest segment is returned here
+         * @param distance  If not `nullptr` and segments is not empty, the distance to the
+         *                  nearest segment is returned here
+         *
+         * @return Index of the nearest segment (the first one if there are several
+         *         segments with the same distance), or -1 if segments is empty
+         */
+        static int nearestSegment(const Point& p, const SegmentArray& segments,
+                                  Point* nearest = nullptr, Length* distance = nullptr) noexcept;
+
+        /**
+         * @brief Calculate the squared distance between two segments [nm^2]
+         *
+         * @return 0 if the segments intersect or touch each other
+         */
+        static qreal squaredDistanceBetweenSegments(const Point& a1, const Point& a2,
+                                                    const Point& b1, const Point& b2) noexcept;
+
+        // Exact Predicates
+
+        /**
+         * @brief Determine on which side of the line a-b the point c is located
+         *
+         * @return 1 if a, b, c are counterclockwise (in a coordinate system with the Y
+         *         axis pointing up), -1 if they are clockwise, 0 if they are collinear
+         */
+        static int orientation(const Point& a, const Point& b, const Point& c) noexcept;
+
+        /**
+         * @brief Check whether a point lies on a segment (including its end points)
+         */
+        static bool isPointOnSegment(const Point& p, const Point& l1, const Point& l2) noexcept;
+
+        /**
+         * @brief Check whether two segments intersect or touch each other
+         */
+        static bool segmentsIntersect(const Point& a1, const Point& a2,
+                                      const Point& b1, const Point& b2) noexcept;
+
+
+    private: // Internal Helper Methods
+        static int compareProducts(qint64 a, qint64 b, qint64 c, qint64 d) noexcept;
+        static bool isInBoundingBox(const Point& p, const Point& l1, const Point& l2) noexcept;
+        static qreal squaredDistanceToSegment(const Point& p, const Point& l1,
+                                              const Point& l2) noexcept;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GEOMETRYKERNEL_H
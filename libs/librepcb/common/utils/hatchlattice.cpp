@@ -0,0 +1,219 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "hatchlattice.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+HatchLattice::HatchLattice(const Length& width, const Length& pitch) noexcept :
+    mWidth(width), mPitch(pitch), mLow(width.toNm() / 2),
+    mHigh(pitch.toNm() - (width.toNm() - width.toNm() / 2))
+{
+}
+
+HatchLattice::~HatchLattice() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+ClipperLib::Paths HatchLattice::createOpenings(const ClipperLib::Paths& area) const noexcept
+{
+    ClipperLib::Paths openings;
+    if (!isValid()) return openings;
+
+    // collect all non-degenerated edges and the vertical extent of the area
+    QVector<Edge> edges;
+    ClipperLib::cInt areaMinY = std::numeric_limits<ClipperLib::cInt>::max();
+    ClipperLib::cInt areaMaxY = std::numeric_limits<ClipperLib::cInt>::min();
+    for (const ClipperLib::Path& path : area) {
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            const ClipperLib::IntPoint& p1 = path.at(i);
+            const ClipperLib::IntPoint& p2 = path.at((i + 1) % path.size());
+            if (p1 == p2) continue;
+            edges.append(Edge{p1, p2, qMin(p1.Y, p2.Y), qMax(p1.Y, p2.Y)});
+            areaMinY = qMin(areaMinY, qMin(p1.Y, p2.Y));
+            areaMaxY = qMax(areaMaxY, qMax(p1.Y, p2.Y));
+        }
+    }
+    if (edges.isEmpty()) return openings;
+
+    // assign the edges to all rows of openings they are passing through
+    ClipperLib::cInt pitch = mPitch.toNm();
+    ClipperLib::cInt firstRow = ceilDiv(areaMinY - mLow, pitch);
+    ClipperLib::cInt lastRow = floorDiv(areaMaxY - mHigh, pitch);
+    if (lastRow < firstRow) return openings;
+    QVector<QVector<int>> rowEdges(static_cast<int>(lastRow - firstRow + 1));
+    for (int i = 0; i < edges.count(); ++i) {
+        ClipperLib::cInt first = qMax(firstRow, ceilDiv(edges.at(i).minY - mHigh, pitch));
+        ClipperLib::cInt last = qMin(lastRow, floorDiv(edges.at(i).maxY - mLow, pitch));
+        for (ClipperLib::cInt row = first; row <= last; ++row) {
+            rowEdges[row - firstRow].append(i);
+        }
+    }
+
+    // scan all rows, the buffers are reused for all rows to avoid reallocations
+    QVector<QPair<ClipperLib::cInt, ClipperLib::cInt>> cells; // column, row
+    QVector<ClipperLib::cInt> crossings;
+    QVector<Interval> blocked;
+    for (ClipperLib::cInt row = firstRow; row <= lastRow; ++row) {
+        ClipperLib::cInt y0 = row * pitch + mLow;
+        ClipperLib::cInt y1 = row * pitch + mHigh;
+        crossings.clear();
+        blocked.clear();
+        foreach (int i, rowEdges.at(row - firstRow)) {
+            const Edge& edge = edges.at(i);
+            if ((edge.minY <= y0) && (y0 < edge.maxY)) {
+                crossings.append(xAt(edge, y0));
+            }
+            ClipperLib::cInt ya = qMax(edge.minY, y0);
+            ClipperLib::cInt yb = qMin(edge.maxY, y1);
+            if (ya > yb) continue;
+            ClipperLib::cInt xa = xAt(edge, ya);
+            ClipperLib::cInt xb = xAt(edge, yb);
+            if (edge.minY == edge.maxY) {
+                xa = edge.p1.X;
+                xb = edge.p2.X;
+            }
+            blocked.append(Interval(qMin(xa, xb), qMax(xa, xb)));
+        }
+        std::sort(crossings.begin(), crossings.end());
+        std::sort(blocked.begin(), blocked.end());
+
+        // the inner intervals at y0 minus all blocked ranges are completely inside
+        int nextBlocked = 0;
+        for (int i = 0; i + 1 < crossings.count(); i += 2) {
+            ClipperLib::cInt start = crossings.at(i);
+            ClipperLib::cInt end = crossings.at(i + 1);
+            while ((nextBlocked < blocked.count()) && (blocked.at(nextBlocked).second <= start)) {
+                ++nextBlocked;
+            }
+            for (int k = nextBlocked; (k <= blocked.count()) && (start < end); ++k) {
+                ClipperLib::cInt freeEnd = end;
+                if ((k < blocked.count()) && (blocked.at(k).first < end)) {
+                    freeEnd = blocked.at(k).first;
+                }
+                // add all openings which fit into the free interval ]start, freeEnd[
+                ClipperLib::cInt firstColumn = floorDiv(start - mLow, pitch) + 1;
+                ClipperLib::cInt lastColumn = ceilDiv(freeEnd - mHigh, pitch) - 1;
+                for (ClipperLib::cInt column = firstColumn; column <= lastColumn; ++column) {
+                    cells.append(qMakePair(column, row));
+                }
+                if ((k >= blocked.count()) || (blocked.at(k).first >= end)) break;
+                start = qMax(start, blocked.at(k).second);
+            }
+        }
+    }
+
+    // merge vertically adjacent openings to runs
+    std::sort(cells.begin(), cells.end());
+    for (int i = 0; i < cells.count();) {
+        int j = i + 1;
+        while ((j < cells.count()) && (cells.at(j).first == cells.at(i).first) &&
+               (cells.at(j).second == cells.at(j - 1).second + 1)) {
+            ++j;
+        }
+        openings.push_back(createRun(cells.at(i).first, cells.at(i).second,
+                                     cells.at(j - 1).second));
+        i = j;
+    }
+    return openings;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+ClipperLib::Path HatchLattice::createRun(ClipperLib::cInt column, ClipperLib::cInt firstRow,
+                                         ClipperLib::cInt lastRow) const noexcept
+{
+    ClipperLib::cInt pitch = mPitch.toNm();
+    ClipperLib::cInt x0 = column * pitch + mLow;
+    ClipperLib::cInt x1 = column * pitch + mHigh;
+    ClipperLib::cInt xc = (x0 + x1) / 2;
+    auto y0 = [&](ClipperLib::cInt row){return row * pitch + mLow;};
+    auto y1 = [&](ClipperLib::cInt row){return row * pitch + mHigh;};
+
+    // up along the right side of all openings, then down along the left side, with
+    // zero width cut-ins between the openings at the center
+    ClipperLib::Path path;
+    path.reserve((lastRow - firstRow + 1) * 8);
+    path.push_back(ClipperLib::IntPoint(xc, y0(firstRow)));
+    for (ClipperLib::cInt row = firstRow; row <= lastRow; ++row) {
+        path.push_back(ClipperLib::IntPoint(x1, y0(row)));
+        path.push_back(ClipperLib::IntPoint(x1, y1(row)));
+        if (row < lastRow) {
+            path.push_back(ClipperLib::IntPoint(xc, y1(row)));
+            path.push_back(ClipperLib::IntPoint(xc, y0(row + 1)));
+        }
+    }
+    for (ClipperLib::cInt row = lastRow; row >= firstRow; --row) {
+        path.push_back(ClipperLib::IntPoint(x0, y1(row)));
+        path.push_back(ClipperLib::IntPoint(x0, y0(row)));
+        if (row > firstRow) {
+            path.push_back(ClipperLib::IntPoint(xc, y0(row)));
+            path.push_back(ClipperLib::IntPoint(xc, y1(row - 1)));
+        }
+    }
+
+    // holes need the opposite orientation of outlines, but the connection point must
+    // stay the first vertex
+    if (ClipperLib::Orientation(path)) {
+        ClipperLib::ReversePath(path);
+        std::rotate(path.begin(), path.end() - 1, path.end());
+    }
+    return path;
+}
+
+ClipperLib::cInt HatchLattice::xAt(const Edge& edge, ClipperLib::cInt y) noexcept
+{
+    if (edge.p1.Y == edge.p2.Y) return edge.p1.X;
+    qreal t = qreal(y - edge.p1.Y) / qreal(edge.p2.Y - edge.p1.Y);
+    return edge.p1.X + qRound64(t * qreal(edge.p2.X - edge.p1.X));
+}
+
+ClipperLib::cInt HatchLattice::floorDiv(ClipperLib::cInt a, ClipperLib::cInt b) noexcept
+{
+    ClipperLib::cInt q = a / b;
+    return ((a % b != 0) && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+ClipperLib::cInt HatchLattice::ceilDiv(ClipperLib::cInt a, ClipperLib::cInt b) noexcept
+{
+    return -floorDiv(-a, b);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
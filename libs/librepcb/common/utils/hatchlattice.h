@@ -0,0 +1,122 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_HATCHLATTICE_H
+#define LIBREPCB_HATCHLATTICE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <clipper/clipper.hpp>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class HatchLattice
+ ****************************************************************************************/
+
+/**
+ * @brief The HatchLattice class determines the openings of a cross-hatched area
+ *
+ * The lattice consists of horizontal and vertical lines of a given width, centered on
+ * multiples of the pitch (so the hatches of all areas are aligned to each other). The
+ * square openings between the lines which lie completely inside an area are determined
+ * with a scanline algorithm, one row of openings at a time: the inner intervals of the
+ * area are calculated from the edges crossing the bottom of the row, and the x ranges of
+ * all edges passing through the row are removed from them. This avoids clipping
+ * thousands of hatch strips with general polygon boolean operations.
+ *
+ * Vertically adjacent openings are returned as a single hole path, connected by zero
+ * width cut-ins. The first vertex of each hole is its (bottom center) connection point,
+ * so the holes can be passed to librepcb::ClipperHelpers::convertHolesToCutIns()
+ * directly and the number of cut-ins to insert into the outline stays small.
+ */
+class HatchLattice final
+{
+    public:
+
+        // Constructors / Destructor
+        HatchLattice() = delete;
+        HatchLattice(const HatchLattice& other) = default;
+        HatchLattice(const Length& width, const Length& pitch) noexcept;
+        ~HatchLattice() noexcept;
+
+        // Getters
+        const Length& getWidth() const noexcept {return mWidth;}
+        const Length& getPitch() const noexcept {return mPitch;}
+
+        /**
+         * @brief Check whether the lattice has any openings at all
+         */
+        bool isValid() const noexcept {return (mWidth > 0) && (mPitch > mWidth);}
+
+        // General Methods
+
+        /**
+         * @brief Get all openings of the lattice which lie completely inside an area
+         *
+         * @param area      Outlines and holes of the area (even-odd fill rule). To keep
+         *                  a border around the openings, shrink the area before.
+         *
+         * @return The openings as holes (orientation opposite to the outlines created
+         *         by Clipper), one path per vertical run of openings
+         */
+        ClipperLib::Paths createOpenings(const ClipperLib::Paths& area) const noexcept;
+
+        // Operator Overloadings
+        HatchLattice& operator=(const HatchLattice& rhs) = default;
+
+
+    private: // Types
+        struct Edge {
+            ClipperLib::IntPoint p1;
+            ClipperLib::IntPoint p2;
+            ClipperLib::cInt minY;
+            ClipperLib::cInt maxY;
+        };
+        typedef QPair<ClipperLib::cInt, ClipperLib::cInt> Interval;
+
+
+    private: // Methods
+        ClipperLib::Path createRun(ClipperLib::cInt column, ClipperLib::cInt firstRow,
+                                   ClipperLib::cInt lastRow) const noexcept;
+        static ClipperLib::cInt xAt(const Edge& edge, ClipperLib::cInt y) noexcept;
+        static ClipperLib::cInt floorDiv(ClipperLib::cInt a, ClipperLib::cInt b) noexcept;
+        static ClipperLib::cInt ceilDiv(ClipperLib::cInt a, ClipperLib::cInt b) noexcept;
+
+
+    private: // Data
+        Length mWidth;
+        Length mPitch;
+        ClipperLib::cInt mLow;  ///< start of an opening relative to the lattice line
+        ClipperLib::cInt mHigh; ///< end of an opening relative to the lattice line
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_HATCHLATTICE_H
@@ -0,0 +1,216 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_RECTSELECTIONINDEX_H
+#define LIBREPCB_RECTSELECTIONINDEX_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <QtConcurrent/QtConcurrent>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class RectSelectionIndex
+ ****************************************************************************************/
+
+/**
+ * @brief The RectSelectionIndex class determines which items intersect with a rectangle
+ *        (e.g. the rubber band of a selection) without testing the areas of all items
+ *
+ * The areas of all items are added once (e.g. when the rubber band selection starts)
+ * and their bounding rectangles are inserted into a uniform grid. Then #query() only
+ * runs the expensive QPainterPath::intersects() for items whose bounding rectangle
+ * intersects the rectangle. If there are many such candidates, they are tested in
+ * parallel in the global thread pool.
+ *
+ * @note The index does not observe the items, so it must be rebuilt whenever an item
+ *       is moved, added or removed.
+ *
+ * @tparam T    The item type. Must be copyable and usable as a key of QHash/QSet.
+ */
+template <typename T>
+class RectSelectionIndex final
+{
+    public:
+
+        // Constructors / Destructor
+        RectSelectionIndex() noexcept : mCellSize(0), mColumns(0), mRows(0) {}
+        RectSelectionIndex(const RectSelectionIndex& other) = default;
+        ~RectSelectionIndex() noexcept {}
+
+        // Getters
+        int count() const noexcept {return mItems.count();}
+        bool isEmpty() const noexcept {return mItems.isEmpty();}
+
+        // General Methods
+
+        /**
+         * @brief Add an item (invalidates the grid until #build() is called)
+         *
+         * @param item      The item
+         * @param area      The area of the item in scene pixels (empty areas are ignored)
+         */
+        void add(const T& item, const QPainterPath& area) noexcept {
+            if (area.isEmpty()) return;
+            Entry entry{item, area, area.boundingRect()};
+            entry.area.controlPointRect(); // compute lazy bounds before multithreaded use
+            mItems.append(entry);
+            mCells.clear();
+        }
+
+        /**
+         * @brief Build the grid after all items were added
+         */
+        void build() noexcept {
+            mCells.clear();
+            mBounds = QRectF();
+            foreach (const Entry& entry, mItems) {
+                mBounds = mBounds.united(entry.bounds);
+            }
+            if (mItems.isEmpty() || mBounds.isEmpty()) return;
+            // roughly one item per cell on average
+            qreal cellCount = qMax(qreal(1), qSqrt(qreal(mItems.count())));
+            mCellSize = qMax(mBounds.width(), mBounds.height()) / cellCount;
+            mColumns = qMax(1, qCeil(mBounds.width() / mCellSize));
+            mRows = qMax(1, qCeil(mBounds.height() / mCellSize));
+            mCells.resize(mColumns * mRows);
+            for (int i = 0; i < mItems.count(); ++i) {
+                int x1, y1, x2, y2;
+                getCellRange(mItems.at(i).bounds, x1, y1, x2, y2);
+                for (int y = y1; y <= y2; ++y) {
+                    for (int x = x1; x <= x2; ++x) {
+                        mCells[y * mColumns + x].append(i);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Get all items whose area intersects with a rectangle
+         *
+         * @param rect      The rectangle in scene pixels
+         *
+         * @return All intersecting items
+         */
+        QSet<T> query(const QRectF& rect) const noexcept {
+            QSet<T> result;
+            if (mCells.isEmpty() || (!rect.intersects(mBounds))) return result;
+
+            // collect candidates by their bounding rectangles
+            QVector<int> candidates;
+            QVector<bool> visited(mItems.count(), false);
+            int x1, y1, x2, y2;
+            getCellRange(rect, x1, y1, x2, y2);
+            for (int y = y1; y <= y2; ++y) {
+                for (int x = x1; x <= x2; ++x) {
+                    foreach (int i, mCells.at(y * mColumns + x)) {
+                        if ((!visited.at(i)) && mItems.at(i).bounds.intersects(rect)) {
+                            visited[i] = true;
+                            candidates.append(i);
+                        }
+                    }
+                }
+            }
+
+            // run the exact tests only for the candidates
+            QVector<bool> hits(candidates.count(), false);
+            bool* hitsData = hits.data(); // detach before accessing it from other threads
+            auto test = [&](int begin, int end) {
+                for (int k = begin; k < end; ++k) {
+                    hitsData[k] = mItems.at(candidates.at(k)).area.intersects(rect);
+                }
+            };
+            if (candidates.count() < sParallelThreshold) {
+                test(0, candidates.count());
+            } else {
+                int chunks = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+                int chunkSize = (candidates.count() + chunks - 1) / chunks;
+                QList<QFuture<void>> futures;
+                for (int begin = chunkSize; begin < candidates.count(); begin += chunkSize) {
+                    int end = qMin(begin + chunkSize, candidates.count());
+                    futures.append(QtConcurrent::run([&test, begin, end](){test(begin, end);}));
+                }
+                test(0, qMin(chunkSize, candidates.count()));
+                foreach (QFuture<void> future, futures) {
+                    future.waitForFinished();
+                }
+            }
+            for (int k = 0; k < candidates.count(); ++k) {
+                if (hits.at(k)) result.insert(mItems.at(candidates.at(k)).item);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Remove all items
+         */
+        void clear() noexcept {
+            mItems.clear();
+            mCells.clear();
+            mBounds = QRectF();
+        }
+
+        // Operator Overloadings
+        RectSelectionIndex& operator=(const RectSelectionIndex& rhs) = default;
+
+
+    private: // Types
+        struct Entry {
+            T item;
+            QPainterPath area;
+            QRectF bounds;
+        };
+
+
+    private: // Methods
+        void getCellRange(const QRectF& rect, int& x1, int& y1, int& x2,
+                          int& y2) const noexcept {
+            x1 = qBound(0, int((rect.left() - mBounds.left()) / mCellSize), mColumns - 1);
+            x2 = qBound(0, int((rect.right() - mBounds.left()) / mCellSize), mColumns - 1);
+            y1 = qBound(0, int((rect.top() - mBounds.top()) / mCellSize), mRows - 1);
+            y2 = qBound(0, int((rect.bottom() - mBounds.top()) / mCellSize), mRows - 1);
+        }
+
+
+    private: // Data
+        QVector<Entry> mItems;
+        QRectF mBounds;             ///< bounding rectangle of all items
+        qreal mCellSize;
+        int mColumns;
+        int mRows;
+        QVector<QVector<int>> mCells; ///< indices of mItems, row by row
+
+        /// Minimum number of candidates to test them in parallel
+        static constexpr int sParallelThreshold = 256;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_RECTSELECTIONINDEX_H
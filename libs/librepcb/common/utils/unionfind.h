@@ -0,0 +1,185 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_UNIONFIND_H
+#define LIBREPCB_UNIONFIND_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class UnionFind
+ ****************************************************************************************/
+
+/**
+ * @brief The UnionFind class implements a disjoint-set forest to determine connected
+ *        groups of items (e.g. netpoints connected together by netlines)
+ *
+ * Uses path compression and union by rank, so #unite() and #find() run in nearly
+ * constant amortized time. This is much faster than recursively walking through the
+ * connections of items when determining connectivity of large netsegments.
+ *
+ * Items are identified by their value (typically pointers), the order of added items is
+ * remembered to make #getGroups() deterministic.
+ *
+ * @tparam T    The item type. Must be copyable and usable as a key of QHash.
+ */
+template <typename T>
+class UnionFind final
+{
+    public:
+
+        // Constructors / Destructor
+        UnionFind() noexcept : mGroupCountDelta(0) {}
+        UnionFind(const UnionFind& other) = default;
+        ~UnionFind() noexcept {}
+
+        // Getters
+        int count() const noexcept {return mItems.count();}
+        bool contains(const T& item) const noexcept {return mIndices.contains(item);}
+
+        // General Methods
+
+        /**
+         * @brief Add an item as a new group (does nothing if it was already added)
+         *
+         * @return The internal index of the item
+         */
+        int add(const T& item) noexcept {
+            auto it = mIndices.constFind(item);
+            if (it != mIndices.constEnd()) return *it;
+            int index = mItems.count();
+            mItems.append(item);
+            mParents.append(index);
+            mRanks.append(0);
+            mIndices.insert(item, index);
+            return index;
+        }
+
+        /**
+         * @brief Merge the groups of two items (items are added if not yet done)
+         *
+         * @retval true     If the items were in different groups before.
+         * @retval false    If the items were already in the same group.
+         */
+        bool unite(const T& a, const T& b) noexcept {
+            int rootA = findRoot(add(a));
+            int rootB = findRoot(add(b));
+            if (rootA == rootB) return false;
+            if (mRanks[rootA] < mRanks[rootB]) {
+                mParents[rootA] = rootB;
+            } else if (mRanks[rootA] > mRanks[rootB]) {
+                mParents[rootB] = rootA;
+            } else {
+                mParents[rootB] = rootA;
+                ++mRanks[rootA];
+            }
+            --mGroupCountDelta;
+            return true;
+        }
+
+        /**
+         * @brief Get the representative item of the group an item belongs to
+         *
+         * @note The item must have been added before!
+         */
+        T find(const T& item) const noexcept {
+            Q_ASSERT(contains(item));
+            return mItems[findRoot(mIndices.value(item))];
+        }
+
+        /**
+         * @brief Check whether two items are in the same group
+         *
+         * @return False if one of the items was not added, otherwise whether they are
+         *         in the same group.
+         */
+        bool areConnected(const T& a, const T& b) const noexcept {
+            auto itA = mIndices.constFind(a);
+            auto itB = mIndices.constFind(b);
+            if ((itA == mIndices.constEnd()) || (itB == mIndices.constEnd())) return false;
+            return findRoot(*itA) == findRoot(*itB);
+        }
+
+        /**
+         * @brief Get the number of separate groups
+         */
+        int getGroupCount() const noexcept {return mItems.count() + mGroupCountDelta;}
+
+        /**
+         * @brief Get all groups with their items
+         *
+         * @return All groups in the order of their first added item, items within a
+         *         group in the order they were added.
+         */
+        QList<QList<T>> getGroups() const noexcept {
+            QList<QList<T>> groups;
+            QHash<int, int> rootToGroup;
+            for (int i = 0; i < mItems.count(); ++i) {
+                int root = findRoot(i);
+                int group = rootToGroup.value(root, -1);
+                if (group < 0) {
+                    group = groups.count();
+                    rootToGroup.insert(root, group);
+                    groups.append(QList<T>());
+                }
+                groups[group].append(mItems[i]);
+            }
+            return groups;
+        }
+
+        // Operator Overloadings
+        UnionFind& operator=(const UnionFind& rhs) = default;
+
+
+    private: // Methods
+        int findRoot(int index) const noexcept {
+            int root = index;
+            while (mParents[root] != root) root = mParents[root];
+            while (mParents[index] != root) { // path compression
+                int next = mParents[index];
+                mParents[index] = root;
+                index = next;
+            }
+            return root;
+        }
+
+
+    private: // Data
+        QVector<T> mItems;
+        QHash<T, int> mIndices;
+        mutable QVector<int> mParents; ///< mutable for path compression in const methods
+        QVector<int> mRanks;
+        int mGroupCountDelta; ///< negative number of successful #unite() calls
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_UNIONFIND_H
@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "converterdb.h"
+#include <librepcb/common/sqlitedatabase.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -33,13 +34,42 @@ namespace eagleimport {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-ConverterDb::ConverterDb(const FilePath& ini) noexcept :
-    mIniFile(ini.toStr(), QSettings::IniFormat)
+ConverterDb::ConverterDb(const FilePath& filepath)
 {
+    bool isIniFile = (filepath.getSuffix().toLower() == "ini");
+    FilePath dbFilePath = isIniFile ? filepath.getParentDir().getPathTo(
+        filepath.getCompleteBasename() % ".sqlite") : filepath;
+    mDb.reset(new SQLiteDatabase(dbFilePath)); // can throw
+    mDb->exec("CREATE TABLE IF NOT EXISTS uuids ("
+              "`key` TEXT PRIMARY KEY NOT NULL, "
+              "`uuid` TEXT NOT NULL"
+              ")"); // can throw
+
+    // load all entries into memory
+    QSqlQuery query = mDb->prepareQuery("SELECT key, uuid FROM uuids"); // can throw
+    mDb->exec(query); // can throw
+    while (query.next()) {
+        QString key = query.value(0).toString();
+        Uuid uuid(query.value(1).toString());
+        if (uuid.isNull()) {
+            throw RuntimeError(__FILE__, __LINE__, "Invalid UUID in database: " % key);
+        }
+        mUuids.insert(key, uuid);
+    }
+
+    // migrate the INI file of earlier versions
+    if (isIniFile && mUuids.isEmpty() && filepath.isExistingFile()) {
+        importIniFile(filepath); // can throw
+    }
 }
 
 ConverterDb::~ConverterDb() noexcept
 {
+    try {
+        flush(); // can throw
+    } catch (const Exception& e) {
+        qCritical() << "Could not write UUIDs to the converter database:" << e.getMsg();
+    }
 }
 
 /*****************************************************************************************
@@ -99,10 +129,47 @@ Uuid ConverterDb::getDeviceUuid(const QString& deviceSetName, const QString& dev
     return getOrCreateUuid("devices_to_devices", deviceSetName, deviceName);
 }
 
+void ConverterDb::flush()
+{
+    QList<QPair<QString, Uuid>> entries;
+    {
+        QMutexLocker locker(&mMutex);
+        entries = mPendingUuids;
+    }
+    if (entries.isEmpty()) return;
+
+    SQLiteDatabase::TransactionScopeGuard transactionGuard(*mDb); // can throw
+    QSqlQuery query = mDb->prepareQuery(
+        "INSERT OR REPLACE INTO uuids (key, uuid) VALUES (:key, :uuid)"); // can throw
+    for (const auto& entry : entries) {
+        query.bindValue(":key", entry.first);
+        query.bindValue(":uuid", entry.second.toStr());
+        mDb->exec(query); // can throw
+    }
+    transactionGuard.commit(); // can throw
+
+    QMutexLocker locker(&mMutex);
+    mPendingUuids.erase(mPendingUuids.begin(), mPendingUuids.begin() + entries.count());
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void ConverterDb::importIniFile(const FilePath& ini)
+{
+    QSettings settings(ini.toStr(), QSettings::IniFormat);
+    foreach (const QString& key, settings.allKeys()) {
+        Uuid uuid(settings.value(key).toString());
+        if (uuid.isNull()) {
+            throw RuntimeError(__FILE__, __LINE__, "Invalid UUID in *.ini file: " % key);
+        }
+        mUuids.insert(key, uuid);
+        mPendingUuids.append(qMakePair(key, uuid));
+    }
+    flush(); // can throw
+}
+
 Uuid ConverterDb::getOrCreateUuid(const QString& cat, const QString& key1,
                                   const QString& key2)
 {
@@ -119,14 +186,17 @@ Uuid ConverterDb::getOrCreateUuid(const QString& cat, const QString& key1,
     }
     settingsKey.prepend(cat % '/');
 
+    QMutexLocker locker(&mMutex);
+    auto it = mUuids.constFind(settingsKey);
+    if (it != mUuids.constEnd()) {
+        return *it;
+    }
     Uuid uuid = Uuid::createRandom();
-    QString value = mIniFile.value(settingsKey).toString();
-    if (!value.isEmpty()) uuid = Uuid(value); //Uuid(QString("{%1}").arg(value));
-
     if (uuid.isNull()) {
-        throw RuntimeError(__FILE__, __LINE__, "Invalid UUID in *.ini file: " % settingsKey);
+        throw RuntimeError(__FILE__, __LINE__, "Could not create UUID for " % settingsKey);
     }
-    mIniFile.setValue(settingsKey, uuid.toStr());
+    mUuids.insert(settingsKey, uuid);
+    mPendingUuids.append(qMakePair(settingsKey, uuid));
     return uuid;
 }
 
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/uuid.h>
+#include <memory>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -33,6 +34,7 @@
 namespace librepcb {
 
 class FilePath;
+class SQLiteDatabase;
 
 namespace eagleimport {
 
@@ -41,7 +43,21 @@ namespace eagleimport {
  ****************************************************************************************/
 
 /**
- * @brief The ConverterDb class
+ * @brief The ConverterDb class stores the UUIDs assigned to converted Eagle elements
+ *
+ * Every key (e.g. library filename + symbol name) gets a random UUID the first time it
+ * is requested, and always the same UUID afterwards. This makes re-imports of the same
+ * Eagle libraries stable.
+ *
+ * The mapping is stored in an SQLite database with an indexed key column. All entries
+ * are loaded into memory on construction and new entries are written in batches (see
+ * #flush()), so looking up UUIDs doesn't cause any database access. For backward
+ * compatibility, an "*.ini" file (as used by earlier versions) may be passed to the
+ * constructor: Then the database is stored next to it with the suffix "*.sqlite" and
+ * initially filled with all entries of the INI file.
+ *
+ * @note    All "get*Uuid()" methods are thread-safe, so converters may run in parallel.
+ *          All other methods must be called from the thread which created the object.
  */
 class ConverterDb final
 {
@@ -50,7 +66,7 @@ class ConverterDb final
         // Constructors / Destructor
         ConverterDb() = delete;
         ConverterDb(const ConverterDb& other) = delete;
-        ConverterDb(const FilePath& ini) noexcept;
+        explicit ConverterDb(const FilePath& filepath);
         ~ConverterDb() noexcept;
 
         // General Methods
@@ -68,17 +84,31 @@ class ConverterDb final
         Uuid getSymbolVariantItemUuid(const Uuid& componentUuid, const QString& gateName);
         Uuid getDeviceUuid(const QString& deviceSetName, const QString& deviceName);
 
+        /**
+         * @brief Write all newly created UUIDs to the database
+         *
+         * Is also called automatically from the destructor.
+         *
+         * @throw Exception on database errors
+         */
+        void flush();
 
         // Operator Overloadings
         ConverterDb& operator=(const ConverterDb& rhs) = delete;
 
 
-    private:
+    private: // Methods
+        void importIniFile(const FilePath& ini);
         Uuid getOrCreateUuid(const QString& cat, const QString& key1,
                              const QString& key2 = QString());
 
-        QSettings mIniFile;
+
+    private: // Data
+        std::unique_ptr<SQLiteDatabase> mDb;
         FilePath mLibFilePath;
+        QMutex mMutex; ///< protects #mUuids and #mPendingUuids
+        QHash<QString, Uuid> mUuids;
+        QList<QPair<QString, Uuid>> mPendingUuids; ///< not yet written to the database
 };
 
 /*****************************************************************************************
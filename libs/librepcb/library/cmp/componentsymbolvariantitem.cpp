@@ -78,7 +78,7 @@ void ComponentSymbolVariantItem::serialize(SExpression& root) const
 
     root.appendToken(mUuid);
     root.appendTokenChild("symbol", mSymbolUuid, true);
-    root.appendChild(mSymbolPos.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mSymbolPos, "pos"), true);
     root.appendTokenChild("rot", mSymbolRot, false);
     root.appendTokenChild("required", mIsRequired, false);
     root.appendStringChild("suffix", mSuffix, false);
@@ -26,6 +26,7 @@
 #include <librepcb/common/toolbox.h>
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/fileutils.h>
 #include "cat/componentcategory.h"
 #include "cat/packagecategory.h"
 #include "sym/symbol.h"
@@ -119,6 +120,12 @@ void Library::setIconFilePath(const FilePath& png) noexcept
     }
 
     if (png.isExistingFile()) {
+        try {
+            createTemporaryDirectoryIfNeeded(); // can throw
+        } catch (const Exception& e) {
+            qWarning() << "Could not set library icon:" << e.getMsg();
+            return;
+        }
         QFile::copy(png.toStr(), getIconFilePath().toStr());
         mIcon = QPixmap(getIconFilePath().toStr());
     } else {
@@ -179,11 +186,20 @@ template QList<FilePath> Library::searchForElements<Package>() const noexcept;
 template QList<FilePath> Library::searchForElements<Component>() const noexcept;
 template QList<FilePath> Library::searchForElements<Device>() const noexcept;
 
+QMap<QString, QByteArray> Library::serializeToFiles(const FilePath& destination) const
+{
+    QMap<QString, QByteArray> files = LibraryBaseElement::serializeToFiles(destination);
+    if (getIconFilePath().isExistingFile()) {
+        files.insert("library.png", FileUtils::readFile(getIconFilePath())); // can throw
+    }
+    return files;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void Library::copyTo(const FilePath& destination, bool removeSource)
+void Library::checkDestinationDirectory(const FilePath& destination) const
 {
     // check directory suffix
     if (destination.getSuffix() != "lplib") {
@@ -192,8 +208,7 @@ void Library::copyTo(const FilePath& destination, bool removeSource)
             QString(tr("A library directory name must have the suffix '.lplib'.")));
     }
 
-    // copy the element
-    LibraryBaseElement::copyTo(destination, removeSource);
+    LibraryBaseElement::checkDestinationDirectory(destination);
 }
 
 void Library::serialize(SExpression& root) const
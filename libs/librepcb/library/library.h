@@ -77,6 +77,7 @@ class Library final : public LibraryBaseElement
         void removeDependency(const Uuid& uuid) noexcept;
         template <typename ElementType>
         QList<FilePath> searchForElements() const noexcept;
+        virtual QMap<QString, QByteArray> serializeToFiles(const FilePath& destination) const override;
 
         // Operator Overloadings
         Library& operator=(const Library& rhs) = delete;
@@ -89,7 +90,7 @@ class Library final : public LibraryBaseElement
     private: // Methods
 
         // Private Methods
-        virtual void copyTo(const FilePath& destination, bool removeSource) override;
+        virtual void checkDestinationDirectory(const FilePath& destination) const override;
         /// @copydoc librepcb::SerializableObject::serialize()
         virtual void serialize(SExpression& root) const override;
         virtual bool checkAttributesValidity() const noexcept override;
@@ -39,6 +39,8 @@ SOURCES += \
     library.cpp \
     librarybaseelement.cpp \
     libraryelement.cpp \
+    libraryelementbatchwriter.cpp \
+    libraryelementcache.cpp \
     pkg/cmd/cmdfootprintedit.cpp \
     pkg/cmd/cmdfootprintpadedit.cpp \
     pkg/cmd/cmdpackagepadedit.cpp \
@@ -78,6 +80,8 @@ HEADERS += \
     library.h \
     librarybaseelement.h \
     libraryelement.h \
+    libraryelementbatchwriter.h \
+    libraryelementcache.h \
     pkg/cmd/cmdfootprintedit.h \
     pkg/cmd/cmdfootprintpadedit.h \
     pkg/cmd/cmdpackagepadedit.h \
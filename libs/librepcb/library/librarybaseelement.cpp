@@ -27,6 +27,7 @@
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/application.h>
+#include <librepcb/common/scopeguard.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -45,13 +46,15 @@ LibraryBaseElement::LibraryBaseElement(bool dirnameMustBeUuid, const QString& sh
                                        const QString& description_en_US,
                                        const QString& keywords_en_US) :
     QObject(nullptr), mDirectory(FilePath::getRandomTempPath()),
-    mDirectoryIsTemporary(true), mOpenedReadOnly(false),
+    mDirectoryIsTemporary(true), mTemporaryDirectoryCreated(false), mOpenedReadOnly(false),
     mDirectoryNameMustBeUuid(dirnameMustBeUuid),
     mShortElementName(shortElementName), mLongElementName(longElementName),
     mUuid(uuid), mVersion(version), mAuthor(author),
     mCreated(QDateTime::currentDateTime()), mIsDeprecated(false)
 {
-    FileUtils::makePath(mDirectory); // can throw
+    // Note: The temporary directory is not created until it is really needed (see
+    // #createTemporaryDirectoryIfNeeded()). Elements which are only created in memory and
+    // then saved to their destination (e.g. by importers) never touch it at all.
 
     mNames.setDefaultValue(name_en_US);
     mDescriptions.setDefaultValue(description_en_US);
@@ -62,37 +65,13 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
                                        bool dirnameMustBeUuid,
                                        const QString& shortElementName,
                                        const QString& longElementName, bool readOnly) :
-    QObject(nullptr), mDirectory(elementDirectory),mDirectoryIsTemporary(false),
-    mOpenedReadOnly(readOnly), mDirectoryNameMustBeUuid(dirnameMustBeUuid),
+    QObject(nullptr), mDirectory(elementDirectory), mDirectoryIsTemporary(false),
+    mTemporaryDirectoryCreated(false), mOpenedReadOnly(readOnly), mDirectoryNameMustBeUuid(dirnameMustBeUuid),
     mShortElementName(shortElementName), mLongElementName(longElementName)
 {
-    // determine the filepath to the version file
-    FilePath versionFilePath = mDirectory.getPathTo(".librepcb-" % mShortElementName);
-
-    // check if the directory is a library element
-    if (!versionFilePath.isExistingFile()) {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("Directory is not a library element of type %1: \"%2\""))
-            .arg(mLongElementName, mDirectory.toNative()));
-    }
-
-    // check directory name
-    Uuid dirUuid(mDirectory.getFilename());
-    if (mDirectoryNameMustBeUuid && dirUuid.isNull()) {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("Directory name is not a valid UUID: \"%1\""))
-            .arg(mDirectory.toNative()));
-    }
-
-    // read version number from version file
-    SmartVersionFile versionFile(versionFilePath, false, true);
-    mLoadingElementFileVersion = versionFile.getVersion();
-    if (mLoadingElementFileVersion != qApp->getAppVersion()) {
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("The library element %1 was created with a newer application "
-                       "version. You need at least LibrePCB version %2 to open it."))
-            .arg(mDirectory.toNative()).arg(mLoadingElementFileVersion.toPrettyStr(3)));
-    }
+    // check directory and read version number from version file
+    mLoadingElementFileVersion = checkElementDirectory(mDirectory, mDirectoryNameMustBeUuid,
+                                                       mShortElementName, mLongElementName);
 
     // open main file
     FilePath sexprFilePath = mDirectory.getPathTo(mLongElementName % ".lp");
@@ -100,12 +79,7 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
     mLoadingFileDocument = sexprFile.parseFileAndBuildDomTree();
 
     // read attributes
-    if (mLoadingFileDocument.getChildByIndex(0).isString()) {
-        mUuid = mLoadingFileDocument.getChildByIndex(0).getValue<Uuid>(true);
-    } else {
-        // backward compatibility, remove this some time!
-        mUuid = mLoadingFileDocument.getValueByPath<Uuid>("uuid", true);
-    }
+    mUuid = readUuid(mLoadingFileDocument);
     mVersion = mLoadingFileDocument.getValueByPath<Version>("version", true);
     mAuthor = mLoadingFileDocument.getValueByPath<QString>("author", false);
     mCreated = mLoadingFileDocument.getValueByPath<QDateTime>("created", true);
@@ -117,17 +91,12 @@ LibraryBaseElement::LibraryBaseElement(const FilePath& elementDirectory,
     mKeywords.loadFromDomElement(mLoadingFileDocument);
 
     // check if the UUID equals to the directory basename
-    if (mDirectoryNameMustBeUuid && (mUuid != dirUuid)) {
-        qDebug() << mUuid << "!=" << dirUuid;
-        throw RuntimeError(__FILE__, __LINE__,
-            QString(tr("UUID mismatch between element directory and main file: \"%1\""))
-            .arg(sexprFilePath.toNative()));
-    }
+    checkUuidMatchesDirectory(mDirectory, mDirectoryNameMustBeUuid, mUuid);
 }
 
 LibraryBaseElement::~LibraryBaseElement() noexcept
 {
-    if (mDirectoryIsTemporary) {
+    if (mDirectoryIsTemporary && mTemporaryDirectoryCreated) {
         if (!QDir(mDirectory.toStr()).removeRecursively()) {
             qWarning() << "Could not remove temporary directory:" << mDirectory.toNative();
         }
@@ -138,6 +107,17 @@ LibraryBaseElement::~LibraryBaseElement() noexcept
  *  Getters
  ****************************************************************************************/
 
+QStringList LibraryBaseElement::Metadata::getAllAvailableLocales() const noexcept
+{
+    QStringList list;
+    list.append(names.keys());
+    list.append(descriptions.keys());
+    list.append(keywords.keys());
+    list.removeDuplicates();
+    list.sort(Qt::CaseSensitive);
+    return list;
+}
+
 QStringList LibraryBaseElement::getAllAvailableLocales() const noexcept
 {
     QStringList list;
@@ -161,9 +141,11 @@ void LibraryBaseElement::save()
             .arg(mDirectory.toNative()));
     }
 
+    createTemporaryDirectoryIfNeeded(); // can throw
+
     // save S-Expressions file
     FilePath sexprFilePath = mDirectory.getPathTo(mLongElementName % ".lp");
-    SExpression root(serializeToDomElement("librepcb_" % mLongElementName));
+    SExpression root(serializeToDomElement<SerializableObject>(*this, "librepcb_" % mLongElementName));
     QScopedPointer<SmartSExprFile> sexprFile(SmartSExprFile::create(sexprFilePath));
     sexprFile->save(root, true);
 
@@ -174,6 +156,23 @@ void LibraryBaseElement::save()
     versionFile->save(true);
 }
 
+QMap<QString, QByteArray> LibraryBaseElement::serializeToFiles(
+    const FilePath& destination) const
+{
+    checkDestinationDirectory(destination); // can throw
+
+    QMap<QString, QByteArray> files;
+    SExpression root(serializeToDomElement<SerializableObject>(*this, "librepcb_" % mLongElementName)); // can throw
+    QString content = root.toString(0); // can throw
+    if (!content.endsWith('\n')) {
+        content.append('\n');
+    }
+    files.insert(mLongElementName % ".lp", content.toUtf8());
+    files.insert(".librepcb-" % mShortElementName,
+                 QString("%1\n").arg(qApp->getFileFormatVersion().toStr()).toUtf8());
+    return files;
+}
+
 void LibraryBaseElement::saveTo(const FilePath& destination)
 {
     // copy to new directory and remove source directory if it was temporary
@@ -198,6 +197,51 @@ void LibraryBaseElement::moveIntoParentDirectory(const FilePath& parentDir)
     moveTo(elemDir);
 }
 
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+LibraryBaseElement::Metadata LibraryBaseElement::readMetadata(
+        const FilePath& elementDirectory, bool dirnameMustBeUuid,
+        const QString& shortElementName, const QString& longElementName)
+{
+    checkElementDirectory(elementDirectory, dirnameMustBeUuid, shortElementName,
+                          longElementName); // can throw
+
+    // parse only the nodes of the main file which are needed for the metadata
+    static const QSet<QString> metadataNodes = {
+        "uuid", "name", "description", "keywords", "author", "version", "created",
+        "deprecated", "category", "parent", "component", "package"};
+    FilePath sexprFilePath = elementDirectory.getPathTo(longElementName % ".lp");
+    QString content = QString::fromUtf8(FileUtils::readFile(sexprFilePath)); // can throw
+    SExpression root = SExpression::parse(content, sexprFilePath, metadataNodes); // can throw
+
+    Metadata metadata;
+    metadata.directory = elementDirectory;
+    metadata.uuid = readUuid(root); // can throw
+    metadata.version = root.getValueByPath<Version>("version", true);
+    metadata.author = root.getValueByPath<QString>("author", false);
+    metadata.created = root.getValueByPath<QDateTime>("created", true);
+    metadata.isDeprecated = root.getValueByPath<bool>("deprecated", true);
+    metadata.names.loadFromDomElement(root);
+    metadata.descriptions.loadFromDomElement(root);
+    metadata.keywords.loadFromDomElement(root);
+    foreach (const SExpression& node, root.getChildren("category")) {
+        metadata.categories.insert(node.getValueOfFirstChild<Uuid>(true));
+    }
+    if (const SExpression* node = root.tryGetChildByPath("parent")) {
+        metadata.parentUuid = node->getValueOfFirstChild<Uuid>(false);
+    }
+    if (const SExpression* node = root.tryGetChildByPath("component")) {
+        metadata.componentUuid = node->getValueOfFirstChild<Uuid>(true);
+    }
+    if (const SExpression* node = root.tryGetChildByPath("package")) {
+        metadata.packageUuid = node->getValueOfFirstChild<Uuid>(true);
+    }
+    checkUuidMatchesDirectory(elementDirectory, dirnameMustBeUuid, metadata.uuid);
+    return metadata;
+}
+
 /*****************************************************************************************
  *  Protected Methods
  ****************************************************************************************/
@@ -207,15 +251,18 @@ void LibraryBaseElement::cleanupAfterLoadingElementFromFile() noexcept
     mLoadingFileDocument = SExpression(); // destroy the whole DOM tree
 }
 
+void LibraryBaseElement::createTemporaryDirectoryIfNeeded()
+{
+    if (mDirectoryIsTemporary && (!mTemporaryDirectoryCreated)) {
+        FileUtils::makePath(mDirectory); // can throw
+        mTemporaryDirectoryCreated = true;
+    }
+}
+
 void LibraryBaseElement::copyTo(const FilePath& destination, bool removeSource)
 {
     if (destination != mDirectory) {
-        // check destination directory name validity
-        if (mDirectoryNameMustBeUuid && (destination.getFilename() != mUuid.toStr())) {
-            throw RuntimeError(__FILE__, __LINE__,
-                 QString(tr("Library element directory name is not a valid UUID: \"%1\""))
-                .arg(destination.getFilename()));
-        }
+        checkDestinationDirectory(destination); // can throw
 
         // check if destination directory exists already
         if (destination.isExistingDir() || destination.isExistingFile()) {
@@ -224,6 +271,26 @@ void LibraryBaseElement::copyTo(const FilePath& destination, bool removeSource)
                 .arg(mDirectory.toNative(), destination.toNative()));
         }
 
+        // if the element exists only in memory, there is nothing to copy
+        if (isInMemory()) {
+            // save() writes to mDirectory, so keep the element in memory if it fails
+            // instead of pointing to a half-written directory
+            FilePath memoryDirectory = mDirectory;
+            bool openedReadOnly = mOpenedReadOnly;
+            auto sg = scopeGuard([&](){
+                mDirectory = memoryDirectory;
+                mDirectoryIsTemporary = true;
+                mOpenedReadOnly = openedReadOnly;
+                QDir(destination.toStr()).removeRecursively();
+            });
+            mDirectory = destination;
+            mDirectoryIsTemporary = false;
+            mOpenedReadOnly = false;
+            save(); // can throw
+            sg.dismiss();
+            return;
+        }
+
         // copy current directory to destination
         FileUtils::copyDirRecursively(mDirectory, destination);
 
@@ -246,6 +313,15 @@ void LibraryBaseElement::copyTo(const FilePath& destination, bool removeSource)
     }
 }
 
+void LibraryBaseElement::checkDestinationDirectory(const FilePath& destination) const
+{
+    if (mDirectoryNameMustBeUuid && (destination.getFilename() != mUuid.toStr())) {
+        throw RuntimeError(__FILE__, __LINE__,
+             QString(tr("Library element directory name is not a valid UUID: \"%1\""))
+            .arg(destination.getFilename()));
+    }
+}
+
 void LibraryBaseElement::serialize(SExpression& root) const
 {
     if (!checkAttributesValidity()) {
@@ -271,6 +347,62 @@ bool LibraryBaseElement::checkAttributesValidity() const noexcept
     return true;
 }
 
+Version LibraryBaseElement::checkElementDirectory(const FilePath& elementDirectory,
+                                                  bool dirnameMustBeUuid,
+                                                  const QString& shortElementName,
+                                                  const QString& longElementName)
+{
+    // determine the filepath to the version file
+    FilePath versionFilePath = elementDirectory.getPathTo(".librepcb-" % shortElementName);
+
+    // check if the directory is a library element
+    if (!versionFilePath.isExistingFile()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Directory is not a library element of type %1: \"%2\""))
+            .arg(longElementName, elementDirectory.toNative()));
+    }
+
+    // check directory name
+    if (dirnameMustBeUuid && Uuid(elementDirectory.getFilename()).isNull()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Directory name is not a valid UUID: \"%1\""))
+            .arg(elementDirectory.toNative()));
+    }
+
+    // read version number from version file
+    SmartVersionFile versionFile(versionFilePath, false, true);
+    Version fileVersion = versionFile.getVersion();
+    if (fileVersion != qApp->getAppVersion()) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("The library element %1 was created with a newer application "
+                       "version. You need at least LibrePCB version %2 to open it."))
+            .arg(elementDirectory.toNative()).arg(fileVersion.toPrettyStr(3)));
+    }
+    return fileVersion;
+}
+
+Uuid LibraryBaseElement::readUuid(const SExpression& root)
+{
+    if (root.getChildByIndex(0).isString()) {
+        return root.getChildByIndex(0).getValue<Uuid>(true);
+    } else {
+        // backward compatibility, remove this some time!
+        return root.getValueByPath<Uuid>("uuid", true);
+    }
+}
+
+void LibraryBaseElement::checkUuidMatchesDirectory(const FilePath& elementDirectory,
+                                                   bool dirnameMustBeUuid, const Uuid& uuid)
+{
+    Uuid dirUuid(elementDirectory.getFilename());
+    if (dirnameMustBeUuid && (uuid != dirUuid)) {
+        qDebug() << uuid << "!=" << dirUuid;
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("UUID mismatch between element directory and main file: \"%1\""))
+            .arg(elementDirectory.toNative()));
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
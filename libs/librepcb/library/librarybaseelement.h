@@ -51,6 +51,32 @@ class LibraryBaseElement : public QObject, public SerializableObject
 
     public:
 
+        // Types
+
+        /**
+         * @brief Metadata of a library element, loaded without parsing the whole element
+         *
+         * See #readMetadata(). Attributes which do not exist for the element type
+         * (e.g. #componentUuid for a symbol) are left empty/null.
+         */
+        struct Metadata {
+            FilePath directory;
+            Uuid uuid;
+            Version version;
+            QString author;
+            QDateTime created;
+            bool isDeprecated;
+            LocalizedNameMap names;
+            LocalizedDescriptionMap descriptions;
+            LocalizedKeywordsMap keywords;
+            QSet<Uuid> categories;  ///< only for elements with categories
+            Uuid parentUuid;        ///< only for categories
+            Uuid componentUuid;     ///< only for devices
+            Uuid packageUuid;       ///< only for devices
+
+            QStringList getAllAvailableLocales() const noexcept;
+        };
+
         // Constructors / Destructor
         LibraryBaseElement() = delete;
         LibraryBaseElement(const LibraryBaseElement& other) = delete;
@@ -66,6 +92,15 @@ class LibraryBaseElement : public QObject, public SerializableObject
 
         // Getters: General
         const FilePath& getFilePath() const noexcept {return mDirectory;}
+
+        /**
+         * @brief Check whether the element exists only in memory (nothing written to disk)
+         *
+         * Newly created elements are kept in memory until they are saved with #saveTo()
+         * (or a similar method). Their #getFilePath() points to a temporary directory
+         * which doesn't exist (yet).
+         */
+        bool isInMemory() const noexcept {return mDirectoryIsTemporary && (!mTemporaryDirectoryCreated);}
         bool isOpenedReadOnly() const noexcept {return mOpenedReadOnly;}
 
         // Getters: Attributes
@@ -94,6 +129,23 @@ class LibraryBaseElement : public QObject, public SerializableObject
         virtual void moveTo(const FilePath& destination);
         virtual void moveIntoParentDirectory(const FilePath& parentDir);
 
+        /**
+         * @brief Serialize the element into the files which #saveTo() would write
+         *
+         * Nothing is written to the file system, which allows to serialize elements in
+         * worker threads and to write them later in one go (see
+         * librepcb::library::LibraryElementBatchWriter).
+         *
+         * @param destination   The directory the element will be written to. Only used
+         *                      to check the validity of the directory name.
+         *
+         * @return File names (relative to the element directory) and their content
+         *
+         * @throws Exception if the element is not valid or the destination directory
+         *         name is not allowed for this element.
+         */
+        virtual QMap<QString, QByteArray> serializeToFiles(const FilePath& destination) const;
+
         // Operator Overloadings
         LibraryBaseElement& operator=(const LibraryBaseElement& rhs) = delete;
 
@@ -102,21 +154,52 @@ class LibraryBaseElement : public QObject, public SerializableObject
         static bool isValidElementDirectory(const FilePath& dir) noexcept
         {return dir.getPathTo(".librepcb-" % ElementType::getShortElementName()).isExistingFile();}
 
+        /**
+         * @brief Read only the metadata of a library element (UUID, names, categories, ...)
+         *
+         * This is much faster and needs much less memory than opening the whole element,
+         * since all other nodes of the element's file (e.g. footprints, pins, ...) are
+         * skipped while parsing. Useful for indexing the library.
+         *
+         * @param elementDirectory  The directory of the element.
+         *
+         * @return The metadata of the element
+         *
+         * @throws Exception if the element is not valid or could not be read
+         */
+        template <typename ElementType>
+        static Metadata readMetadata(const FilePath& elementDirectory)
+        {return readMetadata(elementDirectory, true, ElementType::getShortElementName(),
+                             ElementType::getLongElementName());}
+        static Metadata readMetadata(const FilePath& elementDirectory, bool dirnameMustBeUuid,
+                                     const QString& shortElementName,
+                                     const QString& longElementName);
+
 
     protected:
 
         // Protected Methods
         virtual void cleanupAfterLoadingElementFromFile() noexcept;
         virtual void copyTo(const FilePath& destination, bool removeSource);
+        virtual void checkDestinationDirectory(const FilePath& destination) const;
+        void createTemporaryDirectoryIfNeeded();
 
         /// @copydoc librepcb::SerializableObject::serialize()
         virtual void serialize(SExpression& root) const override;
         virtual bool checkAttributesValidity() const noexcept;
+        static Version checkElementDirectory(const FilePath& elementDirectory,
+                                             bool dirnameMustBeUuid,
+                                             const QString& shortElementName,
+                                             const QString& longElementName);
+        static Uuid readUuid(const SExpression& root);
+        static void checkUuidMatchesDirectory(const FilePath& elementDirectory,
+                                              bool dirnameMustBeUuid, const Uuid& uuid);
 
 
         // General Attributes
         mutable FilePath mDirectory;
         mutable bool mDirectoryIsTemporary;
+        bool mTemporaryDirectoryCreated; ///< the temporary directory is created lazily
         bool mOpenedReadOnly;
         bool mDirectoryNameMustBeUuid;
         QString mShortElementName; ///< e.g. "lib", "cmpcat", "sym"
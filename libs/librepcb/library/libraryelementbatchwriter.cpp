@@ -0,0 +1,137 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "libraryelementbatchwriter.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include "librarybaseelement.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryElementBatchWriter::LibraryElementBatchWriter() noexcept
+{
+}
+
+LibraryElementBatchWriter::~LibraryElementBatchWriter() noexcept
+{
+    if (!mPendingElements.isEmpty()) {
+        qWarning() << "Discarding" << mPendingElements.count() << "not written library elements.";
+    }
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int LibraryElementBatchWriter::getPendingElementsCount() const noexcept
+{
+    QMutexLocker lock(&mMutex);
+    return mPendingElements.count();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void LibraryElementBatchWriter::addElement(const LibraryBaseElement& element,
+                                           const FilePath& destination)
+{
+    // serialize outside of the lock since this is the expensive part
+    PendingElement pending;
+    pending.directory = destination;
+    pending.files = element.serializeToFiles(destination); // can throw
+    foreach (const QString& filename, pending.files.keys()) {
+        if (filename.startsWith(".librepcb-")) {
+            pending.versionFileName = filename;
+        }
+    }
+    Q_ASSERT(!pending.versionFileName.isEmpty());
+
+    QMutexLocker lock(&mMutex);
+    mPendingElements.append(pending);
+}
+
+void LibraryElementBatchWriter::addElementIntoParentDirectory(
+    const LibraryBaseElement& element, const FilePath& parentDir)
+{
+    addElement(element, parentDir.getPathTo(element.getUuid().toStr())); // can throw
+}
+
+void LibraryElementBatchWriter::commit()
+{
+    QMutexLocker lock(&mMutex);
+    while (!mPendingElements.isEmpty()) {
+        PendingElement element = mPendingElements.takeFirst();
+        writeElement(element); // can throw
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void LibraryElementBatchWriter::writeElement(const PendingElement& element)
+{
+    if (element.directory.isExistingDir() || element.directory.isExistingFile()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write library "
+            "element to \"%1\" because the directory exists already."))
+            .arg(element.directory.toNative()));
+    }
+    FileUtils::makePath(element.directory); // can throw
+
+    // write the version file as the last one since it marks the element as valid
+    for (auto it = element.files.constBegin(); it != element.files.constEnd(); ++it) {
+        if (it.key() != element.versionFileName) {
+            writeFile(element.directory.getPathTo(it.key()), it.value()); // can throw
+        }
+    }
+    writeFile(element.directory.getPathTo(element.versionFileName),
+              element.files.value(element.versionFileName)); // can throw
+}
+
+void LibraryElementBatchWriter::writeFile(const FilePath& filepath, const QByteArray& content)
+{
+    // Note: Intentionally no QSaveFile (as used by FileUtils::writeFile()) since it
+    // syncs every single file to disk, which is very slow for thousands of files.
+    QFile file(filepath.toStr());
+    if ((!file.open(QIODevice::WriteOnly)) || (file.write(content) != content.size())) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not write to file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYELEMENTBATCHWRITER_H
+#define LIBREPCB_LIBRARY_LIBRARYELEMENTBATCHWRITER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+class LibraryBaseElement;
+
+/*****************************************************************************************
+ *  Class LibraryElementBatchWriter
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryElementBatchWriter class writes many library elements to disk at once
+ *
+ * Intended for importers which generate lots of elements: The elements are serialized
+ * into memory with #addElement() (thread-safe, so it can be called from worker threads)
+ * and written with a single call to #commit(). In contrast to
+ * librepcb::library::LibraryBaseElement::saveTo(), no temporary directories or backup
+ * files are involved and the files are not synced to disk individually, so the
+ * throughput is bounded by the serialization instead of file system metadata updates.
+ *
+ * The main file of each element is written before its version file, so an element whose
+ * writing was interrupted is not recognized as a valid library element.
+ *
+ * @note The added element objects are not modified, i.e. they still refer to their old
+ *       directory after committing.
+ */
+class LibraryElementBatchWriter final
+{
+        Q_DECLARE_TR_FUNCTIONS(LibraryElementBatchWriter)
+
+    public:
+
+        // Constructors / Destructor
+        LibraryElementBatchWriter(const LibraryElementBatchWriter& other) = delete;
+        LibraryElementBatchWriter() noexcept;
+        ~LibraryElementBatchWriter() noexcept;
+
+        // Getters
+        int getPendingElementsCount() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Serialize an element and add it to the elements to be written
+         *
+         * @note This method is thread-safe.
+         *
+         * @param element       The element to write.
+         * @param destination   The directory to write the element into. Must not exist.
+         *
+         * @throws Exception if the element could not be serialized.
+         */
+        void addElement(const LibraryBaseElement& element, const FilePath& destination);
+
+        /**
+         * @brief Same as #addElement(), but with the element's UUID as directory name
+         */
+        void addElementIntoParentDirectory(const LibraryBaseElement& element,
+                                           const FilePath& parentDir);
+
+        /**
+         * @brief Write all pending elements to disk
+         *
+         * Already written elements are removed from the pending list, so if an
+         * exception is thrown, #commit() can be called again to write the remaining
+         * elements (except the failed one, which is discarded).
+         *
+         * @throws Exception if an element could not be written.
+         */
+        void commit();
+
+        // Operator Overloadings
+        LibraryElementBatchWriter& operator=(const LibraryElementBatchWriter& rhs) = delete;
+
+
+    private: // Types
+        struct PendingElement {
+            FilePath directory;
+            QMap<QString, QByteArray> files;
+            QString versionFileName;
+        };
+
+
+    private: // Methods
+        static void writeElement(const PendingElement& element);
+        static void writeFile(const FilePath& filepath, const QByteArray& content);
+
+
+    private: // Data
+        mutable QMutex mMutex;
+        QList<PendingElement> mPendingElements;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_LIBRARYELEMENTBATCHWRITER_H
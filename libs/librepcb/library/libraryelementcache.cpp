@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "libraryelementcache.h"
+#include <librepcb/common/fileio/fileutils.h>
+#include "librarybaseelement.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryElementCache::LibraryElementCache() noexcept :
+    mEnabled(true)
+{
+}
+
+LibraryElementCache::~LibraryElementCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool LibraryElementCache::isEnabled() const noexcept
+{
+    QMutexLocker lock(&mMutex);
+    return mEnabled;
+}
+
+int LibraryElementCache::getElementCount() const noexcept
+{
+    QMutexLocker lock(&mMutex);
+    int count = 0;
+    foreach (const std::weak_ptr<const LibraryBaseElement>& element, mElements) {
+        if (!element.expired()) ++count;
+    }
+    return count;
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void LibraryElementCache::setEnabled(bool enabled) noexcept
+{
+    QMutexLocker lock(&mMutex);
+    mEnabled = enabled;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+LibraryElementCache& LibraryElementCache::instance() noexcept
+{
+    static LibraryElementCache cache;
+    return cache;
+}
+
+QByteArray LibraryElementCache::calcContentHash(const FilePath& elementDirectory,
+                                                const QString& shortElementName)
+{
+    QDir dir(elementDirectory.toStr());
+    QStringList filenames;
+    QDirIterator it(dir.path(), QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString filename = dir.relativeFilePath(it.next());
+        if (!filename.endsWith('~')) { // ignore backup files
+            filenames.append(filename);
+        }
+    }
+    filenames.sort();
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(shortElementName.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(elementDirectory.getFilename().toUtf8());
+    foreach (const QString& filename, filenames) {
+        QByteArray content = FileUtils::readFile(elementDirectory.getPathTo(filename)); // can throw
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(filename.toUtf8());
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(QByteArray::number(content.size()));
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(content);
+    }
+    return hash.result();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+std::shared_ptr<const LibraryBaseElement> LibraryElementCache::getElement(
+    const FilePath& elementDirectory, const QString& shortElementName, const Loader& loader)
+{
+    // the element may be used by any thread, so don't keep it bound to a worker thread
+    auto load = [&]() {
+        std::unique_ptr<LibraryBaseElement> element(loader(elementDirectory)); // can throw
+        QCoreApplication* app = QCoreApplication::instance();
+        if (app && (element->thread() != app->thread())) {
+            element->moveToThread(app->thread());
+        }
+        return element;
+    };
+
+    if (!isEnabled()) {
+        return std::shared_ptr<const LibraryBaseElement>(load().release()); // can throw
+    }
+
+    QByteArray hash = calcContentHash(elementDirectory, shortElementName); // can throw
+    {
+        QMutexLocker lock(&mMutex);
+        if (std::shared_ptr<const LibraryBaseElement> element = mElements.value(hash).lock()) {
+            return element;
+        }
+    }
+
+    // parse the element outside of the lock since this is the expensive part
+    std::unique_ptr<LibraryBaseElement> element = load(); // can throw
+
+    QMutexLocker lock(&mMutex);
+    if (std::shared_ptr<const LibraryBaseElement> other = mElements.value(hash).lock()) {
+        return other; // another thread was faster, discard our element
+    }
+    for (auto it = mElements.begin(); it != mElements.end();) {
+        if (it->expired()) {
+            it = mElements.erase(it); // element is not used anymore
+        } else {
+            ++it;
+        }
+    }
+    std::shared_ptr<const LibraryBaseElement> shared(element.release());
+    mElements.insert(hash, shared);
+    return shared;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
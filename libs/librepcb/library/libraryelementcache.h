@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
+#define LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <functional>
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+
+class LibraryBaseElement;
+
+/*****************************************************************************************
+ *  Class LibraryElementCache
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryElementCache class shares immutable library elements between all
+ *        projects and library previews of the process
+ *
+ * Elements are identified by a hash over the content of their directory (see
+ * #calcContentHash()), not by their location. So if several open projects contain the
+ * same library element, it is parsed only once and all of them get the same read-only
+ * instance. Memory usage thus scales with the number of distinct elements instead of
+ * elements times projects.
+ *
+ * The cache holds only weak references: An element is deleted as soon as its last user
+ * releases it. If the files of an element are modified, their hash changes, so the next
+ * #getElement() call parses the element again while the old instance stays valid for
+ * its current users.
+ *
+ * Cached elements are opened in read-only mode and must never be modified. Their
+ * librepcb::library::LibraryBaseElement::getFilePath() refers to the directory they were
+ * loaded from first, which may belong to another project.
+ *
+ * @note All methods are thread-safe. Elements are parsed outside of the lock, so
+ *       different elements can be loaded concurrently.
+ */
+class LibraryElementCache final
+{
+        Q_DECLARE_TR_FUNCTIONS(LibraryElementCache)
+
+    public:
+
+        // Constructors / Destructor
+        LibraryElementCache(const LibraryElementCache& other) = delete;
+        LibraryElementCache() noexcept;
+        ~LibraryElementCache() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept;
+
+        /**
+         * @brief Get the number of cached elements which are still in use
+         */
+        int getElementCount() const noexcept;
+
+        // Setters
+
+        /**
+         * @brief Enable or disable the cache (enabled by default)
+         *
+         * While disabled, #getElement() loads a new (not shared) instance of the element
+         * on every call. Already cached elements are not affected.
+         */
+        void setEnabled(bool enabled) noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Get the shared instance of a library element, loading it if needed
+         *
+         * @param elementDirectory  The directory of the element.
+         *
+         * @return The shared, read-only element
+         *
+         * @throws Exception if the element could not be read or parsed.
+         */
+        template <typename ElementType>
+        std::shared_ptr<const ElementType> getElement(const FilePath& elementDirectory) {
+            return std::static_pointer_cast<const ElementType>(getElement(elementDirectory,
+                ElementType::getShortElementName(), [](const FilePath& dir) {
+                    return new ElementType(dir, true); // can throw
+                }));
+        }
+
+        // Operator Overloadings
+        LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Get the process-wide cache instance
+         */
+        static LibraryElementCache& instance() noexcept;
+
+        /**
+         * @brief Calculate the hash of all files of a library element directory
+         *
+         * The hash also contains the directory name (which must match the element's
+         * UUID) and the element type, but not the location of the directory.
+         *
+         * @throws Exception if a file could not be read.
+         */
+        static QByteArray calcContentHash(const FilePath& elementDirectory,
+                                          const QString& shortElementName);
+
+
+    private: // Types
+        typedef std::function<LibraryBaseElement*(const FilePath&)> Loader;
+
+
+    private: // Methods
+        std::shared_ptr<const LibraryBaseElement> getElement(const FilePath& elementDirectory,
+                                                             const QString& shortElementName,
+                                                             const Loader& loader);
+
+
+    private: // Data
+        mutable QMutex mMutex;
+        bool mEnabled;
+        QHash<QByteArray, std::weak_ptr<const LibraryBaseElement>> mElements;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_LIBRARYELEMENTCACHE_H
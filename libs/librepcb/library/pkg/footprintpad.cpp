@@ -193,9 +193,9 @@ void FootprintPad::serialize(SExpression& root) const
     root.appendToken(mPackagePadUuid);
     root.appendTokenChild("side", boardSideToString(mBoardSide), false);
     root.appendTokenChild("shape", shapeToString(mShape), false);
-    root.appendChild(mPosition.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     root.appendTokenChild("rot", mRotation, false);
-    root.appendChild(Point(mWidth, mHeight).serializeToDomElement("size"), false);
+    root.appendChild(serializeToDomElement(Point(mWidth, mHeight), "size"), false);
     root.appendTokenChild("drill", mDrillDiameter, false);
 }
 
@@ -120,7 +120,7 @@ void SymbolPin::serialize(SExpression& root) const
 
     root.appendToken(mUuid);
     root.appendStringChild("name", mName, false);
-    root.appendChild(mPosition.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     root.appendTokenChild("rot", mRotation, false);
     root.appendTokenChild("length", mLength, false);
 }
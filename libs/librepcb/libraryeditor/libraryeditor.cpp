@@ -301,7 +301,7 @@ void LibraryEditor::newElementTriggered() noexcept
                 break;
             default: break;
         }
-        mWorkspace.getLibraryDb().startLibraryRescan();
+        mWorkspace.getLibraryDb().startElementRescan(fp);
     }
 }
 
@@ -330,7 +330,7 @@ void LibraryEditor::removeElementTriggered() noexcept
         } catch (const Exception& e) {
             QMessageBox::critical(this, tr("Error"), e.getMsg());
         }
-        mWorkspace.getLibraryDb().startLibraryRescan();
+        mWorkspace.getLibraryDb().startElementRescan(elementDir);
     }
 }
 
@@ -423,7 +423,7 @@ void LibraryEditor::editLibraryElementTriggered(const FilePath& fp, bool isNewEl
                 mUi->statusBar, &StatusBar::setAbsoluteCursorPosition);
         connect(widget, &EditorWidgetBase::dirtyChanged, this, &LibraryEditor::updateTabTitles);
         connect(widget, &EditorWidgetBase::elementEdited,
-                &mWorkspace.getLibraryDb(), &workspace::WorkspaceLibraryDb::startLibraryRescan);
+                &mWorkspace.getLibraryDb(), &workspace::WorkspaceLibraryDb::startElementRescan);
         int index = mUi->tabWidget->addTab(widget, widget->windowIcon(), widget->windowTitle());
         mUi->tabWidget->setCurrentIndex(index);
     } catch (const Exception& e) {
@@ -25,14 +25,17 @@
 #include "addlibrarywidget.h"
 #include "ui_addlibrarywidget.h"
 #include <librepcb/common/application.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/common/systeminfo.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/network/repository.h>
 #include <librepcb/library/library.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
 #include "repositorylibrarylistwidgetitem.h"
 #include "librarydownload.h"
+#include "librarydownloadqueue.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -46,7 +49,8 @@ namespace manager {
  ****************************************************************************************/
 
 AddLibraryWidget::AddLibraryWidget(workspace::Workspace& ws) noexcept :
-    QWidget(nullptr), mWorkspace(ws), mUi(new Ui::AddLibraryWidget)
+    QWidget(nullptr), mWorkspace(ws), mUi(new Ui::AddLibraryWidget),
+    mRepoLibraryDownloadQueue(new LibraryDownloadQueue())
 {
     mUi->setupUi(this);
     connect(mUi->btnDownloadZip, &QPushButton::clicked,
@@ -59,6 +63,12 @@ AddLibraryWidget::AddLibraryWidget(workspace::Workspace& ws) noexcept :
             this, &AddLibraryWidget::downloadZipUrlLineEditTextChanged);
     connect(mUi->btnRepoLibsDownload, &QPushButton::clicked,
             this, &AddLibraryWidget::downloadLibrariesFromRepositoryButtonClicked);
+    connect(mUi->btnRepoLibsUpdateAll, &QPushButton::clicked,
+            this, &AddLibraryWidget::updateAllLibrariesButtonClicked);
+    connect(mRepoLibraryDownloadQueue.data(), &LibraryDownloadQueue::downloadFinished,
+            this, &AddLibraryWidget::repoLibraryDownloadFinished);
+    connect(mRepoLibraryDownloadQueue.data(), &LibraryDownloadQueue::allDownloadsFinished,
+            this, &AddLibraryWidget::allRepoLibraryDownloadsFinished);
 
     // tab "create local library": set placeholder texts
     mUi->edtLocalName->setPlaceholderText("My Library");
@@ -80,6 +90,7 @@ AddLibraryWidget::AddLibraryWidget(workspace::Workspace& ws) noexcept :
 AddLibraryWidget::~AddLibraryWidget() noexcept
 {
     clearRepositoryLibraryList();
+    mRepoLibraryDownloadQueue.reset(); // aborts all running downloads
 }
 
 /*****************************************************************************************
@@ -335,8 +346,6 @@ void AddLibraryWidget::repositoryLibraryListReceived(const QJsonArray& libs) noe
                                                       mWorkspace, libVal.toObject());
         connect(widget, &RepositoryLibraryListWidgetItem::checkedChanged,
                 this, &AddLibraryWidget::repoLibraryDownloadCheckedChanged);
-        connect(widget, &RepositoryLibraryListWidgetItem::libraryAdded,
-                this, &AddLibraryWidget::libraryAdded);
         QListWidgetItem* item = new QListWidgetItem(mUi->lstRepoLibs);
         item->setSizeHint(widget->sizeHint());
         mUi->lstRepoLibs->setItemWidget(item, widget);
@@ -413,13 +422,67 @@ void AddLibraryWidget::downloadLibrariesFromRepositoryButtonClicked() noexcept
         auto* widget = dynamic_cast<RepositoryLibraryListWidgetItem*>(
                            mUi->lstRepoLibs->itemWidget(item));
         if (widget) {
-            widget->startDownloadIfSelected();
+            widget->startDownloadIfSelected(*mRepoLibraryDownloadQueue);
         } else {
             qWarning() << "Invalid item widget detected.";
         }
     }
 }
 
+void AddLibraryWidget::updateAllLibrariesButtonClicked() noexcept
+{
+    for (int i = 0; i < mUi->lstRepoLibs->count(); i++) {
+        QListWidgetItem* item = mUi->lstRepoLibs->item(i); Q_ASSERT(item);
+        auto* widget = dynamic_cast<RepositoryLibraryListWidgetItem*>(
+                           mUi->lstRepoLibs->itemWidget(item));
+        if (widget && widget->isUpdateAvailable()) {
+            widget->setChecked(true); // also checks dependencies
+        }
+    }
+    downloadLibrariesFromRepositoryButtonClicked();
+}
+
+void AddLibraryWidget::repoLibraryDownloadFinished(const FilePath& destDir, bool success,
+                                                   const QString& errMsg) noexcept
+{
+    if (success) {
+        try {
+            // the library gets rescanned once after all downloads have finished
+            mWorkspace.setLibraryRescanSuppressed(true);
+            auto sg = scopeGuard([this](){mWorkspace.setLibraryRescanSuppressed(false);});
+
+            // if the library exists already in the workspace, remove it first
+            QString libDirName = destDir.getFilename();
+            if (mWorkspace.getRemoteLibraries().contains(libDirName)) {
+                mWorkspace.removeRemoteLibrary(libDirName, false); // can throw
+            }
+
+            // add downloaded library to workspace
+            mWorkspace.addRemoteLibrary(libDirName); // can throw
+
+            // finish
+            emit libraryAdded(destDir, false);
+        } catch (const Exception& e) {
+            mRepoLibraryDownloadErrors.append(e.getMsg());
+        }
+    } else if (!errMsg.isEmpty()) {
+        mRepoLibraryDownloadErrors.append(errMsg);
+    }
+}
+
+void AddLibraryWidget::allRepoLibraryDownloadsFinished() noexcept
+{
+    // rescan the library once after all downloads instead of after every single one
+    mWorkspace.getLibraryDb().startLibraryRescan();
+
+    // report all errors at once instead of opening a message box for every library
+    if (!mRepoLibraryDownloadErrors.isEmpty()) {
+        QMessageBox::critical(this, tr("Download failed"),
+                              mRepoLibraryDownloadErrors.join("\n\n"));
+        mRepoLibraryDownloadErrors.clear();
+    }
+}
+
 /*****************************************************************************************
  *  Private Static Methods
  ****************************************************************************************/
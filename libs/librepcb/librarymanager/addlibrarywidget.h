@@ -41,6 +41,7 @@ namespace library {
 namespace manager {
 
 class LibraryDownload;
+class LibraryDownloadQueue;
 
 namespace Ui {
 class AddLibraryWidget;
@@ -92,6 +93,10 @@ class AddLibraryWidget final : public QWidget
         void clearRepositoryLibraryList() noexcept;
         void repoLibraryDownloadCheckedChanged(bool checked) noexcept;
         void downloadLibrariesFromRepositoryButtonClicked() noexcept;
+        void updateAllLibrariesButtonClicked() noexcept;
+        void repoLibraryDownloadFinished(const FilePath& destDir, bool success,
+                                         const QString& errMsg) noexcept;
+        void allRepoLibraryDownloadsFinished() noexcept;
 
         static QString getTextOrPlaceholderFromQLineEdit(QLineEdit* edit, bool isFilename) noexcept;
 
@@ -101,6 +106,8 @@ class AddLibraryWidget final : public QWidget
         workspace::Workspace& mWorkspace;
         QScopedPointer<Ui::AddLibraryWidget> mUi;
         QScopedPointer<LibraryDownload> mManualLibraryDownload;
+        QScopedPointer<LibraryDownloadQueue> mRepoLibraryDownloadQueue;
+        QStringList mRepoLibraryDownloadErrors;
         QList<QMetaObject::Connection> mLibraryDownloadConnections;
 };
 
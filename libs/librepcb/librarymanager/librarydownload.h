@@ -43,10 +43,13 @@ namespace manager {
 /**
  * @brief The LibraryDownload class
  *
+ * The slots #start() and #abort() are virtual only to allow replacing the real download
+ * by a fake one in unit tests (see librepcb::library::manager::LibraryDownloadQueue).
+ *
  * @author ubruhin
  * @date 2016-10-01
  */
-class LibraryDownload final : public QObject
+class LibraryDownload : public QObject
 {
         Q_OBJECT
 
@@ -56,7 +59,7 @@ class LibraryDownload final : public QObject
         LibraryDownload() = delete;
         LibraryDownload(const LibraryDownload& other) = delete;
         LibraryDownload(const QUrl& urlToZip, const FilePath& destDir) noexcept;
-        ~LibraryDownload() noexcept;
+        virtual ~LibraryDownload() noexcept;
 
         // Getters
         const FilePath& getDestinationDir() const noexcept {return mDestDir;}
@@ -83,12 +86,12 @@ class LibraryDownload final : public QObject
         /**
          * @brief Start downloading the library
          */
-        void start() noexcept;
+        virtual void start() noexcept;
 
         /**
          * @brief Abort downloading the library
          */
-        void abort() noexcept;
+        virtual void abort() noexcept;
 
 
     signals:
@@ -0,0 +1,198 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "librarydownloadqueue.h"
+#include "librarydownload.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace manager {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+LibraryDownloadQueue::LibraryDownloadQueue(QObject* parent) noexcept :
+    LibraryDownloadQueue([](const QUrl& url, const FilePath& destDir){
+                             return new LibraryDownload(url, destDir);
+                         }, sRetryBaseDelayMs, parent)
+{
+}
+
+LibraryDownloadQueue::LibraryDownloadQueue(const DownloadFactory& factory,
+                                           int retryBaseDelayMs, QObject* parent) noexcept :
+    QObject(parent), mFactory(factory), mRetryBaseDelayMs(retryBaseDelayMs), mBusy(false)
+{
+}
+
+LibraryDownloadQueue::~LibraryDownloadQueue() noexcept
+{
+    mPending.clear();
+    mWaitingForRetry.clear();
+    qDeleteAll(mRunning.keys()); // aborts the downloads
+    mRunning.clear();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool LibraryDownloadQueue::contains(const FilePath& destDir) const noexcept
+{
+    foreach (const Job& job, mPending) {
+        if (job.destDir == destDir) return true;
+    }
+    foreach (const Job& job, mRunning) {
+        if (job.destDir == destDir) return true;
+    }
+    foreach (const Job& job, mWaitingForRetry) {
+        if (job.destDir == destDir) return true;
+    }
+    return false;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void LibraryDownloadQueue::enqueue(const QUrl& urlToZip, const FilePath& destDir,
+                                   qint64 zipSize, const QByteArray& sha256) noexcept
+{
+    if (contains(destDir)) return;
+    mPending.append(Job{urlToZip, destDir, zipSize, sha256, 1});
+    mBusy = true;
+    startNextDownloads();
+}
+
+void LibraryDownloadQueue::abortAll() noexcept
+{
+    QList<Job> pending = mPending + mWaitingForRetry;
+    mPending.clear();
+    mWaitingForRetry.clear();
+    foreach (const Job& job, pending) {
+        emit downloadFinished(job.destDir, false, QString());
+    }
+    foreach (LibraryDownload* download, mRunning.keys()) {
+        download->abort(); // finished() is emitted asynchronously
+    }
+    checkIfIdle();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void LibraryDownloadQueue::startNextDownloads() noexcept
+{
+    QHash<QString, int> runningPerHost;
+    foreach (const Job& job, mRunning) {
+        runningPerHost[job.url.host()]++;
+    }
+    for (int i = 0; (i < mPending.count()) && (mRunning.count() < sMaxParallelDownloads); ) {
+        QString host = mPending.at(i).url.host();
+        if (runningPerHost.value(host) < sMaxParallelDownloadsPerHost) {
+            runningPerHost[host]++;
+            startDownload(mPending.takeAt(i));
+        } else {
+            ++i; // try the next one, maybe it's on another host
+        }
+    }
+}
+
+void LibraryDownloadQueue::startDownload(const Job& job) noexcept
+{
+    LibraryDownload* download = mFactory(job.url, job.destDir);
+    if (job.zipSize > 0) {
+        download->setExpectedZipFileSize(job.zipSize);
+    }
+    if (!job.sha256.isEmpty()) {
+        download->setExpectedChecksum(QCryptographicHash::Sha256, job.sha256);
+    }
+    FilePath destDir = job.destDir;
+    connect(download, &LibraryDownload::progressPercent,
+            this, [this, destDir](int percent){
+                emit downloadProgressPercent(destDir, percent);
+            }, Qt::QueuedConnection);
+    connect(download, &LibraryDownload::finished,
+            this, [this, download](bool success, const QString& errMsg){
+                downloadFinishedSlot(download, success, errMsg);
+            }, Qt::QueuedConnection);
+    mRunning.insert(download, job);
+    download->start();
+}
+
+void LibraryDownloadQueue::downloadFinishedSlot(LibraryDownload* download, bool success,
+                                                const QString& errMsg) noexcept
+{
+    if (!mRunning.contains(download)) return;
+    Job job = mRunning.take(download);
+    download->deleteLater();
+
+    // errMsg is empty if the download was aborted, don't retry in that case
+    if ((!success) && (!errMsg.isEmpty()) && (job.attempt < sMaxAttempts)) {
+        int delay = mRetryBaseDelayMs * (1 << (job.attempt - 1));
+        qWarning() << "Library download failed, retry in" << delay << "ms:" << errMsg;
+        job.attempt++;
+        mWaitingForRetry.append(job);
+        FilePath destDir = job.destDir;
+        QTimer::singleShot(delay, this, [this, destDir](){retryDownload(destDir);});
+    } else {
+        emit downloadFinished(job.destDir, success, errMsg);
+    }
+
+    startNextDownloads();
+    checkIfIdle();
+}
+
+void LibraryDownloadQueue::retryDownload(const FilePath& destDir) noexcept
+{
+    for (int i = 0; i < mWaitingForRetry.count(); ++i) {
+        if (mWaitingForRetry.at(i).destDir == destDir) {
+            mPending.append(mWaitingForRetry.takeAt(i));
+            startNextDownloads();
+            return;
+        }
+    }
+    // the download was aborted in the meantime
+}
+
+void LibraryDownloadQueue::checkIfIdle() noexcept
+{
+    // only emit the signal on the transition from busy to idle, e.g. not when aborting
+    // an already idle queue
+    if (mBusy && isIdle()) {
+        mBusy = false;
+        emit allDownloadsFinished();
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace manager
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,168 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_LIBRARY_MANAGER_LIBRARYDOWNLOADQUEUE_H
+#define LIBREPCB_LIBRARY_MANAGER_LIBRARYDOWNLOADQUEUE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <functional>
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace manager {
+
+class LibraryDownload;
+
+/*****************************************************************************************
+ *  Class LibraryDownloadQueue
+ ****************************************************************************************/
+
+/**
+ * @brief The LibraryDownloadQueue class schedules the download of many libraries
+ *
+ * Enqueued downloads are started in the order they were added, but only a limited
+ * number of them run at the same time (in total and per host), so installing or
+ * updating many libraries at once neither overloads the network nor the server.
+ *
+ * Failed downloads are retried a few times with an exponentially increasing delay.
+ * Aborted downloads are not retried.
+ *
+ * The signal #allDownloadsFinished() is emitted every time the queue becomes idle, i.e.
+ * once after the last of all enqueued downloads has finished or was aborted.
+ *
+ * Every download is identified by its destination directory (see #enqueue()).
+ */
+class LibraryDownloadQueue final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        typedef std::function<LibraryDownload*(const QUrl&, const FilePath&)> DownloadFactory;
+
+        // Constructors / Destructor
+        LibraryDownloadQueue(const LibraryDownloadQueue& other) = delete;
+        explicit LibraryDownloadQueue(QObject* parent = nullptr) noexcept;
+
+        /**
+         * @brief Constructor with a custom download factory (used by unit tests)
+         *
+         * @param factory           Creates the (not yet started) download of a job. The
+         *                          queue takes the ownership of the returned object.
+         * @param retryBaseDelayMs  Delay before the first retry of a failed download, it
+         *                          is doubled for every further retry.
+         * @param parent            The parent object.
+         */
+        LibraryDownloadQueue(const DownloadFactory& factory, int retryBaseDelayMs,
+                             QObject* parent = nullptr) noexcept;
+        ~LibraryDownloadQueue() noexcept;
+
+        // Getters
+        bool isIdle() const noexcept {return mPending.isEmpty() && mRunning.isEmpty()
+                                             && mWaitingForRetry.isEmpty();}
+        bool contains(const FilePath& destDir) const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Add a library download to the queue
+         *
+         * @param urlToZip      URL of the library ZIP file.
+         * @param destDir       Destination directory of the library. If a download with
+         *                      the same destination is already enqueued, nothing is done.
+         * @param zipSize       Expected size of the ZIP file (-1 if unknown).
+         * @param sha256        Expected SHA-256 checksum of the ZIP file (empty if
+         *                      unknown).
+         */
+        void enqueue(const QUrl& urlToZip, const FilePath& destDir, qint64 zipSize,
+                     const QByteArray& sha256) noexcept;
+
+        /**
+         * @brief Abort all running and remove all pending downloads
+         */
+        void abortAll() noexcept;
+
+        // Operator Overloadings
+        LibraryDownloadQueue& operator=(const LibraryDownloadQueue& rhs) = delete;
+
+
+    signals:
+
+        void downloadProgressPercent(const FilePath& destDir, int percent);
+        void downloadFinished(const FilePath& destDir, bool success, const QString& errMsg);
+
+        /**
+         * @brief All enqueued downloads have finished (successfully or not)
+         */
+        void allDownloadsFinished();
+
+
+    private: // Types
+
+        struct Job {
+            QUrl url;
+            FilePath destDir;
+            qint64 zipSize;
+            QByteArray sha256;
+            int attempt;
+        };
+
+
+    private: // Methods
+
+        void startNextDownloads() noexcept;
+        void startDownload(const Job& job) noexcept;
+        void retryDownload(const FilePath& destDir) noexcept;
+        void downloadFinishedSlot(LibraryDownload* download, bool success,
+                                  const QString& errMsg) noexcept;
+        void checkIfIdle() noexcept;
+
+
+    private: // Data
+
+        DownloadFactory mFactory;
+        int mRetryBaseDelayMs;
+        bool mBusy; ///< whether #allDownloadsFinished() has to be emitted when idle
+        QList<Job> mPending;
+        QHash<LibraryDownload*, Job> mRunning;
+        QList<Job> mWaitingForRetry;
+
+        static constexpr int sMaxParallelDownloads = 4;
+        static constexpr int sMaxParallelDownloadsPerHost = 2;
+        static constexpr int sMaxAttempts = 3;
+        static constexpr int sRetryBaseDelayMs = 1000;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace manager
+} // namespace library
+} // namespace librepcb
+
+#endif // LIBREPCB_LIBRARY_MANAGER_LIBRARYDOWNLOADQUEUE_H
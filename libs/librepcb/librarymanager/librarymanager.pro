@@ -23,6 +23,7 @@ INCLUDEPATH += \
 SOURCES += \
     addlibrarywidget.cpp \
     librarydownload.cpp \
+    librarydownloadqueue.cpp \
     libraryinfowidget.cpp \
     librarylistwidgetitem.cpp \
     librarymanager.cpp \
@@ -31,6 +32,7 @@ SOURCES += \
 HEADERS += \
     addlibrarywidget.h \
     librarydownload.h \
+    librarydownloadqueue.h \
     libraryinfowidget.h \
     librarylistwidgetitem.h \
     librarymanager.h \
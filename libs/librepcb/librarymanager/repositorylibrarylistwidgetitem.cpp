@@ -26,7 +26,7 @@
 #include "ui_repositorylibrarylistwidgetitem.h"
 #include <librepcb/common/network/networkrequest.h>
 #include <librepcb/workspace/workspace.h>
-#include "librarydownload.h"
+#include "librarydownloadqueue.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -42,7 +42,7 @@ namespace manager {
 RepositoryLibraryListWidgetItem::RepositoryLibraryListWidgetItem(workspace::Workspace& ws,
                                                                  const QJsonObject& obj) noexcept :
     QWidget(nullptr), mWorkspace(ws), mJsonObject(obj),
-    mUi(new Ui::RepositoryLibraryListWidgetItem)
+    mUi(new Ui::RepositoryLibraryListWidgetItem), mIsDownloading(false)
 {
     mUi->setupUi(this);
     mUi->lblIcon->setText("");
@@ -92,6 +92,18 @@ bool RepositoryLibraryListWidgetItem::isChecked() const noexcept
     return mUi->cbxDownload->isChecked();
 }
 
+bool RepositoryLibraryListWidgetItem::isUpdateAvailable() const noexcept
+{
+    Version installedVersion = mWorkspace.getVersionOfLibrary(mUuid, true, true);
+    return installedVersion.isValid() && (installedVersion < mVersion);
+}
+
+FilePath RepositoryLibraryListWidgetItem::getDestinationDir() const noexcept
+{
+    QString libDirName = mUuid.toStr() % ".lplib";
+    return mWorkspace.getLibrariesPath().getPathTo("remote/" % libDirName);
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -133,10 +145,12 @@ void RepositoryLibraryListWidgetItem::updateInstalledStatus() noexcept
     }
 }
 
-void RepositoryLibraryListWidgetItem::startDownloadIfSelected() noexcept
+void RepositoryLibraryListWidgetItem::startDownloadIfSelected(LibraryDownloadQueue& queue) noexcept
 {
-    if (mUi->cbxDownload->isVisible() && mUi->cbxDownload->isChecked() && (!mLibraryDownload)) {
+    if (mUi->cbxDownload->isVisible() && mUi->cbxDownload->isChecked() && (!mIsDownloading)) {
+        mIsDownloading = true;
         mUi->cbxDownload->setVisible(false);
+        mUi->prgProgress->setValue(0);
         mUi->prgProgress->setVisible(true);
 
         // read ZIP metadata from JSON
@@ -144,24 +158,14 @@ void RepositoryLibraryListWidgetItem::startDownloadIfSelected() noexcept
         qint64 zipSize = mJsonObject.value("zip_size").toInt(-1);
         QByteArray zipSha256 = mJsonObject.value("zip_sha256").toString().toUtf8();
 
-        // determine destination directory
-        QString libDirName = mUuid.toStr() % ".lplib";
-        FilePath destDir = mWorkspace.getLibrariesPath().getPathTo("remote/" % libDirName);
-
-        // start download
-        mLibraryDownload.reset(new LibraryDownload(url, destDir));
-        if (zipSize > 0) {
-            mLibraryDownload->setExpectedZipFileSize(zipSize);
-        }
-        if (!zipSha256.isEmpty()) {
-            mLibraryDownload->setExpectedChecksum(QCryptographicHash::Sha256,
-                                                  QByteArray::fromHex(zipSha256));
-        }
-        connect(mLibraryDownload.data(), &LibraryDownload::progressPercent,
-                mUi->prgProgress, &QProgressBar::setValue, Qt::QueuedConnection);
-        connect(mLibraryDownload.data(), &LibraryDownload::finished,
-                this, &RepositoryLibraryListWidgetItem::downloadFinished, Qt::QueuedConnection);
-        mLibraryDownload->start();
+        // enqueue download (the queue limits the number of parallel downloads)
+        connect(&queue, &LibraryDownloadQueue::downloadProgressPercent,
+                this, &RepositoryLibraryListWidgetItem::downloadProgressPercent,
+                Qt::UniqueConnection);
+        connect(&queue, &LibraryDownloadQueue::downloadFinished,
+                this, &RepositoryLibraryListWidgetItem::downloadFinished,
+                Qt::UniqueConnection);
+        queue.enqueue(url, getDestinationDir(), zipSize, QByteArray::fromHex(zipSha256));
     }
 }
 
@@ -169,38 +173,26 @@ void RepositoryLibraryListWidgetItem::startDownloadIfSelected() noexcept
  *  Private Methods
  ****************************************************************************************/
 
-void RepositoryLibraryListWidgetItem::downloadFinished(bool success, const QString& errMsg) noexcept
+void RepositoryLibraryListWidgetItem::downloadProgressPercent(const FilePath& destDir,
+                                                              int percent) noexcept
 {
-    Q_ASSERT(mLibraryDownload);
-
-    if (success) {
-        try {
-            // if the library exists already in the workspace, remove it first
-            QString libDirName = mLibraryDownload->getDestinationDir().getFilename();
-            if (mWorkspace.getRemoteLibraries().contains(libDirName)) {
-                mWorkspace.removeRemoteLibrary(libDirName, false); // can throw
-            }
-
-            // add downloaded library to workspace
-            mWorkspace.addRemoteLibrary(libDirName); // can throw
-
-            // finish
-            emit libraryAdded(mLibraryDownload->getDestinationDir(), false);
-        } catch (const Exception& e) {
-            QMessageBox::critical(this, tr("Download failed"), e.getMsg());
-        }
-    } else if (!errMsg.isEmpty()) {
-        QMessageBox::critical(this, tr("Download failed"), errMsg);
+    if (destDir == getDestinationDir()) {
+        mUi->prgProgress->setValue(percent);
     }
+}
+
+void RepositoryLibraryListWidgetItem::downloadFinished(const FilePath& destDir, bool success,
+                                                       const QString& errMsg) noexcept
+{
+    Q_UNUSED(errMsg); // errors are reported by the AddLibraryWidget
+    if (destDir != getDestinationDir()) return;
 
     // update widgets
+    mIsDownloading = false;
     mUi->cbxDownload->setChecked(!success);
     mUi->cbxDownload->setVisible(true);
     mUi->prgProgress->setVisible(false);
     updateInstalledStatus();
-
-    // delete download helper
-    mLibraryDownload.reset();
 }
 
 void RepositoryLibraryListWidgetItem::iconReceived(const QByteArray& data) noexcept
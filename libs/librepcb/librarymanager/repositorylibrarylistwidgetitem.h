@@ -42,7 +42,7 @@ class Workspace;
 namespace library {
 namespace manager {
 
-class LibraryDownload;
+class LibraryDownloadQueue;
 
 namespace Ui {
 class RepositoryLibraryListWidgetItem;
@@ -74,13 +74,15 @@ class RepositoryLibraryListWidgetItem final : public QWidget
         const Uuid& getUuid() const noexcept {return mUuid;}
         const QSet<Uuid>& getDependencies() const noexcept {return mDependencies;}
         bool isChecked() const noexcept;
+        bool isUpdateAvailable() const noexcept;
+        FilePath getDestinationDir() const noexcept;
 
         // Setters
         void setChecked(bool checked) noexcept;
 
         // General Methods
         void updateInstalledStatus() noexcept;
-        void startDownloadIfSelected() noexcept;
+        void startDownloadIfSelected(LibraryDownloadQueue& queue) noexcept;
 
         // Operator Overloadings
         RepositoryLibraryListWidgetItem& operator=(const RepositoryLibraryListWidgetItem& rhs) = delete;
@@ -89,12 +91,13 @@ class RepositoryLibraryListWidgetItem final : public QWidget
     signals:
 
         void checkedChanged(bool checked);
-        void libraryAdded(const FilePath& libDir, bool select);
 
 
     private: // Methods
 
-        void downloadFinished(bool success, const QString& errMsg) noexcept;
+        void downloadProgressPercent(const FilePath& destDir, int percent) noexcept;
+        void downloadFinished(const FilePath& destDir, bool success,
+                              const QString& errMsg) noexcept;
         void iconReceived(const QByteArray& data) noexcept;
 
 
@@ -107,7 +110,7 @@ class RepositoryLibraryListWidgetItem final : public QWidget
         bool mIsRecommended;
         QSet<Uuid> mDependencies;
         QScopedPointer<Ui::RepositoryLibraryListWidgetItem> mUi;
-        QScopedPointer<LibraryDownload> mLibraryDownload;
+        bool mIsDownloading;
 };
 
 /*****************************************************************************************
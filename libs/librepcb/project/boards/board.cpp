@@ -34,8 +34,11 @@
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/geometry/polygon.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/utils/clipperpathcache.h>
+#include <librepcb/common/utils/rectselectionindex.h>
 #include "../circuit/circuit.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "../circuit/componentinstance.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
@@ -55,8 +58,11 @@
 #include "boardlayerstack.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardusersettings.h"
+#include "boardplanefragmentscache.h"
 #include "boardselectionquery.h"
 #include "boardairwiresbuilder.h"
+#include "boardclearancematrix.h"
+#include "boardstatistics.h"
 #include "../circuit/netsignal.h"
 
 /*****************************************************************************************
@@ -71,11 +77,14 @@ namespace project {
 
 Board::Board(const Board& other, const FilePath& filepath, const QString& name) :
     QObject(&other.getProject()), mProject(other.getProject()), mFilePath(filepath),
-    mIsAddedToProject(false)
+    mIsAddedToProject(false), mAttributeSubstitutionCache(*this)
 {
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mPlaneFragmentsCache.reset(new BoardPlaneFragmentsCache(*this));
+        mClipperPathCache.reset(new ClipperPathCache());
+        mStatistics.reset(new BoardStatistics(*this));
 
         // copy the other board
         mFile.reset(SmartSExprFile::create(mFilePath));
@@ -148,8 +157,10 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
         // emit the "attributesChanged" signal when the project has emited it
         connect(&mProject, &Project::attributesChanged, this, &Board::attributesChanged);
 
-        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
-        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::scheduleErcMessagesUpdate);
+        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::scheduleErcMessagesUpdate);
+
+        connectClearanceMatrixInvalidation();
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
@@ -170,6 +181,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
         mGridProperties.reset();
         mLayerStack.reset();
         mFile.reset();
+        mPlaneFragmentsCache.reset();
         mGraphicsScene.reset();
         throw; // ...and rethrow the exception
     }
@@ -177,11 +189,15 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
 
 Board::Board(Project& project, const FilePath& filepath, bool restore,
              bool readOnly, bool create, const QString& newName) :
-    QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false)
+    QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false),
+    mAttributeSubstitutionCache(*this)
 {
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mPlaneFragmentsCache.reset(new BoardPlaneFragmentsCache(*this));
+        mClipperPathCache.reset(new ClipperPathCache());
+        mStatistics.reset(new BoardStatistics(*this));
 
         // try to open/create the board file
         if (create)
@@ -316,15 +332,19 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
             //////////////////////////////////////////////////////////////////////////////
         }
 
-        rebuildAllPlanes();
+        // restore planes from the cache, outdated planes will be rebuilt afterwards
+        mPlaneFragmentsCache->load();
+        restorePlanesFromCache();
         updateErcMessages();
         updateIcon();
 
         // emit the "attributesChanged" signal when the project has emited it
         connect(&mProject, &Project::attributesChanged, this, &Board::attributesChanged);
 
-        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::updateErcMessages);
-        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::updateErcMessages);
+        connect(&mProject.getCircuit(), &Circuit::componentAdded, this, &Board::scheduleErcMessagesUpdate);
+        connect(&mProject.getCircuit(), &Circuit::componentRemoved, this, &Board::scheduleErcMessagesUpdate);
+
+        connectClearanceMatrixInvalidation();
 
         if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
     }
@@ -345,6 +365,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
         mGridProperties.reset();
         mLayerStack.reset();
         mFile.reset();
+        mPlaneFragmentsCache.reset();
         mGraphicsScene.reset();
         throw; // ...and rethrow the exception
     }
@@ -354,6 +375,7 @@ Board::~Board() noexcept
 {
     Q_ASSERT(!mIsAddedToProject);
 
+    mProject.getErcMsgList().unscheduleUpdate(*this);
     qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
 
     // delete all items
@@ -371,6 +393,9 @@ Board::~Board() noexcept
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mPlaneFragmentsCache.reset();
+    mStatistics.reset();
+    mClipperPathCache.reset();
     mGraphicsScene.reset();
 }
 
@@ -388,6 +413,16 @@ bool Board::isEmpty() const noexcept
             mHoles.isEmpty());
 }
 
+const BoardClearanceMatrix& Board::getClearanceMatrix() const noexcept
+{
+    // the design rules are modified by assignment, so check if they have changed
+    if ((!mClearanceMatrix) ||
+        (mClearanceMatrix->getMinClearance() != mDesignRules->getCopperClearance())) {
+        mClearanceMatrix.reset(new BoardClearanceMatrix(*this));
+    }
+    return *mClearanceMatrix;
+}
+
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 {
     QPointF scenePosPx = pos.toPxQPointF();
@@ -567,7 +602,7 @@ void Board::addDeviceInstance(BI_Device& instance)
     // add to board
     instance.addToBoard(); // can throw
     mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     emit deviceAdded(instance);
 }
 
@@ -579,7 +614,7 @@ void Board::removeDeviceInstance(BI_Device& instance)
     // remove from board
     instance.removeFromBoard(); // can throw
     mDeviceInstances.remove(instance.getComponentInstanceUuid());
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     emit deviceRemoved(instance);
 }
 
@@ -654,8 +689,34 @@ void Board::rebuildAllPlanes() noexcept
     qSort(planes.begin(), planes.end(),
           [](const BI_Plane* p1, const BI_Plane* p2)
           {return !(*p1 < *p2);}); // sort by priority (highest priority first)
+    BoardPlaneFragmentsCache::BoardInputHashes boardInputHashes;
     foreach (BI_Plane* plane, planes) {
-        plane->rebuild();
+        plane->rebuild(boardInputHashes);
+    }
+}
+
+void Board::restorePlanesFromCache() noexcept
+{
+    QList<BI_Plane*> planes = mPlanes;
+    qSort(planes.begin(), planes.end(),
+          [](const BI_Plane* p1, const BI_Plane* p2)
+          {return !(*p1 < *p2);}); // sort by priority (highest priority first)
+    QSet<QString> outdatedLayers;
+    BoardPlaneFragmentsCache::BoardInputHashes boardInputHashes;
+    foreach (BI_Plane* plane, planes) {
+        // if a plane with higher priority is outdated, all planes with lower priority
+        // on the same layer are outdated too
+        if (outdatedLayers.contains(plane->getLayerName())
+            || (!mPlaneFragmentsCache->restore(*plane, boardInputHashes)))
+        {
+            outdatedLayers.insert(plane->getLayerName());
+            mPlanesScheduledForRebuild.insert(plane);
+        }
+    }
+    if (!mPlanesScheduledForRebuild.isEmpty()) {
+        // rebuild outdated planes as soon as the event loop is running again to not
+        // block opening the project
+        QMetaObject::invokeMethod(this, "rebuildScheduledPlanes", Qt::QueuedConnection);
     }
 }
 
@@ -824,7 +885,7 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
     {
         if (mIsAddedToProject)
         {
-            SExpression doc(serializeToDomElement("librepcb_board"));
+            SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_board"));
             mFile->save(doc, toOriginal);
         }
         else
@@ -843,6 +904,13 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
         success = false;
     }
 
+    // save plane fragments cache (it's optional, so errors are ignored)
+    if (mIsAddedToProject) {
+        mPlaneFragmentsCache->save(toOriginal);
+    } else {
+        mPlaneFragmentsCache->remove(toOriginal);
+    }
+
     return success;
 }
 
@@ -855,44 +923,46 @@ void Board::setSelectionRect(const Point& p1, const Point& p2, bool updateItems)
 {
     mGraphicsScene->setSelectionRect(p1, p2);
     if (updateItems) {
+        // the items don't change while drawing the selection rectangle, so their grab
+        // areas are determined only once
+        if (!mSelectionIndex) buildSelectionIndex();
         QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+        QSet<BI_Base*> items = mSelectionIndex->query(rectPx);
+
+        // only modify items whose selection state has changed to avoid repainting them
+        auto select = [&items](BI_Base* item, bool forceSelected) {
+            bool selected = forceSelected || items.contains(item);
+            if (item->isSelected() != selected) item->setSelected(selected);
+        };
         foreach (BI_Device* component, mDeviceInstances) {
             BI_Footprint& footprint = component->getFootprint();
-            bool selectFootprint = footprint.isSelectable() && footprint.getGrabAreaScenePx().intersects(rectPx);
-            footprint.setSelected(selectFootprint);
+            bool selectFootprint = items.contains(&footprint);
+            select(&footprint, false);
             foreach (BI_FootprintPad* pad, footprint.getPads()) {
-                bool selectPad = pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-                pad->setSelected(selectFootprint || selectPad);
+                select(pad, selectFootprint);
             }
             foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-                bool selectText = text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-                text->setSelected(selectFootprint || selectText);
+                select(text, selectFootprint);
             }
         }
         foreach (BI_NetSegment* segment, mNetSegments) {
-            segment->setSelectionRect(rectPx);
-        }
-        foreach (BI_Plane* plane, mPlanes) {
-            bool select = plane->isSelectable() && plane->getGrabAreaScenePx().intersects(rectPx);
-            plane->setSelected(select);
-        }
-        foreach (BI_Polygon* polygon, mPolygons) {
-            bool select = polygon->isSelectable() && polygon->getGrabAreaScenePx().intersects(rectPx);
-            polygon->setSelected(select);
-        }
-        foreach (BI_StrokeText* text, mStrokeTexts) {
-            bool select = text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-            text->setSelected(select);
-        }
-        foreach (BI_Hole* hole, mHoles) {
-            bool select = hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
-            hole->setSelected(select);
+            foreach (BI_Via* via, segment->getVias()) select(via, false);
+            foreach (BI_NetPoint* netpoint, segment->getNetPoints()) select(netpoint, false);
+            foreach (BI_NetLine* netline, segment->getNetLines()) select(netline, false);
         }
+        foreach (BI_Plane* plane, mPlanes) select(plane, false);
+        foreach (BI_Polygon* polygon, mPolygons) select(polygon, false);
+        foreach (BI_StrokeText* text, mStrokeTexts) select(text, false);
+        foreach (BI_Hole* hole, mHoles) select(hole, false);
+    } else {
+        mSelectionIndex.reset(); // selection rectangle finished
     }
 }
 
 void Board::clearSelection() const noexcept
 {
+    mSelectionIndex.reset(); // items may have been modified since the last selection
+
     foreach (BI_Device* device, mDeviceInstances)
         device->getFootprint().setSelected(false);
     foreach (BI_NetSegment* segment, mNetSegments) {
@@ -937,10 +1007,65 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const noe
     return QVector<const AttributeProvider*>{&mProject};
 }
 
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void Board::rebuildScheduledPlanes() noexcept
+{
+    QList<BI_Plane*> planes = mPlanes;
+    qSort(planes.begin(), planes.end(),
+          [](const BI_Plane* p1, const BI_Plane* p2)
+          {return !(*p1 < *p2);}); // sort by priority (highest priority first)
+    BoardPlaneFragmentsCache::BoardInputHashes boardInputHashes;
+    foreach (BI_Plane* plane, planes) {
+        if (mPlanesScheduledForRebuild.contains(plane)) {
+            plane->rebuild(boardInputHashes);
+        }
+    }
+    mPlanesScheduledForRebuild.clear();
+    triggerAirWiresRebuild();
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void Board::buildSelectionIndex() const noexcept
+{
+    mSelectionIndex.reset(new RectSelectionIndex<BI_Base*>());
+    auto add = [this](BI_Base* item) {
+        if (item->isSelectable()) {
+            mSelectionIndex->add(item, item->getGrabAreaScenePx());
+        }
+    };
+    foreach (BI_Device* component, mDeviceInstances) {
+        BI_Footprint& footprint = component->getFootprint();
+        add(&footprint);
+        foreach (BI_FootprintPad* pad, footprint.getPads()) add(pad);
+        foreach (BI_StrokeText* text, footprint.getStrokeTexts()) add(text);
+    }
+    foreach (BI_NetSegment* segment, mNetSegments) {
+        foreach (BI_Via* via, segment->getVias()) add(via);
+        foreach (BI_NetPoint* netpoint, segment->getNetPoints()) add(netpoint);
+        foreach (BI_NetLine* netline, segment->getNetLines()) add(netline);
+    }
+    foreach (BI_Plane* plane, mPlanes) add(plane);
+    foreach (BI_Polygon* polygon, mPolygons) add(polygon);
+    foreach (BI_StrokeText* text, mStrokeTexts) add(text);
+    foreach (BI_Hole* hole, mHoles) add(hole);
+    mSelectionIndex->build();
+}
+
+void Board::connectClearanceMatrixInvalidation() noexcept
+{
+    // the clearance matrix needs to be rebuilt when netclasses are modified
+    auto invalidate = [this](){mClearanceMatrix.reset();};
+    connect(&mProject.getCircuit(), &Circuit::netClassAdded, this, invalidate);
+    connect(&mProject.getCircuit(), &Circuit::netClassRemoved, this, invalidate);
+    connect(&mProject.getCircuit(), &Circuit::netClassRulesChanged, this, invalidate);
+}
+
 void Board::updateIcon() noexcept
 {
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
@@ -967,10 +1092,10 @@ void Board::serialize(SExpression& root) const
     root.appendToken(mUuid);
     root.appendStringChild("name", mName, true);
     root.appendStringChild("default_font", mDefaultFontFileName, true);
-    root.appendChild(mGridProperties->serializeToDomElement("grid"), true);
-    root.appendChild(mLayerStack->serializeToDomElement("layers"), true);
-    root.appendChild(mDesignRules->serializeToDomElement("design_rules"), true);
-    root.appendChild(mFabricationOutputSettings->serializeToDomElement("fabrication_output_settings"), true);
+    root.appendChild(serializeToDomElement(*mGridProperties, "grid"), true);
+    root.appendChild(serializeToDomElement(*mLayerStack, "layers"), true);
+    root.appendChild(serializeToDomElement(*mDesignRules, "design_rules"), true);
+    root.appendChild(serializeToDomElement(*mFabricationOutputSettings, "fabrication_output_settings"), true);
     root.appendLineBreak();
     serializePointerContainer(root, mDeviceInstances, "device");
     root.appendLineBreak();
@@ -986,6 +1111,13 @@ void Board::serialize(SExpression& root) const
     root.appendLineBreak();
 }
 
+void Board::scheduleErcMessagesUpdate() noexcept
+{
+    // evaluating all component instances is O(n), so avoid doing it on every single
+    // added device or component (e.g. when placing many components at once)
+    mProject.getErcMsgList().scheduleUpdate(*this, [this](){updateErcMessages();});
+}
+
 void Board::updateErcMessages() noexcept
 {
     // type: UnplacedComponent (ComponentInstances without DeviceInstance)
@@ -27,6 +27,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/attributes/attributeprovider.h>
+#include <librepcb/common/attributes/attributesubstitutioncache.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/fileio/filepath.h>
@@ -45,11 +46,15 @@ class GraphicsScene;
 class SmartSExprFile;
 class GraphicsLayer;
 class BoardDesignRules;
+class ClipperPathCache;
+template <typename T> class RectSelectionIndex;
 
 namespace project {
 
 class NetSignal;
 class Project;
+class BoardClearanceMatrix;
+class BoardStatistics;
 class BI_Device;
 class BI_Base;
 class BI_FootprintPad;
@@ -65,6 +70,7 @@ class BI_AirWire;
 class BoardLayerStack;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
+class BoardPlaneFragmentsCache;
 class BoardSelectionQuery;
 
 /*****************************************************************************************
@@ -127,6 +133,10 @@ class Board final : public QObject, public AttributeProvider,
         const BoardDesignRules& getDesignRules() const noexcept {return *mDesignRules;}
         BoardFabricationOutputSettings& getFabricationOutputSettings() noexcept {return *mFabricationOutputSettings;}
         const BoardFabricationOutputSettings& getFabricationOutputSettings() const noexcept {return *mFabricationOutputSettings;}
+        const BoardClearanceMatrix& getClearanceMatrix() const noexcept;
+        ClipperPathCache& getClipperPathCache() const noexcept {return *mClipperPathCache;}
+        BoardStatistics& getStatistics() noexcept {return *mStatistics;}
+        const BoardStatistics& getStatistics() const noexcept {return *mStatistics;}
         bool isEmpty() const noexcept;
         QList<BI_Base*> getItemsAtScenePos(const Point& pos) const noexcept;
         QList<BI_Via*> getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept;
@@ -202,6 +212,11 @@ class Board final : public QObject, public AttributeProvider,
         /// @copydoc librepcb::AttributeProvider::getAttributeProviderParents()
         QVector<const AttributeProvider*> getAttributeProviderParents() const noexcept override;
 
+        /// @copydoc librepcb::AttributeProvider::getAttributeSubstitutionCache()
+        AttributeSubstitutionCache* getAttributeSubstitutionCache() const noexcept override {
+            return &mAttributeSubstitutionCache;
+        }
+
         // Operator Overloadings
         Board& operator=(const Board& rhs) = delete;
         bool operator==(const Board& rhs) noexcept {return (this == &rhs);}
@@ -221,13 +236,22 @@ class Board final : public QObject, public AttributeProvider,
         void deviceRemoved(BI_Device& comp);
 
 
+    private slots:
+
+        void rebuildScheduledPlanes() noexcept;
+
+
     private:
 
         Board(Project& project, const FilePath& filepath, bool restore,
               bool readOnly, bool create, const QString& newName);
+        void connectClearanceMatrixInvalidation() noexcept;
         void updateIcon() noexcept;
         bool checkAttributesValidity() const noexcept;
+        void restorePlanesFromCache() noexcept;
+        void scheduleErcMessagesUpdate() noexcept;
         void updateErcMessages() noexcept;
+        void buildSelectionIndex() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
@@ -238,6 +262,7 @@ class Board final : public QObject, public AttributeProvider,
         FilePath mFilePath; ///< the filepath of the board *.lp file (from the ctor)
         QScopedPointer<SmartSExprFile> mFile;
         bool mIsAddedToProject;
+        mutable AttributeSubstitutionCache mAttributeSubstitutionCache;
 
         QScopedPointer<GraphicsScene> mGraphicsScene;
         QScopedPointer<BoardLayerStack> mLayerStack;
@@ -245,8 +270,14 @@ class Board final : public QObject, public AttributeProvider,
         QScopedPointer<BoardDesignRules> mDesignRules;
         QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
         QScopedPointer<BoardUserSettings> mUserSettings;
+        QScopedPointer<BoardPlaneFragmentsCache> mPlaneFragmentsCache;
+        QScopedPointer<ClipperPathCache> mClipperPathCache; ///< thread-safe, shared by all planes
+        QScopedPointer<BoardStatistics> mStatistics;
         QRectF mViewRect;
         QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+        QSet<BI_Plane*> mPlanesScheduledForRebuild;
+        mutable std::unique_ptr<RectSelectionIndex<BI_Base*>> mSelectionIndex; ///< only valid while drawing a selection rectangle
+        mutable QScopedPointer<BoardClearanceMatrix> mClearanceMatrix; ///< lazily built, reset when netclasses change
 
         // Attributes
         Uuid mUuid;
@@ -21,12 +21,10 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
-#include <unordered_map>
 #include "boardairwiresbuilder.h"
 #include "board.h"
 #include "items/bi_netsegment.h"
 #include "items/bi_netpoint.h"
-#include "items/bi_netline.h"
 #include "items/bi_footprintpad.h"
 #include "items/bi_via.h"
 #include "items/bi_plane.h"
@@ -35,6 +33,7 @@
 #include "../circuit/netsignal.h"
 #include "../circuit/componentsignalinstance.h"
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/unionfind.h>
 #include <librepcb/library/pkg/footprintpad.h>
 #include <delaunay-triangulation/delaunay.h>
 
@@ -44,102 +43,34 @@
 namespace librepcb {
 namespace project {
 
-// adapted from horizon/kicad
 static QVector<QPair<Point, Point>> kruskalMst(
         std::vector<delaunay::Edge<qreal>>& aEdges,
-        std::vector<delaunay::Vector2<qreal>>& aNodes) noexcept
+        const std::vector<delaunay::Vector2<qreal>>& aNodes) noexcept
 {
-    unsigned int nodeNumber = aNodes.size();
-    unsigned int mstExpectedSize = nodeNumber - 1;
-    unsigned int mstSize = 0;
-    bool ratsnestLines = false;
-
-    // printf("mst nodes : %d edges : %d\n", aNodes.size(), aEdges.size () );
     // The output
     QVector<QPair<Point, Point>> mst;
 
-    // Set tags for marking cycles
-    std::unordered_map<int, int> tags;
-    unsigned int tag = 0;
-
-    for (auto &node : aNodes) {
-        node.tag = tag;
-        tags[node.id] = tag++;
+    // Groups of nodes connected together, used to detect cycles in the graph
+    UnionFind<int> groups;
+    for (const auto& node : aNodes) {
+        groups.add(node.id);
     }
 
-    // Lists of nodes connected together (subtrees) to detect cycles in the
-    // graph
-    std::vector<std::list<int>> cycles(nodeNumber);
-
-    for (unsigned int i = 0; i < nodeNumber; ++i)
-        cycles[i].push_back(i);
-
-    // Kruskal algorithm requires edges to be sorted by their weight
+    // Kruskal algorithm requires edges to be sorted by their weight. Edges of already
+    // connected items have a negative weight, so they are processed first and only
+    // merge groups without creating airwires.
     std::sort(aEdges.begin(), aEdges.end(),
         [](const delaunay::Edge<qreal> &a, const delaunay::Edge<qreal> &b) {
-            return a.weight > b.weight;
+            return a.weight < b.weight;
         });
 
-    while (mstSize < mstExpectedSize && !aEdges.empty()) {
-        auto &dt = aEdges.back();
-
-        int srcTag = tags[dt.p1.id];
-        int trgTag = tags[dt.p2.id];
-        // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-        // dt.weight, srcTag, trgTag);
-
-        // Check if by adding this edge we are going to join two different
-        // forests
-        if (srcTag != trgTag) {
-            // Because edges are sorted by their weight, first we always process
-            // connected
-            // items (weight == 0). Once we stumble upon an edge with non-zero
-            // weight,
-            // it means that the rest of the lines are ratsnest.
-            if (!ratsnestLines && dt.weight >= 0)
-                ratsnestLines = true;
-
-            // Update tags
-            if (ratsnestLines) {
-                for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it) {
-                    tags[aNodes[*it].id] = srcTag;
-                }
-
-                // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-                // RN_EDGE,
-                // RN_EDGE_MST saves both source and target node and does not
-                // require any other
-                // edges to exist for getting source/target nodes
-                // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-                // dt.GetWeight() );
-
-                // assert( newEdge.GetSourceNode()->GetTag() !=
-                // newEdge.GetTargetNode()->GetTag() );
-                // assert(dt.p1.tag != dt.p2.tag);
-                mst.append(qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
-                ++mstSize;
-            }
-            else {
-                // for( it = cycles[trgTag].begin(), itEnd =
-                // cycles[trgTag].end(); it != itEnd; ++it )
-                // for( auto it : cycles[trgTag] )
-                for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it) {
-                    tags[aNodes[*it].id] = srcTag;
-                    aNodes[*it].tag = srcTag;
-                }
-
-                // Processing a connection, decrease the expected size of the
-                // ratsnest MST
-                --mstExpectedSize;
-            }
-
-            // Move nodes that were marked with old tag to the list marked with
-            // the new tag
-            cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
+    for (const auto& edge : aEdges) {
+        if (groups.getGroupCount() <= 1) {
+            break; // all nodes are connected together
+        }
+        if (groups.unite(edge.p1.id, edge.p2.id) && (edge.weight >= 0)) {
+            mst.append(qMakePair(Point(edge.p1.x, edge.p1.y), Point(edge.p2.x, edge.p2.y)));
         }
-
-        // Remove the edge that was just processed
-        aEdges.pop_back();
     }
 
     return mst;
@@ -166,8 +97,6 @@ QVector<QPair<Point, Point> > BoardAirWiresBuilder::buildAirWires() const
 {
     std::vector<delaunay::Vector2<qreal>> points;
     QHash<const BI_FootprintPad*, int> padMap;
-    QHash<const BI_Via*, int> viaMap;
-    QHash<const BI_NetPoint*, int> netPointMap;
     QHash<int, QString> layerMap;
     std::vector<delaunay::Edge<qreal>> edges;
 
@@ -187,36 +116,37 @@ QVector<QPair<Point, Point> > BoardAirWiresBuilder::buildAirWires() const
         }
     }
 
-    // vias, netpoints, netlines
+    // vias and netpoints, with the connections within their netsegment
     foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) { Q_ASSERT(netsegment);
         if (&netsegment->getBoard() != &mBoard) continue;
+        QHash<const BI_Base*, int> itemMap;
         foreach (const BI_Via* via, netsegment->getVias()) { Q_ASSERT(via);
             int id = points.size();
             Point pos = via->getPosition();
             points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-            viaMap[via] = id;
+            itemMap[via] = id;
             layerMap[id] = QString(); // on all layers
         }
         foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) { Q_ASSERT(netpoint);
             int id = points.size();
             Point pos = netpoint->getPosition();
             points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-            netPointMap[netpoint] = id;
+            itemMap[netpoint] = id;
             layerMap[id] = netpoint->getLayer().getName();
-            if (const BI_Via* via = netpoint->getVia()) {
-                Q_ASSERT(viaMap.contains(via));
-                edges.emplace_back(points[id], points[viaMap[via]], -1);
-            }
             if (const BI_FootprintPad* pad = netpoint->getFootprintPad()) {
                 Q_ASSERT(padMap.contains(pad));
                 edges.emplace_back(points[id], points[padMap[pad]], -1);
             }
         }
-        foreach (const BI_NetLine* netline, netsegment->getNetLines()) { Q_ASSERT(netline);
-            Q_ASSERT(netPointMap.contains(&netline->getStartPoint()));
-            Q_ASSERT(netPointMap.contains(&netline->getEndPoint()));
-            edges.emplace_back(points[netPointMap[&netline->getStartPoint()]],
-                               points[netPointMap[&netline->getEndPoint()]], -1);
+        // one chain of edges per group of connected items is enough to let the
+        // Kruskal algorithm merge them
+        foreach (const QList<const BI_Base*>& group,
+                 netsegment->getConnectivity().getGroups()) {
+            for (int i = 1; i < group.count(); ++i) {
+                Q_ASSERT(itemMap.contains(group.at(i - 1)) && itemMap.contains(group.at(i)));
+                edges.emplace_back(points[itemMap[group.at(i - 1)]],
+                                   points[itemMap[group.at(i)]], -1);
+            }
         }
     }
 
@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardclearancematrix.h"
+#include <librepcb/common/boarddesignrules.h>
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include "board.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardClearanceMatrix::BoardClearanceMatrix() noexcept :
+    mSize(1), mMinClearance(0), mMaxClearance(0), mNetClassClearances(1, 0),
+    mClearances(1, 0)
+{
+}
+
+BoardClearanceMatrix::BoardClearanceMatrix(const Board& board) noexcept :
+    mSize(0), mMinClearance(board.getDesignRules().getCopperClearance()),
+    mMaxClearance(mMinClearance)
+{
+    // index 0 is for objects without netclass
+    QVector<LengthBase_t> classClearances(1, 0);
+    foreach (const NetClass* netclass, board.getProject().getCircuit().getNetClasses()) {
+        mIndices.insert(netclass, classClearances.count());
+        classClearances.append(netclass->getClearance().toNm());
+    }
+
+    mSize = classClearances.count();
+    mNetClassClearances.resize(mSize * mSize);
+    mClearances.resize(mSize * mSize);
+    for (int i = 0; i < mSize; ++i) {
+        for (int k = 0; k < mSize; ++k) {
+            LengthBase_t clearance = qMax(classClearances.at(i), classClearances.at(k));
+            mNetClassClearances[i * mSize + k] = clearance;
+            mClearances[i * mSize + k] = qMax(clearance, mMinClearance.toNm());
+            mMaxClearance = qMax(mMaxClearance, Length(mClearances.at(i * mSize + k)));
+        }
+    }
+}
+
+BoardClearanceMatrix::~BoardClearanceMatrix() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+int BoardClearanceMatrix::getIndex(const NetSignal* netsignal) const noexcept
+{
+    return netsignal ? getIndex(&netsignal->getNetClass()) : 0;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDCLEARANCEMATRIX_H
+#define LIBREPCB_PROJECT_BOARDCLEARANCEMATRIX_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetClass;
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BoardClearanceMatrix
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardClearanceMatrix class contains the required copper clearance between
+ *        all pairs of netclasses of a board
+ *
+ * Every netclass gets an index, and the clearances for all pairs of indices are
+ * precalculated into a flat N×N array. Algorithms which check many pairs of objects
+ * (e.g. plane fill or the trace router) determine the index of each object once with
+ * #getIndex() and then only need an array lookup per pair.
+ *
+ * The index 0 is reserved for objects without a net (e.g. holes). The clearance between
+ * two netclasses is the larger one of their clearances, and #getClearance() additionally
+ * takes the global copper clearance of the board design rules into account.
+ *
+ * @note The matrix is a snapshot, so it needs to be rebuilt when netclasses or design
+ *       rules are modified. Use librepcb::project::Board::getClearanceMatrix() to get an
+ *       up-to-date matrix.
+ */
+class BoardClearanceMatrix final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardClearanceMatrix() noexcept;
+        BoardClearanceMatrix(const BoardClearanceMatrix& other) = default;
+        explicit BoardClearanceMatrix(const Board& board) noexcept;
+        ~BoardClearanceMatrix() noexcept;
+
+        // Getters
+        int getSize() const noexcept {return mSize;}
+        const Length& getMinClearance() const noexcept {return mMinClearance;}
+        const Length& getMaxClearance() const noexcept {return mMaxClearance;}
+
+        /**
+         * @brief Get the index of a netclass (0 for `nullptr` or unknown netclasses)
+         */
+        int getIndex(const NetClass* netclass) const noexcept {
+            return mIndices.value(netclass, 0);
+        }
+
+        /**
+         * @brief Get the index of the netclass of a net signal (0 for `nullptr`)
+         */
+        int getIndex(const NetSignal* netsignal) const noexcept;
+
+        /**
+         * @brief Get the clearance required by the netclasses only
+         *
+         * This does not include the global copper clearance, so callers can combine it
+         * with their own minimum (e.g. the clearance of a plane).
+         */
+        Length getNetClassClearance(int index1, int index2) const noexcept {
+            return Length(mNetClassClearances[index1 * mSize + index2]);
+        }
+
+        /**
+         * @brief Get the clearance between two objects, including the global clearance
+         */
+        Length getClearance(int index1, int index2) const noexcept {
+            return Length(mClearances[index1 * mSize + index2]);
+        }
+
+        // Operator Overloadings
+        BoardClearanceMatrix& operator=(const BoardClearanceMatrix& rhs) = default;
+
+
+    private: // Data
+        int mSize;
+        Length mMinClearance;
+        Length mMaxClearance;
+        QHash<const NetClass*, int> mIndices;
+        QVector<LengthBase_t> mNetClassClearances;  ///< mSize × mSize, row by row
+        QVector<LengthBase_t> mClearances;          ///< mSize × mSize, row by row
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDCLEARANCEMATRIX_H
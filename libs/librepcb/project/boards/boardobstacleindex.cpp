@@ -0,0 +1,384 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardobstacleindex.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clipperpathcache.h>
+#include <librepcb/common/utils/geometrykernel.h>
+#include <librepcb/library/pkg/footprint.h>
+#include "board.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+#include "items/bi_hole.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Helper Functions
+ ****************************************************************************************/
+
+static const Length sMaxArcTolerance(5000);
+
+static QVector<Point> toPoints(const ClipperLib::Path& path) noexcept
+{
+    QVector<Point> points;
+    points.reserve(path.size());
+    for (const ClipperLib::IntPoint& p : path) {
+        points.append(ClipperHelpers::convert(p));
+    }
+    return points;
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardObstacleIndex::BoardObstacleIndex(Board& board) noexcept :
+    mBoard(board), mCurrentStamp(0)
+{
+    rebuild();
+}
+
+BoardObstacleIndex::~BoardObstacleIndex() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+Length BoardObstacleIndex::getClearance(const NetSignal* net1,
+                                        const NetSignal* net2) const noexcept
+{
+    return mClearanceMatrix.getClearance(mClearanceMatrix.getIndex(net1),
+                                         mClearanceMatrix.getIndex(net2));
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardObstacleIndex::rebuild() noexcept
+{
+    mObstacles.clear();
+    mFreeIds.clear();
+    mItemObstacles.clear();
+    mNetSegmentItems.clear();
+    mGrids.clear();
+    mVisitedStamps.clear();
+    mCurrentStamp = 0;
+    mClearanceMatrix = mBoard.getClearanceMatrix();
+
+    mCopperLayers.clear();
+    foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+        if (layer->isCopperLayer() && layer->isEnabled()) {
+            mCopperLayers.append(layer->getName());
+        }
+    }
+
+    // pads and holes of devices
+    foreach (BI_Device* device, mBoard.getDeviceInstances()) {
+        for (const Hole& hole : device->getFootprint().getLibFootprint().getHoles()) {
+            Point pos = device->getFootprint().mapToScene(hole.getPosition());
+            addObstacleOnAllLayers(*device, nullptr, {pos}, hole.getDiameter() / 2, false);
+        }
+        foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            QVector<Point> outline = toPoints(mBoard.getClipperPathCache().convert(
+                pad->getOutline(Length(0)), sMaxArcTolerance, pad->getRotation(),
+                pad->getPosition()));
+            foreach (const QString& layerName, mCopperLayers) {
+                if (pad->isOnLayer(layerName)) {
+                    addObstacle(*pad, pad->getCompSigInstNetSignal(), layerName, outline,
+                                Length(0), true);
+                }
+            }
+        }
+    }
+
+    // board holes
+    foreach (BI_Hole* hole, mBoard.getHoles()) {
+        addObstacleOnAllLayers(*hole, nullptr, {hole->getHole().getPosition()},
+                               hole->getHole().getDiameter() / 2, false);
+    }
+
+    // copper polygons
+    foreach (BI_Polygon* polygon, mBoard.getPolygons()) {
+        const Polygon& p = polygon->getPolygon();
+        if (!mCopperLayers.contains(p.getLayerName())) continue;
+        QVector<Point> points = toPoints(ClipperHelpers::convert(p.getPath(),
+                                                                 sMaxArcTolerance));
+        if (points.isEmpty()) continue;
+        bool filled = p.isFilled() && p.getPath().isClosed();
+        if (p.getPath().isClosed() && (!filled)) {
+            points.append(points.first()); // the outline needs to be a closed polyline
+        }
+        addObstacle(*polygon, nullptr, p.getLayerName(), points, p.getLineWidth() / 2,
+                    filled);
+    }
+
+    // vias and netlines
+    foreach (BI_NetSegment* segment, mBoard.getNetSegments()) {
+        addNetSegment(*segment);
+    }
+}
+
+void BoardObstacleIndex::updateNetSegment(BI_NetSegment& segment) noexcept
+{
+    removeItem(segment);
+    if (mBoard.getNetSegments().contains(&segment)) {
+        addNetSegment(segment);
+    }
+}
+
+void BoardObstacleIndex::removeItem(const BI_Base& item) noexcept
+{
+    foreach (const BI_Base* child, mNetSegmentItems.take(&item)) {
+        removeItem(*child);
+    }
+    foreach (int id, mItemObstacles.take(&item)) {
+        Obstacle& obstacle = mObstacles[id];
+        QHash<qint64, QVector<int>>& grid = mGrids[obstacle.layerName];
+        qint64 x1, y1, x2, y2;
+        getCellRange(obstacle.boundsMin, obstacle.boundsMax, x1, y1, x2, y2);
+        for (qint64 y = y1; y <= y2; ++y) {
+            for (qint64 x = x1; x <= x2; ++x) {
+                auto it = grid.find(cellKey(x, y));
+                if (it != grid.end()) {
+                    it->removeOne(id);
+                    if (it->isEmpty()) grid.erase(it);
+                }
+            }
+        }
+        obstacle.item = nullptr;
+        obstacle.points.clear();
+        mFreeIds.append(id);
+    }
+}
+
+QVector<int> BoardObstacleIndex::findCollisions(const QString& layerName,
+    const Point& p1, const Point& p2, const Length& width, const NetSignal* netSignal,
+    const QSet<int>& ignore) const noexcept
+{
+    QVector<int> result;
+    auto gridIt = mGrids.constFind(layerName);
+    if (gridIt == mGrids.constEnd()) return result;
+    const QHash<qint64, QVector<int>>& grid = *gridIt;
+
+    // determine the netclass only once, then the clearances are simple lookups
+    int netClassIndex = mClearanceMatrix.getIndex(netSignal);
+
+    // the bounds of the obstacles already include their radius
+    Length margin = width / 2 + getMaxClearance();
+    Point min(qMin(p1.getX(), p2.getX()) - margin, qMin(p1.getY(), p2.getY()) - margin);
+    Point max(qMax(p1.getX(), p2.getX()) + margin, qMax(p1.getY(), p2.getY()) + margin);
+
+    // avoid checking obstacles multiple times if they span several cells
+    if (mVisitedStamps.count() < mObstacles.count()) {
+        mVisitedStamps.resize(mObstacles.count());
+    }
+    if (++mCurrentStamp == 0) {
+        mVisitedStamps.fill(0);
+        mCurrentStamp = 1;
+    }
+
+    qint64 x1, y1, x2, y2;
+    getCellRange(min, max, x1, y1, x2, y2);
+    for (qint64 y = y1; y <= y2; ++y) {
+        for (qint64 x = x1; x <= x2; ++x) {
+            auto cellIt = grid.constFind(cellKey(x, y));
+            if (cellIt == grid.constEnd()) continue;
+            foreach (int id, *cellIt) {
+                if (mVisitedStamps.at(id) == mCurrentStamp) continue;
+                mVisitedStamps[id] = mCurrentStamp;
+                if (ignore.contains(id)) continue;
+                const Obstacle& obstacle = mObstacles.at(id);
+                if (netSignal && (obstacle.netSignal == netSignal)) continue;
+                if ((obstacle.boundsMax.getX() < min.getX())
+                    || (obstacle.boundsMin.getX() > max.getX())
+                    || (obstacle.boundsMax.getY() < min.getY())
+                    || (obstacle.boundsMin.getY() > max.getY())) continue;
+                if (collides(obstacle, p1, p2, width, netClassIndex)) {
+                    result.append(id);
+                }
+            }
+        }
+    }
+
+    // the nearest obstacle first, since it is the first one to walk around
+    auto distance = [&](int id) {
+        const Obstacle& o = mObstacles.at(id);
+        return ((o.boundsMin + o.boundsMax) / 2 - p1).getLength();
+    };
+    std::sort(result.begin(), result.end(),
+              [&](int a, int b) {return distance(a) < distance(b);});
+    return result;
+}
+
+Length BoardObstacleIndex::getRequiredDistance(const Obstacle& obstacle,
+    const Length& width, const NetSignal* netSignal) const noexcept
+{
+    return width / 2 + obstacle.radius + mClearanceMatrix.getClearance(
+        mClearanceMatrix.getIndex(netSignal), obstacle.netClassIndex);
+}
+
+bool BoardObstacleIndex::collides(const Obstacle& obstacle, const Point& p1,
+    const Point& p2, const Length& width, const NetSignal* netSignal) const noexcept
+{
+    return collides(obstacle, p1, p2, width, mClearanceMatrix.getIndex(netSignal));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool BoardObstacleIndex::collides(const Obstacle& obstacle, const Point& p1,
+    const Point& p2, const Length& width, int netClassIndex) const noexcept
+{
+    if (obstacle.points.isEmpty()) return false;
+    qreal need = (width / 2 + obstacle.radius + mClearanceMatrix.getClearance(
+                  netClassIndex, obstacle.netClassIndex)).toNm();
+    qreal needSq = need * need;
+    const QVector<Point>& pts = obstacle.points;
+    if (pts.count() == 1) {
+        return GeometryKernel::squaredDistanceBetweenSegments(p1, p2, pts.first(),
+                                                              pts.first()) < needSq;
+    }
+    int edges = obstacle.filled ? pts.count() : pts.count() - 1;
+    for (int i = 0; i < edges; ++i) {
+        const Point& a = pts.at(i);
+        const Point& b = pts.at((i + 1) % pts.count());
+        if (GeometryKernel::squaredDistanceBetweenSegments(p1, p2, a, b) < needSq) {
+            return true;
+        }
+    }
+    // a segment completely inside a filled polygon does not come close to its edges
+    return obstacle.filled && isInsidePolygon(p1, pts);
+}
+
+void BoardObstacleIndex::addNetSegment(BI_NetSegment& segment) noexcept
+{
+    QList<const BI_Base*>& items = mNetSegmentItems[&segment];
+    const NetSignal* netSignal = &segment.getNetSignal();
+    foreach (BI_Via* via, segment.getVias()) {
+        QVector<Point> outline = toPoints(mBoard.getClipperPathCache().convert(
+            via->getOutline(Length(0)), sMaxArcTolerance, Angle::deg0(),
+            via->getPosition()));
+        addObstacleOnAllLayers(*via, netSignal, outline, Length(0), true);
+        items.append(via);
+    }
+    foreach (BI_NetLine* netline, segment.getNetLines()) {
+        QVector<Point> points = {netline->getStartPoint().getPosition(),
+                                 netline->getEndPoint().getPosition()};
+        addObstacle(*netline, netSignal, netline->getLayer().getName(), points,
+                    netline->getWidth() / 2, false);
+        items.append(netline);
+    }
+}
+
+void BoardObstacleIndex::addObstacle(BI_Base& item, const NetSignal* netSignal,
+    const QString& layerName, const QVector<Point>& points, const Length& radius,
+    bool filled) noexcept
+{
+    if (points.isEmpty()) return;
+    Obstacle obstacle{&item, netSignal, mClearanceMatrix.getIndex(netSignal), layerName,
+                      points, radius, filled, points.first(), points.first()};
+    foreach (const Point& p, points) {
+        obstacle.boundsMin.setX(qMin(obstacle.boundsMin.getX(), p.getX()));
+        obstacle.boundsMin.setY(qMin(obstacle.boundsMin.getY(), p.getY()));
+        obstacle.boundsMax.setX(qMax(obstacle.boundsMax.getX(), p.getX()));
+        obstacle.boundsMax.setY(qMax(obstacle.boundsMax.getY(), p.getY()));
+    }
+    obstacle.boundsMin -= Point(radius, radius);
+    obstacle.boundsMax += Point(radius, radius);
+
+    int id;
+    if (mFreeIds.isEmpty()) {
+        id = mObstacles.count();
+        mObstacles.append(obstacle);
+    } else {
+        id = mFreeIds.takeLast();
+        mObstacles[id] = obstacle;
+    }
+    mItemObstacles[&item].append(id);
+
+    QHash<qint64, QVector<int>>& grid = mGrids[layerName];
+    qint64 x1, y1, x2, y2;
+    getCellRange(obstacle.boundsMin, obstacle.boundsMax, x1, y1, x2, y2);
+    for (qint64 y = y1; y <= y2; ++y) {
+        for (qint64 x = x1; x <= x2; ++x) {
+            grid[cellKey(x, y)].append(id);
+        }
+    }
+}
+
+void BoardObstacleIndex::addObstacleOnAllLayers(BI_Base& item, const NetSignal* netSignal,
+    const QVector<Point>& points, const Length& radius, bool filled) noexcept
+{
+    foreach (const QString& layerName, mCopperLayers) {
+        addObstacle(item, netSignal, layerName, points, radius, filled);
+    }
+}
+
+void BoardObstacleIndex::getCellRange(const Point& min, const Point& max, qint64& x1,
+    qint64& y1, qint64& x2, qint64& y2) const noexcept
+{
+    x1 = qFloor(min.getX().toNm() / qreal(sCellSize));
+    y1 = qFloor(min.getY().toNm() / qreal(sCellSize));
+    x2 = qFloor(max.getX().toNm() / qreal(sCellSize));
+    y2 = qFloor(max.getY().toNm() / qreal(sCellSize));
+}
+
+bool BoardObstacleIndex::isInsidePolygon(const Point& p,
+                                         const QVector<Point>& polygon) noexcept
+{
+    // crossing number test
+    bool inside = false;
+    qreal px = p.getX().toNm(), py = p.getY().toNm();
+    for (int i = 0, j = polygon.count() - 1; i < polygon.count(); j = i++) {
+        qreal xi = polygon.at(i).getX().toNm(), yi = polygon.at(i).getY().toNm();
+        qreal xj = polygon.at(j).getX().toNm(), yj = polygon.at(j).getY().toNm();
+        if (((yi > py) != (yj > py)) && (px < (xj - xi) * (py - yi) / (yj - yi) + xi)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
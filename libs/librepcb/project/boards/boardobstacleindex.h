@@ -0,0 +1,192 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDOBSTACLEINDEX_H
+#define LIBREPCB_PROJECT_BOARDOBSTACLEINDEX_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+#include "boardclearancematrix.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+class BI_Base;
+class BI_NetSegment;
+class BI_NetLine;
+
+/*****************************************************************************************
+ *  Class BoardObstacleIndex
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardObstacleIndex class is a spatial index of all copper objects of a
+ *        board which have to be avoided when drawing traces
+ *
+ * Every copper layer has its own uniform grid containing the bounding rectangles of
+ * the obstacles on that layer (pads, vias, netlines, copper polygons and holes). This
+ * allows to check a trace segment against only the few obstacles in its neighbourhood,
+ * which is fast enough to do it many times on every mouse move.
+ *
+ * Obstacles are stored either as a polyline with a radius (e.g. netlines, unfilled
+ * polygons, holes) or as a filled polygon (pads, vias, filled polygons). Planes are not
+ * obstacles since they are poured around traces anyway.
+ *
+ * The required clearances are looked up in a copy of the board's BoardClearanceMatrix
+ * which is taken by #rebuild(), with the netclass index of every obstacle determined
+ * only once when it is added.
+ *
+ * The index does not observe the board, so it must be updated after modifying items,
+ * e.g. with #updateNetSegment() after committing new traces.
+ *
+ * @note The index is not thread-safe, not even for concurrent read access.
+ */
+class BoardObstacleIndex final
+{
+    public:
+
+        // Types
+        struct Obstacle {
+            BI_Base* item;              ///< the item of the obstacle
+            const NetSignal* netSignal; ///< `nullptr` if the obstacle has no net
+            int netClassIndex;          ///< index in the BoardClearanceMatrix
+            QString layerName;          ///< the copper layer of the obstacle
+            QVector<Point> points;      ///< polyline or polygon (at least one point)
+            Length radius;              ///< the obstacle is inflated by this radius
+            bool filled;                ///< whether the points form a filled polygon
+            Point boundsMin;            ///< bottom left corner of the bounding rectangle
+            Point boundsMax;            ///< top right corner of the bounding rectangle
+        };
+
+        // Constructors / Destructor
+        BoardObstacleIndex() = delete;
+        BoardObstacleIndex(const BoardObstacleIndex& other) = delete;
+        explicit BoardObstacleIndex(Board& board) noexcept;
+        ~BoardObstacleIndex() noexcept;
+
+        // Getters
+        Board& getBoard() const noexcept {return mBoard;}
+        const Obstacle& getObstacle(int id) const noexcept {return mObstacles.at(id);}
+        QVector<int> getObstacleIds(const BI_Base& item) const noexcept {return mItemObstacles.value(&item);}
+        Length getClearance(const NetSignal* net1, const NetSignal* net2) const noexcept;
+        Length getMaxClearance() const noexcept {return mClearanceMatrix.getMaxClearance();}
+
+        // General Methods
+
+        /**
+         * @brief Rebuild the whole index from the current state of the board
+         */
+        void rebuild() noexcept;
+
+        /**
+         * @brief Update all obstacles of a net segment (e.g. after adding netlines)
+         */
+        void updateNetSegment(BI_NetSegment& segment) noexcept;
+
+        /**
+         * @brief Remove all obstacles of an item (e.g. before it gets deleted)
+         *
+         * If the item is a net segment, the obstacles of all its vias and netlines
+         * are removed. The item is not accessed, so it may already be removed from the
+         * board.
+         */
+        void removeItem(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Get all obstacles which are too close to a trace segment
+         *
+         * @param layerName     The copper layer of the trace
+         * @param p1            Start point of the trace
+         * @param p2            End point of the trace
+         * @param width         Width of the trace
+         * @param netSignal     The net of the trace (its obstacles are ignored)
+         * @param ignore        IDs of obstacles to ignore
+         *
+         * @return IDs of all obstacles violating the clearance, sorted by the distance
+         *         of their bounding rectangle center from p1
+         */
+        QVector<int> findCollisions(const QString& layerName, const Point& p1,
+                                    const Point& p2, const Length& width,
+                                    const NetSignal* netSignal,
+                                    const QSet<int>& ignore = QSet<int>()) const noexcept;
+
+        /**
+         * @brief Calculate the distance which a trace segment must keep from the center
+         *        line or area of an obstacle
+         */
+        Length getRequiredDistance(const Obstacle& obstacle, const Length& width,
+                                   const NetSignal* netSignal) const noexcept;
+
+        /**
+         * @brief Check whether a trace segment violates the clearance to an obstacle
+         */
+        bool collides(const Obstacle& obstacle, const Point& p1, const Point& p2,
+                      const Length& width, const NetSignal* netSignal) const noexcept;
+
+        // Operator Overloadings
+        BoardObstacleIndex& operator=(const BoardObstacleIndex& rhs) = delete;
+
+
+    private: // Methods
+        bool collides(const Obstacle& obstacle, const Point& p1, const Point& p2,
+                      const Length& width, int netClassIndex) const noexcept;
+        void addNetSegment(BI_NetSegment& segment) noexcept;
+        void addObstacle(BI_Base& item, const NetSignal* netSignal, const QString& layerName,
+                         const QVector<Point>& points, const Length& radius,
+                         bool filled) noexcept;
+        void addObstacleOnAllLayers(BI_Base& item, const NetSignal* netSignal,
+                                    const QVector<Point>& points, const Length& radius,
+                                    bool filled) noexcept;
+        void getCellRange(const Point& min, const Point& max, qint64& x1, qint64& y1,
+                          qint64& x2, qint64& y2) const noexcept;
+        static qint64 cellKey(qint64 x, qint64 y) noexcept {return (x << 32) ^ (y & 0xFFFFFFFF);}
+        static bool isInsidePolygon(const Point& p, const QVector<Point>& polygon) noexcept;
+
+
+    private: // Data
+        Board& mBoard;
+        BoardClearanceMatrix mClearanceMatrix;
+        QStringList mCopperLayers;
+        QVector<Obstacle> mObstacles;       ///< removed obstacles have no item
+        QVector<int> mFreeIds;              ///< IDs of removed obstacles, to be reused
+        QHash<const BI_Base*, QVector<int>> mItemObstacles;
+        QHash<const BI_Base*, QList<const BI_Base*>> mNetSegmentItems;
+        QHash<QString, QHash<qint64, QVector<int>>> mGrids; ///< key: layer name
+        mutable QVector<quint32> mVisitedStamps;    ///< to avoid checking obstacles twice
+        mutable quint32 mCurrentStamp;
+
+        static constexpr qint64 sCellSize = 2000000; ///< 2mm
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDOBSTACLEINDEX_H
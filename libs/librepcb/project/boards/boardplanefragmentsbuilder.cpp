@@ -24,8 +24,11 @@
 #include "boardplanefragmentsbuilder.h"
 #include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clipperpathcache.h>
+#include <librepcb/common/utils/hatchlattice.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
+#include "board.h"
 #include "items/bi_plane.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
@@ -48,7 +51,9 @@ namespace project {
  ****************************************************************************************/
 
 BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept :
-    mPlane(plane)
+    mPlane(plane), mPathCache(plane.getBoard().getClipperPathCache()),
+    mClearanceMatrix(plane.getBoard().getClearanceMatrix()),
+    mNetClassIndex(mClearanceMatrix.getIndex(&plane.getNetSignal()))
 {
 }
 
@@ -64,11 +69,12 @@ QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept
 {
     try {
         mResult.clear();
+        mThermalGaps.clear();
+        mThermalSpokes.clear();
         addPlaneOutline();
         clipToBoardOutline();
         subtractOtherObjects();
-        ensureMinimumWidth();
-        flattenResult();
+        ensureMinimumWidthAndFlattenResult();
         if (!mPlane.getKeepOrphans()) {
             removeOrphans();
         }
@@ -131,49 +137,51 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects()
         if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
         ClipperLib::Paths paths = ClipperHelpers::convert(plane->getFragments(),
                                                           maxArcTolerance());
-        ClipperHelpers::offset(paths, mPlane.getMinClearance(), maxArcTolerance()); // can throw
+        ClipperHelpers::offset(paths, getClearance(&plane->getNetSignal()),
+                               maxArcTolerance()); // can throw
         c.AddPaths(paths, ClipperLib::ptClip, true);
     }
 
     // subtract holes and pads from devices
+    Length holeClearance = getClearance(nullptr);
     foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
         for (const Hole& hole : device->getFootprint().getLibFootprint().getHoles()) {
             Point pos = device->getFootprint().mapToScene(hole.getPosition());
-            Length dia = hole.getDiameter() + mPlane.getMinClearance() * 2;
-            Path path = Path::circle(dia).translated(pos);
-            c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
+            Length dia = hole.getDiameter() + holeClearance * 2;
+            c.AddPath(mPathCache.convert(Path::circle(dia), maxArcTolerance(),
+                                         Angle::deg0(), pos),
                       ClipperLib::ptClip, true);
         }
         foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
             if (!pad->isOnLayer(mPlane.getLayerName())) continue;
             if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-                ClipperLib::Path path = ClipperHelpers::convert(pad->getSceneOutline(),
-                                                                maxArcTolerance());
-                mConnectedNetSignalAreas.push_back(path);
+                mConnectedNetSignalAreas.push_back(createPadOutline(*pad, Length(0)));
+                addPadThermal(*pad);
             }
-            c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
+            c.AddPath(createPadCutOut(*pad, getClearance(pad->getCompSigInstNetSignal())),
+                      ClipperLib::ptClip, true);
         }
     }
 
     // subtract board holes
     for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-        Length dia = hole->getHole().getDiameter() + mPlane.getMinClearance() * 2;
-        Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-        c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
+        Length dia = hole->getHole().getDiameter() + holeClearance * 2;
+        c.AddPath(mPathCache.convert(Path::circle(dia), maxArcTolerance(),
+                                     Angle::deg0(), hole->getHole().getPosition()),
                   ClipperLib::ptClip, true);
     }
 
     // subtract net segment items
     foreach (const BI_NetSegment* netsegment, mPlane.getBoard().getNetSegments()) {
+        Length clearance = getClearance(&netsegment->getNetSignal());
 
         // subtract vias
         foreach (const BI_Via* via, netsegment->getVias()) {
             if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-                ClipperLib::Path path = ClipperHelpers::convert(via->getSceneOutline(),
-                                                                maxArcTolerance());
-                mConnectedNetSignalAreas.push_back(path);
+                mConnectedNetSignalAreas.push_back(createViaOutline(*via, Length(0)));
+                addViaThermal(*via);
             }
-            c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
+            c.AddPath(createViaCutOut(*via, clearance), ClipperLib::ptClip, true);
         }
 
         // subtract netlines
@@ -185,33 +193,87 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects()
                 mConnectedNetSignalAreas.push_back(path);
             } else {
                 ClipperLib::Path path = ClipperHelpers::convert(
-                    netline->getSceneOutline(mPlane.getMinClearance()), maxArcTolerance());
+                    netline->getSceneOutline(clearance), maxArcTolerance());
                 c.AddPath(path, ClipperLib::ptClip, true);
             }
         }
     }
 
+    // subtract thermal gaps (all thermals are processed in a single pass)
+    c.AddPaths(createThermalCutOuts(), ClipperLib::ptClip, true);
+
     c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
               ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::ensureMinimumWidth()
+void BoardPlaneFragmentsBuilder::ensureMinimumWidthAndFlattenResult()
 {
+    // The second offset of the opening operation (shrink + grow) directly produces a
+    // tree with all outlines and holes, so no additional Clipper pass is needed just
+    // to determine which paths are holes.
+    ClipperLib::PolyTree tree;
     Length delta = mPlane.getMinWidth() / 2;
-    ClipperHelpers::offset(mResult, -delta, maxArcTolerance()); // can throw
-    ClipperHelpers::offset(mResult, delta, maxArcTolerance()); // can throw
+    if (delta > 0) {
+        ClipperHelpers::offset(mResult, -delta, maxArcTolerance()); // can throw
+        ClipperHelpers::offsetToTree(mResult, delta, maxArcTolerance(), tree); // can throw
+    } else {
+        ClipperLib::Clipper c;
+        c.AddPaths(mResult, ClipperLib::ptSubject, true);
+        c.Execute(ClipperLib::ctXor, tree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+    }
+
+    // convert tree to simple paths with cut-ins
+    if (mPlane.getFillStyle() == BI_Plane::FillStyle::Hatched) {
+        // hatch lines must not be thinner than the minimum width of the plane
+        HatchLattice lattice(qMax(mPlane.getHatchWidth(), mPlane.getMinWidth()),
+                             mPlane.getHatchPitch());
+
+        // connected pads, vias and traces are surrounded by solid copper, otherwise
+        // they might be located within an opening and would not be connected at all
+        ClipperLib::Paths solidAreas = mConnectedNetSignalAreas;
+        for (ClipperLib::Path& path : solidAreas) {
+            if (!ClipperLib::Orientation(path)) ClipperLib::ReversePath(path);
+        }
+        ClipperHelpers::offset(solidAreas, lattice.getWidth(), maxArcTolerance()); // can throw
+
+        mResult.clear();
+        flattenHatchedTree(tree, lattice, solidAreas); // can throw
+    } else {
+        mResult = ClipperHelpers::flattenTree(tree); // can throw
+    }
 }
 
-void BoardPlaneFragmentsBuilder::flattenResult()
+void BoardPlaneFragmentsBuilder::flattenHatchedTree(const ClipperLib::PolyNode& node,
+                                                    const HatchLattice& lattice,
+                                                    const ClipperLib::Paths& solidAreas)
 {
-    // convert paths to tree
-    ClipperLib::PolyTree tree;
-    ClipperLib::Clipper c;
-    c.AddPaths(mResult, ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctXor, tree, ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+    for (const ClipperLib::PolyNode* outline : node.Childs) { Q_ASSERT(outline);
+        ClipperLib::Paths holes;
+        for (const ClipperLib::PolyNode* hole : outline->Childs) { Q_ASSERT(hole);
+            flattenHatchedTree(*hole, lattice, solidAreas); // can throw
+            holes.push_back(hole->Contour);
+        }
 
-    // convert tree to simple paths with cut-ins
-    mResult = ClipperHelpers::flattenTree(tree); // can throw
+        // keep a border of one hatch line around the outline and all holes
+        ClipperLib::Paths interior = holes;
+        interior.push_back(outline->Contour);
+        ClipperHelpers::offset(interior, -lattice.getWidth(), maxArcTolerance()); // can throw
+
+        // and keep the solid areas around connected items
+        if (!solidAreas.empty()) {
+            ClipperLib::Clipper c;
+            c.AddPaths(interior, ClipperLib::ptSubject, true);
+            c.AddPaths(solidAreas, ClipperLib::ptClip, true);
+            c.Execute(ClipperLib::ctDifference, interior, ClipperLib::pftNonZero,
+                      ClipperLib::pftNonZero);
+        }
+
+        // the openings are added as additional holes of the outline
+        ClipperLib::Paths openings = lattice.createOpenings(interior);
+        holes.insert(holes.end(), openings.begin(), openings.end());
+        mResult.push_back(ClipperHelpers::convertHolesToCutIns(outline->Contour,
+                                                               holes)); // can throw
+    }
 }
 
 void BoardPlaneFragmentsBuilder::removeOrphans()
@@ -233,26 +295,128 @@ void BoardPlaneFragmentsBuilder::removeOrphans()
  *  Helper Methods
  ****************************************************************************************/
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(const BI_FootprintPad& pad) const noexcept
+Length BoardPlaneFragmentsBuilder::getClearance(const NetSignal* netsignal) const noexcept
+{
+    // netclasses can only increase the clearance of the plane
+    return qMax(mPlane.getMinClearance(), mClearanceMatrix.getNetClassClearance(
+        mNetClassIndex, mClearanceMatrix.getIndex(netsignal)));
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(const BI_FootprintPad& pad,
+        const Length& clearance) const noexcept
 {
     bool differentNetSignal = (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
     if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) || differentNetSignal) {
-        return ClipperHelpers::convert(pad.getSceneOutline(mPlane.getMinClearance()), maxArcTolerance());
+        return createPadOutline(pad, clearance);
     } else {
         return ClipperLib::Path();
     }
 }
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(const BI_Via& via) const noexcept
+ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(const BI_Via& via,
+        const Length& clearance) const noexcept
 {
     bool differentNetSignal = (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
     if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) || differentNetSignal) {
-        return ClipperHelpers::convert(via.getSceneOutline(mPlane.getMinClearance()), maxArcTolerance());
+        return createViaOutline(via, clearance);
     } else {
         return ClipperLib::Path();
     }
 }
 
+ClipperLib::Path BoardPlaneFragmentsBuilder::createPadOutline(const BI_FootprintPad& pad,
+        const Length& expansion) const noexcept
+{
+    // the outline in footprint coordinates is the same for all pads with the same
+    // shape, so the flattened path is cached and only transformed to the scene
+    return mPathCache.convert(pad.getOutline(expansion), maxArcTolerance(),
+                              pad.getRotation(), pad.getPosition());
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::createViaOutline(const BI_Via& via,
+        const Length& expansion) const noexcept
+{
+    return mPathCache.convert(via.getOutline(expansion), maxArcTolerance(),
+                              Angle::deg0(), via.getPosition());
+}
+
+void BoardPlaneFragmentsBuilder::addPadThermal(const BI_FootprintPad& pad) noexcept
+{
+    if (mPlane.getConnectStyle() != BI_Plane::ConnectStyle::Thermal) return;
+    mThermalGaps.push_back(createPadOutline(pad, mPlane.getThermalGapWidth()));
+    addThermalSpokes(pad.getLibPad().getWidth(), pad.getLibPad().getHeight(),
+                     pad.getRotation(), pad.getPosition());
+}
+
+void BoardPlaneFragmentsBuilder::addViaThermal(const BI_Via& via) noexcept
+{
+    if (mPlane.getConnectStyle() != BI_Plane::ConnectStyle::Thermal) return;
+    mThermalGaps.push_back(createViaOutline(via, mPlane.getThermalGapWidth()));
+    addThermalSpokes(via.getSize(), via.getSize(), Angle::deg0(), via.getPosition());
+}
+
+void BoardPlaneFragmentsBuilder::addThermalSpokes(const Length& width,
+        const Length& height, const Angle& rotation, const Point& pos) noexcept
+{
+    // Spokes narrower than the minimum width would be removed again by
+    // ensureMinimumWidthAndFlattenResult(), so they are at least slightly wider.
+    Length spokeWidth = qMax(mPlane.getThermalSpokeWidth(),
+                             mPlane.getMinWidth() + maxArcTolerance());
+    Length gap = mPlane.getThermalGapWidth();
+
+    // Most pads of a board have only a few different sizes and rotations, so the
+    // spokes are built only once per combination and then just translated.
+    auto key = std::make_tuple(width.toNm(), height.toNm(), rotation.toMicroDeg());
+    auto it = mSpokeTemplates.find(key);
+    if (it == mSpokeTemplates.end()) {
+        // a cross of two bars from the pad center to beyond the thermal gap
+        Length halfSpoke = spokeWidth / 2;
+        Length halfX = width / 2 + gap + spokeWidth;
+        Length halfY = height / 2 + gap + spokeWidth;
+        QVector<QVector<Point>> bars = {
+            {Point(-halfX, -halfSpoke), Point(halfX, -halfSpoke),
+             Point(halfX, halfSpoke), Point(-halfX, halfSpoke)},
+            {Point(-halfSpoke, -halfY), Point(halfSpoke, -halfY),
+             Point(halfSpoke, halfY), Point(-halfSpoke, halfY)},
+        };
+        ClipperLib::Paths spokes;
+        foreach (const QVector<Point>& bar, bars) {
+            ClipperLib::Path path;
+            foreach (const Point& p, bar) {
+                path.push_back(ClipperHelpers::convert(p.rotated(rotation)));
+            }
+            spokes.push_back(path);
+        }
+        it = mSpokeTemplates.insert(key, spokes);
+    }
+
+    ClipperLib::IntPoint offset = ClipperHelpers::convert(pos);
+    for (const ClipperLib::Path& spoke : it.value()) {
+        ClipperLib::Path path = spoke;
+        for (ClipperLib::IntPoint& p : path) {
+            p.X += offset.X;
+            p.Y += offset.Y;
+        }
+        mThermalSpokes.push_back(path);
+    }
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::createThermalCutOuts() const noexcept
+{
+    // The gaps minus the spokes are subtracted from the plane together with all other
+    // cutouts, thus the spokes are automatically cut by the clearance of other objects.
+    // Since the spokes always reach beyond the gaps, the result doesn't contain holes
+    // (which would break the non-zero fill rule of the clip paths).
+    ClipperLib::Paths cutOuts;
+    if (mThermalGaps.empty()) return cutOuts;
+    ClipperLib::Clipper c;
+    c.AddPaths(mThermalGaps, ClipperLib::ptSubject, true);
+    c.AddPaths(mThermalSpokes, ClipperLib::ptClip, true);
+    c.Execute(ClipperLib::ctDifference, cutOuts, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return cutOuts;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -24,15 +24,22 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <tuple>
 #include <clipper/clipper.hpp>
 #include <librepcb/common/geometry/path.h>
+#include "boardclearancematrix.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
+
+class ClipperPathCache;
+class HatchLattice;
+
 namespace project {
 
+class NetSignal;
 class BI_Plane;
 class BI_Via;
 class BI_FootprintPad;
@@ -65,13 +72,27 @@ class BoardPlaneFragmentsBuilder final
         void addPlaneOutline();
         void clipToBoardOutline();
         void subtractOtherObjects();
-        void ensureMinimumWidth();
-        void flattenResult();
+        void ensureMinimumWidthAndFlattenResult();
+        void flattenHatchedTree(const ClipperLib::PolyNode& node,
+                                const HatchLattice& lattice,
+                                const ClipperLib::Paths& solidAreas);
         void removeOrphans();
 
         // Helper Methods
-        ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-        ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
+        Length getClearance(const NetSignal* netsignal) const noexcept;
+        ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad,
+                                         const Length& clearance) const noexcept;
+        ClipperLib::Path createViaCutOut(const BI_Via& via,
+                                         const Length& clearance) const noexcept;
+        ClipperLib::Path createPadOutline(const BI_FootprintPad& pad,
+                                          const Length& expansion) const noexcept;
+        ClipperLib::Path createViaOutline(const BI_Via& via,
+                                          const Length& expansion) const noexcept;
+        void addPadThermal(const BI_FootprintPad& pad) noexcept;
+        void addViaThermal(const BI_Via& via) noexcept;
+        void addThermalSpokes(const Length& width, const Length& height,
+                              const Angle& rotation, const Point& pos) noexcept;
+        ClipperLib::Paths createThermalCutOuts() const noexcept;
 
         /**
          * Returns the maximum allowed arc tolerance when flattening arcs. Do not change
@@ -83,8 +104,16 @@ class BoardPlaneFragmentsBuilder final
 
     private: // Data
         BI_Plane& mPlane;
+        ClipperPathCache& mPathCache; ///< shared with all other planes of the board
+        BoardClearanceMatrix mClearanceMatrix;
+        int mNetClassIndex; ///< index of the plane's netclass in mClearanceMatrix
         ClipperLib::Paths mConnectedNetSignalAreas;
+        ClipperLib::Paths mThermalGaps;   ///< pads/vias expanded by the thermal gap
+        ClipperLib::Paths mThermalSpokes; ///< spokes of all thermals in scene coordinates
         ClipperLib::Paths mResult;
+
+        /// Spoke templates (rotated, but not translated) by pad width, height and rotation
+        QMap<std::tuple<LengthBase_t, LengthBase_t, qint32>, ClipperLib::Paths> mSpokeTemplates;
 };
 
 /*****************************************************************************************
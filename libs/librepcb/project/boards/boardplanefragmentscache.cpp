@@ -0,0 +1,331 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardplanefragmentscache.h"
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+#include "board.h"
+#include "../project.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include "items/bi_plane.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_via.h"
+#include "items/bi_netline.h"
+#include "items/bi_polygon.h"
+#include "items/bi_hole.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Helper Functions
+ ****************************************************************************************/
+
+static void writePath(QDataStream& stream, const Path& path) noexcept
+{
+    stream << static_cast<quint32>(path.getVertices().count());
+    for (const Vertex& vertex : path.getVertices()) {
+        stream << static_cast<qint64>(vertex.getPos().getX().toNm())
+               << static_cast<qint64>(vertex.getPos().getY().toNm())
+               << static_cast<qint32>(vertex.getAngle().toMicroDeg());
+    }
+}
+
+static Path readPath(QDataStream& stream) noexcept
+{
+    quint32 count = 0;
+    stream >> count;
+    Path path;
+    for (quint32 i = 0; (i < count) && (stream.status() == QDataStream::Ok); ++i) {
+        qint64 x = 0, y = 0;
+        qint32 angle = 0;
+        stream >> x >> y >> angle;
+        path.addVertex(Point(Length(x), Length(y)), Angle(angle));
+    }
+    return path;
+}
+
+static void writeNetSignal(QDataStream& stream, const NetSignal* netsignal) noexcept
+{
+    // the clearances depend on the netclass, which can be modified without the net
+    stream << (netsignal ? netsignal->getUuid().toStr() : QString());
+    stream << static_cast<qint64>(netsignal ?
+                                  netsignal->getNetClass().getClearance().toNm() : 0);
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardPlaneFragmentsCache::BoardPlaneFragmentsCache(Board& board) noexcept :
+    mBoard(board)
+{
+    QString relpath = QString("user/boards/%1.planes")
+                      .arg(mBoard.getFilePath().getCompleteBasename());
+    mFilePath = mBoard.getProject().getPath().getPathTo(relpath);
+}
+
+BoardPlaneFragmentsCache::~BoardPlaneFragmentsCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardPlaneFragmentsCache::load() noexcept
+{
+    mEntries.clear();
+    if (!mFilePath.isExistingFile()) return;
+
+    try {
+        QByteArray content = FileUtils::readFile(mFilePath); // can throw
+        QDataStream stream(content);
+        stream.setVersion(QDataStream::Qt_5_2);
+        quint32 magic = 0, version = 0, planeCount = 0;
+        stream >> magic >> version >> planeCount;
+        if ((magic != sFileMagic) || (version != sFileVersion)) {
+            qInfo() << "Ignoring plane fragments cache with unknown format:" << mFilePath.toNative();
+            return;
+        }
+        QHash<Uuid, Entry> entries;
+        for (quint32 i = 0; i < planeCount; ++i) {
+            QString uuid;
+            Entry entry;
+            quint32 fragmentCount = 0;
+            stream >> uuid >> entry.inputHash >> fragmentCount;
+            for (quint32 k = 0; (k < fragmentCount) && (stream.status() == QDataStream::Ok); ++k) {
+                entry.fragments.append(readPath(stream));
+            }
+            entries.insert(Uuid(uuid), entry);
+        }
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "Ignoring corrupt plane fragments cache:" << mFilePath.toNative();
+            return;
+        }
+        mEntries = entries;
+    } catch (const Exception& e) {
+        qWarning() << "Could not read plane fragments cache:" << e.getMsg();
+    }
+}
+
+bool BoardPlaneFragmentsCache::restore(BI_Plane& plane,
+                                       BoardInputHashes& boardInputHashes) noexcept
+{
+    auto it = mEntries.constFind(plane.getUuid());
+    if ((it == mEntries.constEnd())
+        || (it->inputHash != calcInputHash(plane, boardInputHashes))) {
+        return false;
+    }
+    plane.restoreFragments(it->fragments, it->inputHash);
+    return true;
+}
+
+void BoardPlaneFragmentsCache::save(bool toOriginal) noexcept
+{
+    if (!toOriginal) return;
+
+    // the hash of a plane depends on planes with higher priority, so the entries are
+    // always calculated in the same order as the planes are rebuilt
+    QList<BI_Plane*> planes = mBoard.getPlanes();
+    qSort(planes.begin(), planes.end(),
+          [](const BI_Plane* p1, const BI_Plane* p2)
+          {return !(*p1 < *p2);}); // sort by priority (highest priority first)
+
+    // only cache fragments which are still up to date, i.e. whose inputs were not
+    // modified since the plane was rebuilt (planes are not refilled automatically)
+    mEntries.clear();
+    BoardInputHashes boardInputHashes;
+    foreach (const BI_Plane* plane, planes) {
+        const QByteArray& inputHash = plane->getFragmentsInputHash();
+        if ((!inputHash.isEmpty())
+            && (inputHash == calcInputHash(*plane, boardInputHashes))) {
+            mEntries.insert(plane->getUuid(), Entry{inputHash, plane->getFragments()});
+        }
+    }
+
+    QByteArray content;
+    QDataStream stream(&content, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream << sFileMagic << sFileVersion << static_cast<quint32>(mEntries.count());
+    foreach (const BI_Plane* plane, planes) {
+        auto it = mEntries.constFind(plane->getUuid());
+        if (it == mEntries.constEnd()) continue;
+        const Entry& entry = *it;
+        stream << plane->getUuid().toStr() << entry.inputHash
+               << static_cast<quint32>(entry.fragments.count());
+        foreach (const Path& fragment, entry.fragments) {
+            writePath(stream, fragment);
+        }
+    }
+
+    try {
+        FileUtils::writeFile(mFilePath, content); // can throw
+    } catch (const Exception& e) {
+        // the cache is optional, so saving the project must not fail because of it
+        qWarning() << "Could not write plane fragments cache:" << e.getMsg();
+    }
+}
+
+void BoardPlaneFragmentsCache::remove(bool toOriginal) noexcept
+{
+    if ((!toOriginal) || (!mFilePath.isExistingFile())) return;
+
+    try {
+        FileUtils::removeFile(mFilePath); // can throw
+    } catch (const Exception& e) {
+        qWarning() << "Could not remove plane fragments cache:" << e.getMsg();
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QByteArray BoardPlaneFragmentsCache::calcInputHash(const BI_Plane& plane,
+                                                   BoardInputHashes& boardInputHashes) noexcept
+{
+    const Board& board = plane.getBoard();
+    const QString& layer = plane.getLayerName();
+
+    auto boardInputHash = boardInputHashes.constFind(layer);
+    if (boardInputHash == boardInputHashes.constEnd()) {
+        boardInputHash = boardInputHashes.insert(layer, calcBoardInputHash(board, layer));
+    }
+    if (boardInputHash->isEmpty()) {
+        return QByteArray(); // never matches a valid hash
+    }
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream << sFileVersion << *boardInputHash;
+
+    // the plane itself
+    try {
+        stream << serializeToDomElement(plane, "plane").toString(0);
+    } catch (const Exception& e) {
+        qWarning() << "Failed to serialize plane for fragments cache:" << e.getMsg();
+        return QByteArray(); // never matches a valid hash
+    }
+    writeNetSignal(stream, &plane.getNetSignal());
+
+    // other planes with higher priority on the same layer
+    foreach (const BI_Plane* other, board.getPlanes()) {
+        if (other == &plane) continue;
+        if (*other < plane) continue;
+        if (other->getLayerName() != layer) continue;
+        if (&other->getNetSignal() == &plane.getNetSignal()) continue;
+        stream << other->getUuid().toStr();
+        writeNetSignal(stream, &other->getNetSignal());
+        foreach (const Path& fragment, other->getFragments()) {
+            writePath(stream, fragment);
+        }
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+QByteArray BoardPlaneFragmentsCache::calcInputHash(const BI_Plane& plane) noexcept
+{
+    BoardInputHashes boardInputHashes;
+    return calcInputHash(plane, boardInputHashes);
+}
+
+QByteArray BoardPlaneFragmentsCache::calcBoardInputHash(const Board& board,
+                                                        const QString& layer) noexcept
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_2);
+    stream << sFileVersion << layer;
+
+    // the design rules
+    try {
+        stream << serializeToDomElement(board.getDesignRules(), "design_rules").toString(0);
+    } catch (const Exception& e) {
+        qWarning() << "Failed to serialize design rules for fragments cache:" << e.getMsg();
+        return QByteArray(); // never matches a valid hash
+    }
+
+    // board outlines
+    foreach (const BI_Polygon* polygon, board.getPolygons()) {
+        if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+            writePath(stream, polygon->getPolygon().getPath());
+        }
+    }
+
+    // holes and pads of devices
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+        for (const Hole& hole : device->getFootprint().getLibFootprint().getHoles()) {
+            Point pos = device->getFootprint().mapToScene(hole.getPosition());
+            stream << static_cast<qint64>(pos.getX().toNm())
+                   << static_cast<qint64>(pos.getY().toNm())
+                   << static_cast<qint64>(hole.getDiameter().toNm());
+        }
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            if (!pad->isOnLayer(layer)) continue;
+            writeNetSignal(stream, pad->getCompSigInstNetSignal());
+            writePath(stream, pad->getSceneOutline());
+        }
+    }
+
+    // board holes
+    foreach (const BI_Hole* hole, board.getHoles()) {
+        const Point& pos = hole->getHole().getPosition();
+        stream << static_cast<qint64>(pos.getX().toNm())
+               << static_cast<qint64>(pos.getY().toNm())
+               << static_cast<qint64>(hole->getHole().getDiameter().toNm());
+    }
+
+    // vias and netlines
+    foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+        writeNetSignal(stream, &netsegment->getNetSignal());
+        foreach (const BI_Via* via, netsegment->getVias()) {
+            writePath(stream, via->getSceneOutline());
+        }
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            if (netline->getLayer().getName() != layer) continue;
+            writePath(stream, netline->getSceneOutline());
+        }
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
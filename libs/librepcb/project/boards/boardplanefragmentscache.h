@@ -0,0 +1,186 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANEFRAGMENTSCACHE_H
+#define LIBREPCB_PROJECT_BOARDPLANEFRAGMENTSCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Plane;
+
+/*****************************************************************************************
+ *  Class BoardPlaneFragmentsCache
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardPlaneFragmentsCache class stores the calculated fragments of all planes
+ *        of a board in a binary sidecar file to avoid refilling them on every project open
+ *
+ * The file is stored at "user/boards/<BOARDBASENAME>.planes" (next to the board user
+ * settings) since it is not intended to be put under version control. Every cached plane
+ * is stored together with a hash over all inputs which affect its fragments (see
+ * #calcInputHash()). If the hash doesn't match anymore when loading the board, the
+ * cached fragments are discarded and the plane needs to be rebuilt.
+ *
+ * The cache is completely optional: if the file doesn't exist or can't be read, all
+ * planes are simply rebuilt as usual.
+ */
+class BoardPlaneFragmentsCache final
+{
+    public:
+
+        // Types
+
+        /**
+         * @brief Board input hashes (see #calcBoardInputHash()) by layer name
+         *
+         * Rebuilding planes doesn't modify any of the board inputs, so they are hashed
+         * only once per layer while processing a batch of planes.
+         */
+        typedef QHash<QString, QByteArray> BoardInputHashes;
+
+        // Constructors / Destructor
+        BoardPlaneFragmentsCache() = delete;
+        BoardPlaneFragmentsCache(const BoardPlaneFragmentsCache& other) = delete;
+        explicit BoardPlaneFragmentsCache(Board& board) noexcept;
+        ~BoardPlaneFragmentsCache() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Load the cache file (if it exists)
+         *
+         * Errors are ignored, an invalid file just leads to an empty cache.
+         */
+        void load() noexcept;
+
+        /**
+         * @brief Restore the fragments of a plane from the cache, if it's still valid
+         *
+         * @note Planes must be restored in the same order as they are rebuilt (highest
+         *       priority first) since the fragments of planes with higher priority are
+         *       part of the input hash.
+         *
+         * @param plane             The plane to restore.
+         * @param boardInputHashes  The board input hashes of the current batch.
+         *
+         * @retval true     The cached fragments were valid and applied to the plane.
+         * @retval false    There were no valid cached fragments, the plane needs to be
+         *                  rebuilt.
+         */
+        bool restore(BI_Plane& plane, BoardInputHashes& boardInputHashes) noexcept;
+
+        /**
+         * @brief Write the current fragments of all planes of the board to the cache file
+         *
+         * Planes are not refilled automatically when the board is modified, so only
+         * planes whose input hash at the time of their last rebuild (see
+         * BI_Plane::getFragmentsInputHash()) still matches the current inputs are
+         * written. All other planes will be rebuilt when the board is opened again.
+         *
+         * @param toOriginal    Only writes the file if true, since there is no need
+         *                      to create backups of a cache.
+         */
+        void save(bool toOriginal) noexcept;
+
+        /**
+         * @brief Remove the cache file (e.g. if the board was removed from the project)
+         *
+         * @param toOriginal    Only removes the file if true.
+         */
+        void remove(bool toOriginal) noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Calculate a hash over all inputs which affect the fragments of a plane
+         *
+         * This includes the plane itself, the current fragments of other planes with
+         * higher priority and the board input hash of the plane's layer.
+         *
+         * @param plane             The plane to calculate the hash for.
+         * @param boardInputHashes  The board input hashes of the current batch of
+         *                          planes. The hash of the plane's layer is calculated
+         *                          and added if it doesn't exist yet.
+         *
+         * @return The input hash (SHA-256)
+         */
+        static QByteArray calcInputHash(const BI_Plane& plane,
+                                        BoardInputHashes& boardInputHashes) noexcept;
+
+        /**
+         * @brief Same as above, but for a single plane
+         */
+        static QByteArray calcInputHash(const BI_Plane& plane) noexcept;
+
+        /**
+         * @brief Calculate a hash over the inputs of all planes on a layer
+         *
+         * This includes the board outlines, holes, pads, vias, netlines, the design rules
+         * and the netclass clearances of all involved nets.
+         *
+         * @param board     The board to calculate the hash for.
+         * @param layer     The name of the copper layer of the planes.
+         *
+         * @return The board input hash (SHA-256)
+         */
+        static QByteArray calcBoardInputHash(const Board& board,
+                                             const QString& layer) noexcept;
+
+        // Operator Overloadings
+        BoardPlaneFragmentsCache& operator=(const BoardPlaneFragmentsCache& rhs) = delete;
+
+
+    private: // Types
+        struct Entry {
+            QByteArray inputHash;
+            QVector<Path> fragments;
+        };
+
+
+    private: // Data
+        Board& mBoard;
+        FilePath mFilePath;
+        QHash<Uuid, Entry> mEntries;
+
+        static constexpr quint32 sFileMagic = 0x4C505043; ///< "LPPC"
+        static constexpr quint32 sFileVersion = 3; ///< increment on any format change!
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDPLANEFRAGMENTSCACHE_H
@@ -0,0 +1,286 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardstatistics.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include "board.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_plane.h"
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class TraceStatistics
+ ****************************************************************************************/
+
+BoardStatistics::TraceStatistics& BoardStatistics::TraceStatistics::operator+=(
+        const TraceStatistics& rhs) noexcept
+{
+    length += rhs.length;
+    count += rhs.count;
+    area += rhs.area;
+    return *this;
+}
+
+BoardStatistics::TraceStatistics& BoardStatistics::TraceStatistics::operator-=(
+        const TraceStatistics& rhs) noexcept
+{
+    length -= rhs.length;
+    count -= rhs.count;
+    area -= rhs.area;
+    return *this;
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardStatistics::BoardStatistics(Board& board) noexcept :
+    QObject(nullptr), mBoard(board), mIsDirty(true), mAllDirty(true), mViaCount(0)
+{
+}
+
+BoardStatistics::~BoardStatistics() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+BoardStatistics::NetStatistics BoardStatistics::getNetStatistics(
+        const NetSignal& netsignal) const noexcept
+{
+    update();
+    NetStatistics statistics = mNetStatistics.value(&netsignal);
+    foreach (const PlaneStatistics& plane, mPlaneStatistics) {
+        if (plane.netSignal == &netsignal) {
+            statistics.planeArea += plane.area;
+        }
+    }
+    return statistics;
+}
+
+BoardStatistics::LayerStatistics BoardStatistics::getLayerStatistics(
+        const QString& layerName) const noexcept
+{
+    update();
+    return mLayerStatistics.value(layerName);
+}
+
+QStringList BoardStatistics::getLayerNames() const noexcept
+{
+    update();
+    return mLayerStatistics.keys();
+}
+
+qreal BoardStatistics::getPlaneArea(const BI_Plane& plane) const noexcept
+{
+    update();
+    return mPlaneStatistics.value(&plane).area;
+}
+
+int BoardStatistics::getViaCount() const noexcept
+{
+    update();
+    return mViaCount;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardStatistics::invalidateNetSignal(const NetSignal* netsignal) noexcept
+{
+    if (netsignal) {
+        mDirtyNetSignals.insert(netsignal);
+        setDirty();
+    }
+}
+
+void BoardStatistics::invalidatePlane(const BI_Plane* plane) noexcept
+{
+    if (plane) {
+        mDirtyPlanes.insert(plane);
+        setDirty();
+    }
+}
+
+void BoardStatistics::invalidateAll() noexcept
+{
+    mAllDirty = true;
+    setDirty();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardStatistics::update() const noexcept
+{
+    if (!mIsDirty) return;
+
+    // Invalidated pointers may refer to already deleted objects, so they are only
+    // dereferenced if the object still exists.
+    QSet<const NetSignal*> existingNetSignals;
+    foreach (const NetSignal* netsignal, mBoard.getProject().getCircuit().getNetSignals()) {
+        existingNetSignals.insert(netsignal);
+    }
+    QSet<const BI_Plane*> existingPlanes;
+    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+        existingPlanes.insert(plane);
+    }
+    if (mAllDirty) {
+        mDirtyNetSignals += existingNetSignals;
+        mDirtyNetSignals += mNetStatistics.keys().toSet();
+        mDirtyPlanes += existingPlanes;
+        mDirtyPlanes += mPlaneStatistics.keys().toSet();
+    }
+
+    // calculate the area of modified planes and remember the affected layers
+    QSet<QString> dirtyLayers;
+    foreach (const BI_Plane* plane, mDirtyPlanes) {
+        auto it = mPlaneStatistics.find(plane);
+        if (it != mPlaneStatistics.end()) {
+            dirtyLayers.insert(it->layerName);
+            mPlaneStatistics.erase(it);
+        }
+        if (existingPlanes.contains(plane)) {
+            PlaneStatistics statistics{plane->getLayerName(), &plane->getNetSignal(), 0};
+            foreach (const Path& fragment, plane->getFragments()) {
+                // fragments contain holes as cut-ins, so the area of holes is negative
+                statistics.area += toSquareMm(ClipperLib::Area(
+                    ClipperHelpers::convert(fragment, Length(5000))));
+            }
+            mPlaneStatistics.insert(plane, statistics);
+            dirtyLayers.insert(statistics.layerName);
+        }
+    }
+    foreach (const QString& layerName, dirtyLayers) {
+        updateLayerPlaneArea(layerName);
+    }
+
+    // recalculate modified net signals
+    foreach (const NetSignal* netsignal, mDirtyNetSignals) {
+        updateNetSignal(netsignal, existingNetSignals.contains(netsignal));
+    }
+
+    // remove layers without any copper, and avoid rounding errors of empty layers
+    for (auto it = mLayerStatistics.begin(); it != mLayerStatistics.end();) {
+        if (it->traces.count <= 0) {
+            it->traces = TraceStatistics();
+        }
+        if ((it->traces.count <= 0) && (it->planeArea <= 0)) {
+            it = mLayerStatistics.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    mDirtyNetSignals.clear();
+    mDirtyPlanes.clear();
+    mAllDirty = false;
+    mIsDirty = false;
+}
+
+void BoardStatistics::setDirty() noexcept
+{
+    if (!mIsDirty) {
+        mIsDirty = true;
+        emit invalidated();
+    }
+}
+
+void BoardStatistics::updateNetSignal(const NetSignal* netsignal, bool exists) const noexcept
+{
+    // remove the old contribution of the net signal
+    auto it = mNetStatistics.find(netsignal);
+    if (it != mNetStatistics.end()) {
+        for (auto layer = it->tracesPerLayer.constBegin();
+             layer != it->tracesPerLayer.constEnd(); ++layer) {
+            mLayerStatistics[layer.key()].traces -= layer.value();
+        }
+        mViaCount -= it->viaCount;
+        mNetStatistics.erase(it);
+    }
+    if (!exists) return;
+
+    // calculate and add the new contribution
+    NetStatistics statistics;
+    foreach (const BI_NetSegment* netsegment, netsignal->getBoardNetSegments()) {
+        if (&netsegment->getBoard() != &mBoard) continue;
+        statistics.viaCount += netsegment->getVias().count();
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            TraceStatistics trace;
+            trace.length = (netline->getEndPoint().getPosition() -
+                            netline->getStartPoint().getPosition()).getLength();
+            trace.count = 1;
+            trace.area = netline->getWidth().toMm() * trace.length.toMm();
+            statistics.traces += trace;
+            statistics.tracesPerLayer[netline->getLayer().getName()] += trace;
+        }
+    }
+    if ((statistics.traces.count == 0) && (statistics.viaCount == 0)) return;
+    for (auto layer = statistics.tracesPerLayer.constBegin();
+         layer != statistics.tracesPerLayer.constEnd(); ++layer) {
+        mLayerStatistics[layer.key()].traces += layer.value();
+    }
+    mViaCount += statistics.viaCount;
+    mNetStatistics.insert(netsignal, statistics);
+}
+
+void BoardStatistics::updateLayerPlaneArea(const QString& layerName) const noexcept
+{
+    // planes of the same net signal may overlap, so the union is needed
+    ClipperLib::Clipper c;
+    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+        if (plane->getLayerName() == layerName) {
+            c.AddPaths(ClipperHelpers::convert(plane->getFragments(), Length(5000)),
+                       ClipperLib::ptSubject, true);
+        }
+    }
+    ClipperLib::Paths paths;
+    c.Execute(ClipperLib::ctUnion, paths, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+    qreal area = 0;
+    for (const ClipperLib::Path& path : paths) {
+        area += ClipperLib::Area(path); // holes have a negative area
+    }
+    mLayerStatistics[layerName].planeArea = toSquareMm(area);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDSTATISTICS_H
+#define LIBREPCB_PROJECT_BOARDSTATISTICS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+class BI_Plane;
+
+/*****************************************************************************************
+ *  Class BoardStatistics
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardStatistics class provides copper statistics of a board (trace lengths,
+ *        via counts, trace and plane areas) per net signal and per layer
+ *
+ * The statistics are maintained incrementally: board items report their modifications
+ * with #invalidateNetSignal() and #invalidatePlane(), and on the next query only the
+ * invalidated net signals and planes are recalculated. The per-layer aggregates are
+ * updated by subtracting the old and adding the new contribution of each recalculated
+ * net signal. The exact plane areas are calculated with Clipper, but only for planes
+ * whose fragments have changed (and the union per layer only for the affected layers).
+ *
+ * @note    The trace area is calculated as width × length of all traces, i.e. the round
+ *          caps are ignored (they mostly overlap at the joints anyway). Areas are
+ *          returned in square millimeters.
+ */
+class BoardStatistics final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        struct TraceStatistics {
+            Length length;
+            int count;
+            qreal area; ///< [mm²]
+
+            TraceStatistics() noexcept : length(0), count(0), area(0) {}
+            TraceStatistics& operator+=(const TraceStatistics& rhs) noexcept;
+            TraceStatistics& operator-=(const TraceStatistics& rhs) noexcept;
+        };
+        struct NetStatistics {
+            TraceStatistics traces;
+            QHash<QString, TraceStatistics> tracesPerLayer;
+            int viaCount;
+            qreal planeArea; ///< sum of all planes of the net signal [mm²]
+
+            NetStatistics() noexcept : viaCount(0), planeArea(0) {}
+        };
+        struct LayerStatistics {
+            TraceStatistics traces;
+            qreal planeArea; ///< union of all planes on the layer [mm²]
+
+            LayerStatistics() noexcept : planeArea(0) {}
+        };
+
+        // Constructors / Destructor
+        BoardStatistics() = delete;
+        BoardStatistics(const BoardStatistics& other) = delete;
+        explicit BoardStatistics(Board& board) noexcept;
+        ~BoardStatistics() noexcept;
+
+        // Getters (recalculate invalidated statistics if needed)
+        NetStatistics getNetStatistics(const NetSignal& netsignal) const noexcept;
+        LayerStatistics getLayerStatistics(const QString& layerName) const noexcept;
+        QStringList getLayerNames() const noexcept;
+        qreal getPlaneArea(const BI_Plane& plane) const noexcept;
+        int getViaCount() const noexcept;
+
+        // General Methods
+        void invalidateNetSignal(const NetSignal* netsignal) noexcept;
+        void invalidatePlane(const BI_Plane* plane) noexcept;
+        void invalidateAll() noexcept;
+
+        // Operator Overloadings
+        BoardStatistics& operator=(const BoardStatistics& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief Emitted when statistics get invalidated after they were up to date
+         *
+         * Only emitted once until the statistics are queried again, so it's cheap to
+         * invalidate statistics on every modification.
+         */
+        void invalidated();
+
+
+    private: // Types
+        struct PlaneStatistics {
+            QString layerName;
+            const NetSignal* netSignal;
+            qreal area; ///< [mm²]
+        };
+
+
+    private: // Methods
+        void update() const noexcept;
+        void setDirty() noexcept;
+        void updateNetSignal(const NetSignal* netsignal, bool exists) const noexcept;
+        void updateLayerPlaneArea(const QString& layerName) const noexcept;
+        static qreal toSquareMm(qreal squareNm) noexcept {return squareNm / 1e12;}
+
+
+    private: // Data
+        Board& mBoard;
+
+        // all data is mutable since the statistics are updated lazily in getters
+        mutable bool mIsDirty;
+        mutable bool mAllDirty;
+        mutable QSet<const NetSignal*> mDirtyNetSignals;
+        mutable QSet<const BI_Plane*> mDirtyPlanes;
+        mutable QHash<const NetSignal*, NetStatistics> mNetStatistics;
+        mutable QHash<const BI_Plane*, PlaneStatistics> mPlaneStatistics;
+        mutable QHash<QString, LayerStatistics> mLayerStatistics;
+        mutable int mViaCount;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDSTATISTICS_H
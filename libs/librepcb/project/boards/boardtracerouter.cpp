@@ -0,0 +1,363 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardtracerouter.h"
+#include <librepcb/common/utils/geometrykernel.h>
+#include "boardobstacleindex.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardTraceRouter::BoardTraceRouter(const BoardObstacleIndex& index) noexcept :
+    mIndex(index), mTimeBudgetMs(16), mNetSignal(nullptr)
+{
+}
+
+BoardTraceRouter::~BoardTraceRouter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+BoardTraceRouter::Result BoardTraceRouter::route(const QString& layerName,
+    const QVector<Point>& desiredPath, const Length& width, const NetSignal* netSignal,
+    Mode mode) noexcept
+{
+    mTimer.start();
+    mLayerName = layerName;
+    mWidth = width;
+    mNetSignal = netSignal;
+    mResult = Result{QVector<Point>(), QHash<BI_NetPoint*, Point>(), false};
+    mIgnoredObstacles.clear();
+    mTemporaryLines.clear();
+
+    if (desiredPath.isEmpty()) return mResult;
+    if (mode == Mode::IgnoreObstacles) {
+        mResult.points = desiredPath;
+        mResult.complete = true;
+        return mResult;
+    }
+
+    mResult.points.append(desiredPath.first());
+    for (int i = 1; i < desiredPath.count(); ++i) {
+        if (desiredPath.at(i) == mResult.points.last()) continue;
+        if (!routeSegment(mResult.points.last(), desiredPath.at(i), mode)) {
+            return mResult;
+        }
+    }
+    mResult.complete = true;
+    return mResult;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool BoardTraceRouter::routeSegment(const Point& a, const Point& b, Mode mode) noexcept
+{
+    if (mode == Mode::Shove) {
+        // shoving may fail after some netlines were already shoved, so the state needs
+        // to be restored before walking around instead
+        QHash<BI_NetPoint*, Point> shovedNetPoints = mResult.shovedNetPoints;
+        QSet<int> ignoredObstacles = mIgnoredObstacles;
+        QList<TemporaryLine> temporaryLines = mTemporaryLines;
+        if (shove(a, b)) return true;
+        mResult.shovedNetPoints = shovedNetPoints;
+        mIgnoredObstacles = ignoredObstacles;
+        mTemporaryLines = temporaryLines;
+    }
+    if (walkaround(a, b)) return true;
+    appendFarthestFreePoint(a, b);
+    return false;
+}
+
+bool BoardTraceRouter::walkaround(const Point& a, const Point& b) noexcept
+{
+    // the octagon around the inflated bounding rectangle must not cut the rounded
+    // corners of the real clearance area
+    Length distance = mWidth / 2 + mIndex.getMaxClearance() + sMargin;
+    Length chamfer = qMax((mWidth / 2 + mIndex.getMaxClearance()) / 2, Length(sMargin));
+
+    QVector<Point> path;
+    Point current = a;
+    for (int i = 0; (i < sMaxSegmentIterations) && (!isTimeExceeded()); ++i) {
+        if (isFree(current, b, mWidth, mNetSignal, mIgnoredObstacles)) {
+            mResult.points += path;
+            mResult.points.append(b);
+            return true;
+        }
+        QVector<int> collisions = findCollisions(current, b);
+        if (collisions.isEmpty()) return false; // blocked by a shoved netline
+
+        // walk around the first obstacle, merging other obstacles into its hull
+        const BoardObstacleIndex::Obstacle& first = mIndex.getObstacle(collisions.first());
+        Point min = first.boundsMin - Point(distance, distance);
+        Point max = first.boundsMax + Point(distance, distance);
+        QVector<Point> around;
+        bool found = false;
+        for (int merges = 0; (merges <= sMaxHullMerges) && (!found); ++merges) {
+            QVector<Point> hull = createHull(min, max, chamfer);
+            if (!findPathAroundHull(hull, current, b, around)) return false;
+            found = true;
+            Point p = current;
+            foreach (const Point& next, around) {
+                QVector<int> ids = findCollisions(p, next);
+                if (!ids.isEmpty()) {
+                    const BoardObstacleIndex::Obstacle& other = mIndex.getObstacle(ids.first());
+                    min.setX(qMin(min.getX(), other.boundsMin.getX() - distance));
+                    min.setY(qMin(min.getY(), other.boundsMin.getY() - distance));
+                    max.setX(qMax(max.getX(), other.boundsMax.getX() + distance));
+                    max.setY(qMax(max.getY(), other.boundsMax.getY() + distance));
+                    found = false;
+                    break;
+                } else if (!isFree(p, next, mWidth, mNetSignal, mIgnoredObstacles)) {
+                    return false; // blocked by a shoved netline
+                }
+                p = next;
+            }
+        }
+        if (!found) return false;
+        path += around;
+        current = around.last();
+    }
+    return false;
+}
+
+bool BoardTraceRouter::shove(const Point& a, const Point& b) noexcept
+{
+    for (int i = 0; (i < sMaxSegmentIterations) && (!isTimeExceeded()); ++i) {
+        QVector<int> collisions = findCollisions(a, b);
+        if (collisions.isEmpty()) {
+            if (!isFree(a, b, mWidth, mNetSignal, mIgnoredObstacles)) return false;
+            mResult.points.append(b);
+            return true;
+        }
+        const BoardObstacleIndex::Obstacle& obstacle = mIndex.getObstacle(collisions.first());
+        const BI_NetLine* netline = dynamic_cast<const BI_NetLine*>(obstacle.item);
+        if ((!netline) || (!shoveNetLine(*netline, a, b))) return false;
+    }
+    return false;
+}
+
+bool BoardTraceRouter::shoveNetLine(const BI_NetLine& netline, const Point& a,
+                                    const Point& b) noexcept
+{
+    BI_NetPoint* start = &netline.getStartPoint();
+    BI_NetPoint* end = &netline.getEndPoint();
+    if (start->isAttached() || end->isAttached()) return false;
+    if (mResult.shovedNetPoints.contains(start)) return false;
+    if (mResult.shovedNetPoints.contains(end)) return false;
+
+    // move the netline perpendicular to the segment to the side where it already is
+    qreal dx = (b - a).getX().toNm(), dy = (b - a).getY().toNm();
+    qreal length = qSqrt(dx * dx + dy * dy);
+    if (length <= 0) return false;
+    qreal nx = -dy / length, ny = dx / length;
+    auto signedDistance = [&](const Point& p) {
+        return (p - a).getX().toNm() * nx + (p - a).getY().toNm() * ny;
+    };
+    qreal ds = signedDistance(start->getPosition());
+    qreal de = signedDistance(end->getPosition());
+    qreal side = (ds + de >= 0) ? 1 : -1;
+    const NetSignal* netSignal = &netline.getNetSignalOfNetSegment();
+    Length need = mWidth / 2 + netline.getWidth() / 2
+                + mIndex.getClearance(mNetSignal, netSignal) + sMargin;
+    qreal shift = need.toNm() - qMin(side * ds, side * de);
+    if (shift <= 0) return false;
+    Point offset(Length(qRound64(side * nx * shift)), Length(qRound64(side * ny * shift)));
+
+    // the shoved netline and all netlines connected to it must not collide with
+    // anything else
+    QSet<int> ignore = mIgnoredObstacles;
+    QList<TemporaryLine> lines;
+    QHash<BI_NetPoint*, Point> moved;
+    moved.insert(start, start->getPosition() + offset);
+    moved.insert(end, end->getPosition() + offset);
+    foreach (BI_NetPoint* point, moved.keys()) {
+        foreach (const BI_NetLine* line, point->getLines()) {
+            foreach (int id, mIndex.getObstacleIds(*line)) {
+                if ((line != &netline) && mIgnoredObstacles.contains(id)) {
+                    return false; // already stretched by another shove
+                }
+                ignore.insert(id);
+            }
+            BI_NetPoint* other = line->getOtherPoint(*point);
+            if ((line == &netline) && (point == end)) continue; // added already
+            Point otherPos = moved.value(other, mResult.shovedNetPoints.value(
+                                                    other, other->getPosition()));
+            lines.append(TemporaryLine{moved.value(point), otherPos, line->getWidth(),
+                                       netSignal});
+        }
+    }
+    QVector<Point> route = mResult.points;
+    route.append(b);
+    foreach (const TemporaryLine& line, lines) {
+        if (!isFree(line.p1, line.p2, line.width, netSignal, ignore)) return false;
+        qreal distance = (mWidth / 2 + line.width / 2
+                          + mIndex.getClearance(mNetSignal, netSignal)).toNm();
+        for (int i = 1; i < route.count(); ++i) {
+            if (GeometryKernel::squaredDistanceBetweenSegments(line.p1, line.p2,
+                    route.at(i - 1), route.at(i)) < distance * distance) {
+                return false;
+            }
+        }
+    }
+
+    mIgnoredObstacles = ignore;
+    mTemporaryLines += lines;
+    for (auto it = moved.constBegin(); it != moved.constEnd(); ++it) {
+        mResult.shovedNetPoints.insert(it.key(), it.value());
+    }
+    return true;
+}
+
+void BoardTraceRouter::appendFarthestFreePoint(const Point& a, const Point& b) noexcept
+{
+    // bisect the segment to find the farthest point which can be reached directly
+    qreal lower = 0, upper = 1;
+    for (int i = 0; i < 12; ++i) {
+        qreal t = (lower + upper) / 2;
+        Point p = a + Point(Length(qRound64((b - a).getX().toNm() * t)),
+                            Length(qRound64((b - a).getY().toNm() * t)));
+        if (isFree(a, p, mWidth, mNetSignal, mIgnoredObstacles)) {
+            lower = t;
+        } else {
+            upper = t;
+        }
+    }
+    Point p = a + Point(Length(qRound64((b - a).getX().toNm() * lower)),
+                        Length(qRound64((b - a).getY().toNm() * lower)));
+    if (p != a) {
+        mResult.points.append(p);
+    }
+}
+
+QVector<int> BoardTraceRouter::findCollisions(const Point& p1, const Point& p2) const noexcept
+{
+    return mIndex.findCollisions(mLayerName, p1, p2, mWidth, mNetSignal, mIgnoredObstacles);
+}
+
+bool BoardTraceRouter::isFree(const Point& p1, const Point& p2, const Length& width,
+    const NetSignal* netSignal, const QSet<int>& ignore) const noexcept
+{
+    if (!mIndex.findCollisions(mLayerName, p1, p2, width, netSignal, ignore).isEmpty()) {
+        return false;
+    }
+    foreach (const TemporaryLine& line, mTemporaryLines) {
+        if (line.netSignal == netSignal) continue;
+        qreal distance = (width / 2 + line.width / 2
+                          + mIndex.getClearance(netSignal, line.netSignal)).toNm();
+        if (GeometryKernel::squaredDistanceBetweenSegments(p1, p2, line.p1, line.p2)
+            < distance * distance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BoardTraceRouter::isTimeExceeded() const noexcept
+{
+    return (mTimeBudgetMs >= 0) && (mTimer.elapsed() >= mTimeBudgetMs);
+}
+
+QVector<Point> BoardTraceRouter::createHull(const Point& min, const Point& max,
+                                            const Length& chamfer) noexcept
+{
+    // counterclockwise, starting at the bottom left
+    Length c = qMin(chamfer, qMin(max.getX() - min.getX(), max.getY() - min.getY()) / 2);
+    return QVector<Point>{
+        Point(min.getX() + c, min.getY()), Point(max.getX() - c, min.getY()),
+        Point(max.getX(), min.getY() + c), Point(max.getX(), max.getY() - c),
+        Point(max.getX() - c, max.getY()), Point(min.getX() + c, max.getY()),
+        Point(min.getX(), max.getY() - c), Point(min.getX(), min.getY() + c)};
+}
+
+bool BoardTraceRouter::findPathAroundHull(const QVector<Point>& hull, const Point& a,
+                                          const Point& b, QVector<Point>& path) noexcept
+{
+    int n = hull.count();
+    auto edgeSeesPoint = [&](int i, const Point& p) {
+        return !isLeftOf(hull.at(i), hull.at((i + 1) % n), p);
+    };
+    // a vertex is visible from a point if the point is outside of one of its edges
+    auto isVisible = [&](int i, const Point& p) {
+        return edgeSeesPoint((i + n - 1) % n, p) || edgeSeesPoint(i, p);
+    };
+    // there is no way around the hull if a or b are inside of it
+    for (const Point& p : {a, b}) {
+        bool inside = true;
+        for (int i = 0; i < n; ++i) {
+            if (edgeSeesPoint(i, p)) inside = false;
+        }
+        if (inside) return false;
+    }
+
+    // try both directions from all vertices visible from a and take the shortest path
+    qreal bestLength = -1;
+    for (int direction : {1, -1}) {
+        for (int i = 0; i < n; ++i) {
+            if (!isVisible(i, a)) continue;
+            QVector<Point> candidate;
+            qreal length = (hull.at(i) - a).getLength().toNm();
+            int k = i;
+            for (int steps = 0; steps < n; ++steps) {
+                candidate.append(hull.at(k));
+                if (isVisible(k, b)) {
+                    length += (b - hull.at(k)).getLength().toNm();
+                    if ((bestLength < 0) || (length < bestLength)) {
+                        bestLength = length;
+                        path = candidate;
+                    }
+                    break;
+                }
+                int next = (k + direction + n) % n;
+                length += (hull.at(next) - hull.at(k)).getLength().toNm();
+                k = next;
+            }
+        }
+    }
+    return bestLength >= 0;
+}
+
+bool BoardTraceRouter::isLeftOf(const Point& l1, const Point& l2, const Point& p) noexcept
+{
+    return GeometryKernel::orientation(l1, l2, p) > 0;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDTRACEROUTER_H
+#define LIBREPCB_PROJECT_BOARDTRACEROUTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class NetSignal;
+class BI_NetPoint;
+class BI_NetLine;
+class BoardObstacleIndex;
+
+/*****************************************************************************************
+ *  Class BoardTraceRouter
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardTraceRouter class calculates the path of a trace which is currently
+ *        drawn interactively, respecting the clearances to other copper objects
+ *
+ * The router is called on every mouse move with the path the user wants to draw (the
+ * start point, an optional bend point and the cursor position) and returns the path
+ * which can actually be drawn. Depending on the mode, obstacles of other nets are
+ * either ignored, walked around or pushed away:
+ *
+ *  - Walkaround: For the first obstacle blocking a segment, an octagonal hull around
+ *    the obstacle (inflated by the required clearance) is created and the shorter way
+ *    around it is taken. If that way collides with other obstacles, they are merged
+ *    into the hull.
+ *  - Shove: Netlines of other nets which are not attached to pads or vias are moved
+ *    away perpendicular to the trace, stretching their neighbour netlines. Obstacles
+ *    which cannot be shoved (or whose shoving would lead to new collisions) are walked
+ *    around instead.
+ *
+ * All calculations are done on the geometry in the BoardObstacleIndex only, the board
+ * is not modified. To stay responsive, routing stops after a time budget and returns
+ * the path found so far.
+ */
+class BoardTraceRouter final
+{
+    public:
+
+        // Types
+        enum class Mode {
+            IgnoreObstacles,    ///< just draw the desired path
+            Walkaround,         ///< walk around obstacles
+            Shove,              ///< push netlines away, walk around other obstacles
+        };
+
+        struct Result {
+            QVector<Point> points;      ///< the path to draw, starting with the start point
+            QHash<BI_NetPoint*, Point> shovedNetPoints; ///< new positions of shoved points
+            bool complete;              ///< whether the last desired point was reached
+        };
+
+        // Constructors / Destructor
+        BoardTraceRouter() = delete;
+        BoardTraceRouter(const BoardTraceRouter& other) = delete;
+        explicit BoardTraceRouter(const BoardObstacleIndex& index) noexcept;
+        ~BoardTraceRouter() noexcept;
+
+        // Setters
+
+        /**
+         * @brief Set the maximum time for routing (default 16ms)
+         *
+         * @param milliseconds  The time budget, or -1 for no limit. With 0, obstacles
+         *                      are not avoided at all and the trace ends before the
+         *                      first collision.
+         */
+        void setTimeBudget(int milliseconds) noexcept {mTimeBudgetMs = milliseconds;}
+
+        // General Methods
+
+        /**
+         * @brief Route a trace along a desired path
+         *
+         * @param layerName     The copper layer of the trace
+         * @param desiredPath   The path the user wants to draw (at least one point)
+         * @param width         Width of the trace
+         * @param netSignal     The net of the trace
+         * @param mode          How to handle obstacles
+         *
+         * @return The routed path and shoved netpoints
+         */
+        Result route(const QString& layerName, const QVector<Point>& desiredPath,
+                     const Length& width, const NetSignal* netSignal, Mode mode) noexcept;
+
+        // Operator Overloadings
+        BoardTraceRouter& operator=(const BoardTraceRouter& rhs) = delete;
+
+
+    private: // Types
+        struct TemporaryLine {
+            Point p1;
+            Point p2;
+            Length width;
+            const NetSignal* netSignal;
+        };
+
+
+    private: // Methods
+        bool routeSegment(const Point& a, const Point& b, Mode mode) noexcept;
+        bool walkaround(const Point& a, const Point& b) noexcept;
+        bool shove(const Point& a, const Point& b) noexcept;
+        bool shoveNetLine(const BI_NetLine& netline, const Point& a, const Point& b) noexcept;
+        void appendFarthestFreePoint(const Point& a, const Point& b) noexcept;
+        QVector<int> findCollisions(const Point& p1, const Point& p2) const noexcept;
+        bool isFree(const Point& p1, const Point& p2, const Length& width,
+                    const NetSignal* netSignal, const QSet<int>& ignore) const noexcept;
+        bool isTimeExceeded() const noexcept;
+        static QVector<Point> createHull(const Point& min, const Point& max,
+                                         const Length& chamfer) noexcept;
+        static bool findPathAroundHull(const QVector<Point>& hull, const Point& a,
+                                       const Point& b, QVector<Point>& path) noexcept;
+        static bool isLeftOf(const Point& l1, const Point& l2, const Point& p) noexcept;
+
+
+    private: // Data
+        const BoardObstacleIndex& mIndex;
+        int mTimeBudgetMs;
+        QElapsedTimer mTimer;
+
+        // state of the current routing
+        QString mLayerName;
+        Length mWidth;
+        const NetSignal* mNetSignal;
+        Result mResult;
+        QSet<int> mIgnoredObstacles;            ///< original obstacles of shoved netlines
+        QList<TemporaryLine> mTemporaryLines;   ///< shoved (and stretched) netlines
+
+        static constexpr int sMaxHullMerges = 8;
+        static constexpr int sMaxSegmentIterations = 32;
+        static constexpr qint64 sMargin = 1000; ///< additional distance to obstacles [nm]
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDTRACEROUTER_H
@@ -87,7 +87,7 @@ bool BoardUserSettings::save(bool toOriginal, QStringList& errors) noexcept
     bool success = true;
 
     try {
-        SExpression doc(serializeToDomElement("librepcb_board_user_settings"));
+        SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_board_user_settings"));
         mFile->save(doc, toOriginal);
     } catch (Exception& e) {
         success = false;
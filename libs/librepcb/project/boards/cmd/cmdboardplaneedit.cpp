@@ -42,6 +42,12 @@ CmdBoardPlaneEdit::CmdBoardPlaneEdit(BI_Plane& plane, bool rebuildOnChanges) noe
     mOldMinWidth(plane.getMinWidth()), mNewMinWidth(mOldMinWidth),
     mOldMinClearance(plane.getMinClearance()), mNewMinClearance(mOldMinClearance),
     mOldConnectStyle(plane.getConnectStyle()), mNewConnectStyle(mOldConnectStyle),
+    mOldThermalGapWidth(plane.getThermalGapWidth()), mNewThermalGapWidth(mOldThermalGapWidth),
+    mOldThermalSpokeWidth(plane.getThermalSpokeWidth()),
+    mNewThermalSpokeWidth(mOldThermalSpokeWidth),
+    mOldFillStyle(plane.getFillStyle()), mNewFillStyle(mOldFillStyle),
+    mOldHatchWidth(plane.getHatchWidth()), mNewHatchWidth(mOldHatchWidth),
+    mOldHatchPitch(plane.getHatchPitch()), mNewHatchPitch(mOldHatchPitch),
     mOldPriority(plane.getPriority()), mNewPriority(mOldPriority),
     mOldKeepOrphans(plane.getKeepOrphans()), mNewKeepOrphans(mOldKeepOrphans)
 {
@@ -111,6 +117,36 @@ void CmdBoardPlaneEdit::setConnectStyle(BI_Plane::ConnectStyle style) noexcept
     mNewConnectStyle = style;
 }
 
+void CmdBoardPlaneEdit::setThermalGapWidth(const Length& width) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewThermalGapWidth = width;
+}
+
+void CmdBoardPlaneEdit::setThermalSpokeWidth(const Length& width) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewThermalSpokeWidth = width;
+}
+
+void CmdBoardPlaneEdit::setFillStyle(BI_Plane::FillStyle style) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewFillStyle = style;
+}
+
+void CmdBoardPlaneEdit::setHatchWidth(const Length& width) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewHatchWidth = width;
+}
+
+void CmdBoardPlaneEdit::setHatchPitch(const Length& pitch) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewHatchPitch = pitch;
+}
+
 void CmdBoardPlaneEdit::setPriority(int priority) noexcept
 {
     Q_ASSERT(!wasEverExecuted());
@@ -137,6 +173,11 @@ bool CmdBoardPlaneEdit::performExecute()
     if (mNewMinWidth != mOldMinWidth)           return true;
     if (mNewMinClearance != mOldMinClearance)   return true;
     if (mNewConnectStyle != mOldConnectStyle)   return true;
+    if (mNewThermalGapWidth != mOldThermalGapWidth)     return true;
+    if (mNewThermalSpokeWidth != mOldThermalSpokeWidth) return true;
+    if (mNewFillStyle != mOldFillStyle)         return true;
+    if (mNewHatchWidth != mOldHatchWidth)       return true;
+    if (mNewHatchPitch != mOldHatchPitch)       return true;
     if (mNewPriority != mOldPriority)           return true;
     if (mNewKeepOrphans != mOldKeepOrphans)     return true;
     return false;
@@ -144,12 +185,16 @@ bool CmdBoardPlaneEdit::performExecute()
 
 void CmdBoardPlaneEdit::performUndo()
 {
+    applyHatch(mOldHatchWidth, mOldHatchPitch); // can throw
     mPlane.setNetSignal(*mOldNetSignal); // can throw
     mPlane.setOutline(mOldOutline);
     mPlane.setLayerName(mOldLayerName);
     mPlane.setMinWidth(mOldMinWidth);
     mPlane.setMinClearance(mOldMinClearance);
     mPlane.setConnectStyle(mOldConnectStyle);
+    mPlane.setThermalGapWidth(mOldThermalGapWidth);
+    mPlane.setThermalSpokeWidth(mOldThermalSpokeWidth);
+    mPlane.setFillStyle(mOldFillStyle);
     mPlane.setPriority(mOldPriority);
     mPlane.setKeepOrphans(mOldKeepOrphans);
 
@@ -159,12 +204,16 @@ void CmdBoardPlaneEdit::performUndo()
 
 void CmdBoardPlaneEdit::performRedo()
 {
+    applyHatch(mNewHatchWidth, mNewHatchPitch); // can throw
     mPlane.setNetSignal(*mNewNetSignal); // can throw
     mPlane.setOutline(mNewOutline);
     mPlane.setLayerName(mNewLayerName);
     mPlane.setMinWidth(mNewMinWidth);
     mPlane.setMinClearance(mNewMinClearance);
     mPlane.setConnectStyle(mNewConnectStyle);
+    mPlane.setThermalGapWidth(mNewThermalGapWidth);
+    mPlane.setThermalSpokeWidth(mNewThermalSpokeWidth);
+    mPlane.setFillStyle(mNewFillStyle);
     mPlane.setPriority(mNewPriority);
     mPlane.setKeepOrphans(mNewKeepOrphans);
 
@@ -172,6 +221,23 @@ void CmdBoardPlaneEdit::performRedo()
     if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void CmdBoardPlaneEdit::applyHatch(const Length& width, const Length& pitch)
+{
+    // the plane rejects a pitch which is not greater than the width, so the order of the
+    // two setters depends on whether the hatch gets finer or coarser
+    if (width < mPlane.getHatchPitch()) {
+        mPlane.setHatchWidth(width); // can throw
+        mPlane.setHatchPitch(pitch); // can throw
+    } else {
+        mPlane.setHatchPitch(pitch); // can throw
+        mPlane.setHatchWidth(width); // can throw
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
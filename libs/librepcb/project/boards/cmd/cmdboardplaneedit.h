@@ -60,6 +60,11 @@ class CmdBoardPlaneEdit final : public UndoCommand
         void setMinWidth(const Length& minWidth) noexcept;
         void setMinClearance(const Length& minClearance) noexcept;
         void setConnectStyle(BI_Plane::ConnectStyle style) noexcept;
+        void setThermalGapWidth(const Length& width) noexcept;
+        void setThermalSpokeWidth(const Length& width) noexcept;
+        void setFillStyle(BI_Plane::FillStyle style) noexcept;
+        void setHatchWidth(const Length& width) noexcept;
+        void setHatchPitch(const Length& pitch) noexcept;
         void setPriority(int priority) noexcept;
         void setKeepOrphans(bool keepOrphans) noexcept;
 
@@ -77,6 +82,8 @@ class CmdBoardPlaneEdit final : public UndoCommand
         /// @copydoc UndoCommand::performRedo()
         void performRedo() override;
 
+        void applyHatch(const Length& width, const Length& pitch);
+
 
         // Private Member Variables
 
@@ -97,6 +104,16 @@ class CmdBoardPlaneEdit final : public UndoCommand
         Length mNewMinClearance;
         BI_Plane::ConnectStyle mOldConnectStyle;
         BI_Plane::ConnectStyle mNewConnectStyle;
+        Length mOldThermalGapWidth;
+        Length mNewThermalGapWidth;
+        Length mOldThermalSpokeWidth;
+        Length mNewThermalSpokeWidth;
+        BI_Plane::FillStyle mOldFillStyle;
+        BI_Plane::FillStyle mNewFillStyle;
+        Length mOldHatchWidth;
+        Length mNewHatchWidth;
+        Length mOldHatchPitch;
+        Length mNewHatchPitch;
         int mOldPriority;
         int mNewPriority;
         bool mOldKeepOrphans;
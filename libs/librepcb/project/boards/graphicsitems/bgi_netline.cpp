@@ -86,8 +86,7 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
     mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
     QPainterPathStroker ps;
     ps.setCapStyle(Qt::RoundCap);
-    Length width = (mNetLine.getWidth() > Length(100000) ? mNetLine.getWidth() : Length(100000));
-    ps.setWidth(width.toPx());
+    ps.setWidth(mNetLine.getGrabAreaWidth().toPx());
     mShape = ps.createStroke(mShape);
     update();
 }
@@ -38,7 +38,8 @@ namespace project {
  ****************************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept :
-    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
+    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false),
+    mSceneGraphicsItem(nullptr)
 {
 }
 
@@ -80,6 +81,7 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept
     if (item) {
         mBoard.getGraphicsScene().addItem(*item);
     }
+    mSceneGraphicsItem = item;
     mIsAddedToBoard = true;
 }
 
@@ -89,6 +91,7 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept
     if (item) {
         mBoard.getGraphicsScene().removeItem(*item);
     }
+    mSceneGraphicsItem = nullptr;
     mIsAddedToBoard = false;
 }
 
@@ -88,6 +88,14 @@ class BI_Base : public QObject
         virtual bool isSelectable() const noexcept = 0;
         virtual bool isSelected() const noexcept {return mIsSelected;}
 
+        /**
+         * @brief Get the graphics item which was added to the scene by #addToBoard()
+         *
+         * @return The graphics item, or nullptr if the item is not added to the board
+         *         or has no graphics item
+         */
+        QGraphicsItem* getSceneGraphicsItem() const noexcept {return mSceneGraphicsItem;}
+
         // Setters
         virtual void setSelected(bool selected) noexcept;
 
@@ -116,6 +124,7 @@ class BI_Base : public QObject
         // General Attributes
         bool mIsAddedToBoard;
         bool mIsSelected;
+        QGraphicsItem* mSceneGraphicsItem;
 };
 
 /*****************************************************************************************
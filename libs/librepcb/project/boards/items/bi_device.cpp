@@ -233,7 +233,7 @@ void BI_Device::serialize(SExpression& root) const
     root.appendToken(mCompInstance->getUuid());
     root.appendTokenChild("lib_device", mLibDevice->getUuid(), true);
     root.appendTokenChild("lib_footprint", mLibFootprint->getUuid(), true);
-    root.appendChild(mPosition.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     root.appendTokenChild("rot", mRotation, false);
     root.appendTokenChild("mirror", mIsMirrored, false);
     mAttributes.serialize(root);
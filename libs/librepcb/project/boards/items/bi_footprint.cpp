@@ -47,7 +47,7 @@ namespace project {
  ****************************************************************************************/
 
 BI_Footprint::BI_Footprint(BI_Device& device, const BI_Footprint& other) :
-    BI_Base(device.getBoard()), mDevice(device)
+    BI_Base(device.getBoard()), mDevice(device), mAttributeSubstitutionCache(*this)
 {
     foreach (const BI_StrokeText* text, other.mStrokeTexts) {
         addStrokeText(*new BI_StrokeText(mBoard, *text));
@@ -56,7 +56,7 @@ BI_Footprint::BI_Footprint(BI_Device& device, const BI_Footprint& other) :
 }
 
 BI_Footprint::BI_Footprint(BI_Device& device, const SExpression& node) :
-    BI_Base(device.getBoard()), mDevice(device)
+    BI_Base(device.getBoard()), mDevice(device), mAttributeSubstitutionCache(*this)
 {
     foreach (const SExpression& node, node.getChildren("stroke_text")) {
         addStrokeText(*new BI_StrokeText(mBoard, node)); // can throw
@@ -65,7 +65,7 @@ BI_Footprint::BI_Footprint(BI_Device& device, const SExpression& node) :
 }
 
 BI_Footprint::BI_Footprint(BI_Device& device) :
-    BI_Base(device.getBoard()), mDevice(device)
+    BI_Base(device.getBoard()), mDevice(device), mAttributeSubstitutionCache(*this)
 {
     resetStrokeTextsToLibraryFootprint();
     init();
@@ -222,7 +222,7 @@ void BI_Footprint::removeFromBoard()
 void BI_Footprint::serialize(SExpression& root) const
 {
     foreach (const BI_StrokeText* text, mStrokeTexts) {
-        root.appendChild(text->serializeToDomElement("stroke_text"), true);
+        root.appendChild(serializeToDomElement(*text, "stroke_text"), true);
     }
 }
 
@@ -291,14 +291,14 @@ void BI_Footprint::setSelected(bool selected) noexcept
 
 void BI_Footprint::deviceInstanceAttributesChanged()
 {
+    emit attributesChanged(); // must be emitted first to invalidate substitution caches
     mGraphicsItem->updateCacheAndRepaint();
-    emit attributesChanged();
 }
 
 void BI_Footprint::deviceInstanceMoved(const Point& pos)
 {
+    // all shapes are in footprint-local coordinates, so only the positions are updated
     mGraphicsItem->setPos(pos.toPxQPointF());
-    mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
         mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -312,7 +312,6 @@ void BI_Footprint::deviceInstanceRotated(const Angle& rot)
 {
     Q_UNUSED(rot);
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
         mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -323,9 +322,10 @@ void BI_Footprint::deviceInstanceMirrored(bool mirrored)
 {
     Q_UNUSED(mirrored);
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
+    mGraphicsItem->updateCacheAndRepaint(); // layers are mirrored too
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
+        pad->updateGraphicsItems();
         mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
     }
 }
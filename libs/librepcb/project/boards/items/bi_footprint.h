@@ -27,6 +27,7 @@
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/attributes/attributeprovider.h>
+#include <librepcb/common/attributes/attributesubstitutioncache.h>
 #include "bi_stroketext.h"
 #include "../graphicsitems/bgi_footprint.h"
 
@@ -101,6 +102,11 @@ class BI_Footprint final : public BI_Base, public SerializableObject,
         /// @copydoc librepcb::AttributeProvider::getAttributeProviderParents()
         QVector<const AttributeProvider*> getAttributeProviderParents() const noexcept override;
 
+        /// @copydoc librepcb::AttributeProvider::getAttributeSubstitutionCache()
+        AttributeSubstitutionCache* getAttributeSubstitutionCache() const noexcept override {
+            return &mAttributeSubstitutionCache;
+        }
+
         // Inherited from BI_Base
         Type_t getType() const noexcept override {return BI_Base::Type_t::Footprint;}
         const Point& getPosition() const noexcept override;
@@ -130,6 +136,7 @@ class BI_Footprint final : public BI_Base, public SerializableObject,
 
         // General
         BI_Device& mDevice;
+        mutable AttributeSubstitutionCache mAttributeSubstitutionCache;
         QScopedPointer<BGI_Footprint> mGraphicsItem;
         QMap<Uuid, BI_FootprintPad*> mPads; ///< key: footprint pad UUID
         QList<BI_StrokeText*> mStrokeTexts;
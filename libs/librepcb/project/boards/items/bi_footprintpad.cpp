@@ -182,12 +182,16 @@ void BI_FootprintPad::updatePosition() noexcept
     mRotation = mFootprint.getRotation() + mFootprintPad->getRotation();
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_NetPoint* netpoint, mRegisteredNetPoints) {
         netpoint->setPosition(mPosition);
     }
 }
 
+void BI_FootprintPad::updateGraphicsItems() noexcept
+{
+    mGraphicsItem->updateCacheAndRepaint();
+}
+
 /*****************************************************************************************
  *  Inherited from BI_Base
  ****************************************************************************************/
@@ -229,7 +233,7 @@ Path BI_FootprintPad::getSceneOutline(const Length& expansion) const noexcept
 
 void BI_FootprintPad::footprintAttributesChanged()
 {
-    mGraphicsItem->updateCacheAndRepaint();
+    updateGraphicsItems();
 }
 
 void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from, NetSignal* to)
@@ -86,8 +86,21 @@ class BI_FootprintPad final : public BI_Base
         void removeFromBoard() override;
         void registerNetPoint(BI_NetPoint& netpoint);
         void unregisterNetPoint(BI_NetPoint& netpoint);
+
+        /**
+         * @brief Update the position and rotation after the footprint was moved/rotated
+         *
+         * This only updates the transformation of the graphics item since its shapes are
+         * kept in pad-local coordinates. Use #updateGraphicsItems() if the shapes or
+         * layers have changed (e.g. after mirroring).
+         */
         void updatePosition() noexcept;
 
+        /**
+         * @brief Rebuild the shapes of the graphics item and assign its layers
+         */
+        void updateGraphicsItems() noexcept;
+
 
         // Inherited from BI_Base
         Type_t getType() const noexcept override {return BI_Base::Type_t::FootprintPad;}
@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "bi_netline.h"
 #include "../board.h"
+#include "../boardstatistics.h"
 #include "bi_netpoint.h"
 #include "bi_netsegment.h"
 #include "../../project.h"
@@ -186,6 +187,7 @@ void BI_NetLine::setWidth(const Length& width) noexcept
     if ((width != mWidth) && (width >= 0)) {
         mWidth = width;
         mGraphicsItem->updateCacheAndRepaint();
+        mBoard.getStatistics().invalidateNetSignal(&getNetSignalOfNetSegment());
     }
 }
 
@@ -210,6 +212,7 @@ void BI_NetLine::addToBoard()
                                               &NetSignal::highlightedChanged,
                                               [this](){mGraphicsItem->update();});
     BI_Base::addToBoard(mGraphicsItem.data());
+    mBoard.getStatistics().invalidateNetSignal(&getNetSignalOfNetSegment());
     sg.dismiss();
 }
 
@@ -228,6 +231,7 @@ void BI_NetLine::removeFromBoard()
 
     disconnect(mHighlightChangedConnection);
     BI_Base::removeFromBoard(mGraphicsItem.data());
+    mBoard.getStatistics().invalidateNetSignal(&getNetSignalOfNetSegment());
     sg.dismiss();
 }
 
@@ -235,6 +239,7 @@ void BI_NetLine::updateLine() noexcept
 {
     mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.getStatistics().invalidateNetSignal(&getNetSignalOfNetSegment());
 }
 
 void BI_NetLine::serialize(SExpression& root) const
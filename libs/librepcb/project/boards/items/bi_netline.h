@@ -68,6 +68,8 @@ class BI_NetLine final : public BI_Base, public SerializableObject
         BI_NetSegment& getNetSegment() const noexcept;
         const Uuid& getUuid() const noexcept {return mUuid;}
         const Length& getWidth() const noexcept {return mWidth;}
+        /// Width of the grab area (may be larger than the line to make it easier to grab)
+        Length getGrabAreaWidth() const noexcept {return qMax(mWidth, Length(100000));}
         BI_NetPoint& getStartPoint() const noexcept {return *mStartPoint;}
         BI_NetPoint& getEndPoint() const noexcept {return *mEndPoint;}
         BI_NetPoint* getOtherPoint(const BI_NetPoint& firstPoint) const noexcept;
@@ -263,7 +263,9 @@ void BI_NetPoint::setViaToAttach(BI_Via* via)
         mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
         sgl.dismiss();
     }
+    BI_Via* oldVia = mVia;
     mVia = via;
+    mNetSegment.updateNetPointConnectivity(*this, oldVia);
     mGraphicsItem->updateCacheAndRepaint();
 }
 
@@ -374,7 +376,7 @@ void BI_NetPoint::serialize(SExpression& root) const
     } else if (isAttachedToVia()) {
         root.appendTokenChild("via", mVia->getUuid(), true);
     } else {
-        root.appendChild(mPosition.serializeToDomElement("pos"), true);
+        root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     }
 }
 
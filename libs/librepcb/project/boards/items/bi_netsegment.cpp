@@ -34,6 +34,7 @@
 #include "../../circuit/netsignal.h"
 #include "../../circuit/componentsignalinstance.h"
 #include <librepcb/common/scopeguardlist.h>
+#include <librepcb/common/utils/geometrykernel.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -80,6 +81,10 @@ BI_NetSegment::BI_NetSegment(Board& board, const BI_NetSegment& other,
         mNetLines.append(copy);
         copiedNetLines.append(copy);
     }
+    // build connectivity graph
+    foreach (const BI_Via* via, mVias) {addToConnectivity(*via);}
+    foreach (const BI_NetPoint* netpoint, mNetPoints) {addToConnectivity(*netpoint);}
+    foreach (const BI_NetLine* netline, mNetLines) {addToConnectivity(*netline);}
 }
 
 BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node) :
@@ -129,6 +134,11 @@ BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node) :
             mNetLines.append(netline);
         }
 
+        // build connectivity graph
+        foreach (const BI_Via* via, mVias) {addToConnectivity(*via);}
+        foreach (const BI_NetPoint* netpoint, mNetPoints) {addToConnectivity(*netpoint);}
+        foreach (const BI_NetLine* netline, mNetLines) {addToConnectivity(*netline);}
+
         if (!areAllNetPointsConnectedTogether()) {
             throw RuntimeError(__FILE__, __LINE__,
                 QString(tr("The netsegment with the UUID \"%1\" is not cohesive!"))
@@ -201,10 +211,23 @@ int BI_NetSegment::getNetPointsAtScenePos(const Point& pos, const GraphicsLayer*
 int BI_NetSegment::getNetLinesAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                          QList<BI_NetLine*>& lines) const noexcept
 {
+    // the grab areas of netlines are round capped strokes, so a netline is hit if its
+    // distance to pos is not larger than half of the grab area width
+    GeometryKernel::SegmentArray segments;
+    segments.reserve(mNetLines.count());
+    foreach (const BI_NetLine* netline, mNetLines) {
+        segments.append(netline->getStartPoint().getPosition(),
+                        netline->getEndPoint().getPosition());
+    }
+    QVarLengthArray<qreal, 256> distances(mNetLines.count());
+    GeometryKernel::squaredDistancesToSegments(pos, segments, distances.data());
+
     int count = 0;
-    foreach (BI_NetLine* netline, mNetLines) {
-        if (netline->isSelectable()
-            && netline->getGrabAreaScenePx().contains(pos.toPxQPointF())
+    for (int i = 0; i < mNetLines.count(); ++i) {
+        BI_NetLine* netline = mNetLines.at(i);
+        qreal radius = netline->getGrabAreaWidth().toNm() / qreal(2);
+        if ((distances[i] <= radius * radius)
+            && netline->isSelectable()
             && ((!layer) || (&netline->getLayer() == layer)))
         {
             lines.append(netline);
@@ -299,7 +322,9 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
         // add to board
         via->addToBoard(); // can throw
         mVias.append(via);
-        sgl.add([this, via](){via->removeFromBoard(); mVias.removeOne(via);});
+        addToConnectivity(*via);
+        sgl.add([this, via](){
+            via->removeFromBoard(); mVias.removeOne(via); removeFromConnectivity(*via);});
     }
     foreach (BI_NetPoint* netpoint, netpoints) {
         if ((mNetPoints.contains(netpoint)) || (&netpoint->getNetSegment() != this)) {
@@ -314,7 +339,9 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
         // add to board
         netpoint->addToBoard(); // can throw
         mNetPoints.append(netpoint);
-        sgl.add([this, netpoint](){netpoint->removeFromBoard(); mNetPoints.removeOne(netpoint);});
+        addToConnectivity(*netpoint);
+        sgl.add([this, netpoint](){
+            netpoint->removeFromBoard(); mNetPoints.removeOne(netpoint); removeFromConnectivity(*netpoint);});
     }
     foreach (BI_NetLine* netline, netlines) {
         if ((mNetLines.contains(netline)) || (&netline->getNetSegment() != this)) {
@@ -329,7 +356,9 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
         // add to board
         netline->addToBoard(); // can throw
         mNetLines.append(netline);
-        sgl.add([this, netline](){netline->removeFromBoard(); mNetLines.removeOne(netline);});
+        addToConnectivity(*netline);
+        sgl.add([this, netline](){
+            netline->removeFromBoard(); mNetLines.removeOne(netline); removeFromConnectivity(*netline);});
     }
 
     if (!areAllNetPointsConnectedTogether()) {
@@ -357,7 +386,9 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>& vias,
         // remove from board
         netline->removeFromBoard(); // can throw
         mNetLines.removeOne(netline);
-        sgl.add([this, netline](){netline->addToBoard(); mNetLines.append(netline);});
+        removeFromConnectivity(*netline);
+        sgl.add([this, netline](){
+            netline->addToBoard(); mNetLines.append(netline); addToConnectivity(*netline);});
     }
     foreach (BI_NetPoint* netpoint, netpoints) {
         if (!mNetPoints.contains(netpoint)) {
@@ -366,7 +397,9 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>& vias,
         // remove from board
         netpoint->removeFromBoard(); // can throw
         mNetPoints.removeOne(netpoint);
-        sgl.add([this, netpoint](){netpoint->addToBoard(); mNetPoints.append(netpoint);});
+        removeFromConnectivity(*netpoint);
+        sgl.add([this, netpoint](){
+            netpoint->addToBoard(); mNetPoints.append(netpoint); addToConnectivity(*netpoint);});
     }
     foreach (BI_Via* via, vias) {
         if (!mVias.contains(via)) {
@@ -375,7 +408,9 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>& vias,
         // remove from board
         via->removeFromBoard(); // can throw
         mVias.removeOne(via);
-        sgl.add([this, via](){via->addToBoard(); mVias.append(via);});
+        removeFromConnectivity(*via);
+        sgl.add([this, via](){
+            via->addToBoard(); mVias.append(via); addToConnectivity(*via);});
     }
 
     if (!areAllNetPointsConnectedTogether()) {
@@ -387,6 +422,24 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>& vias,
     sgl.dismiss();
 }
 
+/*****************************************************************************************
+ *  Connectivity Methods
+ ****************************************************************************************/
+
+void BI_NetSegment::updateNetPointConnectivity(const BI_NetPoint& netpoint,
+                                               const BI_Via* oldVia) noexcept
+{
+    if (!mConnectivity.containsNode(&netpoint)) {
+        return; // netpoint is not (yet) part of this netsegment
+    }
+    if (oldVia) {
+        mConnectivity.removeEdge(&netpoint, oldVia);
+    }
+    if (const BI_Via* via = netpoint.getVia()) {
+        mConnectivity.addEdge(&netpoint, via);
+    }
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -443,16 +496,6 @@ void BI_NetSegment::removeFromBoard()
     sgl.dismiss();
 }
 
-void BI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept
-{
-    foreach (BI_Via* via, mVias)
-        via->setSelected(via->isSelectable() && via->getGrabAreaScenePx().intersects(rectPx));
-    foreach (BI_NetPoint* netpoint, mNetPoints)
-        netpoint->setSelected(netpoint->isSelectable() && netpoint->getGrabAreaScenePx().intersects(rectPx));
-    foreach (BI_NetLine* netline, mNetLines)
-        netline->setSelected(netline->isSelectable() && netline->getGrabAreaScenePx().intersects(rectPx));
-}
-
 void BI_NetSegment::clearSelection() const noexcept
 {
     foreach (BI_Via* via, mVias)
@@ -511,35 +554,48 @@ bool BI_NetSegment::checkAttributesValidity() const noexcept
 
 bool BI_NetSegment::areAllNetPointsConnectedTogether() const noexcept
 {
-    if (mNetPoints.count() > 1) {
-        const BI_NetPoint* firstPoint = mNetPoints.first();
-        QList<const BI_NetPoint*> points({firstPoint});
-        findAllConnectedNetPoints(*firstPoint, points);
-        return (points.count() == mNetPoints.count());
-    } else {
-        return true; // there is only 0 or 1 netpoint => must be "connected together" :)
+    // vias without netpoints are irrelevant, so the group count can't be used
+    foreach (const BI_NetPoint* netpoint, mNetPoints) {
+        if (!mConnectivity.areConnected(mNetPoints.first(), netpoint)) {
+            return false;
+        }
     }
+    return true;
 }
 
-void BI_NetSegment::findAllConnectedNetPoints(const BI_NetPoint& p, QList<const BI_NetPoint*>& points) const noexcept
+void BI_NetSegment::addToConnectivity(const BI_Via& via) noexcept
 {
-    if (p.isAttachedToVia()) { Q_ASSERT(p.getVia());
-        foreach (const BI_NetPoint* np, mNetPoints) {
-            if ((np->getVia() == p.getVia()) && (!points.contains(np))) {
-                points.append(np);
-                findAllConnectedNetPoints(*np, points);
-            }
-        }
-    }
-    foreach (const BI_NetLine* line, mNetLines) {
-        const BI_NetPoint* p2 = line->getOtherPoint(p);
-        if ((p2) && (!points.contains(p2))) {
-            points.append(p2);
-            findAllConnectedNetPoints(*p2, points);
-        }
+    mConnectivity.addNode(&via);
+}
+
+void BI_NetSegment::addToConnectivity(const BI_NetPoint& netpoint) noexcept
+{
+    mConnectivity.addNode(&netpoint);
+    if (const BI_Via* via = netpoint.getVia()) {
+        mConnectivity.addEdge(&netpoint, via);
     }
 }
 
+void BI_NetSegment::addToConnectivity(const BI_NetLine& netline) noexcept
+{
+    mConnectivity.addEdge(&netline.getStartPoint(), &netline.getEndPoint());
+}
+
+void BI_NetSegment::removeFromConnectivity(const BI_Via& via) noexcept
+{
+    mConnectivity.removeNode(&via);
+}
+
+void BI_NetSegment::removeFromConnectivity(const BI_NetPoint& netpoint) noexcept
+{
+    mConnectivity.removeNode(&netpoint);
+}
+
+void BI_NetSegment::removeFromConnectivity(const BI_NetLine& netline) noexcept
+{
+    mConnectivity.removeEdge(&netline.getStartPoint(), &netline.getEndPoint());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "bi_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/connectivitygraph.h>
 #include <librepcb/common/uuid.h>
 
 /*****************************************************************************************
@@ -98,10 +99,29 @@ class BI_NetSegment final : public BI_Base, public SerializableObject
         void removeElements(const QList<BI_Via*>& vias, const QList<BI_NetPoint*>& netpoints,
                             const QList<BI_NetLine*>& netlines);
 
+        // Connectivity Methods
+
+        /**
+         * @brief Get the connectivity of all vias and netpoints of this netsegment
+         *
+         * Netpoints are connected by netlines and to the via they are attached to. The
+         * graph is updated incrementally whenever elements are added or removed.
+         */
+        const ConnectivityGraph<const BI_Base*>& getConnectivity() const noexcept {
+            return mConnectivity;
+        }
+
+        /**
+         * @brief Update the connectivity after a netpoint was attached to another via
+         *
+         * Called by BI_NetPoint::setViaToAttach().
+         */
+        void updateNetPointConnectivity(const BI_NetPoint& netpoint,
+                                        const BI_Via* oldVia) noexcept;
+
         // General Methods
         void addToBoard() override;
         void removeFromBoard() override;
-        void setSelectionRect(const QRectF rectPx) noexcept;
         void clearSelection() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
@@ -125,7 +145,12 @@ class BI_NetSegment final : public BI_Base, public SerializableObject
     private:
         bool checkAttributesValidity() const noexcept;
         bool areAllNetPointsConnectedTogether() const noexcept;
-        void findAllConnectedNetPoints(const BI_NetPoint& p, QList<const BI_NetPoint*>& points) const noexcept;
+        void addToConnectivity(const BI_Via& via) noexcept;
+        void addToConnectivity(const BI_NetPoint& netpoint) noexcept;
+        void addToConnectivity(const BI_NetLine& netline) noexcept;
+        void removeFromConnectivity(const BI_Via& via) noexcept;
+        void removeFromConnectivity(const BI_NetPoint& netpoint) noexcept;
+        void removeFromConnectivity(const BI_NetLine& netline) noexcept;
 
 
         // Attributes
@@ -136,6 +161,9 @@ class BI_NetSegment final : public BI_Base, public SerializableObject
         QList<BI_Via*> mVias;
         QList<BI_NetPoint*> mNetPoints;
         QList<BI_NetLine*> mNetLines;
+
+        /// Vias and netpoints, connected by netlines and via attachments
+        ConnectivityGraph<const BI_Base*> mConnectivity;
 };
 
 /*****************************************************************************************
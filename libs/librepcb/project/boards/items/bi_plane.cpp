@@ -27,6 +27,8 @@
 #include "../../circuit/netsignal.h"
 #include "../graphicsitems/bgi_plane.h"
 #include "../boardplanefragmentsbuilder.h"
+#include "../boardplanefragmentscache.h"
+#include "../boardstatistics.h"
 #include <librepcb/common/scopeguard.h>
 
 /*****************************************************************************************
@@ -45,7 +47,9 @@ BI_Plane::BI_Plane(Board& board, const BI_Plane& other) :
     mMinWidth(other.mMinWidth), mMinClearance(other.mMinClearance),
     mKeepOrphans(other.mKeepOrphans), mPriority(other.mPriority),
     mConnectStyle(other.mConnectStyle),
-    //mThermalGapWidth(other.mThermalGapWidth), mThermalSpokeWidth(other.mThermalSpokeWidth),
+    mThermalGapWidth(other.mThermalGapWidth), mThermalSpokeWidth(other.mThermalSpokeWidth),
+    mFillStyle(other.mFillStyle), mHatchWidth(other.mHatchWidth),
+    mHatchPitch(other.mHatchPitch),
     mFragments(other.mFragments) // also copy fragments to avoid the need for a rebuild
 {
     init();
@@ -68,15 +72,43 @@ BI_Plane::BI_Plane(Board& board, const SExpression& node) :
     mPriority = node.getValueByPath<int>("priority", true);
     if (node.getValueByPath<QString>("connect_style", true) == "none") {
         mConnectStyle = ConnectStyle::None;
-    //} else if (node.getValueByPath<QString>("connect_style", true) == "thermal") {
-    //    mConnectStyle = ConnectStyle::Thermal;
+    } else if (node.getValueByPath<QString>("connect_style", true) == "thermal") {
+        mConnectStyle = ConnectStyle::Thermal;
     } else if (node.getValueByPath<QString>("connect_style", true) == "solid") {
         mConnectStyle = ConnectStyle::Solid;
     } else {
         throw RuntimeError(__FILE__, __LINE__, tr("Unknown plane connect style."));
     }
-    //mThermalGapWidth = node.getValueByPath<Length>("thermal_gap_width", true);
-    //mThermalSpokeWidth = node.getValueByPath<Length>("thermal_spoke_width", true);
+    // thermal parameters are optional to keep older boards loadable
+    mThermalGapWidth = Length(sDefaultThermalGapWidth);
+    mThermalSpokeWidth = Length(sDefaultThermalSpokeWidth);
+    if (const SExpression* child = node.tryGetChildByPath("thermal_gap_width")) {
+        mThermalGapWidth = child->getValueOfFirstChild<Length>(true);
+    }
+    if (const SExpression* child = node.tryGetChildByPath("thermal_spoke_width")) {
+        mThermalSpokeWidth = child->getValueOfFirstChild<Length>(true);
+    }
+    // the fill style is optional as well, older boards have only solid planes
+    mFillStyle = FillStyle::Solid;
+    mHatchWidth = Length(sDefaultHatchWidth);
+    mHatchPitch = Length(sDefaultHatchPitch);
+    if (const SExpression* child = node.tryGetChildByPath("fill_style")) {
+        QString fillStyle = child->getValueOfFirstChild<QString>(true);
+        if (fillStyle == "solid") {
+            mFillStyle = FillStyle::Solid;
+        } else if (fillStyle == "hatched") {
+            mFillStyle = FillStyle::Hatched;
+        } else {
+            throw RuntimeError(__FILE__, __LINE__, tr("Unknown plane fill style."));
+        }
+    }
+    if (const SExpression* child = node.tryGetChildByPath("hatch_width")) {
+        mHatchWidth = child->getValueOfFirstChild<Length>(true);
+    }
+    if (const SExpression* child = node.tryGetChildByPath("hatch_pitch")) {
+        mHatchPitch = child->getValueOfFirstChild<Length>(true);
+    }
+    checkHatchAttributes(mHatchWidth, mHatchPitch); // can throw
     mOutline = Path(node);
     init();
 }
@@ -86,7 +118,9 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const QString& layerName,
     BI_Base(board), mUuid(uuid), mLayerName(layerName), mNetSignal(&netsignal),
     mOutline(outline), mMinWidth(200000), mMinClearance(300000), mKeepOrphans(false),
     mPriority(0), mConnectStyle(ConnectStyle::Solid),
-    //mThermalGapWidth(100000), mThermalSpokeWidth(100000),
+    mThermalGapWidth(sDefaultThermalGapWidth), mThermalSpokeWidth(sDefaultThermalSpokeWidth),
+    mFillStyle(FillStyle::Solid), mHatchWidth(sDefaultHatchWidth),
+    mHatchPitch(sDefaultHatchPitch),
     mFragments()
 {
     init();
@@ -124,6 +158,7 @@ void BI_Plane::setLayerName(const QString& layerName) noexcept
     if (layerName != mLayerName) {
         mLayerName = layerName;
         mGraphicsItem->updateCacheAndRepaint();
+        mBoard.getStatistics().invalidatePlane(this);
     }
 }
 
@@ -140,6 +175,7 @@ void BI_Plane::setNetSignal(NetSignal& netsignal)
             sg.dismiss();
         }
         mNetSignal = &netsignal;
+        mBoard.getStatistics().invalidatePlane(this);
     }
 }
 
@@ -164,6 +200,43 @@ void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept
     }
 }
 
+void BI_Plane::setThermalGapWidth(const Length& width) noexcept
+{
+    if (width != mThermalGapWidth) {
+        mThermalGapWidth = width;
+    }
+}
+
+void BI_Plane::setThermalSpokeWidth(const Length& width) noexcept
+{
+    if (width != mThermalSpokeWidth) {
+        mThermalSpokeWidth = width;
+    }
+}
+
+void BI_Plane::setFillStyle(BI_Plane::FillStyle style) noexcept
+{
+    if (style != mFillStyle) {
+        mFillStyle = style;
+    }
+}
+
+void BI_Plane::setHatchWidth(const Length& width)
+{
+    checkHatchAttributes(width, mHatchPitch); // can throw
+    if (width != mHatchWidth) {
+        mHatchWidth = width;
+    }
+}
+
+void BI_Plane::setHatchPitch(const Length& pitch)
+{
+    checkHatchAttributes(mHatchWidth, pitch); // can throw
+    if (pitch != mHatchPitch) {
+        mHatchPitch = pitch;
+    }
+}
+
 void BI_Plane::setPriority(int priority) noexcept
 {
     if (priority != mPriority) {
@@ -191,6 +264,7 @@ void BI_Plane::addToBoard()
     BI_Base::addToBoard(mGraphicsItem.data());
     mGraphicsItem->updateCacheAndRepaint(); // TODO: remove this
     mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.getStatistics().invalidatePlane(this);
 }
 
 void BI_Plane::removeFromBoard()
@@ -201,20 +275,43 @@ void BI_Plane::removeFromBoard()
     mNetSignal->unregisterBoardPlane(*this); // can throw
     BI_Base::removeFromBoard(mGraphicsItem.data());
     mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.getStatistics().invalidatePlane(this);
 }
 
 void BI_Plane::clear() noexcept
 {
     mFragments.clear();
+    mFragmentsInputHash.clear();
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.getStatistics().invalidatePlane(this);
 }
 
 void BI_Plane::rebuild() noexcept
 {
+    BoardPlaneFragmentsCache::BoardInputHashes boardInputHashes;
+    rebuild(boardInputHashes);
+}
+
+void BI_Plane::rebuild(BoardPlaneFragmentsCache::BoardInputHashes& boardInputHashes) noexcept
+{
+    // the hash must be calculated from the same inputs as the fragments, otherwise
+    // the fragments cache could store outdated fragments as valid
+    mFragmentsInputHash = BoardPlaneFragmentsCache::calcInputHash(*this, boardInputHashes);
     BoardPlaneFragmentsBuilder builder(*this);
     mFragments = builder.buildFragments();
     mGraphicsItem->updateCacheAndRepaint();
     mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.getStatistics().invalidatePlane(this);
+}
+
+void BI_Plane::restoreFragments(const QVector<Path>& fragments,
+                                const QByteArray& inputHash) noexcept
+{
+    mFragments = fragments;
+    mFragmentsInputHash = inputHash;
+    mGraphicsItem->updateCacheAndRepaint();
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
+    mBoard.getStatistics().invalidatePlane(this);
 }
 
 void BI_Plane::serialize(SExpression& root) const
@@ -229,13 +326,30 @@ void BI_Plane::serialize(SExpression& root) const
     QString connectStyle;
     switch (mConnectStyle) {
         case ConnectStyle::None:    connectStyle = "none";      break;
-        //case ConnectStyle::Thermal: connectStyle = "thermal";   break;
+        case ConnectStyle::Thermal: connectStyle = "thermal";   break;
         case ConnectStyle::Solid:   connectStyle = "solid";     break;
         default: throw LogicError(__FILE__, __LINE__);
     }
     root.appendTokenChild("connect_style", connectStyle, true);
-    //root.appendTokenChild("thermal_gap_width", mThermalGapWidth, false);
-    //root.appendTokenChild("thermal_spoke_width", mThermalSpokeWidth, false);
+    // the optional attributes are written only if they differ from the defaults used
+    // when loading, so boards which don't use them are not modified by saving
+    if (mThermalGapWidth != Length(sDefaultThermalGapWidth)) {
+        root.appendTokenChild("thermal_gap_width", mThermalGapWidth, false);
+    }
+    if (mThermalSpokeWidth != Length(sDefaultThermalSpokeWidth)) {
+        root.appendTokenChild("thermal_spoke_width", mThermalSpokeWidth, false);
+    }
+    switch (mFillStyle) {
+        case FillStyle::Solid:      break;
+        case FillStyle::Hatched:    root.appendTokenChild("fill_style", QString("hatched"), true); break;
+        default: throw LogicError(__FILE__, __LINE__);
+    }
+    if (mHatchWidth != Length(sDefaultHatchWidth)) {
+        root.appendTokenChild("hatch_width", mHatchWidth, false);
+    }
+    if (mHatchPitch != Length(sDefaultHatchPitch)) {
+        root.appendTokenChild("hatch_pitch", mHatchPitch, false);
+    }
     mOutline.serialize(root);
 }
 
@@ -284,6 +398,22 @@ void BI_Plane::boardAttributesChanged()
     mGraphicsItem->updateCacheAndRepaint();
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BI_Plane::checkHatchAttributes(const Length& width, const Length& pitch)
+{
+    if (width <= 0) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The plane hatch width must be greater than zero!"));
+    }
+    if (pitch <= width) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The plane hatch pitch must be greater than the hatch width!"));
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
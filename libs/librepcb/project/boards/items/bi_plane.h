@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "bi_base.h"
+#include "../boardplanefragmentscache.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/geometry/path.h>
 #include <librepcb/common/uuid.h>
@@ -59,9 +60,13 @@ class BI_Plane final : public BI_Base, public SerializableObject
         // Types
         enum class ConnectStyle {
             None,       ///< do not connect pads/vias to plane
-            //Thermal,    ///< add thermals to connect pads/vias to plane
+            Thermal,    ///< add thermals to connect pads/vias to plane
             Solid,      ///< completely connect pads/vias to plane
         };
+        enum class FillStyle {
+            Solid,      ///< fill the whole plane area with copper
+            Hatched,    ///< fill the plane area with a cross-hatch lattice
+        };
 
         // Constructors / Destructor
         BI_Plane() = delete;
@@ -81,10 +86,14 @@ class BI_Plane final : public BI_Base, public SerializableObject
         bool getKeepOrphans() const noexcept {return mKeepOrphans;}
         int getPriority() const noexcept {return mPriority;}
         ConnectStyle getConnectStyle() const noexcept {return mConnectStyle;}
-        //const Length& getThermalGapWidth() const noexcept {return mThermalGapWidth;}
-        //const Length& getThermalSpokeWidth() const noexcept {return mThermalSpokeWidth;}
+        const Length& getThermalGapWidth() const noexcept {return mThermalGapWidth;}
+        const Length& getThermalSpokeWidth() const noexcept {return mThermalSpokeWidth;}
+        FillStyle getFillStyle() const noexcept {return mFillStyle;}
+        const Length& getHatchWidth() const noexcept {return mHatchWidth;}
+        const Length& getHatchPitch() const noexcept {return mHatchPitch;}
         const Path& getOutline() const noexcept {return mOutline;}
         const QVector<Path>& getFragments() const noexcept {return mFragments;}
+        const QByteArray& getFragmentsInputHash() const noexcept {return mFragmentsInputHash;}
         bool isSelectable() const noexcept override;
 
         // Setters
@@ -94,6 +103,11 @@ class BI_Plane final : public BI_Base, public SerializableObject
         void setMinWidth(const Length& minWidth) noexcept;
         void setMinClearance(const Length& minClearance) noexcept;
         void setConnectStyle(ConnectStyle style) noexcept;
+        void setThermalGapWidth(const Length& width) noexcept;
+        void setThermalSpokeWidth(const Length& width) noexcept;
+        void setFillStyle(FillStyle style) noexcept;
+        void setHatchWidth(const Length& width);
+        void setHatchPitch(const Length& pitch);
         void setPriority(int priority) noexcept;
         void setKeepOrphans(bool keepOrphans) noexcept;
 
@@ -102,6 +116,9 @@ class BI_Plane final : public BI_Base, public SerializableObject
         void removeFromBoard() override;
         void clear() noexcept;
         void rebuild() noexcept;
+        void rebuild(BoardPlaneFragmentsCache::BoardInputHashes& boardInputHashes) noexcept;
+        void restoreFragments(const QVector<Path>& fragments,
+                              const QByteArray& inputHash) noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
@@ -125,6 +142,7 @@ class BI_Plane final : public BI_Base, public SerializableObject
 
     private: // Methods
         void init();
+        static void checkHatchAttributes(const Length& width, const Length& pitch);
 
 
     private: // Data
@@ -137,12 +155,22 @@ class BI_Plane final : public BI_Base, public SerializableObject
         bool mKeepOrphans;
         int mPriority;
         ConnectStyle mConnectStyle;
-        //Length mThermalGapWidth;
-        //Length mThermalSpokeWidth;
+        Length mThermalGapWidth;
+        Length mThermalSpokeWidth;
+        FillStyle mFillStyle;
+        Length mHatchWidth;
+        Length mHatchPitch;
         // style [round square miter] ?
         QScopedPointer<BGI_Plane> mGraphicsItem;
 
         QVector<Path> mFragments;
+        QByteArray mFragmentsInputHash; ///< input hash at the time mFragments were built
+
+        // Default values of optional attributes (not written to the file)
+        static constexpr LengthBase_t sDefaultThermalGapWidth = 300000;
+        static constexpr LengthBase_t sDefaultThermalSpokeWidth = 300000;
+        static constexpr LengthBase_t sDefaultHatchWidth = 500000;
+        static constexpr LengthBase_t sDefaultHatchPitch = 2000000;
 };
 
 /*****************************************************************************************
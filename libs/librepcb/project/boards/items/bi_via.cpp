@@ -27,6 +27,7 @@
 #include "bi_netsegment.h"
 #include "../board.h"
 #include "../boardlayerstack.h"
+#include "../boardstatistics.h"
 #include "../../project.h"
 #include "../../circuit/circuit.h"
 #include "../../circuit/netsignal.h"
@@ -192,6 +193,7 @@ void BI_Via::addToBoard()
                                           [this](){mGraphicsItem->update();});
     BI_Base::addToBoard(mGraphicsItem.data());
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
+    mBoard.getStatistics().invalidateNetSignal(&getNetSignalOfNetSegment());
 }
 
 void BI_Via::removeFromBoard()
@@ -202,6 +204,7 @@ void BI_Via::removeFromBoard()
     disconnect(mHighlightChangedConnection);
     BI_Base::removeFromBoard(mGraphicsItem.data());
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
+    mBoard.getStatistics().invalidateNetSignal(&getNetSignalOfNetSegment());
 }
 
 void BI_Via::registerNetPoint(BI_NetPoint& netpoint)
@@ -238,7 +241,7 @@ void BI_Via::serialize(SExpression& root) const
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
     root.appendToken(mUuid);
-    root.appendChild(mPosition.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     root.appendTokenChild("size", mSize, false);
     root.appendTokenChild("drill", mDrillDiameter, false);
     switch (mShape) {
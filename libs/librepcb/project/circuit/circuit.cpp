@@ -186,6 +186,17 @@ void Circuit::setNetClassName(NetClass& netclass, const QString& newName)
     netclass.setName(newName); // can throw
 }
 
+void Circuit::setNetClassClearance(NetClass& netclass, const Length& clearance)
+{
+    // check if the netclass was added to the circuit
+    if (mNetClasses.value(netclass.getUuid()) != &netclass) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    if (clearance == netclass.getClearance()) return;
+    netclass.setClearance(clearance); // can throw
+    emit netClassRulesChanged(netclass);
+}
+
 /*****************************************************************************************
  *  NetSignal Methods
  ****************************************************************************************/
@@ -374,7 +385,7 @@ bool Circuit::save(bool toOriginal, QStringList& errors) noexcept
     // Save "core/circuit.lp"
     try
     {
-        SExpression doc(serializeToDomElement("librepcb_circuit"));
+        SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_circuit"));
         mFile->save(doc, toOriginal);
     }
     catch (Exception& e)
@@ -28,6 +28,7 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/units/all_length_units.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -90,6 +91,7 @@ class Circuit final : public QObject, public SerializableObject
         void addNetClass(NetClass& netclass);
         void removeNetClass(NetClass& netclass);
         void setNetClassName(NetClass& netclass, const QString& newName);
+        void setNetClassClearance(NetClass& netclass, const Length& clearance);
 
         // NetSignal Methods
         QString generateAutoNetSignalName() const noexcept;
@@ -124,6 +126,7 @@ class Circuit final : public QObject, public SerializableObject
 
         void netClassAdded(NetClass& netclass);
         void netClassRemoved(NetClass& netclass);
+        void netClassRulesChanged(NetClass& netclass);
         void netSignalAdded(NetSignal& netsignal);
         void netSignalRemoved(NetSignal& netsignal);
         void componentAdded(ComponentInstance& cmp);
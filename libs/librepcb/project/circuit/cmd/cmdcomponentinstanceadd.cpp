@@ -57,7 +57,7 @@ CmdComponentInstanceAdd::~CmdComponentInstanceAdd() noexcept
 
 bool CmdComponentInstanceAdd::performExecute()
 {
-    library::Component* cmp = mCircuit.getProject().getLibrary().getComponent(mComponentUuid);
+    const library::Component* cmp = mCircuit.getProject().getLibrary().getComponent(mComponentUuid);
     if (!cmp) {
         throw RuntimeError(__FILE__, __LINE__,
             QString(tr("The component with the UUID \"%1\" does not exist in the "
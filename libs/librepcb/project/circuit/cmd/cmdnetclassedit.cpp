@@ -37,7 +37,8 @@ namespace project {
 
 CmdNetClassEdit::CmdNetClassEdit(Circuit& circuit, NetClass& netclass) noexcept :
     UndoCommand(tr("Edit netclass")), mCircuit(circuit), mNetClass(netclass),
-    mOldName(netclass.getName()), mNewName(mOldName)
+    mOldName(netclass.getName()), mNewName(mOldName),
+    mOldClearance(netclass.getClearance()), mNewClearance(mOldClearance)
 {
 }
 
@@ -55,6 +56,12 @@ void CmdNetClassEdit::setName(const QString& name) noexcept
     mNewName = name;
 }
 
+void CmdNetClassEdit::setClearance(const Length& clearance) noexcept
+{
+    Q_ASSERT(!wasEverExecuted());
+    mNewClearance = clearance;
+}
+
 /*****************************************************************************************
  *  Inherited from UndoCommand
  ****************************************************************************************/
@@ -68,12 +75,18 @@ bool CmdNetClassEdit::performExecute()
 
 void CmdNetClassEdit::performUndo()
 {
-    mCircuit.setNetClassName(mNetClass, mOldName); // can throw
+    if (mNetClass.getName() != mOldName) {
+        mCircuit.setNetClassName(mNetClass, mOldName); // can throw
+    }
+    mCircuit.setNetClassClearance(mNetClass, mOldClearance); // can throw
 }
 
 void CmdNetClassEdit::performRedo()
 {
-    mCircuit.setNetClassName(mNetClass, mNewName); // can throw
+    if (mNetClass.getName() != mNewName) {
+        mCircuit.setNetClassName(mNetClass, mNewName); // can throw
+    }
+    mCircuit.setNetClassClearance(mNetClass, mNewClearance); // can throw
 }
 
 /*****************************************************************************************
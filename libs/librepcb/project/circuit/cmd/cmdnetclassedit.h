@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/undocommand.h>
+#include <librepcb/common/units/all_length_units.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -52,6 +53,7 @@ class CmdNetClassEdit final : public UndoCommand
 
         // Setters
         void setName(const QString& name) noexcept;
+        void setClearance(const Length& clearance) noexcept;
 
 
     private:
@@ -77,6 +79,8 @@ class CmdNetClassEdit final : public UndoCommand
         // General Attributes
         QString mOldName;
         QString mNewName;
+        Length mOldClearance;
+        Length mNewClearance;
 };
 
 /*****************************************************************************************
@@ -46,7 +46,7 @@ namespace project {
 
 ComponentInstance::ComponentInstance(Circuit& circuit, const SExpression& node) :
     QObject(&circuit), mCircuit(circuit), mIsAddedToCircuit(false),
-    mLibComponent(nullptr), mCompSymbVar(nullptr), mAttributes()
+    mAttributeSubstitutionCache(*this), mLibComponent(nullptr), mCompSymbVar(nullptr), mAttributes()
 {
     // read general attributes
     mUuid = node.getChildByIndex(0).getValue<Uuid>(true);
@@ -94,7 +94,7 @@ ComponentInstance::ComponentInstance(Circuit& circuit, const SExpression& node)
 ComponentInstance::ComponentInstance(Circuit& circuit, const library::Component& cmp,
         const Uuid& symbVar, const QString& name, const Uuid& defaultDevice) :
     QObject(&circuit), mCircuit(circuit), mIsAddedToCircuit(false),
-    mUuid(Uuid::createRandom()), mName(name), mDefaultDeviceUuid(defaultDevice),
+    mAttributeSubstitutionCache(*this), mUuid(Uuid::createRandom()), mName(name), mDefaultDeviceUuid(defaultDevice),
     mLibComponent(&cmp), mCompSymbVar(nullptr), mAttributes()
 {
     if (mName.isEmpty()) {
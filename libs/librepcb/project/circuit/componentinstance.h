@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <librepcb/common/attributes/attribute.h>
 #include <librepcb/common/attributes/attributeprovider.h>
+#include <librepcb/common/attributes/attributesubstitutioncache.h>
 #include "../erc/if_ercmsgprovider.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/attributes/attribute.h>
@@ -144,6 +145,11 @@ class ComponentInstance : public QObject, public AttributeProvider,
         /// @copydoc librepcb::AttributeProvider::getAttributeProviderParents()
         QVector<const AttributeProvider*> getAttributeProviderParents() const noexcept override;
 
+        /// @copydoc librepcb::AttributeProvider::getAttributeSubstitutionCache()
+        AttributeSubstitutionCache* getAttributeSubstitutionCache() const noexcept override {
+            return &mAttributeSubstitutionCache;
+        }
+
         // Operator Overloadings
         ComponentInstance& operator=(const ComponentInstance& rhs) = delete;
 
@@ -165,6 +171,7 @@ class ComponentInstance : public QObject, public AttributeProvider,
         // General
         Circuit& mCircuit;
         bool mIsAddedToCircuit;
+        mutable AttributeSubstitutionCache mAttributeSubstitutionCache;
 
 
         // Attributes
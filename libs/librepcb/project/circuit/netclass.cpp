@@ -38,17 +38,20 @@ namespace project {
  ****************************************************************************************/
 
 NetClass::NetClass(Circuit& circuit, const SExpression& node) :
-    QObject(&circuit), mCircuit(circuit), mIsAddedToCircuit(false)
+    QObject(&circuit), mCircuit(circuit), mIsAddedToCircuit(false), mClearance(0)
 {
     mUuid = node.getChildByIndex(0).getValue<Uuid>(true);
     mName = node.getValueByPath<QString>("name", true);
+    if (const SExpression* child = node.tryGetChildByPath("clearance")) {
+        mClearance = child->getValueOfFirstChild<Length>(true);
+    }
 
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
 
 NetClass::NetClass(Circuit& circuit, const QString& name) :
     QObject(&circuit), mCircuit(circuit), mIsAddedToCircuit(false),
-    mUuid(Uuid::createRandom()), mName(name)
+    mUuid(Uuid::createRandom()), mName(name), mClearance(0)
 {
     if (mName.isEmpty()) {
         throw RuntimeError(__FILE__, __LINE__,
@@ -81,6 +84,15 @@ void NetClass::setName(const QString& name)
     updateErcMessages();
 }
 
+void NetClass::setClearance(const Length& clearance)
+{
+    if (clearance < 0) {
+        throw RuntimeError(__FILE__, __LINE__,
+            tr("The netclass clearance must not be negative!"));
+    }
+    mClearance = clearance;
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -134,6 +146,7 @@ void NetClass::serialize(SExpression& root) const
 
     root.appendToken(mUuid);
     root.appendStringChild("name", mName, false);
+    root.appendTokenChild("clearance", mClearance, false);
 }
 
 /*****************************************************************************************
@@ -144,6 +157,7 @@ bool NetClass::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())     return false;
     if (mName.isEmpty())    return false;
+    if (mClearance < 0)     return false;
     return true;
 }
 
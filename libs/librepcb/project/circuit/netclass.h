@@ -28,6 +28,7 @@
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/units/all_length_units.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -45,6 +46,10 @@ class ErcMsg;
 
 /**
  * @brief The NetClass class
+ *
+ * Besides grouping net signals, a netclass defines electrical rules for all of its
+ * net signals. At the moment this is the minimum copper clearance to objects of other
+ * nets (0 means that only the global clearance of the board design rules applies).
  */
 class NetClass final : public QObject, public IF_ErcMsgProvider,
                        public SerializableObject
@@ -65,11 +70,13 @@ class NetClass final : public QObject, public IF_ErcMsgProvider,
         Circuit& getCircuit() const noexcept {return mCircuit;}
         const Uuid& getUuid() const noexcept {return mUuid;}
         const QString& getName() const noexcept {return mName;}
+        const Length& getClearance() const noexcept {return mClearance;}
         int getNetSignalCount() const noexcept {return mRegisteredNetSignals.count();}
         bool isUsed() const noexcept {return (getNetSignalCount() > 0);}
 
         // Setters
         void setName(const QString& name);
+        void setClearance(const Length& clearance);
 
         // General Methods
         void addToCircuit();
@@ -96,6 +103,7 @@ class NetClass final : public QObject, public IF_ErcMsgProvider,
         // Attributes
         Uuid mUuid;
         QString mName;
+        Length mClearance; ///< minimum copper clearance (0 = global clearance only)
 
         // Registered Elements
         /// @brief all registered netsignals
@@ -116,6 +116,7 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public Seriali
 
     private:
         bool checkAttributesValidity() const noexcept;
+        void scheduleErcMessagesUpdate() noexcept;
         void updateErcMessages() noexcept;
 
 
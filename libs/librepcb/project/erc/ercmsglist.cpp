@@ -53,6 +53,7 @@ ErcMsgList::ErcMsgList(Project& project, bool restore, bool readOnly, bool creat
 ErcMsgList::~ErcMsgList() noexcept
 {
     Q_ASSERT(mItems.isEmpty());
+    Q_ASSERT(mScheduledUpdates.isEmpty());
 }
 
 /*****************************************************************************************
@@ -85,8 +86,37 @@ void ErcMsgList::update(ErcMsg* ercMsg) noexcept
     emit ercMsgChanged(ercMsg);
 }
 
+void ErcMsgList::scheduleUpdate(const IF_ErcMsgProvider& provider,
+                                const std::function<void()>& updateFunc) noexcept
+{
+    if (mScheduledUpdates.contains(&provider)) return;
+    if (mScheduledUpdates.isEmpty()) {
+        QMetaObject::invokeMethod(this, "updateScheduledProviders", Qt::QueuedConnection);
+    }
+    mScheduledProviders.append(&provider);
+    mScheduledUpdates.insert(&provider, updateFunc);
+}
+
+void ErcMsgList::unscheduleUpdate(const IF_ErcMsgProvider& provider) noexcept
+{
+    if (mScheduledUpdates.remove(&provider) > 0) {
+        mScheduledProviders.removeOne(&provider);
+    }
+}
+
+void ErcMsgList::updateScheduledProviders() noexcept
+{
+    // updating a provider might schedule other providers, so process until empty
+    while (!mScheduledProviders.isEmpty()) {
+        const IF_ErcMsgProvider* provider = mScheduledProviders.takeFirst();
+        std::function<void()> updateFunc = mScheduledUpdates.take(provider);
+        updateFunc();
+    }
+}
+
 void ErcMsgList::restoreIgnoreState()
 {
+    updateScheduledProviders(); // messages must exist to restore their ignore state
     if (mFile->isCreated()) return; // the file does not yet exist
 
     SExpression root = mFile->parseFileAndBuildDomTree();
@@ -112,10 +142,13 @@ bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
 {
     bool success = true;
 
+    // the ignore state of pending messages must be saved too
+    updateScheduledProviders();
+
     // Save "core/erc.lp"
     try
     {
-        SExpression doc(serializeToDomElement("librepcb_erc"));
+        SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_erc"));
         mFile->save(doc, toOriginal);
     }
     catch (Exception& e)
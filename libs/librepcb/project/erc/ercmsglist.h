@@ -27,6 +27,7 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <functional>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -39,6 +40,7 @@ namespace project {
 
 class Project;
 class ErcMsg;
+class IF_ErcMsgProvider;
 
 /*****************************************************************************************
  *  Class ErcMsgList
@@ -46,6 +48,13 @@ class ErcMsg;
 
 /**
  * @brief The ErcMsgList class contains a list of ERC messages which are visible for the user
+ *
+ * Providers which would otherwise re-evaluate their ERC messages many times within a
+ * single operation (e.g. a net signal on every registered component signal while
+ * placing many components) can schedule the update with #scheduleUpdate() instead.
+ * All scheduled updates are then executed once the current operation (e.g. an undo
+ * command) has finished, so every provider is evaluated only once and transient
+ * messages are never added to (and removed from) the list.
  */
 class ErcMsgList final : public QObject, public SerializableObject
 {
@@ -66,6 +75,22 @@ class ErcMsgList final : public QObject, public SerializableObject
         void add(ErcMsg* ercMsg) noexcept;
         void remove(ErcMsg* ercMsg) noexcept;
         void update(ErcMsg* ercMsg) noexcept;
+
+        /**
+         * @brief Schedule the re-evaluation of the ERC messages of a provider
+         *
+         * The update function is called (only once per provider, even if scheduled
+         * multiple times) as soon as the control returns to the event loop, or when
+         * calling #updateScheduledProviders().
+         *
+         * @param provider      The provider whose messages need to be updated.
+         * @param updateFunc    The function which updates the messages.
+         *
+         * @warning Providers must call #unscheduleUpdate() in their destructor!
+         */
+        void scheduleUpdate(const IF_ErcMsgProvider& provider,
+                            const std::function<void()>& updateFunc) noexcept;
+        void unscheduleUpdate(const IF_ErcMsgProvider& provider) noexcept;
         void restoreIgnoreState();
         bool save(bool toOriginal, QStringList& errors) noexcept;
         
@@ -73,6 +98,14 @@ class ErcMsgList final : public QObject, public SerializableObject
         ErcMsgList& operator=(const ErcMsgList& rhs) = delete;
 
 
+    public slots:
+
+        /**
+         * @brief Execute all updates scheduled with #scheduleUpdate() immediately
+         */
+        void updateScheduledProviders() noexcept;
+
+
     signals:
 
         void ercMsgAdded(ErcMsg* ercMsg);
@@ -95,6 +128,8 @@ class ErcMsgList final : public QObject, public SerializableObject
 
         // Misc
         QList<ErcMsg*> mItems; ///< contains all visible ERC messages
+        QList<const IF_ErcMsgProvider*> mScheduledProviders; ///< in order of scheduling
+        QHash<const IF_ErcMsgProvider*, std::function<void()>> mScheduledUpdates;
 };
 
 /*****************************************************************************************
@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtConcurrent/QtConcurrent>
 #include <librepcb/common/exceptions.h>
 #include "projectlibrary.h"
 #include <librepcb/common/fileio/filepath.h>
@@ -30,6 +31,7 @@
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/dev/device.h>
+#include <librepcb/library/libraryelementcache.h>
 #include <librepcb/common/application.h>
 
 /*****************************************************************************************
@@ -66,11 +68,12 @@ ProjectLibrary::ProjectLibrary(Project& project, bool restore, bool readOnly) :
     }
     catch (Exception &e)
     {
-        // free the allocated memory in the reverse order of their allocation...
-        qDeleteAll(mDevices);       mDevices.clear();
-        qDeleteAll(mComponents);    mComponents.clear();
-        qDeleteAll(mPackages);      mPackages.clear();
-        qDeleteAll(mSymbols);       mSymbols.clear();
+        // release the loaded elements...
+        mDevices.clear();
+        mComponents.clear();
+        mPackages.clear();
+        mSymbols.clear();
+        mLoadedElements.clear();
         throw; // ...and rethrow the exception
     }
 
@@ -86,32 +89,33 @@ ProjectLibrary::~ProjectLibrary() noexcept
     cleanupElements<Device>(mAddedDevices, mRemovedDevices);
 
     // Delete all library elements (in reverse order of their creation)
-    qDeleteAll(mDevices);       mDevices.clear();
-    qDeleteAll(mComponents);    mComponents.clear();
-    qDeleteAll(mPackages);      mPackages.clear();
-    qDeleteAll(mSymbols);       mSymbols.clear();
+    deleteElements<Device>(mDevices);
+    deleteElements<Component>(mComponents);
+    deleteElements<Package>(mPackages);
+    deleteElements<Symbol>(mSymbols);
+    mLoadedElements.clear();
 }
 
 /*****************************************************************************************
  *  Getters: Library Elements
  ****************************************************************************************/
 
-Symbol* ProjectLibrary::getSymbol(const Uuid& uuid) const noexcept
+const Symbol* ProjectLibrary::getSymbol(const Uuid& uuid) const noexcept
 {
     return mSymbols.value(uuid, 0);
 }
 
-Package* ProjectLibrary::getPackage(const Uuid& uuid) const noexcept
+const Package* ProjectLibrary::getPackage(const Uuid& uuid) const noexcept
 {
     return mPackages.value(uuid, 0);
 }
 
-Component* ProjectLibrary::getComponent(const Uuid& uuid) const noexcept
+const Component* ProjectLibrary::getComponent(const Uuid& uuid) const noexcept
 {
     return mComponents.value(uuid, 0);
 }
 
-Device* ProjectLibrary::getDevice(const Uuid& uuid) const noexcept
+const Device* ProjectLibrary::getDevice(const Uuid& uuid) const noexcept
 {
     return mDevices.value(uuid, 0);
 }
@@ -120,10 +124,10 @@ Device* ProjectLibrary::getDevice(const Uuid& uuid) const noexcept
  *  Getters: Special Queries
  ****************************************************************************************/
 
-QHash<Uuid, library::Device*> ProjectLibrary::getDevicesOfComponent(const Uuid& compUuid) const noexcept
+QHash<Uuid, const library::Device*> ProjectLibrary::getDevicesOfComponent(const Uuid& compUuid) const noexcept
 {
-    QHash<Uuid, library::Device*> list;
-    foreach (library::Device* device, mDevices)
+    QHash<Uuid, const library::Device*> list;
+    foreach (const library::Device* device, mDevices)
     {
         if (device->getComponentUuid() == compUuid)
             list.insert(device->getUuid(), device);
@@ -203,13 +207,14 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept
 
 template <typename ElementType>
 void ProjectLibrary::loadElements(const FilePath& directory, const QString& type,
-                                  QHash<Uuid, ElementType*>& elementList)
+                                  QHash<Uuid, const ElementType*>& elementList)
 {
     QDir dir(directory.toStr());
 
     // search all subdirectories which have a valid UUID as directory name
     dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Readable);
     dir.setNameFilters(QStringList() << QString("*.%1").arg(directory.getBasename()));
+    QList<QFuture<LoadedElement<ElementType>>> futures;
     foreach (const QString& dirname, dir.entryList())
     {
         FilePath subdirPath(directory.getPathTo(dirname));
@@ -225,16 +230,45 @@ void ProjectLibrary::loadElements(const FilePath& directory, const QString& type
             continue;
         }
 
-        // load the library element --> an exception will be thrown on error
-        ElementType* element = new ElementType(subdirPath, false);
+        // load the library element in the thread pool since parsing large elements takes
+        // some time --> exceptions are caught and rethrown below in this thread
+        // (the process-wide cache shares identical elements with other projects)
+        futures.append(QtConcurrent::run([subdirPath]() -> LoadedElement<ElementType> {
+            try {
+                std::shared_ptr<const ElementType> element =
+                    LibraryElementCache::instance().getElement<ElementType>(subdirPath); // can throw
+                return LoadedElement<ElementType>(element, QSharedPointer<Exception>());
+            } catch (const Exception& e) {
+                return LoadedElement<ElementType>(nullptr, QSharedPointer<Exception>(e.clone()));
+            }
+        }));
+    }
 
-        if (elementList.contains(element->getUuid())) {
-            throw RuntimeError(__FILE__, __LINE__,
-                QString(tr("There are multiple library elements with the same "
-                "UUID in the directory \"%1\"")).arg(subdirPath.toNative()));
+    // wait for all elements, even if one of them failed, to not leak any of them
+    QList<std::shared_ptr<const ElementType>> elements;
+    QSharedPointer<Exception> error;
+    for (QFuture<LoadedElement<ElementType>>& future : futures) {
+        LoadedElement<ElementType> result = future.result();
+        if (result.first) {
+            elements.append(result.first);
+        } else if (!error) {
+            error = result.second;
         }
+    }
 
-        elementList.insert(element->getUuid(), element);
+    foreach (const std::shared_ptr<const ElementType>& element, elements) {
+        if ((!error) && elementList.contains(element->getUuid())) {
+            error.reset(new RuntimeError(__FILE__, __LINE__,
+                QString(tr("There are multiple library elements with the same "
+                "UUID in the directory \"%1\"")).arg(directory.toNative())));
+        }
+        if (!error) {
+            elementList.insert(element->getUuid(), element.get());
+            mLoadedElements.insert(element.get(), element);
+        }
+    }
+    if (error) {
+        error->raise();
     }
 
     qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
@@ -242,7 +276,7 @@ void ProjectLibrary::loadElements(const FilePath& directory, const QString& type
 
 template <typename ElementType>
 void ProjectLibrary::addElement(ElementType& element,
-                                QHash<Uuid, ElementType*>& elementList,
+                                QHash<Uuid, const ElementType*>& elementList,
                                 QList<ElementType*>& addedElementsList,
                                 QList<ElementType*>& removedElementsList)
 {
@@ -262,7 +296,7 @@ void ProjectLibrary::addElement(ElementType& element,
 
 template <typename ElementType>
 void ProjectLibrary::removeElement(ElementType& element,
-                                   QHash<Uuid, ElementType*>& elementList,
+                                   QHash<Uuid, const ElementType*>& elementList,
                                    QList<ElementType*>& addedElementsList,
                                    QList<ElementType*>& removedElementsList)
 {
@@ -275,7 +309,7 @@ void ProjectLibrary::removeElement(ElementType& element,
 
 template <typename ElementType>
 bool ProjectLibrary::saveElements(bool toOriginal, QStringList& errors, const FilePath& parentDir,
-                                  QHash<Uuid, ElementType*>& elementList,
+                                  QHash<Uuid, const ElementType*>& elementList,
                                   QList<ElementType*>& addedElementsList,
                                   QList<ElementType*>& removedElementsList) noexcept
 {
@@ -295,7 +329,24 @@ bool ProjectLibrary::saveElements(bool toOriginal, QStringList& errors, const Fi
         }
     }
 
-    foreach (ElementType* element, elementList) {
+    // loaded elements are immutable, so only their serialization is written
+    foreach (const ElementType* element, elementList) {
+        if (toOriginal && mLoadedElements.contains(element) &&
+            (!mSavedLibraryElements.contains(element))) {
+            try {
+                // TODO: only save if needed (to improve performance)
+                saveLoadedElement(*element, parentDir.getPathTo(element->getUuid().toStr())); // can throw
+                mSavedLibraryElements.insert(element);
+            }
+            catch (Exception& e) {
+                success = false;
+                errors.append(e.getMsg());
+            }
+        }
+    }
+
+    // elements added since the last save are moved into the library directory
+    foreach (ElementType* element, addedElementsList) {
         try {
             if (element->getFilePath().getParentDir().getParentDir() != mLibraryPath) {
                 element->moveIntoParentDirectory(parentDir);
@@ -337,6 +388,37 @@ void ProjectLibrary::cleanupElements(QList<ElementType*>& addedElementsList,
     qDeleteAll(removedElementsList);        removedElementsList.clear();
 }
 
+template <typename ElementType>
+void ProjectLibrary::deleteElements(QHash<Uuid, const ElementType*>& elementList) noexcept
+{
+    // loaded elements are owned by mLoadedElements, all others by this object
+    foreach (const ElementType* element, elementList) {
+        if (!mLoadedElements.contains(element)) {
+            delete element;
+        }
+    }
+    elementList.clear();
+}
+
+void ProjectLibrary::saveLoadedElement(const LibraryBaseElement& element,
+                                       const FilePath& directory)
+{
+    QMap<QString, QByteArray> files = element.serializeToFiles(directory); // can throw
+    FileUtils::makePath(directory); // can throw
+
+    // write the version file as the last one since it marks the element as valid
+    QString versionFileName;
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        if (it.key().startsWith(".librepcb-")) {
+            versionFileName = it.key();
+        } else {
+            FileUtils::writeFile(directory.getPathTo(it.key()), it.value()); // can throw
+        }
+    }
+    Q_ASSERT(!versionFileName.isEmpty());
+    FileUtils::writeFile(directory.getPathTo(versionFileName), files.value(versionFileName)); // can throw
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/exceptions.h>
@@ -52,6 +53,11 @@ class Project;
 /**
  * @brief The ProjectLibrary class
  *
+ * Elements loaded from the project's library directory are immutable. They are
+ * obtained from librepcb::library::LibraryElementCache (if enabled), so projects which
+ * contain identical elements share the same instances. When saving, their serialization
+ * is written into the project's directory instead of modifying them.
+ *
  * @todo Adding and removing elements is very provisional. It does not really work
  *       together with the automatic backup/restore feature of projects.
  */
@@ -66,17 +72,17 @@ class ProjectLibrary final : public QObject
         ~ProjectLibrary() noexcept;
 
         // Getters: Library Elements
-        const QHash<Uuid, library::Symbol*>&     getSymbols()        const noexcept {return mSymbols;}
-        const QHash<Uuid, library::Package*>&    getPackages()       const noexcept {return mPackages;}
-        const QHash<Uuid, library::Component*>&  getComponents()     const noexcept {return mComponents;}
-        const QHash<Uuid, library::Device*>&     getDevices()        const noexcept {return mDevices;}
-        library::Symbol*      getSymbol(     const Uuid& uuid) const noexcept;
-        library::Package*     getPackage(    const Uuid& uuid) const noexcept;
-        library::Component*   getComponent(  const Uuid& uuid) const noexcept;
-        library::Device*      getDevice(     const Uuid& uuid) const noexcept;
+        const QHash<Uuid, const library::Symbol*>&     getSymbols()    const noexcept {return mSymbols;}
+        const QHash<Uuid, const library::Package*>&    getPackages()   const noexcept {return mPackages;}
+        const QHash<Uuid, const library::Component*>&  getComponents() const noexcept {return mComponents;}
+        const QHash<Uuid, const library::Device*>&     getDevices()    const noexcept {return mDevices;}
+        const library::Symbol*      getSymbol(     const Uuid& uuid) const noexcept;
+        const library::Package*     getPackage(    const Uuid& uuid) const noexcept;
+        const library::Component*   getComponent(  const Uuid& uuid) const noexcept;
+        const library::Device*      getDevice(     const Uuid& uuid) const noexcept;
 
         // Getters: Special Queries
-        QHash<Uuid, library::Device*> getDevicesOfComponent(const Uuid& compUuid) const noexcept;
+        QHash<Uuid, const library::Device*> getDevicesOfComponent(const Uuid& compUuid) const noexcept;
 
 
         // Add/Remove Methods
@@ -101,38 +107,50 @@ class ProjectLibrary final : public QObject
         ProjectLibrary(const ProjectLibrary& other);
         ProjectLibrary& operator=(const ProjectLibrary& rhs);
 
+        // Types
+        template <typename ElementType>
+        using LoadedElement = QPair<std::shared_ptr<const ElementType>, QSharedPointer<Exception>>;
+
         // Private Methods
         template <typename ElementType>
         void loadElements(const FilePath& directory, const QString& type,
-                          QHash<Uuid, ElementType*>& elementList);
+                          QHash<Uuid, const ElementType*>& elementList);
         template <typename ElementType>
         void addElement(ElementType& element,
-                        QHash<Uuid, ElementType*>& elementList,
+                        QHash<Uuid, const ElementType*>& elementList,
                         QList<ElementType*>& addedElementsList,
                         QList<ElementType*>& removedElementsList);
         template <typename ElementType>
         void removeElement(ElementType& element,
-                           QHash<Uuid, ElementType*>& elementList,
+                           QHash<Uuid, const ElementType*>& elementList,
                            QList<ElementType*>& addedElementsList,
                            QList<ElementType*>& removedElementsList);
         template <typename ElementType>
         bool saveElements(bool toOriginal, QStringList& errors, const FilePath& parentDir,
-                          QHash<Uuid, ElementType*>& elementList,
+                          QHash<Uuid, const ElementType*>& elementList,
                           QList<ElementType*>& addedElementsList,
                           QList<ElementType*>& removedElementsList) noexcept;
         template <typename ElementType>
         void cleanupElements(QList<ElementType*>& addedElementsList,
                              QList<ElementType*>& removedElementsList) noexcept;
+        template <typename ElementType>
+        void deleteElements(QHash<Uuid, const ElementType*>& elementList) noexcept;
+        static void saveLoadedElement(const library::LibraryBaseElement& element,
+                                      const FilePath& directory);
 
         // General
         Project& mProject; ///< a reference to the Project object (from the ctor)
         FilePath mLibraryPath; ///< the "library" directory of the project
 
         // The Library Elements
-        QHash<Uuid, library::Symbol*> mSymbols;
-        QHash<Uuid, library::Package*> mPackages;
-        QHash<Uuid, library::Component*> mComponents;
-        QHash<Uuid, library::Device*> mDevices;
+        QHash<Uuid, const library::Symbol*> mSymbols;
+        QHash<Uuid, const library::Package*> mPackages;
+        QHash<Uuid, const library::Component*> mComponents;
+        QHash<Uuid, const library::Device*> mDevices;
+
+        /// Elements loaded from the library directory (maybe shared with other projects)
+        QHash<const library::LibraryBaseElement*,
+              std::shared_ptr<const library::LibraryBaseElement>> mLoadedElements;
 
         // Added Library Elements
         QList<library::Symbol*> mAddedSymbols;
@@ -147,7 +165,7 @@ class ProjectLibrary final : public QObject
         QList<library::Device*> mRemovedDevices;
 
         // Temporary, ugly performance improvement to avoid unnecessary file write operations
-        QSet<library::LibraryBaseElement*> mSavedLibraryElements;
+        QSet<const library::LibraryBaseElement*> mSavedLibraryElements;
 };
 
 /*****************************************************************************************
@@ -131,7 +131,7 @@ bool ProjectMetadata::save(bool toOriginal, QStringList& errors) noexcept
     bool success = true;
 
     try {
-        SExpression doc(serializeToDomElement("librepcb_project_metadata"));
+        SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_project_metadata"));
         mFile->save(doc, toOriginal);
     } catch (const Exception& e) {
         success = false;
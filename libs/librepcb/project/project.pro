@@ -23,11 +23,16 @@ INCLUDEPATH += \
 SOURCES += \
     boards/board.cpp \
     boards/boardairwiresbuilder.cpp \
+    boards/boardclearancematrix.cpp \
     boards/boardfabricationoutputsettings.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardobstacleindex.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplanefragmentscache.cpp \
     boards/boardselectionquery.cpp \
+    boards/boardstatistics.cpp \
+    boards/boardtracerouter.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
@@ -136,11 +141,16 @@ SOURCES += \
 HEADERS += \
     boards/board.h \
     boards/boardairwiresbuilder.h \
+    boards/boardclearancematrix.h \
     boards/boardfabricationoutputsettings.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
+    boards/boardobstacleindex.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplanefragmentscache.h \
     boards/boardselectionquery.h \
+    boards/boardstatistics.h \
+    boards/boardtracerouter.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
@@ -75,8 +75,7 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept
     mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
     QPainterPathStroker ps;
     ps.setCapStyle(Qt::RoundCap);
-    Length width = (mNetLine.getWidth() > Length(1270000) ? mNetLine.getWidth() : Length(1270000));
-    ps.setWidth(width.toPx());
+    ps.setWidth(mNetLine.getGrabAreaWidth().toPx());
     mShape = ps.createStroke(mShape);
     update();
 }
@@ -39,7 +39,7 @@ namespace project {
 
 SI_Base::SI_Base(Schematic& schematic) noexcept :
     QObject(&schematic), mSchematic(schematic),
-    mIsAddedToSchematic(false), mIsSelected(false)
+    mIsAddedToSchematic(false), mIsSelected(false), mSceneGraphicsItem(nullptr)
 {
 }
 
@@ -62,6 +62,11 @@ Circuit& SI_Base::getCircuit() const noexcept
     return mSchematic.getProject().getCircuit();
 }
 
+QGraphicsItem* SI_Base::getSceneGraphicsItem() const noexcept
+{
+    return mSceneGraphicsItem; // SGI_Base is incomplete in the header
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -81,6 +86,7 @@ void SI_Base::addToSchematic(SGI_Base* item) noexcept
     if (item) {
         mSchematic.getGraphicsScene().addItem(*item);
     }
+    mSceneGraphicsItem = item;
     mIsAddedToSchematic = true;
 }
 
@@ -90,6 +96,7 @@ void SI_Base::removeFromSchematic(SGI_Base* item) noexcept
     if (item) {
         mSchematic.getGraphicsScene().removeItem(*item);
     }
+    mSceneGraphicsItem = nullptr;
     mIsAddedToSchematic = false;
 }
 
@@ -78,6 +78,14 @@ class SI_Base : public QObject
         virtual const Point& getPosition() const noexcept = 0;
         virtual QPainterPath getGrabAreaScenePx() const noexcept = 0;
         virtual bool isAddedToSchematic() const noexcept {return mIsAddedToSchematic;}
+
+        /**
+         * @brief Get the graphics item which was added to the scene by #addToSchematic()
+         *
+         * @return The graphics item, or nullptr if the item is not added to the
+         *         schematic or has no graphics item
+         */
+        QGraphicsItem* getSceneGraphicsItem() const noexcept;
         virtual bool isSelected() const noexcept {return mIsSelected;}
 
         // Setters
@@ -108,6 +116,7 @@ class SI_Base : public QObject
         // General Attributes
         bool mIsAddedToSchematic;
         bool mIsSelected;
+        SGI_Base* mSceneGraphicsItem;
 };
 
 /*****************************************************************************************
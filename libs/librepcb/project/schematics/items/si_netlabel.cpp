@@ -142,7 +142,7 @@ void SI_NetLabel::serialize(SExpression& root) const
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
     root.appendToken(mUuid);
-    root.appendChild(mPosition.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     root.appendTokenChild("rot", mRotation, false);
 }
 
@@ -63,6 +63,8 @@ class SI_NetLine final : public SI_Base, public SerializableObject
         SI_NetSegment& getNetSegment() const noexcept;
         const Uuid& getUuid() const noexcept {return mUuid;}
         const Length& getWidth() const noexcept {return mWidth;}
+        /// Width of the grab area (may be larger than the line to make it easier to grab)
+        Length getGrabAreaWidth() const noexcept {return qMax(mWidth, Length(1270000));}
         SI_NetPoint& getStartPoint() const noexcept {return *mStartPoint;}
         SI_NetPoint& getEndPoint() const noexcept {return *mEndPoint;}
         SI_NetPoint* getOtherPoint(const SI_NetPoint& firstPoint) const noexcept;
@@ -264,7 +264,7 @@ void SI_NetPoint::serialize(SExpression& root) const
         root.appendTokenChild("sym", mSymbolPin->getSymbol().getUuid(), true);
         root.appendTokenChild("pin", mSymbolPin->getLibPinUuid(), false);
     } else {
-        root.appendChild(mPosition.serializeToDomElement("pos"), true);
+        root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     }
 }
 
@@ -32,7 +32,7 @@
 #include "../../circuit/netsignal.h"
 #include "../../circuit/componentsignalinstance.h"
 #include <librepcb/common/scopeguardlist.h>
-#include <librepcb/common/toolbox.h>
+#include <librepcb/common/utils/geometrykernel.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -67,6 +67,7 @@ SI_NetSegment::SI_NetSegment(Schematic& schematic, const SExpression& node) :
                     .arg(netpoint->getUuid().toStr()));
             }
             mNetPoints.append(netpoint);
+            mConnectivity.addNode(netpoint);
         }
 
         // Load all netlines
@@ -78,6 +79,7 @@ SI_NetSegment::SI_NetSegment(Schematic& schematic, const SExpression& node) :
                     .arg(netline->getUuid().toStr()));
             }
             mNetLines.append(netline);
+            mConnectivity.addEdge(&netline->getStartPoint(), &netline->getEndPoint());
         }
 
         // Load all netlabels
@@ -151,10 +153,22 @@ int SI_NetSegment::getNetPointsAtScenePos(const Point& pos, QList<SI_NetPoint*>&
 
 int SI_NetSegment::getNetLinesAtScenePos(const Point& pos, QList<SI_NetLine*>& lines) const noexcept
 {
+    // the grab areas of netlines are round capped strokes, so a netline is hit if its
+    // distance to pos is not larger than half of the grab area width
+    GeometryKernel::SegmentArray segments;
+    segments.reserve(mNetLines.count());
+    foreach (const SI_NetLine* netline, mNetLines) {
+        segments.append(netline->getStartPoint().getPosition(),
+                        netline->getEndPoint().getPosition());
+    }
+    QVarLengthArray<qreal, 256> distances(mNetLines.count());
+    GeometryKernel::squaredDistancesToSegments(pos, segments, distances.data());
+
     int count = 0;
-    foreach (SI_NetLine* netline, mNetLines) {
-        if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-            lines.append(netline);
+    for (int i = 0; i < mNetLines.count(); ++i) {
+        qreal radius = mNetLines.at(i)->getGrabAreaWidth().toNm() / qreal(2);
+        if (distances[i] <= radius * radius) {
+            lines.append(mNetLines.at(i));
             ++count;
         }
     }
@@ -200,18 +214,14 @@ QString SI_NetSegment::getForcedNetName() const noexcept
 
 Point SI_NetSegment::calcNearestPoint(const Point& p) const noexcept
 {
-    Point pos = p;
-    Length dist;
-    for (int i = 0; i < mNetLines.count(); ++i) {
-        Point lp;
-        Length ld = Toolbox::shortestDistanceBetweenPointAndLine(p,
-            mNetLines.at(i)->getStartPoint().getPosition(),
-            mNetLines.at(i)->getEndPoint().getPosition(), &lp);
-        if ((i == 0) || (ld < dist)) {
-            dist = ld;
-            pos = lp;
-        }
+    GeometryKernel::SegmentArray segments;
+    segments.reserve(mNetLines.count());
+    foreach (const SI_NetLine* netline, mNetLines) {
+        segments.append(netline->getStartPoint().getPosition(),
+                        netline->getEndPoint().getPosition());
     }
+    Point pos = p;
+    GeometryKernel::nearestSegment(p, segments, &pos);
     return pos;
 }
 
@@ -286,7 +296,11 @@ void SI_NetSegment::addNetPointsAndNetLines(const QList<SI_NetPoint*>& netpoints
         // add to schematic
         netpoint->addToSchematic(); // can throw
         mNetPoints.append(netpoint);
-        sgl.add([this, netpoint](){netpoint->removeFromSchematic(); mNetPoints.removeOne(netpoint);});
+        mConnectivity.addNode(netpoint);
+        sgl.add([this, netpoint](){
+            netpoint->removeFromSchematic(); mNetPoints.removeOne(netpoint);
+            mConnectivity.removeNode(netpoint);
+        });
     }
     foreach (SI_NetLine* netline, netlines) {
         if ((mNetLines.contains(netline)) || (&netline->getNetSegment() != this)) {
@@ -301,7 +315,11 @@ void SI_NetSegment::addNetPointsAndNetLines(const QList<SI_NetPoint*>& netpoints
         // add to schematic
         netline->addToSchematic(); // can throw
         mNetLines.append(netline);
-        sgl.add([this, netline](){netline->removeFromSchematic(); mNetLines.removeOne(netline);});
+        mConnectivity.addEdge(&netline->getStartPoint(), &netline->getEndPoint());
+        sgl.add([this, netline](){
+            netline->removeFromSchematic(); mNetLines.removeOne(netline);
+            mConnectivity.removeEdge(&netline->getStartPoint(), &netline->getEndPoint());
+        });
     }
 
     if (!areAllNetPointsConnectedTogether()) {
@@ -330,7 +348,11 @@ void SI_NetSegment::removeNetPointsAndNetLines(const QList<SI_NetPoint*>& netpoi
         // remove from schematic
         netline->removeFromSchematic(); // can throw
         mNetLines.removeOne(netline);
-        sgl.add([this, netline](){netline->addToSchematic(); mNetLines.append(netline);});
+        mConnectivity.removeEdge(&netline->getStartPoint(), &netline->getEndPoint());
+        sgl.add([this, netline](){
+            netline->addToSchematic(); mNetLines.append(netline);
+            mConnectivity.addEdge(&netline->getStartPoint(), &netline->getEndPoint());
+        });
     }
     foreach (SI_NetPoint* netpoint, netpoints) {
         if (!mNetPoints.contains(netpoint)) {
@@ -339,7 +361,11 @@ void SI_NetSegment::removeNetPointsAndNetLines(const QList<SI_NetPoint*>& netpoi
         // remove from schematic
         netpoint->removeFromSchematic(); // can throw
         mNetPoints.removeOne(netpoint);
-        sgl.add([this, netpoint](){netpoint->addToSchematic(); mNetPoints.append(netpoint);});
+        mConnectivity.removeNode(netpoint);
+        sgl.add([this, netpoint](){
+            netpoint->addToSchematic(); mNetPoints.append(netpoint);
+            mConnectivity.addNode(netpoint);
+        });
     }
 
     if (!areAllNetPointsConnectedTogether()) {
@@ -457,16 +483,6 @@ void SI_NetSegment::removeFromSchematic()
     sgl.dismiss();
 }
 
-void SI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept
-{
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-        netpoint->setSelected(netpoint->getGrabAreaScenePx().intersects(rectPx));
-    foreach (SI_NetLine* netline, mNetLines)
-        netline->setSelected(netline->getGrabAreaScenePx().intersects(rectPx));
-    foreach (SI_NetLabel* netlabel, mNetLabels)
-        netlabel->setSelected(netlabel->getGrabAreaScenePx().intersects(rectPx));
-}
-
 void SI_NetSegment::clearSelection() const noexcept
 {
     foreach (SI_NetPoint* netpoint, mNetPoints)
@@ -526,25 +542,7 @@ bool SI_NetSegment::checkAttributesValidity() const noexcept
 
 bool SI_NetSegment::areAllNetPointsConnectedTogether() const noexcept
 {
-    if (mNetPoints.count() > 1) {
-        const SI_NetPoint* firstPoint = mNetPoints.first();
-        QList<const SI_NetPoint*> points({firstPoint});
-        findAllConnectedNetPoints(*firstPoint, points);
-        return (points.count() == mNetPoints.count());
-    } else {
-        return true; // there is only 0 or 1 netpoint => must be "connected together" :)
-    }
-}
-
-void SI_NetSegment::findAllConnectedNetPoints(const SI_NetPoint& p, QList<const SI_NetPoint*>& points) const noexcept
-{
-    foreach (const SI_NetLine* line, mNetLines) {
-        const SI_NetPoint* p2 = line->getOtherPoint(p);
-        if ((p2) && (!points.contains(p2))) {
-            points.append(p2);
-            findAllConnectedNetPoints(*p2, points);
-        }
-    }
+    return (mConnectivity.getGroupCount() <= 1);
 }
 
 /*****************************************************************************************
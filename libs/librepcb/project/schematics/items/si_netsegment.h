@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "si_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/connectivitygraph.h>
 #include <librepcb/common/uuid.h>
 
 /*****************************************************************************************
@@ -89,6 +90,15 @@ class SI_NetSegment final : public SI_Base, public SerializableObject
         void removeNetPointsAndNetLines(const QList<SI_NetPoint*>& netpoints,
                                         const QList<SI_NetLine*>& netlines);
 
+        /**
+         * @brief Get the connectivity of all netpoints (connected by netlines)
+         *
+         * The graph is updated incrementally whenever elements are added or removed.
+         */
+        const ConnectivityGraph<const SI_NetPoint*>& getConnectivity() const noexcept {
+            return mConnectivity;
+        }
+
         // NetLabel Methods
         const QList<SI_NetLabel*>& getNetLabels() const noexcept {return mNetLabels;}
         SI_NetLabel* getNetLabelByUuid(const Uuid& uuid) const noexcept;
@@ -99,7 +109,6 @@ class SI_NetSegment final : public SI_Base, public SerializableObject
         // General Methods
         void addToSchematic() override;
         void removeFromSchematic() override;
-        void setSelectionRect(const QRectF rectPx) noexcept;
         void clearSelection() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
@@ -121,7 +130,6 @@ class SI_NetSegment final : public SI_Base, public SerializableObject
     private:
         bool checkAttributesValidity() const noexcept;
         bool areAllNetPointsConnectedTogether() const noexcept;
-        void findAllConnectedNetPoints(const SI_NetPoint& p, QList<const SI_NetPoint*>& points) const noexcept;
 
 
         // Attributes
@@ -132,6 +140,9 @@ class SI_NetSegment final : public SI_Base, public SerializableObject
         QList<SI_NetPoint*> mNetPoints;
         QList<SI_NetLine*> mNetLines;
         QList<SI_NetLabel*> mNetLabels;
+
+        /// Netpoints, connected by netlines
+        ConnectivityGraph<const SI_NetPoint*> mConnectivity;
 };
 
 /*****************************************************************************************
@@ -44,7 +44,8 @@ namespace project {
  ****************************************************************************************/
 
 SI_Symbol::SI_Symbol(Schematic& schematic, const SExpression& node) :
-    SI_Base(schematic), mComponentInstance(nullptr), mSymbVarItem(nullptr), mSymbol(nullptr)
+    SI_Base(schematic), mAttributeSubstitutionCache(*this), mComponentInstance(nullptr),
+    mSymbVarItem(nullptr), mSymbol(nullptr)
 {
     mUuid = node.getChildByIndex(0).getValue<Uuid>(true);
     Uuid gcUuid = node.getValueByPath<Uuid>("component", true);
@@ -68,7 +69,8 @@ SI_Symbol::SI_Symbol(Schematic& schematic, const SExpression& node) :
 
 SI_Symbol::SI_Symbol(Schematic& schematic, ComponentInstance& cmpInstance,
                      const Uuid& symbolItem, const Point& position, const Angle& rotation) :
-    SI_Base(schematic), mComponentInstance(&cmpInstance), mSymbVarItem(nullptr),
+    SI_Base(schematic), mAttributeSubstitutionCache(*this), mComponentInstance(&cmpInstance),
+    mSymbVarItem(nullptr),
     mSymbol(nullptr), mUuid(Uuid::createRandom()), mPosition(position), mRotation(rotation)
 {
     init(symbolItem);
@@ -104,6 +106,8 @@ void SI_Symbol::init(const Uuid& symbVarItemUuid)
     }
 
     // connect to the "attributes changes" signal of schematic and component instance
+    connect(&mSchematic, &Schematic::attributesChanged,
+            this, &SI_Symbol::schematicOrComponentAttributesChanged);
     connect(mComponentInstance, &ComponentInstance::attributesChanged,
             this, &SI_Symbol::schematicOrComponentAttributesChanged);
 
@@ -196,7 +200,7 @@ void SI_Symbol::serialize(SExpression& root) const
     root.appendToken(mUuid);
     root.appendTokenChild("component", mComponentInstance->getUuid(), true);
     root.appendTokenChild("lib_gate", mSymbVarItem->getUuid(), true);
-    root.appendChild(mPosition.serializeToDomElement("pos"), true);
+    root.appendChild(serializeToDomElement(mPosition, "pos"), true);
     root.appendTokenChild("rot", mRotation, false);
 }
 
@@ -251,6 +255,7 @@ void SI_Symbol::setSelected(bool selected) noexcept
 
 void SI_Symbol::schematicOrComponentAttributesChanged()
 {
+    emit attributesChanged(); // must be emitted first to invalidate substitution caches
     mGraphicsItem->updateCacheAndRepaint();
 }
 
@@ -27,6 +27,7 @@
 #include "si_base.h"
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/attributes/attributeprovider.h>
+#include <librepcb/common/attributes/attributesubstitutioncache.h>
 #include "../graphicsitems/sgi_symbol.h"
 
 /*****************************************************************************************
@@ -102,6 +103,11 @@ class SI_Symbol final : public SI_Base, public SerializableObject,
         /// @copydoc librepcb::AttributeProvider::getAttributeProviderParents()
         QVector<const AttributeProvider*> getAttributeProviderParents() const noexcept override;
 
+        /// @copydoc librepcb::AttributeProvider::getAttributeSubstitutionCache()
+        AttributeSubstitutionCache* getAttributeSubstitutionCache() const noexcept override {
+            return &mAttributeSubstitutionCache;
+        }
+
         // Inherited from SI_Base
         Type_t getType() const noexcept override {return SI_Base::Type_t::Symbol;}
         const Point& getPosition() const noexcept override {return mPosition;}
@@ -130,6 +136,7 @@ class SI_Symbol final : public SI_Base, public SerializableObject,
 
 
         // General
+        mutable AttributeSubstitutionCache mAttributeSubstitutionCache;
         ComponentInstance* mComponentInstance;
         const library::ComponentSymbolVariantItem* mSymbVarItem;
         const library::Symbol* mSymbol;
@@ -36,6 +36,7 @@
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/utils/rectselectionindex.h>
 #include <librepcb/common/application.h>
 #include "schematicselectionquery.h"
 
@@ -375,7 +376,7 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept
     {
         if (mIsAddedToProject)
         {
-            SExpression doc(serializeToDomElement("librepcb_schematic"));
+            SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_schematic"));
             mFile->save(doc, toOriginal);
         }
         else
@@ -402,23 +403,39 @@ void Schematic::setSelectionRect(const Point& p1, const Point& p2, bool updateIt
     mGraphicsScene->setSelectionRect(p1, p2);
     if (updateItems)
     {
+        // the items don't change while drawing the selection rectangle, so their grab
+        // areas are determined only once
+        if (!mSelectionIndex) buildSelectionIndex();
         QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+        QSet<SI_Base*> items = mSelectionIndex->query(rectPx);
+
+        // only modify items whose selection state has changed to avoid repainting them
+        auto select = [&items](SI_Base* item, bool forceSelected) {
+            bool selected = forceSelected || items.contains(item);
+            if (item->isSelected() != selected) item->setSelected(selected);
+        };
         foreach (SI_Symbol* symbol, mSymbols) {
-            bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
-            symbol->setSelected(selectSymbol);
+            bool selectSymbol = items.contains(symbol);
+            select(symbol, false);
             foreach (SI_SymbolPin* pin, symbol->getPins()) {
-                bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-                pin->setSelected(selectSymbol || selectPin);
+                select(pin, selectSymbol);
             }
         }
         foreach (SI_NetSegment* segment, mNetSegments) {
-            segment->setSelectionRect(rectPx);
+            foreach (SI_NetPoint* netpoint, segment->getNetPoints()) select(netpoint, false);
+            foreach (SI_NetLine* netline, segment->getNetLines()) select(netline, false);
+            foreach (SI_NetLabel* netlabel, segment->getNetLabels()) select(netlabel, false);
         }
     }
+    else
+    {
+        mSelectionIndex.reset(); // selection rectangle finished
+    }
 }
 
 void Schematic::clearSelection() const noexcept
 {
+    mSelectionIndex.reset(); // items may have been modified since the last selection
     foreach (SI_Symbol* symbol, mSymbols) {
         symbol->setSelected(false);
     }
@@ -469,6 +486,29 @@ QVector<const AttributeProvider*> Schematic::getAttributeProviderParents() const
  *  Private Methods
  ****************************************************************************************/
 
+void Schematic::buildSelectionIndex() const noexcept
+{
+    mSelectionIndex.reset(new RectSelectionIndex<SI_Base*>());
+    foreach (SI_Symbol* symbol, mSymbols) {
+        mSelectionIndex->add(symbol, symbol->getGrabAreaScenePx());
+        foreach (SI_SymbolPin* pin, symbol->getPins()) {
+            mSelectionIndex->add(pin, pin->getGrabAreaScenePx());
+        }
+    }
+    foreach (SI_NetSegment* segment, mNetSegments) {
+        foreach (SI_NetPoint* netpoint, segment->getNetPoints()) {
+            mSelectionIndex->add(netpoint, netpoint->getGrabAreaScenePx());
+        }
+        foreach (SI_NetLine* netline, segment->getNetLines()) {
+            mSelectionIndex->add(netline, netline->getGrabAreaScenePx());
+        }
+        foreach (SI_NetLabel* netlabel, segment->getNetLabels()) {
+            mSelectionIndex->add(netlabel, netlabel->getGrabAreaScenePx());
+        }
+    }
+    mSelectionIndex->build();
+}
+
 void Schematic::updateIcon() noexcept
 {
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
@@ -494,7 +534,7 @@ void Schematic::serialize(SExpression& root) const
 
     root.appendToken(mUuid);
     root.appendStringChild("name", mName, true);
-    root.appendChild(mGridProperties->serializeToDomElement("grid"), true);
+    root.appendChild(serializeToDomElement(*mGridProperties, "grid"), true);
     root.appendLineBreak();
     serializePointerContainer(root, mSymbols, "symbol");
     root.appendLineBreak();
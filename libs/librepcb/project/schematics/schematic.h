@@ -42,6 +42,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartSExprFile;
+template <typename T> class RectSelectionIndex;
 
 namespace project {
 
@@ -181,6 +182,7 @@ class Schematic final : public QObject, public AttributeProvider,
         Schematic(Project& project, const FilePath& filepath, bool restore,
                   bool readOnly, bool create, const QString& newName);
         void updateIcon() noexcept;
+        void buildSelectionIndex() const noexcept;
         bool checkAttributesValidity() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
@@ -196,6 +198,7 @@ class Schematic final : public QObject, public AttributeProvider,
         QScopedPointer<GraphicsScene> mGraphicsScene;
         QScopedPointer<GridProperties> mGridProperties;
         QRectF mViewRect;
+        mutable std::unique_ptr<RectSelectionIndex<SI_Base*>> mSelectionIndex; ///< only valid while drawing a selection rectangle
 
         // Attributes
         Uuid mUuid;
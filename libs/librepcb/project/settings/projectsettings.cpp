@@ -110,7 +110,7 @@ bool ProjectSettings::save(bool toOriginal, QStringList& errors) noexcept
     // Save "core/settings.lp"
     try
     {
-        SExpression doc(serializeToDomElement("librepcb_project_settings"));
+        SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_project_settings"));
         mFile->save(doc, toOriginal);
     }
     catch (Exception& e)
@@ -48,6 +48,7 @@
 #include "fsm/bes_fsm.h"
 #include "../projecteditor.h"
 #include "boardlayersdock.h"
+#include "boardstatisticsdock.h"
 #include "fabricationoutputdialog.h"
 #include "boardlayerstacksetupdialog.h"
 
@@ -67,7 +68,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     mUi(new Ui::BoardEditor),
     mGraphicsView(nullptr), mActiveBoardIndex(-1), mBoardListActionGroup(this),
     mErcMsgDock(nullptr), mUnplacedComponentsDock(nullptr), mBoardLayersDock(nullptr),
-    mFsm(nullptr)
+    mBoardStatisticsDock(nullptr), mFsm(nullptr)
 {
     mUi->setupUi(this);
     mUi->actionProjectSave->setEnabled(!mProject.isReadOnly());
@@ -89,6 +90,9 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     mErcMsgDock = new ErcMsgDock(mProject);
     addDockWidget(Qt::RightDockWidgetArea, mErcMsgDock, Qt::Vertical);
     tabifyDockWidget(mBoardLayersDock, mErcMsgDock);
+    mBoardStatisticsDock = new BoardStatisticsDock();
+    addDockWidget(Qt::RightDockWidgetArea, mBoardStatisticsDock, Qt::Vertical);
+    tabifyDockWidget(mErcMsgDock, mBoardStatisticsDock);
     mUnplacedComponentsDock->raise();
 
     // add graphics view as central widget
@@ -206,6 +210,7 @@ BoardEditor::~BoardEditor()
 
     delete mFsm;                    mFsm = nullptr;
     qDeleteAll(mBoardListActions);  mBoardListActions.clear();
+    delete mBoardStatisticsDock;    mBoardStatisticsDock = nullptr;
     delete mBoardLayersDock;        mBoardLayersDock = nullptr;
     delete mUnplacedComponentsDock; mUnplacedComponentsDock = nullptr;
     delete mErcMsgDock;             mErcMsgDock = nullptr;
@@ -268,6 +273,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     mActiveBoardIndex = index;
     mUnplacedComponentsDock->setBoard(board);
     mBoardLayersDock->setActiveBoard(board);
+    mBoardStatisticsDock->setActiveBoard(board);
     mUi->tabBar->setCurrentIndex(index);
     emit activeBoardChanged(oldIndex, index);
     return true;
@@ -50,6 +50,7 @@ class ProjectEditor;
 class ErcMsgDock;
 class UnplacedComponentsDock;
 class BoardLayersDock;
+class BoardStatisticsDock;
 class BES_FSM;
 
 namespace Ui {
@@ -148,6 +149,7 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         ErcMsgDock* mErcMsgDock;
         UnplacedComponentsDock* mUnplacedComponentsDock;
         BoardLayersDock* mBoardLayersDock;
+        BoardStatisticsDock* mBoardStatisticsDock;
 
         // Finite State Machine
         BES_FSM* mFsm;
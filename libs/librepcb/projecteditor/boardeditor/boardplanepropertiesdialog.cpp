@@ -77,9 +77,47 @@ BoardPlanePropertiesDialog::BoardPlanePropertiesDialog(Project& project, BI_Plan
     // connect style combobox
     mUi->cbxConnectStyle->addItem(tr("None"), static_cast<int>(BI_Plane::ConnectStyle::None));
     mUi->cbxConnectStyle->addItem(tr("Solid"), static_cast<int>(BI_Plane::ConnectStyle::Solid));
-    //mUi->cbxConnectStyle->addItem(tr("Thermals"), static_cast<int>(BI_Plane::ConnectStyle::Thermal));
+    mUi->cbxConnectStyle->addItem(tr("Thermals"), static_cast<int>(BI_Plane::ConnectStyle::Thermal));
     mUi->cbxConnectStyle->setCurrentIndex(mUi->cbxConnectStyle->findData(static_cast<int>(mPlane.getConnectStyle())));
 
+    // thermal spinboxes (only relevant for thermal connections)
+    mUi->spbThermalGapWidth->setValue(mPlane.getThermalGapWidth().toMm());
+    mUi->spbThermalSpokeWidth->setValue(mPlane.getThermalSpokeWidth().toMm());
+    auto updateThermalSpinBoxes = [this](){
+        bool thermal = (mUi->cbxConnectStyle->currentData().toInt() ==
+                        static_cast<int>(BI_Plane::ConnectStyle::Thermal));
+        mUi->spbThermalGapWidth->setEnabled(thermal);
+        mUi->spbThermalSpokeWidth->setEnabled(thermal);
+    };
+    connect(mUi->cbxConnectStyle, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, updateThermalSpinBoxes);
+    updateThermalSpinBoxes();
+
+    // fill style combobox and hatch spinboxes
+    mUi->cbxFillStyle->addItem(tr("Solid"), static_cast<int>(BI_Plane::FillStyle::Solid));
+    mUi->cbxFillStyle->addItem(tr("Hatched"), static_cast<int>(BI_Plane::FillStyle::Hatched));
+    mUi->cbxFillStyle->setCurrentIndex(mUi->cbxFillStyle->findData(static_cast<int>(mPlane.getFillStyle())));
+    // the hatch width must be positive and the pitch must be greater than the width
+    // (the smallest step of the spinboxes is 1nm)
+    mUi->spbHatchWidth->setMinimum(Length(1).toMm());
+    mUi->spbHatchWidth->setValue(mPlane.getHatchWidth().toMm());
+    auto updateHatchPitchMinimum = [this](double width){
+        mUi->spbHatchPitch->setMinimum(width + Length(1).toMm());
+    };
+    connect(mUi->spbHatchWidth, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged),
+            this, updateHatchPitchMinimum);
+    updateHatchPitchMinimum(mUi->spbHatchWidth->value());
+    mUi->spbHatchPitch->setValue(mPlane.getHatchPitch().toMm());
+    auto updateHatchSpinBoxes = [this](){
+        bool hatched = (mUi->cbxFillStyle->currentData().toInt() ==
+                        static_cast<int>(BI_Plane::FillStyle::Hatched));
+        mUi->spbHatchWidth->setEnabled(hatched);
+        mUi->spbHatchPitch->setEnabled(hatched);
+    };
+    connect(mUi->cbxFillStyle, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, updateHatchSpinBoxes);
+    updateHatchSpinBoxes();
+
     // priority spinbox
     mUi->spbPriority->setValue(mPlane.getPriority());
 
@@ -142,6 +180,13 @@ bool BoardPlanePropertiesDialog::applyChanges() noexcept
 
         // connect style
         cmd->setConnectStyle(static_cast<BI_Plane::ConnectStyle>(mUi->cbxConnectStyle->currentData().toInt()));
+        cmd->setThermalGapWidth(Length::fromMm(mUi->spbThermalGapWidth->value()));
+        cmd->setThermalSpokeWidth(Length::fromMm(mUi->spbThermalSpokeWidth->value()));
+
+        // fill style
+        cmd->setFillStyle(static_cast<BI_Plane::FillStyle>(mUi->cbxFillStyle->currentData().toInt()));
+        cmd->setHatchWidth(Length::fromMm(mUi->spbHatchWidth->value()));
+        cmd->setHatchPitch(Length::fromMm(mUi->spbHatchPitch->value()));
 
         // priority
         cmd->setPriority(mUi->spbPriority->value());
@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "boardstatisticsdock.h"
+#include "ui_boardstatisticsdock.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardstatistics.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardStatisticsDock::BoardStatisticsDock(QWidget* parent) noexcept :
+    QDockWidget(parent), mUi(new Ui::BoardStatisticsDock), mActiveBoard(nullptr)
+{
+    mUi->setupUi(this);
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(500);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &BoardStatisticsDock::updateTables);
+    connect(this, &QDockWidget::visibilityChanged, this, &BoardStatisticsDock::scheduleUpdate);
+}
+
+BoardStatisticsDock::~BoardStatisticsDock() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BoardStatisticsDock::setActiveBoard(Board* board) noexcept
+{
+    if (mActiveBoard) {
+        disconnect(mActiveBoardConnection);
+    }
+
+    mActiveBoard = board;
+
+    if (mActiveBoard) {
+        mActiveBoardConnection = connect(&mActiveBoard->getStatistics(),
+                                         &BoardStatistics::invalidated,
+                                         this, &BoardStatisticsDock::scheduleUpdate);
+    }
+
+    updateTables();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardStatisticsDock::scheduleUpdate() noexcept
+{
+    if (isVisible() && (!mUpdateTimer.isActive())) {
+        mUpdateTimer.start();
+    }
+}
+
+void BoardStatisticsDock::updateTables() noexcept
+{
+    mUi->tblNets->setSortingEnabled(false);
+    mUi->tblLayers->setSortingEnabled(false);
+    mUi->tblNets->setRowCount(0);
+    mUi->tblLayers->setRowCount(0);
+
+    if (mActiveBoard && isVisible()) {
+        const BoardStatistics& statistics = mActiveBoard->getStatistics();
+
+        // net signals
+        foreach (const NetSignal* netsignal,
+                 mActiveBoard->getProject().getCircuit().getNetSignals()) {
+            BoardStatistics::NetStatistics s = statistics.getNetStatistics(*netsignal);
+            if ((s.traces.count == 0) && (s.viaCount == 0) && (s.planeArea == 0)) continue;
+            int row = mUi->tblNets->rowCount();
+            mUi->tblNets->insertRow(row);
+            mUi->tblNets->setItem(row, 0, createItem(netsignal->getName()));
+            mUi->tblNets->setItem(row, 1, createItem(s.traces.length.toMm()));
+            mUi->tblNets->setItem(row, 2, createItem(s.viaCount));
+            mUi->tblNets->setItem(row, 3, createItem(s.traces.area));
+            mUi->tblNets->setItem(row, 4, createItem(s.planeArea));
+        }
+
+        // layers
+        foreach (const QString& layerName, statistics.getLayerNames()) {
+            BoardStatistics::LayerStatistics s = statistics.getLayerStatistics(layerName);
+            const GraphicsLayer* layer = mActiveBoard->getLayerStack().getLayer(layerName);
+            int row = mUi->tblLayers->rowCount();
+            mUi->tblLayers->insertRow(row);
+            mUi->tblLayers->setItem(row, 0, createItem(layer ? layer->getNameTr() : layerName));
+            mUi->tblLayers->setItem(row, 1, createItem(s.traces.length.toMm()));
+            mUi->tblLayers->setItem(row, 2, createItem(s.traces.area));
+            mUi->tblLayers->setItem(row, 3, createItem(s.planeArea));
+        }
+        mUi->lblVias->setText(tr("Total vias: %1").arg(statistics.getViaCount()));
+    } else {
+        mUi->lblVias->clear();
+    }
+
+    mUi->tblNets->setSortingEnabled(true);
+    mUi->tblLayers->setSortingEnabled(true);
+}
+
+QTableWidgetItem* BoardStatisticsDock::createItem(const QVariant& value) noexcept
+{
+    QTableWidgetItem* item = new QTableWidgetItem();
+    if (value.type() == QVariant::Double) {
+        // round to three decimals, but keep it sortable as number
+        item->setData(Qt::DisplayRole, qRound64(value.toDouble() * 1000) / qreal(1000));
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    } else if (value.type() == QVariant::Int) {
+        item->setData(Qt::DisplayRole, value);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    } else {
+        item->setData(Qt::DisplayRole, value);
+    }
+    item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+    return item;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
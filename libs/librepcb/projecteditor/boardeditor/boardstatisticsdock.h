@@ -0,0 +1,93 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDSTATISTICSDOCK_H
+#define LIBREPCB_PROJECT_BOARDSTATISTICSDOCK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+namespace editor {
+
+namespace Ui {
+class BoardStatisticsDock;
+}
+
+/*****************************************************************************************
+ *  Class BoardStatisticsDock
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardStatisticsDock class shows the copper statistics of a board (see
+ *        librepcb::project::BoardStatistics) per net signal and per layer
+ *
+ * The tables are only updated while the dock is visible, and modifications are
+ * accumulated for a short time to avoid updates on every mouse move.
+ */
+class BoardStatisticsDock final : public QDockWidget
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        BoardStatisticsDock(const BoardStatisticsDock& other) = delete;
+        explicit BoardStatisticsDock(QWidget* parent = nullptr) noexcept;
+        ~BoardStatisticsDock() noexcept;
+
+        // Setters
+        void setActiveBoard(Board* board) noexcept;
+
+        // Operator Overloadings
+        BoardStatisticsDock& operator=(const BoardStatisticsDock& rhs) = delete;
+
+
+    private: // Methods
+        void scheduleUpdate() noexcept;
+        void updateTables() noexcept;
+        static QTableWidgetItem* createItem(const QVariant& value) noexcept;
+
+
+    private: // Data
+        QScopedPointer<Ui::BoardStatisticsDock> mUi;
+        Board* mActiveBoard;
+        QMetaObject::Connection mActiveBoardConnection;
+        QTimer mUpdateTimer;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDSTATISTICSDOCK_H
@@ -40,7 +40,12 @@
 #include <librepcb/project/boards/items/bi_netline.h>
 #include <librepcb/project/boards/cmd/cmdboardnetpointedit.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/graphics/graphicsitemsmovepreview.h>
+#include <librepcb/common/graphics/linegraphicsitem.h>
 #include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardobstacleindex.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
 #include "../../cmd/cmdplaceboardnetpoint.h"
 #include "../../cmd/cmdcombineboardnetpoints.h"
 #include "../../cmd/cmdcombineallitemsunderboardnetpoint.h"
@@ -63,9 +68,10 @@ BES_DrawTrace::BES_DrawTrace(BoardEditor& editor, Ui::BoardEditor& editorUi,
     mCurrentLayerName(GraphicsLayer::sTopCopper), mCurrentWidth(500000),
     mFixedNetPoint(nullptr), mPositioningNetLine1(nullptr), mPositioningNetPoint1(nullptr),
     mPositioningNetLine2(nullptr), mPositioningNetPoint2(nullptr),
+    mRouterMode(BoardTraceRouter::Mode::Walkaround),
     // command toolbar actions / widgets:
     mLayerLabel(nullptr), mLayerComboBox(nullptr), mWidthLabel(nullptr),
-    mWidthComboBox(nullptr)
+    mWidthComboBox(nullptr), mRouterLabel(nullptr), mRouterComboBox(nullptr)
 {
 }
 
@@ -166,6 +172,26 @@ bool BES_DrawTrace::entry(BEE_Base* event) noexcept
     connect(mWidthComboBox, &QComboBox::currentTextChanged,
             this, &BES_DrawTrace::wireWidthComboBoxTextChanged);
 
+    // add the "Router:" label to the toolbar
+    mRouterLabel = new QLabel(tr("Router:"));
+    mRouterLabel->setIndent(10);
+    mEditorUi.commandToolbar->addWidget(mRouterLabel);
+
+    // add the router modes combobox to the toolbar
+    mRouterComboBox = new QComboBox();
+    mRouterComboBox->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    mRouterComboBox->setInsertPolicy(QComboBox::NoInsert);
+    mRouterComboBox->addItem(tr("Ignore Obstacles"),
+                             static_cast<int>(BoardTraceRouter::Mode::IgnoreObstacles));
+    mRouterComboBox->addItem(tr("Walkaround"),
+                             static_cast<int>(BoardTraceRouter::Mode::Walkaround));
+    mRouterComboBox->addItem(tr("Push and Shove"),
+                             static_cast<int>(BoardTraceRouter::Mode::Shove));
+    mRouterComboBox->setCurrentIndex(mRouterComboBox->findData(static_cast<int>(mRouterMode)));
+    mEditorUi.commandToolbar->addWidget(mRouterComboBox);
+    connect(mRouterComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &BES_DrawTrace::routerComboBoxIndexChanged);
+
     // change the cursor
     mEditorGraphicsView.setCursor(Qt::CrossCursor);
 
@@ -181,6 +207,8 @@ bool BES_DrawTrace::exit(BEE_Base* event) noexcept
         abortPositioning(true);
 
     // Remove actions / widgets from the "command" toolbar
+    delete mRouterComboBox;         mRouterComboBox = nullptr;
+    delete mRouterLabel;            mRouterLabel = nullptr;
     delete mWidthComboBox;          mWidthComboBox = nullptr;
     delete mWidthLabel;             mWidthLabel = nullptr;
     delete mLayerComboBox;          mLayerComboBox = nullptr;
@@ -335,6 +363,8 @@ bool BES_DrawTrace::startPositioning(Board& board, const Point& pos,
         if (fixedPoint) {
             mFixedNetPoint = fixedPoint;
         } else {
+            // the board may have been modified since the last trace was drawn
+            mObstacleIndex.reset(new BoardObstacleIndex(board));
             GraphicsLayer* layer = board.getLayerStack().getLayer(mCurrentLayerName);
             if (!layer) {
                 throw RuntimeError(__FILE__, __LINE__,
@@ -391,11 +421,43 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
     if (pos == mFixedNetPoint->getPosition()) {
         abortPositioning(true);
         return false;
+    } else if (mPositioningNetPoint2->getPosition() == mFixedNetPoint->getPosition()) {
+        // the router did not find any way, so there is nothing to fix
+        return false;
     } else {
         bool finishCommand = false;
+        BI_NetPoint* lastPoint = mPositioningNetPoint2;
+        QList<BI_NetSegment*> modifiedNetSegments;
 
         try
         {
+            // apply the shoved netpoints by undo commands
+            QHash<BI_NetPoint*, Point> shovedNetPoints = mShovedNetPoints;
+            updateShovePreview(QHash<BI_NetPoint*, Point>());
+            for (auto it = shovedNetPoints.constBegin(); it != shovedNetPoints.constEnd(); ++it) {
+                CmdBoardNetPointEdit* cmd = new CmdBoardNetPointEdit(*it.key());
+                cmd->setPosition(it.value(), false);
+                mUndoStack.appendToCmdGroup(cmd); // can throw
+                if (!modifiedNetSegments.contains(&it.key()->getNetSegment())) {
+                    modifiedNetSegments.append(&it.key()->getNetSegment());
+                }
+            }
+
+            // add the additional points found by the router
+            QVector<Point> routedPoints = mRoutedPoints;
+            updateRoutePreview(QVector<Point>());
+            if (!routedPoints.isEmpty()) {
+                GraphicsLayer& layer = mPositioningNetPoint2->getLayer();
+                CmdBoardNetSegmentAddElements* cmd = new CmdBoardNetSegmentAddElements(
+                    mFixedNetPoint->getNetSegment());
+                foreach (const Point& point, routedPoints) {
+                    BI_NetPoint* netpoint = cmd->addNetPoint(layer, point); Q_ASSERT(netpoint);
+                    cmd->addNetLine(*lastPoint, *netpoint, mCurrentWidth);
+                    lastPoint = netpoint;
+                }
+                mUndoStack.appendToCmdGroup(cmd); // can throw
+            }
+
             // remove p1 if p1 == p0 || p1 == p2
             if (mPositioningNetPoint1->getPosition() == mFixedNetPoint->getPosition()) {
                 mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*mPositioningNetPoint1, *mFixedNetPoint));
@@ -403,8 +465,8 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
                 mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*mPositioningNetPoint1, *mPositioningNetPoint2));
             }
 
-            // combine all board items under "mPositioningNetPoint2" together
-            auto* cmd = new CmdCombineAllItemsUnderBoardNetPoint(*mPositioningNetPoint2);
+            // combine all board items under the last netpoint together
+            auto* cmd = new CmdCombineAllItemsUnderBoardNetPoint(*lastPoint);
             mUndoStack.appendToCmdGroup(cmd);
             finishCommand = cmd->hasCombinedSomeItems();
         }
@@ -430,7 +492,14 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
                 abortPositioning(true);
                 return false;
             } else {
-                return startPositioning(board, pos, mPositioningNetPoint2);
+                // only the shoved net segments have changed for other nets
+                foreach (BI_NetSegment* segment, modifiedNetSegments) {
+                    if (mObstacleIndex) mObstacleIndex->updateNetSegment(*segment);
+                }
+                if (mObstacleIndex) {
+                    mObstacleIndex->updateNetSegment(lastPoint->getNetSegment());
+                }
+                return startPositioning(board, pos, lastPoint);
             }
         }
         catch (Exception e)
@@ -448,6 +517,8 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept
 {
     try
     {
+        updateShovePreview(QHash<BI_NetPoint*, Point>());
+        updateRoutePreview(QVector<Point>());
         mCircuit.setHighlightedNetSignal(nullptr);
         mSubState = SubState_Idle;
         mFixedNetPoint = nullptr;
@@ -467,14 +538,91 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept
 
 void BES_DrawTrace::updateNetpointPositions(const Point& cursorPos) noexcept
 {
-    mPositioningNetPoint1->setPosition(calcMiddlePointPos(mFixedNetPoint->getPosition(),
-                                                          cursorPos, mCurrentWireMode));
-    mPositioningNetPoint2->setPosition(cursorPos);
+    Point p0 = mFixedNetPoint->getPosition();
+    Point middle = calcMiddlePointPos(p0, cursorPos, mCurrentWireMode);
+
+    if ((mRouterMode == BoardTraceRouter::Mode::IgnoreObstacles) || (!mObstacleIndex)) {
+        mPositioningNetPoint1->setPosition(middle);
+        mPositioningNetPoint2->setPosition(cursorPos);
+        updateRoutePreview(QVector<Point>());
+        updateShovePreview(QHash<BI_NetPoint*, Point>());
+    } else {
+        BoardTraceRouter router(*mObstacleIndex);
+        BoardTraceRouter::Result result = router.route(
+            mFixedNetPoint->getLayer().getName(), {p0, middle, cursorPos}, mCurrentWidth,
+            &mFixedNetPoint->getNetSignalOfNetSegment(), mRouterMode);
+
+        // the first two routed segments are drawn with the positioning netlines, all
+        // other segments are only previewed until the next netpoint gets fixed
+        const QVector<Point>& points = result.points;
+        Point p1 = (points.count() > 2) ? points.at(1) : p0;
+        Point p2 = (points.count() > 2) ? points.at(2) : points.value(1, p0);
+        mPositioningNetPoint1->setPosition(p1);
+        mPositioningNetPoint2->setPosition(p2);
+        updateRoutePreview(points.mid(3));
+
+        // other nets are not modified until the next netpoint gets fixed
+        updateShovePreview(result.shovedNetPoints);
+    }
 
     // Force updating airwires immediately as they are important for creating traces.
     mPositioningNetPoint2->getBoard().triggerAirWiresRebuild();
 }
 
+void BES_DrawTrace::updateRoutePreview(const QVector<Point>& points) noexcept
+{
+    foreach (const QSharedPointer<LineGraphicsItem>& line, mRoutePreviewLines) {
+        if (line->scene()) line->scene()->removeItem(line.data());
+    }
+    mRoutePreviewLines.clear();
+    mRoutedPoints = points;
+    if (points.isEmpty()) return;
+
+    Board& board = mPositioningNetPoint2->getBoard();
+    Point previous = mPositioningNetPoint2->getPosition();
+    const GraphicsLayer* layer = &mPositioningNetPoint2->getLayer();
+    QGraphicsItem* netlineItem = mPositioningNetLine2->getSceneGraphicsItem();
+    foreach (const Point& point, points) {
+        QSharedPointer<LineGraphicsItem> line(new LineGraphicsItem());
+        line->setLine(previous, point);
+        line->setLineWidth(mCurrentWidth);
+        line->setLayer(layer);
+        if (netlineItem) line->setZValue(netlineItem->zValue());
+        board.getGraphicsScene().addItem(*line);
+        mRoutePreviewLines.append(line);
+        previous = point;
+    }
+}
+
+void BES_DrawTrace::updateShovePreview(
+    const QHash<BI_NetPoint*, Point>& shovedNetPoints) noexcept
+{
+    mShovePreview.reset(); // restores the original graphics items
+    mShovedNetPoints = shovedNetPoints;
+    if (shovedNetPoints.isEmpty()) return;
+
+    // move the graphics items of the shoved netpoints and replace all netlines connected
+    // to them by rubber band lines
+    Board& board = mPositioningNetPoint2->getBoard();
+    mShovePreview.reset(new GraphicsItemsMovePreview(board.getGraphicsScene()));
+    QList<BI_NetLine*> netlines;
+    for (auto it = shovedNetPoints.constBegin(); it != shovedNetPoints.constEnd(); ++it) {
+        mShovePreview->addMovedItem(it.key()->getSceneGraphicsItem(),
+                                    it.value() - it.key()->getPosition());
+        foreach (BI_NetLine* netline, it.key()->getLines()) {
+            if (!netlines.contains(netline)) netlines.append(netline);
+        }
+    }
+    foreach (BI_NetLine* netline, netlines) {
+        BI_NetPoint& start = netline->getStartPoint();
+        BI_NetPoint& end = netline->getEndPoint();
+        mShovePreview->addRubberBandLine(netline->getSceneGraphicsItem(),
+            shovedNetPoints.value(&start, start.getPosition()),
+            shovedNetPoints.value(&end, end.getPosition()),
+            netline->getWidth(), &netline->getLayer());
+    }
+}
+
 void BES_DrawTrace::layerComboBoxIndexChanged(int index) noexcept
 {
     mCurrentLayerName = mLayerComboBox->itemData(index).toString();
@@ -489,6 +637,11 @@ void BES_DrawTrace::wireWidthComboBoxTextChanged(const QString& width) noexcept
     if (mPositioningNetLine2) mPositioningNetLine2->setWidth(mCurrentWidth);
 }
 
+void BES_DrawTrace::routerComboBoxIndexChanged(int index) noexcept
+{
+    mRouterMode = static_cast<BoardTraceRouter::Mode>(mRouterComboBox->itemData(index).toInt());
+}
+
 void BES_DrawTrace::updateWireModeActionsCheckedState() noexcept
 {
     foreach (WireMode key, mWireModeActions.keys()) {
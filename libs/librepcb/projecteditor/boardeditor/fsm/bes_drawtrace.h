@@ -25,16 +25,22 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/project/boards/boardtracerouter.h>
 #include "bes_base.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
+
+class LineGraphicsItem;
+class GraphicsItemsMovePreview;
+
 namespace project {
 
 class BI_NetPoint;
 class BI_NetLine;
+class BoardObstacleIndex;
 
 namespace editor {
 
@@ -98,8 +104,11 @@ class BES_DrawTrace final : public BES_Base
         bool addNextNetPoint(Board& board, const Point& pos) noexcept;
         bool abortPositioning(bool showErrMsgBox) noexcept;
         void updateNetpointPositions(const Point& cursorPos) noexcept;
+        void updateRoutePreview(const QVector<Point>& points) noexcept;
+        void updateShovePreview(const QHash<BI_NetPoint*, Point>& shovedNetPoints) noexcept;
         void layerComboBoxIndexChanged(int index) noexcept;
         void wireWidthComboBoxTextChanged(const QString& width) noexcept;
+        void routerComboBoxIndexChanged(int index) noexcept;
         void updateWireModeActionsCheckedState() noexcept;
         Point calcMiddlePointPos(const Point& p1, const Point p2, WireMode mode) const noexcept;
 
@@ -115,6 +124,14 @@ class BES_DrawTrace final : public BES_Base
         BI_NetLine* mPositioningNetLine2; ///< line between p1 and p2
         BI_NetPoint* mPositioningNetPoint2; ///< the second netpoint to place
 
+        // Router
+        BoardTraceRouter::Mode mRouterMode; ///< how to handle obstacles
+        QScopedPointer<BoardObstacleIndex> mObstacleIndex; ///< built on start positioning
+        QVector<Point> mRoutedPoints; ///< additional points after p2 found by the router
+        QList<QSharedPointer<LineGraphicsItem>> mRoutePreviewLines; ///< lines after p2
+        QHash<BI_NetPoint*, Point> mShovedNetPoints; ///< value: new (previewed) position
+        QScopedPointer<GraphicsItemsMovePreview> mShovePreview; ///< shoved items of other nets
+
         // Widgets for the command toolbar
         QHash<WireMode, QAction*> mWireModeActions;
         QList<QAction*> mActionSeparators;
@@ -122,6 +139,8 @@ class BES_DrawTrace final : public BES_Base
         QComboBox* mLayerComboBox;
         QLabel* mWidthLabel;
         QComboBox* mWidthComboBox;
+        QLabel* mRouterLabel;
+        QComboBox* mRouterComboBox;
 };
 
 /*****************************************************************************************
@@ -78,7 +78,7 @@ bool CmdAddDeviceToBoard::performExecute()
 {
     // if there is no such device in the project's library, copy it from the
     // workspace library to the project's library
-    library::Device* dev = mBoard.getProject().getLibrary().getDevice(mDeviceUuid);
+    const library::Device* dev = mBoard.getProject().getLibrary().getDevice(mDeviceUuid);
     if (!dev) {
         FilePath devFp = mWorkspace.getLibraryDb().getLatestDevice(mDeviceUuid);
         if (!devFp.isValid()) {
@@ -86,17 +86,18 @@ bool CmdAddDeviceToBoard::performExecute()
                 QString(tr("The device with the UUID \"%1\" does not exist in the "
                 "workspace library!")).arg(mDeviceUuid.toStr()));
         }
-        dev = new library::Device(devFp, true);
+        library::Device* newDev = new library::Device(devFp, true);
         CmdProjectLibraryAddElement<library::Device>* cmdAddToLibrary =
-            new CmdProjectLibraryAddElement<library::Device>(mBoard.getProject().getLibrary(), *dev);
+            new CmdProjectLibraryAddElement<library::Device>(mBoard.getProject().getLibrary(), *newDev);
         appendChild(cmdAddToLibrary); // can throw
+        dev = newDev;
     }
     Q_ASSERT(dev);
 
     // if there is no such package in the project's library, copy it from the
     // workspace library to the project's library
     Uuid pkgUuid = dev->getPackageUuid();
-    library::Package* pkg = mBoard.getProject().getLibrary().getPackage(pkgUuid);
+    const library::Package* pkg = mBoard.getProject().getLibrary().getPackage(pkgUuid);
     if (!pkg) {
         FilePath pkgFp = mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);
         if (!pkgFp.isValid()) {
@@ -104,10 +105,11 @@ bool CmdAddDeviceToBoard::performExecute()
                 QString(tr("The package with the UUID \"%1\" does not exist in the "
                 "workspace library!")).arg(pkgUuid.toStr()));
         }
-        pkg = new library::Package(pkgFp, true);
+        library::Package* newPkg = new library::Package(pkgFp, true);
         CmdProjectLibraryAddElement<library::Package>* cmdAddToLibrary =
-            new CmdProjectLibraryAddElement<library::Package>(mBoard.getProject().getLibrary(), *pkg);
+            new CmdProjectLibraryAddElement<library::Package>(mBoard.getProject().getLibrary(), *newPkg);
         appendChild(cmdAddToLibrary); // can throw
+        pkg = newPkg;
     }
     Q_ASSERT(pkg);
 
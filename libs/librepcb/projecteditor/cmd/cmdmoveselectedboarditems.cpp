@@ -26,11 +26,15 @@
 #include <librepcb/common/geometry/cmd/cmdstroketextedit.h>
 #include <librepcb/common/geometry/cmd/cmdholeedit.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/graphics/graphicsitemsmovepreview.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/items/bi_device.h>
 #include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_netline.h>
 #include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_plane.h>
 #include <librepcb/project/boards/items/bi_via.h>
 #include <librepcb/project/boards/items/bi_polygon.h>
 #include <librepcb/project/boards/items/bi_stroketext.h>
@@ -99,6 +103,50 @@ CmdMoveSelectedBoardItems::CmdMoveSelectedBoardItems(Board& board, const Point&
         CmdHoleEdit* cmd = new CmdHoleEdit(hole->getHole());
         mHoleEditCmds.append(cmd);
     }
+
+    // prepare the preview which is shown while moving
+    mPreview.reset(new GraphicsItemsMovePreview(mBoard.getGraphicsScene()));
+    QSet<BI_NetPoint*> movedNetPoints = query->getNetPoints();
+    foreach (BI_Footprint* footprint, query->getFootprints()) {
+        mPreview->addMovedItem(footprint->getSceneGraphicsItem());
+        foreach (BI_FootprintPad* pad, footprint->getPads()) {
+            mPreview->addMovedItem(pad->getSceneGraphicsItem());
+            foreach (BI_NetPoint* netpoint, pad->getNetPoints()) {
+                movedNetPoints.insert(netpoint);
+            }
+        }
+    }
+    foreach (BI_Via* via, query->getVias()) {
+        mPreview->addMovedItem(via->getSceneGraphicsItem());
+        foreach (BI_NetPoint* netpoint, via->getNetPoints()) {
+            movedNetPoints.insert(netpoint);
+        }
+    }
+    foreach (BI_NetPoint* netpoint, movedNetPoints) {
+        mPreview->addMovedItem(netpoint->getSceneGraphicsItem());
+        foreach (BI_NetLine* netline, netpoint->getLines()) {
+            BI_NetPoint* other = netline->getOtherPoint(*netpoint);
+            if (other && movedNetPoints.contains(other)) {
+                mPreview->addMovedItem(netline->getSceneGraphicsItem());
+            } else if (other) {
+                mPreview->addRubberBandLine(netline->getSceneGraphicsItem(),
+                                            other->getPosition(), netpoint->getPosition(),
+                                            netline->getWidth(), &netline->getLayer());
+            }
+        }
+    }
+    foreach (BI_Plane* plane, query->getPlanes()) {
+        mPreview->addMovedItem(plane->getSceneGraphicsItem());
+    }
+    foreach (BI_Polygon* polygon, query->getPolygons()) {
+        mPreview->addMovedItem(polygon->getSceneGraphicsItem());
+    }
+    foreach (BI_StrokeText* text, query->getStrokeTexts()) {
+        mPreview->addMovedItem(text->getSceneGraphicsItem());
+    }
+    foreach (BI_Hole* hole, query->getHoles()) {
+        mPreview->addMovedItem(hole->getSceneGraphicsItem());
+    }
 }
 
 CmdMoveSelectedBoardItems::~CmdMoveSelectedBoardItems() noexcept
@@ -115,32 +163,9 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept
     delta.mapToGrid(mBoard.getGridProperties().getInterval());
 
     if (delta != mDeltaPos) {
-        // move selected elements
-        foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdBoardViaEdit* cmd, mViaEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdBoardNetPointEdit* cmd, mNetPointEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdBoardPlaneEdit* cmd, mPlaneEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdPolygonEdit* cmd, mPolygonEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdStrokeTextEdit* cmd, mStrokeTextEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdHoleEdit* cmd, mHoleEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
+        // only move the graphics items, the board items are modified on execution
+        mPreview->setDelta(delta);
         mDeltaPos = delta;
-
-        // Force updating airwires immediately as they are important while moving items.
-        mBoard.triggerAirWiresRebuild();
     }
 }
 
@@ -150,6 +175,9 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept
 
 bool CmdMoveSelectedBoardItems::performExecute()
 {
+    // the graphics items must be restored before the board items are modified
+    mPreview->restore();
+
     if (mDeltaPos.isOrigin()) {
         // no movement required --> discard all move commands
         qDeleteAll(mDeviceEditCmds);    mDeviceEditCmds.clear();
@@ -163,24 +191,31 @@ bool CmdMoveSelectedBoardItems::performExecute()
     }
 
     foreach (CmdDeviceInstanceEdit* cmd, mDeviceEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdBoardViaEdit* cmd, mViaEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdBoardNetPointEdit* cmd, mNetPointEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdBoardPlaneEdit* cmd, mPlaneEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdPolygonEdit* cmd, mPolygonEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdStrokeTextEdit* cmd, mStrokeTextEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdHoleEdit* cmd, mHoleEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
 
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <librepcb/common/undocommandgroup.h>
 #include <librepcb/common/units/all_length_units.h>
@@ -35,6 +36,7 @@ namespace librepcb {
 class CmdPolygonEdit;
 class CmdStrokeTextEdit;
 class CmdHoleEdit;
+class GraphicsItemsMovePreview;
 
 namespace project {
 
@@ -52,6 +54,10 @@ namespace editor {
 
 /**
  * @brief The CmdMoveSelectedBoardItems class
+ *
+ * While the mouse is moved (#setCurrentPosition()), only a
+ * librepcb::GraphicsItemsMovePreview is shown. The board items are not modified until
+ * the command gets executed.
  */
 class CmdMoveSelectedBoardItems final : public UndoCommandGroup
 {
@@ -77,6 +83,7 @@ class CmdMoveSelectedBoardItems final : public UndoCommandGroup
         Board& mBoard;
         Point mStartPos;
         Point mDeltaPos;
+        std::unique_ptr<GraphicsItemsMovePreview> mPreview;
 
         // Move commands
         QList<CmdDeviceInstanceEdit*> mDeviceEditCmds;
@@ -23,8 +23,11 @@
 #include <QtCore>
 #include "cmdmoveselectedschematicitems.h"
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/graphics/graphicsitemsmovepreview.h>
+#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/schematiclayerprovider.h>
 #include <librepcb/project/schematics/items/si_symbol.h>
 #include <librepcb/project/schematics/items/si_symbolpin.h>
 #include <librepcb/project/schematics/items/si_netpoint.h>
@@ -74,6 +77,38 @@ CmdMoveSelectedSchematicItems::CmdMoveSelectedSchematicItems(Schematic& schemati
         CmdSchematicNetLabelEdit* cmd = new CmdSchematicNetLabelEdit(*netlabel);
         mNetLabelEditCmds.append(cmd);
     }
+
+    // prepare the preview which is shown while moving
+    mPreview.reset(new GraphicsItemsMovePreview(mSchematic.getGraphicsScene()));
+    QSet<SI_NetPoint*> movedNetPoints = query->getNetPoints();
+    foreach (SI_Symbol* symbol, query->getSymbols()) {
+        mPreview->addMovedItem(symbol->getSceneGraphicsItem());
+        foreach (SI_SymbolPin* pin, symbol->getPins()) {
+            mPreview->addMovedItem(pin->getSceneGraphicsItem());
+            if (pin->getNetPoint()) {
+                movedNetPoints.insert(pin->getNetPoint());
+            }
+        }
+    }
+    const GraphicsLayer* netLinesLayer = mSchematic.getProject().getLayers().getLayer(
+        GraphicsLayer::sSchematicNetLines);
+    foreach (SI_NetPoint* netpoint, movedNetPoints) {
+        mPreview->addMovedItem(netpoint->getSceneGraphicsItem());
+        foreach (SI_NetLine* netline, netpoint->getLines()) {
+            SI_NetPoint* other = &netline->getStartPoint();
+            if (other == netpoint) other = &netline->getEndPoint();
+            if (movedNetPoints.contains(other)) {
+                mPreview->addMovedItem(netline->getSceneGraphicsItem());
+            } else {
+                mPreview->addRubberBandLine(netline->getSceneGraphicsItem(),
+                                            other->getPosition(), netpoint->getPosition(),
+                                            netline->getWidth(), netLinesLayer);
+            }
+        }
+    }
+    foreach (SI_NetLabel* netlabel, query->getNetLabels()) {
+        mPreview->addMovedItem(netlabel->getSceneGraphicsItem());
+    }
 }
 
 CmdMoveSelectedSchematicItems::~CmdMoveSelectedSchematicItems() noexcept
@@ -90,16 +125,8 @@ void CmdMoveSelectedSchematicItems::setCurrentPosition(const Point& pos) noexcep
     delta.mapToGrid(mSchematic.getGridProperties().getInterval());
 
     if (delta != mDeltaPos) {
-        // move selected elements
-        foreach (CmdSymbolInstanceEdit* cmd, mSymbolEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdSchematicNetPointEdit* cmd, mNetPointEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
-        foreach (CmdSchematicNetLabelEdit* cmd, mNetLabelEditCmds) {
-            cmd->setDeltaToStartPos(delta, true);
-        }
+        // only move the graphics items, the schematic items are modified on execution
+        mPreview->setDelta(delta);
         mDeltaPos = delta;
     }
 }
@@ -110,6 +137,9 @@ void CmdMoveSelectedSchematicItems::setCurrentPosition(const Point& pos) noexcep
 
 bool CmdMoveSelectedSchematicItems::performExecute()
 {
+    // the graphics items must be restored before the schematic items are modified
+    mPreview->restore();
+
     if (mDeltaPos.isOrigin()) {
         // no movement required --> discard all move commands
         qDeleteAll(mSymbolEditCmds);    mSymbolEditCmds.clear();
@@ -119,12 +149,15 @@ bool CmdMoveSelectedSchematicItems::performExecute()
     }
 
     foreach (CmdSymbolInstanceEdit* cmd, mSymbolEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdSchematicNetPointEdit* cmd, mNetPointEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
     foreach (CmdSchematicNetLabelEdit* cmd, mNetLabelEditCmds) {
+        cmd->setDeltaToStartPos(mDeltaPos, false);
         appendChild(cmd); // can throw
     }
 
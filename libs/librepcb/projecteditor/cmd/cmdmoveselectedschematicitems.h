@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <librepcb/common/undocommandgroup.h>
 #include <librepcb/common/units/all_length_units.h>
@@ -31,6 +32,9 @@
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
+
+class GraphicsItemsMovePreview;
+
 namespace project {
 
 class Schematic;
@@ -46,6 +50,10 @@ namespace editor {
 
 /**
  * @brief The CmdMoveSelectedSchematicItems class
+ *
+ * Like librepcb::project::editor::CmdMoveSelectedBoardItems, only a
+ * librepcb::GraphicsItemsMovePreview is shown while moving. The schematic items are
+ * not modified until the command gets executed.
  */
 class CmdMoveSelectedSchematicItems final : public UndoCommandGroup
 {
@@ -71,6 +79,7 @@ class CmdMoveSelectedSchematicItems final : public UndoCommandGroup
         Schematic& mSchematic;
         Point mStartPos;
         Point mDeltaPos;
+        std::unique_ptr<GraphicsItemsMovePreview> mPreview;
 
         // Move commands
         QList<CmdSymbolInstanceEdit*> mSymbolEditCmds;
@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdremoveselectedboarditems.h"
 #include <librepcb/common/scopeguard.h>
+#include <librepcb/common/utils/connectivitygraph.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/items/bi_device.h>
@@ -221,60 +222,47 @@ CmdRemoveSelectedBoardItems::getNonCohesiveNetSegmentSubSegments(
     QSet<BI_NetPoint*> netpoints = segment.getNetPoints().toSet() - removedItems.netpoints;
     QSet<BI_NetLine*> netlines = segment.getNetLines().toSet() - removedItems.netlines;
 
-    // find all separate segments of the netsegment
-    QList<NetSegmentItems> segments;
-    while (netpoints.count() > 0) {
-        NetSegmentItems seg;
-        findAllConnectedNetPointsAndNetLines(*netpoints.values().first(),
-                                             vias, netpoints, netlines,
-                                             seg.vias, seg.netpoints, seg.netlines);
-        foreach (BI_Via* v, seg.vias) vias.remove(v);
-        foreach (BI_NetPoint* p, seg.netpoints) netpoints.remove(p);
-        foreach (BI_NetLine* l, seg.netlines) netlines.remove(l);
-        segments.append(seg);
+    // determine connected groups of the remaining vias and netpoints by removing the
+    // items from a copy of the segment's connectivity graph
+    ConnectivityGraph<const BI_Base*> graph = segment.getConnectivity();
+    foreach (const BI_NetLine* netline, removedItems.netlines) {
+        graph.removeEdge(&netline->getStartPoint(), &netline->getEndPoint());
     }
-    foreach (BI_Via* via, vias) {
-        NetSegmentItems seg;
-        seg.vias.insert(via);
-        segments.append(seg);
-        vias.remove(via);
+    foreach (const BI_NetPoint* netpoint, removedItems.netpoints) {
+        graph.removeNode(netpoint);
+    }
+    foreach (const BI_Via* via, removedItems.vias) {
+        graph.removeNode(via);
     }
-    Q_ASSERT(vias.isEmpty());
-    Q_ASSERT(netpoints.isEmpty());
-    Q_ASSERT(netlines.isEmpty());
-    return segments;
-}
 
-void CmdRemoveSelectedBoardItems::findAllConnectedNetPointsAndNetLines(
-        BI_NetPoint& netpoint, QSet<BI_Via*>& availableVias,
-        QSet<BI_NetPoint*>& availableNetPoints, QSet<BI_NetLine*>& availableNetLines,
-        QSet<BI_Via*>& vias, QSet<BI_NetPoint*>& netpoints, QSet<BI_NetLine*>& netlines) const noexcept
-{
-    Q_ASSERT(!netpoints.contains(&netpoint));
-    Q_ASSERT(availableNetPoints.contains(&netpoint));
-    netpoints.insert(&netpoint);
-    if (netpoint.isAttachedToVia()) {
-        BI_Via* via = netpoint.getVia(); Q_ASSERT(via);
-        if ((availableVias.contains(via)) && (!vias.contains(via))) {
-            vias.insert(via);
-            foreach (BI_NetPoint* np, via->getNetPoints()) {
-                if ((availableNetPoints.contains(np)) && (!netpoints.contains(np))) {
-                    findAllConnectedNetPointsAndNetLines(*np, availableVias,
-                        availableNetPoints, availableNetLines, vias, netpoints, netlines);
-                }
-            }
+    // create one segment per group (iterate over the original lists instead of the sets
+    // to get a deterministic order of the items)
+    QList<NetSegmentItems> segments;
+    QHash<const BI_Base*, int> segmentIndices;
+    foreach (const QList<const BI_Base*>& group, graph.getGroups()) {
+        foreach (const BI_Base* item, group) {
+            segmentIndices.insert(item, segments.count());
         }
+        segments.append(NetSegmentItems());
     }
-    foreach (BI_NetLine* line, netpoint.getLines()) {
-        if (availableNetLines.contains(line)) {
-            netlines.insert(line);
-            BI_NetPoint* p2 = line->getOtherPoint(netpoint); Q_ASSERT(p2);
-            if ((availableNetPoints.contains(p2)) && (!netpoints.contains(p2))) {
-                findAllConnectedNetPointsAndNetLines(*p2, availableVias,
-                    availableNetPoints, availableNetLines, vias, netpoints, netlines);
-            }
+    foreach (BI_Via* via, segment.getVias()) {
+        if (vias.contains(via)) {
+            segments[segmentIndices.value(via)].vias.insert(via);
         }
     }
+    foreach (BI_NetPoint* netpoint, segment.getNetPoints()) {
+        if (netpoints.contains(netpoint)) {
+            segments[segmentIndices.value(netpoint)].netpoints.insert(netpoint);
+        }
+    }
+    foreach (BI_NetLine* netline, segment.getNetLines()) {
+        if (!netlines.contains(netline)) continue;
+        int index = segmentIndices.value(&netline->getStartPoint(), -1);
+        if (index >= 0) {
+            segments[index].netlines.insert(netline);
+        }
+    }
+    return segments;
 }
 
 /*****************************************************************************************
@@ -77,13 +77,6 @@ class CmdRemoveSelectedBoardItems final : public UndoCommandGroup
         void createNewSubNetSegment(BI_NetSegment& netsegment, const NetSegmentItems& items);
         QList<NetSegmentItems> getNonCohesiveNetSegmentSubSegments(BI_NetSegment& segment,
                                                                    const NetSegmentItems& removedItems) noexcept;
-        void findAllConnectedNetPointsAndNetLines(BI_NetPoint& netpoint,
-                                                  QSet<BI_Via*>& availableVias,
-                                                  QSet<BI_NetPoint*>& availableNetPoints,
-                                                  QSet<BI_NetLine*>& availableNetLines,
-                                                  QSet<BI_Via*>& vias,
-                                                  QSet<BI_NetPoint*>& netpoints,
-                                                  QSet<BI_NetLine*>& netlines) const noexcept;
 
 
         // Attributes from the constructor
@@ -24,6 +24,7 @@
 #include "cmdremoveselectedschematicitems.h"
 #include <librepcb/common/scopeguard.h>
 #include <librepcb/common/toolbox.h>
+#include <librepcb/common/utils/connectivitygraph.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/circuit/circuit.h>
 #include <librepcb/project/circuit/netsignal.h>
@@ -390,16 +391,37 @@ CmdRemoveSelectedSchematicItems::getNonCohesiveNetSegmentSubSegments(
     QSet<SI_NetLine*> netlines = segment.getNetLines().toSet() - removedItems.netlines;
     QSet<SI_NetLabel*> netlabels = segment.getNetLabels().toSet() - removedItems.netlabels;
 
-    // find all separate segments of the netsegment
+    // determine connected groups of the remaining netpoints by removing the items from
+    // a copy of the segment's connectivity graph
+    ConnectivityGraph<const SI_NetPoint*> graph = segment.getConnectivity();
+    foreach (const SI_NetLine* netline, removedItems.netlines) {
+        graph.removeEdge(&netline->getStartPoint(), &netline->getEndPoint());
+    }
+    foreach (const SI_NetPoint* netpoint, removedItems.netpoints) {
+        graph.removeNode(netpoint);
+    }
+
+    // create one segment per group (iterate over the original lists instead of the sets
+    // to get a deterministic order of the items)
     QList<NetSegmentItems> segments;
-    while (netpoints.count() > 0) {
-        NetSegmentItems seg;
-        findAllConnectedNetPointsAndNetLines(*netpoints.values().first(),
-                                             netpoints, netlines,
-                                             seg.netpoints, seg.netlines);
-        foreach (SI_NetPoint* p, seg.netpoints) netpoints.remove(p);
-        foreach (SI_NetLine* l, seg.netlines) netlines.remove(l);
-        segments.append(seg);
+    QHash<const SI_NetPoint*, int> segmentIndices;
+    foreach (const QList<const SI_NetPoint*>& group, graph.getGroups()) {
+        foreach (const SI_NetPoint* netpoint, group) {
+            segmentIndices.insert(netpoint, segments.count());
+        }
+        segments.append(NetSegmentItems());
+    }
+    foreach (SI_NetPoint* netpoint, segment.getNetPoints()) {
+        if (netpoints.contains(netpoint)) {
+            segments[segmentIndices.value(netpoint)].netpoints.insert(netpoint);
+        }
+    }
+    foreach (SI_NetLine* netline, segment.getNetLines()) {
+        if (!netlines.contains(netline)) continue;
+        int index = segmentIndices.value(&netline->getStartPoint(), -1);
+        if (index >= 0) {
+            segments[index].netlines.insert(netline);
+        }
     }
 
     // re-assign all netlabels to the resulting netsegments
@@ -411,25 +433,6 @@ CmdRemoveSelectedSchematicItems::getNonCohesiveNetSegmentSubSegments(
     return segments;
 }
 
-void CmdRemoveSelectedSchematicItems::findAllConnectedNetPointsAndNetLines(SI_NetPoint& netpoint,
-        QSet<SI_NetPoint*>& availableNetPoints, QSet<SI_NetLine*>& availableNetLines,
-        QSet<SI_NetPoint*>& netpoints, QSet<SI_NetLine*>& netlines) const noexcept
-{
-    Q_ASSERT(!netpoints.contains(&netpoint));
-    Q_ASSERT(availableNetPoints.contains(&netpoint));
-    netpoints.insert(&netpoint);
-    foreach (SI_NetLine* line, netpoint.getLines()) {
-        if (availableNetLines.contains(line)) {
-            netlines.insert(line);
-            SI_NetPoint* p2 = line->getOtherPoint(netpoint); Q_ASSERT(p2);
-            if ((availableNetPoints.contains(p2)) && (!netpoints.contains(p2))) {
-                findAllConnectedNetPointsAndNetLines(*p2, availableNetPoints,
-                                                     availableNetLines, netpoints, netlines);
-            }
-        }
-    }
-}
-
 int CmdRemoveSelectedSchematicItems::getNearestNetSegmentOfNetLabel(
     const SI_NetLabel& netlabel, const QList<NetSegmentItems>& segments) const noexcept
 {
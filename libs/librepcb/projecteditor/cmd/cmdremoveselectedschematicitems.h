@@ -88,11 +88,6 @@ class CmdRemoveSelectedSchematicItems final : public UndoCommandGroup
         void disconnectComponentSignalInstance(ComponentSignalInstance& signal);
         QList<NetSegmentItems> getNonCohesiveNetSegmentSubSegments(SI_NetSegment& segment,
                                                                    const NetSegmentItems& removedItems) noexcept;
-        void findAllConnectedNetPointsAndNetLines(SI_NetPoint& netpoint,
-                                                  QSet<SI_NetPoint*>& availableNetPoints,
-                                                  QSet<SI_NetLine*>& availableNetLines,
-                                                  QSet<SI_NetPoint*>& netpoints,
-                                                  QSet<SI_NetLine*>& netlines) const noexcept;
         int getNearestNetSegmentOfNetLabel(const SI_NetLabel& netlabel,
                                            const QList<NetSegmentItems>& segments) const noexcept;
         Length getDistanceBetweenNetLabelAndNetSegment(const SI_NetLabel& netlabel,
@@ -33,6 +33,7 @@
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/cmp/componentsymbolvariant.h>
 #include <librepcb/library/dev/device.h>
+#include <librepcb/library/libraryelementcache.h>
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
 #include <librepcb/library/sym/symbol.h>
@@ -106,10 +107,11 @@ AddComponentDialog::~AddComponentDialog() noexcept
 {
     delete mPreviewFootprintGraphicsItem;       mPreviewFootprintGraphicsItem = nullptr;
     qDeleteAll(mPreviewSymbolGraphicsItems);    mPreviewSymbolGraphicsItems.clear();
-    delete mSelectedPackage;                    mSelectedPackage = nullptr;
-    delete mSelectedDevice;                     mSelectedDevice = nullptr;
+    mPreviewSymbols.clear();
+    mSelectedPackage.reset();
+    mSelectedDevice.reset();
     mSelectedSymbVar = nullptr;
-    delete mSelectedComponent;                  mSelectedComponent = nullptr;
+    mSelectedComponent.reset();
     delete mCategoryTreeModel;                  mCategoryTreeModel = nullptr;
     delete mDevicePreviewScene;                 mDevicePreviewScene = nullptr;
     delete mComponentPreviewScene;              mComponentPreviewScene = nullptr;
@@ -183,15 +185,15 @@ void AddComponentDialog::treeComponents_currentItemChanged(QTreeWidgetItem *curr
         if (current) {
             QTreeWidgetItem* cmpItem = current->parent() ? current->parent() : current;
             FilePath cmpFp = FilePath(cmpItem->data(0, Qt::UserRole).toString());
+            // previews share the elements with projects (see LibraryElementCache)
+            library::LibraryElementCache& cache = library::LibraryElementCache::instance();
             if ((!mSelectedComponent) || (mSelectedComponent->getFilePath() != cmpFp)) {
-                library::Component* component = new library::Component(cmpFp, true);
-                setSelectedComponent(component);
+                setSelectedComponent(cache.getElement<library::Component>(cmpFp)); // can throw
             }
             if (current->parent()) {
                 FilePath devFp = FilePath(current->data(0, Qt::UserRole).toString());
                 if ((!mSelectedDevice) || (mSelectedDevice->getFilePath() != devFp)) {
-                    library::Device* device = new library::Device(devFp, true);
-                    setSelectedDevice(device);
+                    setSelectedDevice(cache.getElement<library::Device>(devFp)); // can throw
                 }
             } else {
                 setSelectedDevice(nullptr);
@@ -327,7 +329,7 @@ void AddComponentDialog::setSelectedCategory(const Uuid& categoryUuid)
     mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
 }
 
-void AddComponentDialog::setSelectedComponent(const library::Component* cmp)
+void AddComponentDialog::setSelectedComponent(const std::shared_ptr<const library::Component>& cmp)
 {
     if (cmp == mSelectedComponent) return;
 
@@ -335,8 +337,7 @@ void AddComponentDialog::setSelectedComponent(const library::Component* cmp)
     mUi->lblCompDescription->clear();
     setSelectedDevice(nullptr);
     setSelectedSymbVar(nullptr);
-    delete mSelectedComponent;
-    mSelectedComponent = nullptr;
+    mSelectedComponent.reset();
 
     if (cmp)
     {
@@ -366,6 +367,7 @@ void AddComponentDialog::setSelectedSymbVar(const library::ComponentSymbolVarian
     if (symbVar == mSelectedSymbVar) return;
     qDeleteAll(mPreviewSymbolGraphicsItems);
     mPreviewSymbolGraphicsItems.clear();
+    mPreviewSymbols.clear();
     mSelectedSymbVar = symbVar;
 
     if (mSelectedComponent && symbVar) {
@@ -373,9 +375,11 @@ void AddComponentDialog::setSelectedSymbVar(const library::ComponentSymbolVarian
         for (const library::ComponentSymbolVariantItem& item : symbVar->getSymbolItems()) {
             FilePath symbolFp = mWorkspace.getLibraryDb().getLatestSymbol(item.getSymbolUuid());
             if (!symbolFp.isValid()) continue; // TODO: show warning
-            const library::Symbol* symbol = new library::Symbol(symbolFp, true); // TODO: fix memory leak...
+            std::shared_ptr<const library::Symbol> symbol =
+                library::LibraryElementCache::instance().getElement<library::Symbol>(symbolFp); // can throw
+            mPreviewSymbols.append(symbol);
             library::SymbolPreviewGraphicsItem* graphicsItem = new library::SymbolPreviewGraphicsItem(
-                *mGraphicsLayerProvider, localeOrder, *symbol, mSelectedComponent,
+                *mGraphicsLayerProvider, localeOrder, *symbol, mSelectedComponent.get(),
                 symbVar->getUuid(), item.getUuid());
             graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
             graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
@@ -386,28 +390,29 @@ void AddComponentDialog::setSelectedSymbVar(const library::ComponentSymbolVarian
     }
 }
 
-void AddComponentDialog::setSelectedDevice(const library::Device* dev)
+void AddComponentDialog::setSelectedDevice(const std::shared_ptr<const library::Device>& dev)
 {
     if (dev == mSelectedDevice) return;
 
     delete mPreviewFootprintGraphicsItem;   mPreviewFootprintGraphicsItem = nullptr;
-    delete mSelectedPackage;                mSelectedPackage = nullptr;
-    delete mSelectedDevice;                 mSelectedDevice = nullptr;
+    mSelectedPackage.reset();
+    mSelectedDevice.reset();
 
     if (dev) {
         mSelectedDevice = dev;
         const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
         FilePath pkgFp = mWorkspace.getLibraryDb().getLatestPackage(mSelectedDevice->getPackageUuid());
         if (pkgFp.isValid()) {
-            mSelectedPackage = new library::Package(pkgFp, true);
+            mSelectedPackage = library::LibraryElementCache::instance()
+                .getElement<library::Package>(pkgFp); // can throw
             mUi->lblDeviceName->setText(QString("%1 [%2]").arg(
                 mSelectedDevice->getNames().value(localeOrder),
                 mSelectedPackage->getNames().value(localeOrder)));
             if (mSelectedPackage->getFootprints().count() > 0) {
                 mPreviewFootprintGraphicsItem = new library::FootprintPreviewGraphicsItem(
                     *mGraphicsLayerProvider, localeOrder,
-                    *mSelectedPackage->getFootprints().first(), mSelectedPackage,
-                    mSelectedComponent);
+                    *mSelectedPackage->getFootprints().first(), mSelectedPackage.get(),
+                    mSelectedComponent.get());
                 mDevicePreviewScene->addItem(*mPreviewFootprintGraphicsItem);
                 mUi->viewDevice->zoomAll();
             }
@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcb/common/uuid.h>
@@ -107,9 +108,9 @@ class AddComponentDialog final : public QDialog
         // Private Methods
         void searchComponents(const QString& input);
         void setSelectedCategory(const Uuid& categoryUuid);
-        void setSelectedComponent(const library::Component* cmp);
+        void setSelectedComponent(const std::shared_ptr<const library::Component>& cmp);
         void setSelectedSymbVar(const library::ComponentSymbolVariant* symbVar);
-        void setSelectedDevice(const library::Device* dev);
+        void setSelectedDevice(const std::shared_ptr<const library::Device>& dev);
         void accept() noexcept;
 
 
@@ -125,10 +126,11 @@ class AddComponentDialog final : public QDialog
 
         // Attributes
         Uuid mSelectedCategoryUuid;
-        const library::Component* mSelectedComponent;
+        std::shared_ptr<const library::Component> mSelectedComponent;
         const library::ComponentSymbolVariant* mSelectedSymbVar;
-        const library::Device* mSelectedDevice;
-        const library::Package* mSelectedPackage;
+        std::shared_ptr<const library::Device> mSelectedDevice;
+        std::shared_ptr<const library::Package> mSelectedPackage;
+        QList<std::shared_ptr<const library::Symbol>> mPreviewSymbols;
         QList<library::SymbolPreviewGraphicsItem*> mPreviewSymbolGraphicsItems;
         library::FootprintPreviewGraphicsItem* mPreviewFootprintGraphicsItem;
 };
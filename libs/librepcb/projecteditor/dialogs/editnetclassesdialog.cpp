@@ -60,10 +60,13 @@ EditNetClassesDialog::EditNetClassesDialog(Circuit& circuit, UndoStack& undoStac
     {
         QTableWidgetItem* uuid = new QTableWidgetItem(netclass->getUuid().toStr());
         QTableWidgetItem* name = new QTableWidgetItem(netclass->getName());
+        QTableWidgetItem* clearance = new QTableWidgetItem(netclass->getClearance().toMmString());
         uuid->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(netclass)));
         name->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(netclass)));
+        clearance->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(netclass)));
         mUi->tableWidget->setVerticalHeaderItem(row, uuid);
         mUi->tableWidget->setItem(row, 0, name);
+        mUi->tableWidget->setItem(row, 1, clearance);
         row++;
     }
 
@@ -114,6 +117,25 @@ void EditNetClassesDialog::on_tableWidget_itemChanged(QTableWidgetItem *item)
             break;
         }
 
+        case 1: // clearance changed
+        {
+            NetClass* netclass = static_cast<NetClass*>(item->data(Qt::UserRole).value<void*>());
+            if (!netclass) break;
+            if (item->text() == netclass->getClearance().toMmString()) break;
+            try
+            {
+                auto cmd = new CmdNetClassEdit(mCircuit, *netclass);
+                cmd->setClearance(Length::fromMm(item->text())); // can throw
+                mUndoStack.appendToCmdGroup(cmd);
+            }
+            catch (Exception& e)
+            {
+                QMessageBox::critical(this, tr("Could not change netclass clearance"), e.getMsg());
+            }
+            item->setText(netclass->getClearance().toMmString());
+            break;
+        }
+
         default:
             break;
     }
@@ -131,9 +153,13 @@ void EditNetClassesDialog::on_btnAdd_clicked()
         mUi->tableWidget->insertRow(row);
         QTableWidgetItem* uuid = new QTableWidgetItem(cmd->getNetClass()->getUuid().toStr());
         QTableWidgetItem* name = new QTableWidgetItem(cmd->getNetClass()->getName());
+        QTableWidgetItem* clearance = new QTableWidgetItem(
+            cmd->getNetClass()->getClearance().toMmString());
         name->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(cmd->getNetClass())));
+        clearance->setData(Qt::UserRole, qVariantFromValue(static_cast<void*>(cmd->getNetClass())));
         mUi->tableWidget->setVerticalHeaderItem(row, uuid);
         mUi->tableWidget->setItem(row, 0, name);
+        mUi->tableWidget->setItem(row, 1, clearance);
     }
     catch (Exception& e)
     {
@@ -25,6 +25,7 @@ SOURCES += \
     boardeditor/boardlayersdock.cpp \
     boardeditor/boardlayerstacksetupdialog.cpp \
     boardeditor/boardplanepropertiesdialog.cpp \
+    boardeditor/boardstatisticsdock.cpp \
     boardeditor/boardviapropertiesdialog.cpp \
     boardeditor/deviceinstancepropertiesdialog.cpp \
     boardeditor/fabricationoutputdialog.cpp \
@@ -91,6 +92,7 @@ HEADERS += \
     boardeditor/boardlayersdock.h \
     boardeditor/boardlayerstacksetupdialog.h \
     boardeditor/boardplanepropertiesdialog.h \
+    boardeditor/boardstatisticsdock.h \
     boardeditor/boardviapropertiesdialog.h \
     boardeditor/deviceinstancepropertiesdialog.h \
     boardeditor/fabricationoutputdialog.h \
@@ -157,6 +159,7 @@ FORMS += \
     boardeditor/boardlayersdock.ui \
     boardeditor/boardlayerstacksetupdialog.ui \
     boardeditor/boardplanepropertiesdialog.ui \
+    boardeditor/boardstatisticsdock.ui \
     boardeditor/boardviapropertiesdialog.ui \
     boardeditor/deviceinstancepropertiesdialog.ui \
     boardeditor/fabricationoutputdialog.ui \
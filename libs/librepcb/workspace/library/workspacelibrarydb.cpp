@@ -36,6 +36,7 @@
 #include "workspacelibrarydb.h"
 #include "../workspace.h"
 #include "workspacelibraryscanner.h"
+#include "workspacelibrarywatcher.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -80,6 +81,21 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws):
     connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::failed,
             this, &WorkspaceLibraryDb::scanFailed, Qt::QueuedConnection);
 
+    // watch all libraries for modified elements to keep the database up to date
+    mLibraryWatcher.reset(new WorkspaceLibraryWatcher());
+    foreach (const QSharedPointer<Library>& lib, mWorkspace.getLocalLibraries()) {
+        mLibraryWatcher->addLibrary(lib->getFilePath());
+    }
+    foreach (const QSharedPointer<Library>& lib, mWorkspace.getRemoteLibraries()) {
+        mLibraryWatcher->addLibrary(lib->getFilePath());
+    }
+    connect(&mWorkspace, &Workspace::libraryAdded,
+            mLibraryWatcher.data(), &WorkspaceLibraryWatcher::addLibrary);
+    connect(&mWorkspace, &Workspace::libraryRemoved,
+            mLibraryWatcher.data(), &WorkspaceLibraryWatcher::removeLibrary);
+    connect(mLibraryWatcher.data(), &WorkspaceLibraryWatcher::typeDirsChanged,
+            mLibraryScanner.data(), &WorkspaceLibraryScanner::startTypeDirsScan);
+
     qDebug("Workspace library database successfully loaded!");
 }
 
@@ -352,7 +368,17 @@ QSet<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeyword(const QString& keywo
 
 void WorkspaceLibraryDb::startLibraryRescan() noexcept
 {
-    mLibraryScanner->start();
+    mLibraryScanner->startFullScan();
+}
+
+void WorkspaceLibraryDb::startElementRescan(const FilePath& elementDir) noexcept
+{
+    startElementsRescan(QSet<FilePath>{elementDir});
+}
+
+void WorkspaceLibraryDb::startElementsRescan(const QSet<FilePath>& elementDirs) noexcept
+{
+    mLibraryScanner->startElementsScan(elementDirs);
 }
 
 /*****************************************************************************************
@@ -40,6 +40,7 @@ namespace workspace {
 
 class Workspace;
 class WorkspaceLibraryScanner;
+class WorkspaceLibraryWatcher;
 
 /*****************************************************************************************
  *  Class WorkspaceLibraryDb
@@ -115,6 +116,22 @@ class WorkspaceLibraryDb final : public QObject
          */
         void startLibraryRescan() noexcept;
 
+        /**
+         * @brief Update only the given library elements in the SQLite database
+         *
+         * @note Added and removed library elements are also detected automatically by
+         *       a file system watcher, but elements whose files were overwritten in
+         *       place are not. So this needs to be called after modifying an element.
+         *
+         * @param elementDir    The (possibly removed) directory of a library element
+         */
+        void startElementRescan(const FilePath& elementDir) noexcept;
+
+        /**
+         * @copydoc #startElementRescan()
+         */
+        void startElementsRescan(const QSet<FilePath>& elementDirs) noexcept;
+
         // Operator Overloadings
         WorkspaceLibraryDb& operator=(const WorkspaceLibraryDb& rhs) = delete;
 
@@ -152,6 +169,7 @@ class WorkspaceLibraryDb final : public QObject
         Workspace& mWorkspace;
         QScopedPointer<SQLiteDatabase> mDb; ///< the SQLite database "cache.sqlite"
         QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+        QScopedPointer<WorkspaceLibraryWatcher> mLibraryWatcher;
 
         // Constants
         static const int sCurrentDbVersion = 1;
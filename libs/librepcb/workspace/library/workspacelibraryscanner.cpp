@@ -39,7 +39,8 @@ using namespace library;
  ****************************************************************************************/
 
 WorkspaceLibraryScanner::WorkspaceLibraryScanner(Workspace& ws) noexcept :
-    QThread(nullptr), mWorkspace(ws), mAbort(false)
+    QThread(nullptr), mWorkspace(ws), mAbort(false), mThreadRunning(false),
+    mFullScanRequested(false)
 {
 }
 
@@ -55,14 +56,91 @@ WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept
     }
 }
 
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryScanner::startFullScan() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    mFullScanRequested = true;
+    mPendingTypeDirs.clear(); // covered by the full scan
+    mPendingElementDirs.clear(); // covered by the full scan
+    startThreadIfNotRunning();
+}
+
+void WorkspaceLibraryScanner::startElementsScan(const QSet<FilePath>& elementDirs) noexcept
+{
+    if (elementDirs.isEmpty()) return;
+    QMutexLocker locker(&mMutex);
+    if (!mFullScanRequested) {
+        mPendingElementDirs.unite(elementDirs);
+    }
+    startThreadIfNotRunning();
+}
+
+void WorkspaceLibraryScanner::startTypeDirsScan(const QSet<FilePath>& typeDirs) noexcept
+{
+    if (typeDirs.isEmpty()) return;
+    QMutexLocker locker(&mMutex);
+    if (!mFullScanRequested) {
+        mPendingTypeDirs.unite(typeDirs);
+    }
+    startThreadIfNotRunning();
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
 void WorkspaceLibraryScanner::run() noexcept
 {
-    try {
+    // process requests until there are no more pending
+    while (!mAbort) {
+        bool fullScan = false;
+        QSet<FilePath> typeDirs;
+        QSet<FilePath> elementDirs;
+        {
+            QMutexLocker locker(&mMutex);
+            if ((!mFullScanRequested) && mPendingTypeDirs.isEmpty()
+                && mPendingElementDirs.isEmpty()) {
+                mThreadRunning = false;
+                return;
+            }
+            fullScan = mFullScanRequested;
+            typeDirs = mPendingTypeDirs;
+            elementDirs = mPendingElementDirs;
+            mFullScanRequested = false;
+            mPendingTypeDirs.clear();
+            mPendingElementDirs.clear();
+        }
+        if (fullScan) {
+            scanAllLibraries();
+        } else {
+            elementDirs += getModifiedElementDirs(typeDirs);
+            if (!elementDirs.isEmpty()) {
+                scanElements(elementDirs);
+            }
+        }
+    }
+    QMutexLocker locker(&mMutex);
+    mThreadRunning = false;
+}
+
+void WorkspaceLibraryScanner::startThreadIfNotRunning() noexcept
+{
+    // note: mMutex must be locked by the caller
+    if (!mThreadRunning) {
+        wait(); // the thread might be just about to return from run()
         mAbort = false;
+        mThreadRunning = true;
+        start();
+    }
+}
+
+void WorkspaceLibraryScanner::scanAllLibraries() noexcept
+{
+    try {
         emit started();
 
         // get a list of all available libraries
@@ -79,6 +157,7 @@ void WorkspaceLibraryScanner::run() noexcept
 
         // clear all tables
         clearAllTables(db);
+        mElementDirStamps.clear();
 
         // scan all libraries
         int count = 0;
@@ -121,6 +200,159 @@ void WorkspaceLibraryScanner::run() noexcept
     }
 }
 
+void WorkspaceLibraryScanner::scanElements(const QSet<FilePath>& elementDirs) noexcept
+{
+    try {
+        emit started();
+
+        // open SQLite database
+        FilePath dbFilePath = mWorkspace.getLibrariesPath().getPathTo("cache.sqlite");
+        SQLiteDatabase db(dbFilePath); // can throw
+
+        // begin database transaction
+        SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
+
+        // update all elements
+        int count = 0;
+        int processed = 0;
+        foreach (const FilePath& elementDir, elementDirs) {
+            if (mAbort) break;
+            count += updateElementInDb(db, elementDir); // can throw
+            emit progressUpdate(100 * (++processed) / elementDirs.count());
+        }
+
+        // commit transaction
+        if (!mAbort) {
+            transactionGuard.commit(); // can throw
+            emit succeeded(count);
+        }
+    } catch (const Exception& e) {
+        emit failed(e.getMsg());
+    }
+}
+
+int WorkspaceLibraryScanner::updateElementInDb(SQLiteDatabase& db, const FilePath& elementDir)
+{
+    // elements are always located in "<library>/<type>/<element>"
+    FilePath typeDir = elementDir.getParentDir();
+    int libId = getLibraryId(db, typeDir.getParentDir()); // can throw
+    if (libId < 0) {
+        return 0;
+    }
+
+    // an empty list removes the element from the database
+    QList<FilePath> dirs;
+    if (elementDir.isExistingDir()) {
+        dirs.append(elementDir);
+    }
+
+    QString type = typeDir.getFilename();
+    if (type == ComponentCategory::getShortElementName()) {
+        removeElementFromDb(db, "component_categories", "cat_id", elementDir, false); // can throw
+        return addCategoriesToDb<ComponentCategory>(db, dirs, "component_categories", "cat_id", libId);
+    } else if (type == PackageCategory::getShortElementName()) {
+        removeElementFromDb(db, "package_categories", "cat_id", elementDir, false); // can throw
+        return addCategoriesToDb<PackageCategory>(db, dirs, "package_categories", "cat_id", libId);
+    } else if (type == Symbol::getShortElementName()) {
+        removeElementFromDb(db, "symbols", "symbol_id", elementDir, true); // can throw
+        return addElementsToDb<Symbol>(db, dirs, "symbols", "symbol_id", libId);
+    } else if (type == Package::getShortElementName()) {
+        removeElementFromDb(db, "packages", "package_id", elementDir, true); // can throw
+        return addElementsToDb<Package>(db, dirs, "packages", "package_id", libId);
+    } else if (type == Component::getShortElementName()) {
+        removeElementFromDb(db, "components", "component_id", elementDir, true); // can throw
+        return addElementsToDb<Component>(db, dirs, "components", "component_id", libId);
+    } else if (type == Device::getShortElementName()) {
+        removeElementFromDb(db, "devices", "device_id", elementDir, true); // can throw
+        return addDevicesToDb(db, dirs, "devices", "device_id", libId);
+    } else {
+        qWarning() << "Ignoring unknown library element directory:" << elementDir.toNative();
+        return 0;
+    }
+}
+
+QSet<FilePath> WorkspaceLibraryScanner::getModifiedElementDirs(
+        const QSet<FilePath>& typeDirs) noexcept
+{
+    QSet<FilePath> elementDirs;
+    try {
+        FilePath dbFilePath = mWorkspace.getLibrariesPath().getPathTo("cache.sqlite");
+        SQLiteDatabase db(dbFilePath); // can throw
+        foreach (const FilePath& typeDir, typeDirs) {
+            if (mAbort) break;
+            // elements which are in the database but don't exist anymore
+            QSet<FilePath> existingDirs;
+            QDir qDir(typeDir.toStr());
+            foreach (const QString& name, qDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+                existingDirs.insert(typeDir.getPathTo(name));
+            }
+            QSet<FilePath> dbDirs = getElementDirsFromDb(db, typeDir); // can throw
+            elementDirs += dbDirs - existingDirs;
+            // added elements and elements whose files were modified since the last scan
+            foreach (const FilePath& elementDir, existingDirs) {
+                auto stamp = mElementDirStamps.constFind(elementDir);
+                if ((!dbDirs.contains(elementDir)) || (stamp == mElementDirStamps.constEnd())
+                    || (*stamp != getElementDirStamp(elementDir))) {
+                    elementDirs.insert(elementDir);
+                }
+            }
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Failed to compare library directories with the database:"
+                   << e.getMsg();
+    }
+    return elementDirs;
+}
+
+QSet<FilePath> WorkspaceLibraryScanner::getElementDirsFromDb(SQLiteDatabase& db,
+                                                             const FilePath& typeDir)
+{
+    QString table = getElementTableName(typeDir.getFilename());
+    if (table.isEmpty()) {
+        return QSet<FilePath>();
+    }
+    // note: "LIKE" is not used since it would interpret "_" in paths as a wildcard
+    QString prefix = typeDir.toRelative(mWorkspace.getLibrariesPath()) % "/";
+    QSqlQuery query = db.prepareQuery(
+        "SELECT filepath FROM " % table % " WHERE substr(filepath, 1, :length) = :prefix");
+    query.bindValue(":length", prefix.length());
+    query.bindValue(":prefix", prefix);
+    db.exec(query); // can throw
+    QSet<FilePath> elementDirs;
+    while (query.next()) {
+        elementDirs.insert(mWorkspace.getLibrariesPath().getPathTo(query.value(0).toString()));
+    }
+    return elementDirs;
+}
+
+int WorkspaceLibraryScanner::getLibraryId(SQLiteDatabase& db, const FilePath& libDir)
+{
+    QSqlQuery query = db.prepareQuery(
+        "SELECT id FROM libraries WHERE filepath = :filepath");
+    query.bindValue(":filepath", libDir.toRelative(mWorkspace.getLibrariesPath()));
+    db.exec(query); // can throw
+    return query.next() ? query.value(0).toInt() : -1;
+}
+
+void WorkspaceLibraryScanner::removeElementFromDb(SQLiteDatabase& db, const QString& table,
+    const QString& idColumn, const FilePath& elementDir, bool hasCategories)
+{
+    QString filepath = elementDir.toRelative(mWorkspace.getLibrariesPath());
+    QStringList childTables(table % "_tr");
+    if (hasCategories) childTables.append(table % "_cat");
+    foreach (const QString& childTable, childTables) {
+        QSqlQuery query = db.prepareQuery(
+            "DELETE FROM " % childTable % " WHERE " % idColumn % " IN "
+            "(SELECT id FROM " % table % " WHERE filepath = :filepath)");
+        query.bindValue(":filepath", filepath);
+        db.exec(query); // can throw
+    }
+    QSqlQuery query = db.prepareQuery(
+        "DELETE FROM " % table % " WHERE filepath = :filepath");
+    query.bindValue(":filepath", filepath);
+    db.exec(query); // can throw
+}
+
 void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db)
 {
     // libraries
@@ -189,28 +421,30 @@ int WorkspaceLibraryScanner::addCategoriesToDb(SQLiteDatabase& db, const QList<F
     int count = 0;
     foreach (const FilePath& filepath, dirs) {
         if (mAbort) break;
+        mElementDirStamps.insert(filepath, getElementDirStamp(filepath));
         try {
-            ElementType element(filepath, true); // can throw
+            LibraryBaseElement::Metadata metadata =
+                LibraryBaseElement::readMetadata<ElementType>(filepath); // can throw
             QSqlQuery query = db.prepareQuery(
                 "INSERT INTO " % table % " "
                 "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
                 "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
             query.bindValue(":lib_id",      libId);
             query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",        element.getUuid().toStr());
-            query.bindValue(":version",     element.getVersion().toStr());
-            query.bindValue(":parent_uuid", element.getParentUuid().isNull() ? QVariant(QVariant::String) : element.getParentUuid().toStr());
+            query.bindValue(":uuid",        metadata.uuid.toStr());
+            query.bindValue(":version",     metadata.version.toStr());
+            query.bindValue(":parent_uuid", metadata.parentUuid.isNull() ? QVariant(QVariant::String) : metadata.parentUuid.toStr());
             int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
+            foreach (const QString& locale, metadata.getAllAvailableLocales()) {
                 QSqlQuery query = db.prepareQuery(
                     "INSERT INTO " % table % "_tr "
                     "(" % idColumn % ", locale, name, description, keywords) VALUES "
                     "(:element_id, :locale, :name, :description, :keywords)");
                 query.bindValue(":element_id",  id);
                 query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
+                query.bindValue(":name",        metadata.names.value(locale));
+                query.bindValue(":description", metadata.descriptions.value(locale));
+                query.bindValue(":keywords",    metadata.keywords.value(locale));
                 db.insert(query);
             }
             count++;
@@ -228,30 +462,32 @@ int WorkspaceLibraryScanner::addElementsToDb(SQLiteDatabase& db, const QList<Fil
     int count = 0;
     foreach (const FilePath& filepath, dirs) {
         if (mAbort) break;
+        mElementDirStamps.insert(filepath, getElementDirStamp(filepath));
         try {
-            ElementType element(filepath, true); // can throw
+            LibraryBaseElement::Metadata metadata =
+                LibraryBaseElement::readMetadata<ElementType>(filepath); // can throw
             QSqlQuery query = db.prepareQuery(
                 "INSERT INTO " % table % " "
                 "(lib_id, filepath, uuid, version) VALUES "
                 "(:lib_id, :filepath, :uuid, :version)");
             query.bindValue(":lib_id",      libId);
             query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",        element.getUuid().toStr());
-            query.bindValue(":version",     element.getVersion().toStr());
+            query.bindValue(":uuid",        metadata.uuid.toStr());
+            query.bindValue(":version",     metadata.version.toStr());
             int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
+            foreach (const QString& locale, metadata.getAllAvailableLocales()) {
                 QSqlQuery query = db.prepareQuery(
                     "INSERT INTO " % table % "_tr "
                     "(" % idColumn % ", locale, name, description, keywords) VALUES "
                     "(:element_id, :locale, :name, :description, :keywords)");
                 query.bindValue(":element_id",  id);
                 query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
+                query.bindValue(":name",        metadata.names.value(locale));
+                query.bindValue(":description", metadata.descriptions.value(locale));
+                query.bindValue(":keywords",    metadata.keywords.value(locale));
                 db.insert(query);
             }
-            foreach (const Uuid& categoryUuid, element.getCategories()) {
+            foreach (const Uuid& categoryUuid, metadata.categories) {
                 Q_ASSERT(!categoryUuid.isNull());
                 QSqlQuery query = db.prepareQuery(
                     "INSERT INTO " % table % "_cat "
@@ -275,32 +511,34 @@ int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase& db, const QList<File
     int count = 0;
     foreach (const FilePath& filepath, dirs) {
         if (mAbort) break;
+        mElementDirStamps.insert(filepath, getElementDirStamp(filepath));
         try {
-            Device element(filepath, true); // can throw
+            LibraryBaseElement::Metadata metadata =
+                LibraryBaseElement::readMetadata<Device>(filepath); // can throw
             QSqlQuery query = db.prepareQuery(
                 "INSERT INTO " % table % " "
                 "(lib_id, filepath, uuid, version, component_uuid, package_uuid) VALUES "
                 "(:lib_id, :filepath, :uuid, :version, :component_uuid, :package_uuid)");
             query.bindValue(":lib_id",      libId);
             query.bindValue(":filepath",        filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",            element.getUuid().toStr());
-            query.bindValue(":version",         element.getVersion().toStr());
-            query.bindValue(":component_uuid",  element.getComponentUuid().toStr());
-            query.bindValue(":package_uuid",    element.getPackageUuid().toStr());
+            query.bindValue(":uuid",            metadata.uuid.toStr());
+            query.bindValue(":version",         metadata.version.toStr());
+            query.bindValue(":component_uuid",  metadata.componentUuid.toStr());
+            query.bindValue(":package_uuid",    metadata.packageUuid.toStr());
             int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
+            foreach (const QString& locale, metadata.getAllAvailableLocales()) {
                 QSqlQuery query = db.prepareQuery(
                     "INSERT INTO " % table % "_tr "
                     "(" % idColumn % ", locale, name, description, keywords) VALUES "
                     "(:element_id, :locale, :name, :description, :keywords)");
                 query.bindValue(":element_id",  id);
                 query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
+                query.bindValue(":name",        metadata.names.value(locale));
+                query.bindValue(":description", metadata.descriptions.value(locale));
+                query.bindValue(":keywords",    metadata.keywords.value(locale));
                 db.insert(query);
             }
-            foreach (const Uuid& categoryUuid, element.getCategories()) {
+            foreach (const Uuid& categoryUuid, metadata.categories) {
                 Q_ASSERT(!categoryUuid.isNull());
                 QSqlQuery query = db.prepareQuery(
                     "INSERT INTO " % table % "_cat "
@@ -318,6 +556,37 @@ int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase& db, const QList<File
     return count;
 }
 
+QString WorkspaceLibraryScanner::getElementTableName(const QString& typeName) noexcept
+{
+    if (typeName == ComponentCategory::getShortElementName()) {
+        return "component_categories";
+    } else if (typeName == PackageCategory::getShortElementName()) {
+        return "package_categories";
+    } else if (typeName == Symbol::getShortElementName()) {
+        return "symbols";
+    } else if (typeName == Package::getShortElementName()) {
+        return "packages";
+    } else if (typeName == Component::getShortElementName()) {
+        return "components";
+    } else if (typeName == Device::getShortElementName()) {
+        return "devices";
+    } else {
+        return QString();
+    }
+}
+
+QDateTime WorkspaceLibraryScanner::getElementDirStamp(const FilePath& elementDir) noexcept
+{
+    // files are usually saved by renaming a temporary file, which modifies the directory,
+    // but files which are overwritten in place only modify themselves
+    QDir qDir(elementDir.toStr());
+    QDateTime stamp = QFileInfo(elementDir.toStr()).lastModified();
+    foreach (const QFileInfo& info, qDir.entryInfoList(QDir::Files | QDir::Hidden)) {
+        stamp = qMax(stamp, info.lastModified());
+    }
+    return stamp;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
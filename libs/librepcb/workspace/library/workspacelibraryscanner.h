@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -58,6 +59,12 @@ class Workspace;
  *          class instead of having references to objects from the library and workspace
  *          namespaces. This way it would be easier to guarantee thread safety.
  *
+ * Besides scanning all libraries (#startFullScan()), the scanner can also update only
+ * some element directories in the database (#startElementsScan()), e.g. after they were
+ * modified, or only the modified elements of some element type directories
+ * (#startTypeDirsScan()). Requests made while a scan is running are queued and processed
+ * afterwards by the same thread.
+ *
  * @author ubruhin
  * @date 2016-09-06
  */
@@ -72,6 +79,38 @@ class WorkspaceLibraryScanner final : public QThread
         WorkspaceLibraryScanner(const WorkspaceLibraryScanner& other) = delete;
         ~WorkspaceLibraryScanner() noexcept;
 
+        // General Methods
+
+        /**
+         * @brief Rescan all libraries of the workspace (clears the whole database)
+         */
+        void startFullScan() noexcept;
+
+        /**
+         * @brief Update only the database entries of the given element directories
+         *
+         * Element directories which don't exist (anymore) are removed from the database,
+         * all others are (re-)added. Elements of libraries which are not yet in the
+         * database are ignored since adding a library triggers a full scan anyway.
+         *
+         * @param elementDirs   Directories of library elements (e.g. "<lib>/sym/<uuid>")
+         */
+        void startElementsScan(const QSet<FilePath>& elementDirs) noexcept;
+
+        /**
+         * @brief Update the database entries of all modified elements of the given
+         *        element type directories
+         *
+         * The element directories are compared with the database in the worker thread.
+         * Added and removed elements are detected by their directory names, modified
+         * elements by the modification times of their files, which are remembered
+         * whenever an element is read. Only these elements are updated like with
+         * #startElementsScan().
+         *
+         * @param typeDirs      Element type directories (e.g. "<lib>/sym")
+         */
+        void startTypeDirsScan(const QSet<FilePath>& typeDirs) noexcept;
+
         // Operator Overloadings
         WorkspaceLibraryScanner& operator=(const WorkspaceLibraryScanner& rhs) = delete;
 
@@ -87,6 +126,16 @@ class WorkspaceLibraryScanner final : public QThread
     private: // Methods
 
         void run() noexcept override;
+        void startThreadIfNotRunning() noexcept;
+        void scanAllLibraries() noexcept;
+        void scanElements(const QSet<FilePath>& elementDirs) noexcept;
+        QSet<FilePath> getModifiedElementDirs(const QSet<FilePath>& typeDirs) noexcept;
+        QSet<FilePath> getElementDirsFromDb(SQLiteDatabase& db, const FilePath& typeDir);
+        int updateElementInDb(SQLiteDatabase& db, const FilePath& elementDir);
+        int getLibraryId(SQLiteDatabase& db, const FilePath& libDir);
+        void removeElementFromDb(SQLiteDatabase& db, const QString& table,
+                                 const QString& idColumn, const FilePath& elementDir,
+                                 bool hasCategories);
         void clearAllTables(SQLiteDatabase& db);
         int addLibraryToDb(SQLiteDatabase& db, const QSharedPointer<library::Library>& lib);
         template <typename ElementType>
@@ -97,12 +146,23 @@ class WorkspaceLibraryScanner final : public QThread
                             const QString& table, const QString& idColumn, int libId);
         int addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
                            const QString& table, const QString& idColumn, int libId);
+        static QString getElementTableName(const QString& typeName) noexcept;
+        static QDateTime getElementDirStamp(const FilePath& elementDir) noexcept;
 
 
     private: // Data
 
         Workspace& mWorkspace;
         volatile bool mAbort;
+        QMutex mMutex; ///< protects all following members
+        bool mThreadRunning;
+        bool mFullScanRequested;
+        QSet<FilePath> mPendingTypeDirs;
+        QSet<FilePath> mPendingElementDirs;
+
+        /// modification stamps of all read element directories (used by the worker
+        /// thread only, so not protected by #mMutex)
+        QHash<FilePath, QDateTime> mElementDirStamps;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,151 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "workspacelibrarywatcher.h"
+#include <librepcb/library/elements.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+using namespace library;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WorkspaceLibraryWatcher::WorkspaceLibraryWatcher(QObject* parent) noexcept :
+    QObject(parent)
+{
+    mDebounceTimer.setSingleShot(true);
+    mDebounceTimer.setInterval(sDebounceDelayMs);
+    connect(&mDebounceTimer, &QTimer::timeout,
+            this, &WorkspaceLibraryWatcher::emitTypeDirsChanged);
+    connect(&mWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &WorkspaceLibraryWatcher::directoryChanged);
+}
+
+WorkspaceLibraryWatcher::~WorkspaceLibraryWatcher() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryWatcher::addLibrary(const FilePath& libDir) noexcept
+{
+    if (mLibraryDirs.contains(libDir)) return;
+    mLibraryDirs.insert(libDir);
+    mWatcher.addPath(libDir.toStr());
+    foreach (const QString& typeName, getElementTypeDirNames()) {
+        FilePath typeDir = libDir.getPathTo(typeName);
+        if (typeDir.isExistingDir()) {
+            addTypeDir(typeDir); // the library gets scanned when it is added anyway
+        }
+    }
+}
+
+void WorkspaceLibraryWatcher::removeLibrary(const FilePath& libDir) noexcept
+{
+    if (!mLibraryDirs.remove(libDir)) return;
+    mWatcher.removePath(libDir.toStr());
+    foreach (const QString& typeName, getElementTypeDirNames()) {
+        FilePath typeDir = libDir.getPathTo(typeName);
+        if (mTypeDirs.contains(typeDir)) {
+            removeTypeDir(typeDir);
+        }
+        // changes of removed libraries are irrelevant (the library gets removed from the db)
+        mChangedTypeDirs.remove(typeDir);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void WorkspaceLibraryWatcher::directoryChanged(const QString& path) noexcept
+{
+    FilePath dir(path);
+    if (mLibraryDirs.contains(dir)) {
+        // element type directories may have been added or removed
+        foreach (const QString& typeName, getElementTypeDirNames()) {
+            FilePath typeDir = dir.getPathTo(typeName);
+            bool exists = typeDir.isExistingDir();
+            if (exists && (!mTypeDirs.contains(typeDir))) {
+                addTypeDir(typeDir);
+                mChangedTypeDirs.insert(typeDir); // adds all its elements to the db
+            } else if ((!exists) && mTypeDirs.contains(typeDir)) {
+                removeTypeDir(typeDir);
+                mChangedTypeDirs.insert(typeDir); // removes all its elements from the db
+            }
+        }
+    } else if (mTypeDirs.contains(dir)) {
+        // element directories may have been added, removed or replaced
+        mChangedTypeDirs.insert(dir);
+    } else {
+        return;
+    }
+    mDebounceTimer.start(); // (re)start the timer
+}
+
+void WorkspaceLibraryWatcher::addTypeDir(const FilePath& typeDir) noexcept
+{
+    mWatcher.addPath(typeDir.toStr());
+    mTypeDirs.insert(typeDir);
+}
+
+void WorkspaceLibraryWatcher::removeTypeDir(const FilePath& typeDir) noexcept
+{
+    mWatcher.removePath(typeDir.toStr());
+    mTypeDirs.remove(typeDir);
+}
+
+void WorkspaceLibraryWatcher::emitTypeDirsChanged() noexcept
+{
+    if (mChangedTypeDirs.isEmpty()) return;
+    QSet<FilePath> typeDirs = mChangedTypeDirs;
+    mChangedTypeDirs.clear();
+    emit typeDirsChanged(typeDirs);
+}
+
+QStringList WorkspaceLibraryWatcher::getElementTypeDirNames() noexcept
+{
+    return QStringList{
+        ComponentCategory::getShortElementName(),
+        PackageCategory::getShortElementName(),
+        Symbol::getShortElementName(),
+        Package::getShortElementName(),
+        Component::getShortElementName(),
+        Device::getShortElementName(),
+    };
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
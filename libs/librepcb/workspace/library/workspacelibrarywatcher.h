@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACELIBRARYWATCHER_H
+#define LIBREPCB_WORKSPACE_WORKSPACELIBRARYWATCHER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+/*****************************************************************************************
+ *  Class WorkspaceLibraryWatcher
+ ****************************************************************************************/
+
+/**
+ * @brief The WorkspaceLibraryWatcher class watches library directories for added,
+ *        removed or replaced library elements
+ *
+ * For every added library, the library directory and all element type directories
+ * (e.g. "sym") are watched with a QFileSystemWatcher (inotify on Linux). Element
+ * directories are not watched since large libraries would exhaust the limits of the
+ * operating system (e.g. 8192 inotify watches on Linux or 256 file descriptors for
+ * kqueue on macOS), after which watching silently stops.
+ *
+ * The watcher itself never reads the content of a type directory, so it doesn't cause
+ * any file system access in the GUI thread except (un)registering the watched paths.
+ * Changed type directories are collected until there were no more changes for
+ * #sDebounceDelayMs, then #typeDirsChanged() is emitted once with all of them. The
+ * library scanner then compares these type directories with the database in its worker
+ * thread (see WorkspaceLibraryScanner::startTypeDirsScan()).
+ *
+ * @note    Files which are overwritten in place don't modify the type directory, so
+ *          such changes are not detected. The library editor therefore still requests
+ *          a rescan of the elements it has modified.
+ */
+class WorkspaceLibraryWatcher final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        WorkspaceLibraryWatcher(const WorkspaceLibraryWatcher& other) = delete;
+        explicit WorkspaceLibraryWatcher(QObject* parent = nullptr) noexcept;
+        ~WorkspaceLibraryWatcher() noexcept;
+
+        // General Methods
+        void addLibrary(const FilePath& libDir) noexcept;
+        void removeLibrary(const FilePath& libDir) noexcept;
+
+        // Operator Overloadings
+        WorkspaceLibraryWatcher& operator=(const WorkspaceLibraryWatcher& rhs) = delete;
+
+
+    signals:
+
+        void typeDirsChanged(const QSet<FilePath>& typeDirs);
+
+
+    private: // Methods
+        void directoryChanged(const QString& path) noexcept;
+        void addTypeDir(const FilePath& typeDir) noexcept;
+        void removeTypeDir(const FilePath& typeDir) noexcept;
+        void emitTypeDirsChanged() noexcept;
+        static QStringList getElementTypeDirNames() noexcept;
+
+
+    private: // Data
+        QFileSystemWatcher mWatcher;
+        QTimer mDebounceTimer;
+        QSet<FilePath> mLibraryDirs;
+        QSet<FilePath> mTypeDirs;
+        QSet<FilePath> mChangedTypeDirs;
+
+        static constexpr int sDebounceDelayMs = 500;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace workspace
+} // namespace librepcb
+
+#endif // LIBREPCB_WORKSPACE_WORKSPACELIBRARYWATCHER_H
@@ -123,7 +123,7 @@ void WorkspaceSettings::loadSettingsItem(QScopedPointer<T>& member, SExpression&
 
 void WorkspaceSettings::saveToFile() const
 {
-    SExpression doc(serializeToDomElement("librepcb_workspace_settings"));
+    SExpression doc(serializeToDomElement<SerializableObject>(*this, "librepcb_workspace_settings"));
 
     QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(mFilePath));
     file->save(doc, true); // can throw
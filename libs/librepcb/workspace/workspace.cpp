@@ -57,7 +57,7 @@ Workspace::Workspace(const FilePath& wsPath) :
     mProjectsPath(mPath.getPathTo("projects")),
     mMetadataPath(mPath.getPathTo("v" % qApp->getFileFormatVersion().toStr())),
     mLibrariesPath(mMetadataPath.getPathTo("libraries")),
-    mLock(mMetadataPath)
+    mLock(mMetadataPath), mLibraryRescanSuppressed(false)
 {
     // check if the workspace is valid
     if (!isValidWorkspacePath(mPath)) {
@@ -146,10 +146,11 @@ Workspace::Workspace(const FilePath& wsPath) :
 
     // load library database
     mLibraryDb.reset(new WorkspaceLibraryDb(*this)); // can throw
-    connect(this, &Workspace::libraryAdded,
-            mLibraryDb.data(), &WorkspaceLibraryDb::startLibraryRescan);
-    connect(this, &Workspace::libraryRemoved,
-            mLibraryDb.data(), &WorkspaceLibraryDb::startLibraryRescan);
+    auto startLibraryRescan = [this](){
+        if (!mLibraryRescanSuppressed) mLibraryDb->startLibraryRescan();
+    };
+    connect(this, &Workspace::libraryAdded, mLibraryDb.data(), startLibraryRescan);
+    connect(this, &Workspace::libraryRemoved, mLibraryDb.data(), startLibraryRescan);
 
     // load project models
     mRecentProjectsModel.reset(new RecentProjectsModel(*this));
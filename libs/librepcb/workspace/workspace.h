@@ -188,6 +188,17 @@ class Workspace final : public QObject
          */
         void removeRemoteLibrary(const QString& libDirName, bool rmDir = true);
 
+        /**
+         * @brief Suppress the library rescan when libraries are added or removed
+         *
+         * Useful to add or remove several libraries at once. The caller is then
+         * responsible to start a single rescan with
+         * librepcb::workspace::WorkspaceLibraryDb::startLibraryRescan() afterwards.
+         *
+         * @param suppress      Whether the rescan should be suppressed or not
+         */
+        void setLibraryRescanSuppressed(bool suppress) noexcept {mLibraryRescanSuppressed = suppress;}
+
 
         /**
          * @brief Get the workspace library database
@@ -314,6 +325,7 @@ class Workspace final : public QObject
         QMap<QString, QSharedPointer<library::Library>> mLocalLibraries; ///< all local libraries
         QMap<QString, QSharedPointer<library::Library>> mRemoteLibraries; ///< all remote libraries
         QScopedPointer<WorkspaceLibraryDb> mLibraryDb; ///< the library database
+        bool mLibraryRescanSuppressed; ///< see #setLibraryRescanSuppressed()
         QScopedPointer<ProjectTreeModel> mProjectTreeModel; ///< a tree model for the whole projects directory
         QScopedPointer<RecentProjectsModel> mRecentProjectsModel; ///< a list model of all recent projects
         QScopedPointer<FavoriteProjectsModel> mFavoriteProjectsModel; ///< a list model of all favorite projects
@@ -0,0 +1,89 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "benchmark.h"
+#include "corpus.h"
+#include <librepcb/common/attributes/attributeprovider.h>
+#include <librepcb/common/attributes/attributesubstitutor.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*****************************************************************************************
+ *  Class AttributeProviderBenchmarkDummy
+ ****************************************************************************************/
+
+class AttributeProviderBenchmarkDummy final : public AttributeProvider
+{
+    public:
+        AttributeProviderBenchmarkDummy() noexcept {}
+        AttributeProviderBenchmarkDummy(const AttributeProviderBenchmarkDummy& other) = delete;
+        AttributeProviderBenchmarkDummy& operator=(const AttributeProviderBenchmarkDummy& rhs) = delete;
+        ~AttributeProviderBenchmarkDummy() noexcept {}
+
+        QString getUserDefinedAttributeValue(const QString& key) const noexcept override {
+            if (key == "NAME")          return "R42";
+            if (key == "VALUE")         return "{{RESISTANCE}} {{TOLERANCE}}";
+            if (key == "RESISTANCE")    return "100k";
+            if (key == "TOLERANCE")     return "1%";
+            if (key == "PACKAGE")       return "0603";
+            return QString();
+        }
+
+    signals:
+        void attributesChanged() override {}
+};
+
+/*****************************************************************************************
+ *  Benchmarks
+ ****************************************************************************************/
+
+LIBREPCB_BENCHMARK(AttributeSubstitutorTypicalTexts)
+{
+    AttributeProviderBenchmarkDummy provider;
+    QStringList texts = {
+        "{{NAME}}",
+        "{{VALUE}}",
+        "{{NAME}}: {{VALUE}} ({{PACKAGE}})",
+        "{{UNDEFINED or PACKAGE}}",
+        "Text without any attributes",
+    };
+    while (state.keepRunning()) {
+        foreach (const QString& text, texts) {
+            QString result = AttributeSubstitutor::substitute(text, &provider);
+            Q_UNUSED(result);
+        }
+    }
+    state.setItemsProcessed(state.getIterations() * texts.count());
+    state.setLabel("texts");
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
@@ -0,0 +1,237 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtNetwork>
+#include "benchmark.h"
+#include <librepcb/common/application.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*****************************************************************************************
+ *  Class BenchmarkState
+ ****************************************************************************************/
+
+BenchmarkState::BenchmarkState(qint64 iterations) noexcept :
+    mIterations(iterations), mRemainingIterations(iterations), mStarted(false),
+    mRunning(false), mCpuStart(0), mRealTimeNs(0), mCpuTimeNs(0), mItemsProcessed(0)
+{
+}
+
+BenchmarkState::~BenchmarkState() noexcept
+{
+}
+
+bool BenchmarkState::keepRunning() noexcept
+{
+    if (!mStarted) {
+        mStarted = true;
+        resumeTiming();
+    }
+    if (mRemainingIterations > 0) {
+        --mRemainingIterations;
+        return true;
+    } else {
+        pauseTiming();
+        return false;
+    }
+}
+
+void BenchmarkState::pauseTiming() noexcept
+{
+    if (!mRunning) return;
+    mRealTimeNs += mTimer.nsecsElapsed();
+    mCpuTimeNs += static_cast<qint64>(std::clock() - mCpuStart) * 1000000000LL / CLOCKS_PER_SEC;
+    mRunning = false;
+}
+
+void BenchmarkState::resumeTiming() noexcept
+{
+    if (mRunning) return;
+    mCpuStart = std::clock();
+    mTimer.start();
+    mRunning = true;
+}
+
+/*****************************************************************************************
+ *  Class BenchmarkRunner
+ ****************************************************************************************/
+
+int BenchmarkRunner::registerBenchmark(const char* name, Function function) noexcept
+{
+    benchmarks().append(Benchmark{QString(name), function});
+    return 0;
+}
+
+int BenchmarkRunner::run(const QStringList& arguments) noexcept
+{
+    QRegularExpression filter(".*");
+    qreal minTime = 0.5;
+    bool jsonOutput = false;
+    bool listOnly = false;
+    QString outFilePath;
+    foreach (const QString& arg, arguments.mid(1)) {
+        QString value = arg.section('=', 1);
+        if (arg.startsWith("--benchmark_filter=")) {
+            filter.setPattern(value);
+        } else if (arg.startsWith("--benchmark_min_time=")) {
+            minTime = value.toDouble();
+        } else if (arg == "--benchmark_format=json") {
+            jsonOutput = true;
+        } else if (arg == "--benchmark_format=console") {
+            jsonOutput = false;
+        } else if (arg.startsWith("--benchmark_out=")) {
+            outFilePath = value;
+        } else if (arg == "--benchmark_list_tests") {
+            listOnly = true;
+        } else {
+            qCritical("Unknown argument: %s", qPrintable(arg));
+            return 1;
+        }
+    }
+    if (!filter.isValid()) {
+        qCritical("Invalid filter: %s", qPrintable(filter.errorString()));
+        return 1;
+    }
+
+    QList<Benchmark> selected;
+    foreach (const Benchmark& benchmark, benchmarks()) {
+        if (filter.match(benchmark.name).hasMatch()) selected.append(benchmark);
+    }
+    qSort(selected.begin(), selected.end(), [](const Benchmark& a, const Benchmark& b)
+                                            {return a.name < b.name;});
+
+    QTextStream out(stdout);
+    if (listOnly) {
+        foreach (const Benchmark& benchmark, selected) {
+            out << benchmark.name << endl;
+        }
+        return 0;
+    }
+
+    if (!jsonOutput) {
+        out << QString("%1 %2 %3 %4").arg("Benchmark", -40).arg("Time [ns]", 16)
+                                     .arg("CPU [ns]", 16).arg("Iterations", 12) << endl;
+        out << QString(87, '-') << endl;
+    }
+    QJsonArray results;
+    int failedCount = 0;
+    foreach (const Benchmark& benchmark, selected) {
+        try {
+            QJsonObject result = runBenchmark(benchmark, minTime); // can throw
+            results.append(result);
+            if (!jsonOutput) {
+                out << QString("%1 %2 %3 %4")
+                       .arg(benchmark.name, -40)
+                       .arg(result["real_time"].toDouble(), 16, 'f', 0)
+                       .arg(result["cpu_time"].toDouble(), 16, 'f', 0)
+                       .arg(result["iterations"].toDouble(), 12, 'f', 0) << endl;
+            }
+        } catch (const std::exception& e) {
+            qCritical("%s failed: %s", qPrintable(benchmark.name), e.what());
+            ++failedCount;
+        }
+    }
+
+    QJsonObject root;
+    root["context"] = createContext();
+    root["benchmarks"] = results;
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    if (jsonOutput) {
+        out << QString::fromUtf8(json);
+    }
+    if (!outFilePath.isEmpty()) {
+        QFile file(outFilePath);
+        if ((!file.open(QIODevice::WriteOnly)) || (file.write(json) != json.size())) {
+            qCritical("Could not write %s", qPrintable(outFilePath));
+            return 1;
+        }
+    }
+    return (failedCount > 0) ? 1 : 0;
+}
+
+QList<BenchmarkRunner::Benchmark>& BenchmarkRunner::benchmarks() noexcept
+{
+    // function-local to not depend on the initialization order of translation units
+    static QList<Benchmark> list;
+    return list;
+}
+
+QJsonObject BenchmarkRunner::runBenchmark(const Benchmark& benchmark, qreal minTime)
+{
+    // increase the number of iterations until the benchmark runs long enough
+    qint64 minTimeNs = static_cast<qint64>(minTime * 1e9);
+    qint64 iterations = 1;
+    while (true) {
+        BenchmarkState state(iterations);
+        benchmark.function(state); // can throw
+        qint64 timeNs = qMax(state.getRealTimeNs(), qint64(1));
+        if ((timeNs >= minTimeNs) || (iterations >= 1000000000LL)) {
+            QJsonObject result;
+            result["name"] = benchmark.name;
+            result["run_name"] = benchmark.name;
+            result["run_type"] = QString("iteration");
+            result["iterations"] = static_cast<double>(iterations);
+            result["real_time"] = static_cast<double>(state.getRealTimeNs()) / iterations;
+            result["cpu_time"] = static_cast<double>(state.getCpuTimeNs()) / iterations;
+            result["time_unit"] = QString("ns");
+            if (state.getItemsProcessed() > 0) {
+                result["items_per_second"] = state.getItemsProcessed() * 1e9 / timeNs;
+            }
+            if (!state.getLabel().isEmpty()) {
+                result["label"] = state.getLabel();
+            }
+            return result;
+        }
+        // predict the required iterations (with 40% margin), but at most 10x more
+        qint64 predicted = static_cast<qint64>(iterations * 1.4 * minTimeNs / timeNs);
+        iterations = qBound(iterations + 1, predicted, iterations * 10);
+    }
+}
+
+QJsonObject BenchmarkRunner::createContext() noexcept
+{
+    QJsonObject context;
+    context["date"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    context["host_name"] = QHostInfo::localHostName();
+    context["executable"] = qApp->applicationFilePath();
+    context["num_cpus"] = QThread::idealThreadCount();
+    context["librepcb_version"] = qApp->getAppVersion().toStr();
+    context["librepcb_git_version"] = qApp->getGitVersion();
+#ifdef QT_NO_DEBUG
+    context["library_build_type"] = QString("release");
+#else
+    context["library_build_type"] = QString("debug");
+#endif
+    return context;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
@@ -0,0 +1,187 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_BENCHMARKS_BENCHMARK_H
+#define LIBREPCB_BENCHMARKS_BENCHMARK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <ctime>
+#include <functional>
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*****************************************************************************************
+ *  Class BenchmarkState
+ ****************************************************************************************/
+
+/**
+ * @brief The BenchmarkState class controls and measures the iterations of a benchmark
+ *
+ * Everything before the first call to #keepRunning() is considered as setup and not
+ * measured. Use it like this:
+ *
+ * @code
+ * LIBREPCB_BENCHMARK(MyBenchmark)
+ * {
+ *     Foo foo = expensiveSetup();
+ *     while (state.keepRunning()) {
+ *         foo.doSomething();
+ *     }
+ * }
+ * @endcode
+ */
+class BenchmarkState final
+{
+    public:
+
+        // Constructors / Destructor
+        BenchmarkState() = delete;
+        BenchmarkState(const BenchmarkState& other) = delete;
+        explicit BenchmarkState(qint64 iterations) noexcept;
+        ~BenchmarkState() noexcept;
+
+        // Getters
+        qint64 getIterations() const noexcept {return mIterations;}
+        qint64 getRealTimeNs() const noexcept {return mRealTimeNs;}
+        qint64 getCpuTimeNs() const noexcept {return mCpuTimeNs;}
+        qint64 getItemsProcessed() const noexcept {return mItemsProcessed;}
+        const QString& getLabel() const noexcept {return mLabel;}
+
+        // Setters
+
+        /**
+         * @brief Set the number of processed items (over all iterations) to get the
+         *        throughput reported as "items_per_second"
+         */
+        void setItemsProcessed(qint64 items) noexcept {mItemsProcessed = items;}
+        void setLabel(const QString& label) noexcept {mLabel = label;}
+
+        // General Methods
+        bool keepRunning() noexcept;
+        void pauseTiming() noexcept;
+        void resumeTiming() noexcept;
+
+        // Operator Overloadings
+        BenchmarkState& operator=(const BenchmarkState& rhs) = delete;
+
+
+    private: // Data
+        qint64 mIterations;
+        qint64 mRemainingIterations;
+        bool mStarted;
+        bool mRunning;
+        QElapsedTimer mTimer;
+        std::clock_t mCpuStart;
+        qint64 mRealTimeNs;
+        qint64 mCpuTimeNs;
+        qint64 mItemsProcessed;
+        QString mLabel;
+};
+
+/*****************************************************************************************
+ *  Class BenchmarkRunner
+ ****************************************************************************************/
+
+/**
+ * @brief The BenchmarkRunner class holds all registered benchmarks and runs them
+ *
+ * The command line options and the JSON output format are compatible with Google
+ * Benchmark, so its tools (e.g. "compare.py") can be used to compare results of
+ * different commits:
+ *
+ *  - `--benchmark_filter=<regex>`: Only run benchmarks matching the regex
+ *  - `--benchmark_min_time=<seconds>`: Minimum measured time per benchmark (default: 0.5)
+ *  - `--benchmark_format=<console|json>`: Format of the standard output
+ *  - `--benchmark_out=<file>`: Additionally write the results as JSON to a file
+ *  - `--benchmark_list_tests`: Only print the names of all benchmarks
+ */
+class BenchmarkRunner final
+{
+    public:
+
+        // Types
+        typedef std::function<void(BenchmarkState&)> Function;
+
+        // Constructors / Destructor
+        BenchmarkRunner() = delete;
+        BenchmarkRunner(const BenchmarkRunner& other) = delete;
+        ~BenchmarkRunner() = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Register a benchmark (use the macro #LIBREPCB_BENCHMARK instead)
+         *
+         * @return Always 0 (allows to call it for initializing a static variable)
+         */
+        static int registerBenchmark(const char* name, Function function) noexcept;
+
+        /**
+         * @brief Run all (matching) benchmarks
+         *
+         * @return The exit code of the application
+         */
+        static int run(const QStringList& arguments) noexcept;
+
+        // Operator Overloadings
+        BenchmarkRunner& operator=(const BenchmarkRunner& rhs) = delete;
+
+
+    private: // Types
+        struct Benchmark {
+            QString name;
+            Function function;
+        };
+
+
+    private: // Methods
+        static QList<Benchmark>& benchmarks() noexcept;
+        static QJsonObject runBenchmark(const Benchmark& benchmark, qreal minTime);
+        static QJsonObject createContext() noexcept;
+};
+
+/*****************************************************************************************
+ *  Macros
+ ****************************************************************************************/
+
+/**
+ * @brief Define and register a benchmark function with a parameter "state" of type
+ *        librepcb::benchmarks::BenchmarkState
+ */
+#define LIBREPCB_BENCHMARK(name) \
+    static void name(::librepcb::benchmarks::BenchmarkState& state); \
+    static const int name##_registered = \
+        ::librepcb::benchmarks::BenchmarkRunner::registerBenchmark(#name, &name); \
+    static void name(::librepcb::benchmarks::BenchmarkState& state)
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
+
+#endif // LIBREPCB_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,68 @@
+#-------------------------------------------------
+#
+# Project created 2018-03-04
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = benchmarks
+
+# Set the path for the generated binary
+GENERATED_DIR = ../../generated
+
+# Use common project definitions
+include(../../common.pri)
+
+QT += core widgets network printsupport xml opengl sql concurrent
+
+CONFIG += console
+CONFIG -= app_bundle
+
+LIBS += \
+    -L$${DESTDIR} \
+    -llibrepcbworkspace \
+    -llibrepcbproject \
+    -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
+    -llibrepcbcommon \     # Another order could end up in "undefined reference" errors!
+    -lsexpresso \
+    -lclipper \
+    -lquazip -lz
+
+INCLUDEPATH += \
+    ../../libs/quazip \
+    ../../libs \
+
+DEPENDPATH += \
+    ../../libs/librepcb/workspace \
+    ../../libs/librepcb/project \
+    ../../libs/librepcb/library \
+    ../../libs/librepcb/common \
+    ../../libs/quazip \
+    ../../libs/sexpresso \
+    ../../libs/clipper \
+
+PRE_TARGETDEPS += \
+    $${DESTDIR}/liblibrepcbworkspace.a \
+    $${DESTDIR}/liblibrepcbproject.a \
+    $${DESTDIR}/liblibrepcblibrary.a \
+    $${DESTDIR}/liblibrepcbcommon.a \
+    $${DESTDIR}/libquazip.a \
+    $${DESTDIR}/libsexpresso.a \
+    $${DESTDIR}/libclipper.a \
+
+SOURCES += \
+    attributesubstitutorbenchmark.cpp \
+    benchmark.cpp \
+    boardbenchmark.cpp \
+    corpus.cpp \
+    main.cpp \
+    sexpressionbenchmark.cpp \
+    strokefontbenchmark.cpp \
+    workspacelibraryscannerbenchmark.cpp \
+
+HEADERS += \
+    benchmark.h \
+    corpus.h \
+
+FORMS += \
+
@@ -0,0 +1,220 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "benchmark.h"
+#include "corpus.h"
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardairwiresbuilder.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/boardobstacleindex.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
+#include <librepcb/project/boards/boardstatistics.h>
+#include <librepcb/project/boards/boardtracerouter.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+using namespace project;
+
+/*****************************************************************************************
+ *  Benchmarks
+ ****************************************************************************************/
+
+LIBREPCB_BENCHMARK(BoardPlaneFragmentsBuilderLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    while (state.keepRunning()) {
+        foreach (BI_Plane* plane, board.getPlanes()) {
+            BoardPlaneFragmentsBuilder builder(*plane);
+            QVector<Path> fragments = builder.buildFragments();
+            Q_UNUSED(fragments);
+        }
+    }
+    state.setItemsProcessed(state.getIterations() * board.getPlanes().count());
+    state.setLabel("planes");
+}
+
+LIBREPCB_BENCHMARK(BoardPlaneFragmentsBuilderThermalsLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    QHash<BI_Plane*, BI_Plane::ConnectStyle> styles;
+    foreach (BI_Plane* plane, board.getPlanes()) {
+        styles.insert(plane, plane->getConnectStyle());
+        plane->setConnectStyle(BI_Plane::ConnectStyle::Thermal);
+    }
+    while (state.keepRunning()) {
+        foreach (BI_Plane* plane, board.getPlanes()) {
+            BoardPlaneFragmentsBuilder builder(*plane);
+            QVector<Path> fragments = builder.buildFragments();
+            Q_UNUSED(fragments);
+        }
+    }
+    for (auto it = styles.constBegin(); it != styles.constEnd(); ++it) {
+        it.key()->setConnectStyle(it.value()); // the corpus board is shared
+    }
+    state.setItemsProcessed(state.getIterations() * board.getPlanes().count());
+    state.setLabel("planes");
+}
+
+LIBREPCB_BENCHMARK(BoardPlaneFragmentsBuilderHatchedLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    QHash<BI_Plane*, BI_Plane::FillStyle> styles;
+    foreach (BI_Plane* plane, board.getPlanes()) {
+        styles.insert(plane, plane->getFillStyle());
+        plane->setFillStyle(BI_Plane::FillStyle::Hatched);
+    }
+    while (state.keepRunning()) {
+        foreach (BI_Plane* plane, board.getPlanes()) {
+            BoardPlaneFragmentsBuilder builder(*plane);
+            QVector<Path> fragments = builder.buildFragments();
+            Q_UNUSED(fragments);
+        }
+    }
+    for (auto it = styles.constBegin(); it != styles.constEnd(); ++it) {
+        it.key()->setFillStyle(it.value()); // the corpus board is shared
+    }
+    state.setItemsProcessed(state.getIterations() * board.getPlanes().count());
+    state.setLabel("planes");
+}
+
+LIBREPCB_BENCHMARK(BoardAirWiresBuilderLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    QList<NetSignal*> netsignals = board.getProject().getCircuit().getNetSignals().values();
+    while (state.keepRunning()) {
+        foreach (const NetSignal* netsignal, netsignals) {
+            BoardAirWiresBuilder builder(board, *netsignal);
+            QVector<QPair<Point, Point>> airwires = builder.buildAirWires(); // can throw
+            Q_UNUSED(airwires);
+        }
+    }
+    state.setItemsProcessed(state.getIterations() * netsignals.count());
+    state.setLabel("nets");
+}
+
+LIBREPCB_BENCHMARK(BoardPlaneFragmentsCopyLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    board.rebuildAllPlanes();
+    QVector<Path> fragments;
+    foreach (const BI_Plane* plane, board.getPlanes()) {
+        fragments += plane->getFragments();
+    }
+    qint64 vertices = 0;
+    foreach (const Path& path, fragments) {
+        vertices += path.getVertices().count();
+    }
+    while (state.keepRunning()) {
+        // deep copy, like transforming all fragments would do
+        QVector<Path> copy;
+        copy.reserve(fragments.count());
+        foreach (const Path& path, fragments) {
+            copy.append(Path(path.getVertices()));
+            copy.last().getVertices().detach();
+        }
+        Q_UNUSED(copy);
+    }
+    state.setItemsProcessed(state.getIterations() * vertices);
+    state.setLabel(QString("vertices, %1 bytes").arg(
+        fragments.count() * sizeof(Path) + vertices * sizeof(Vertex)));
+}
+
+LIBREPCB_BENCHMARK(BoardObstacleIndexLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    BoardObstacleIndex index(board);
+    while (state.keepRunning()) {
+        index.rebuild();
+    }
+}
+
+LIBREPCB_BENCHMARK(BoardTraceRouterLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    BoardObstacleIndex index(board);
+    BoardTraceRouter router(index);
+    router.setTimeBudget(-1); // measure the full routing time
+
+    // traces between the via rows, each crossing the row above near its end
+    Length pitch(2540000);
+    int traces = 0;
+    while (state.keepRunning()) {
+        for (int row = 1; row < 20; ++row) {
+            Point start(pitch / 2, pitch * row + pitch / 2);
+            Point end(pitch * 30, pitch * (row + 1) + pitch / 2);
+            BoardTraceRouter::Result result = router.route(GraphicsLayer::sTopCopper,
+                {start, Point(pitch * 29, start.getY()), end}, Length(200000), nullptr,
+                BoardTraceRouter::Mode::Walkaround);
+            Q_UNUSED(result);
+            ++traces;
+        }
+    }
+    state.setItemsProcessed(traces);
+    state.setLabel("traces");
+}
+
+LIBREPCB_BENCHMARK(BoardGerberExportLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    board.rebuildAllPlanes(); // export the planes with their real fragments
+    BoardGerberExport gerberExport(board);
+    while (state.keepRunning()) {
+        gerberExport.exportAllLayers(); // can throw
+    }
+}
+
+LIBREPCB_BENCHMARK(BoardStatisticsLargeBoard)
+{
+    Board& board = Corpus::instance().getLargeBoard(); // can throw
+    board.rebuildAllPlanes(); // count the plane areas of the real fragments
+    BoardStatistics& statistics = board.getStatistics();
+    QList<NetSignal*> netsignals = board.getProject().getCircuit().getNetSignals().values();
+    if (netsignals.isEmpty()) return;
+    int nets = 0;
+    while (state.keepRunning()) {
+        // typical editing: only one net signal is modified between two queries
+        NetSignal* netsignal = netsignals.at(nets % netsignals.count());
+        statistics.invalidateNetSignal(netsignal);
+        BoardStatistics::NetStatistics s = statistics.getNetStatistics(*netsignal);
+        Q_UNUSED(s);
+        ++nets;
+    }
+    state.setItemsProcessed(nets);
+    state.setLabel("nets");
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
@@ -0,0 +1,283 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "corpus.h"
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/libraryelementbatchwriter.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/library/projectlibrary.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/componentsignalinstance.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/workspace/workspace.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+using namespace project;
+
+Corpus* Corpus::sInstance = nullptr;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+Corpus::Corpus() noexcept :
+    mTmpDir(FilePath::getRandomTempPath()), mLargeBoard(nullptr)
+{
+    Q_ASSERT(!sInstance);
+    sInstance = this;
+}
+
+Corpus::~Corpus() noexcept
+{
+    mLargeLibraryWorkspace.reset();
+    mLargeBoardProject.reset();
+    QDir(mTmpDir.toStr()).removeRecursively();
+    sInstance = nullptr;
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+Board& Corpus::getLargeBoard()
+{
+    if (!mLargeBoard) createLargeBoard(); // can throw
+    return *mLargeBoard;
+}
+
+const QString& Corpus::getLargeBoardFileContent()
+{
+    if (!mLargeBoard) createLargeBoard(); // can throw
+    return mLargeBoardFileContent;
+}
+
+workspace::Workspace& Corpus::getLargeLibraryWorkspace()
+{
+    if (!mLargeLibraryWorkspace) createLargeLibraryWorkspace(); // can throw
+    return *mLargeLibraryWorkspace;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+Corpus& Corpus::instance() noexcept
+{
+    Q_ASSERT(sInstance);
+    return *sInstance;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void Corpus::createLargeBoard()
+{
+    FilePath projectFp = mTmpDir.getPathTo("large_board/large_board.lpp");
+    mLargeBoardProject.reset(Project::create(projectFp)); // can throw
+    Board* board = mLargeBoardProject->createBoard("large_board"); // can throw
+    mLargeBoardProject->addBoard(*board); // can throw
+
+    // nets
+    Circuit& circuit = mLargeBoardProject->getCircuit();
+    NetClass* netclass = circuit.getNetClassByName("default");
+    Q_ASSERT(netclass);
+    QList<NetSignal*> netsignals;
+    for (int i = 0; i < sNetCount; ++i) {
+        NetSignal* netsignal = new NetSignal(circuit, *netclass, QString("NET%1").arg(i),
+                                             false); // can throw
+        circuit.addNetSignal(*netsignal); // can throw
+        netsignals.append(netsignal);
+    }
+
+    // board outline
+    Length pitch(2540000);
+    Length size = pitch * (sViaGridSize + 1);
+    Path outline = Path::rect(Point(0, 0), Point(size, size));
+    board->addPolygon(*new BI_Polygon(*board, Uuid::createRandom(),
+        GraphicsLayer::sBoardOutlines, Length(0), false, false, outline)); // can throw
+
+    // a row of vias connected by netlines per netsegment
+    GraphicsLayer* topLayer = board->getLayerStack().getLayer(GraphicsLayer::sTopCopper);
+    Q_ASSERT(topLayer);
+    for (int row = 0; row < sViaGridSize; ++row) {
+        NetSignal& netsignal = *netsignals[row % sNetCount];
+        BI_NetSegment* netsegment = new BI_NetSegment(*board, netsignal); // can throw
+        board->addNetSegment(*netsegment); // can throw
+        QList<BI_Via*> vias;
+        QList<BI_NetPoint*> netpoints;
+        QList<BI_NetLine*> netlines;
+        for (int col = 0; col < sViaGridSize; ++col) {
+            Point pos(pitch * (col + 1), pitch * (row + 1));
+            BI_Via* via = new BI_Via(*netsegment, pos, BI_Via::Shape::Round,
+                                     Length(700000), Length(300000)); // can throw
+            BI_NetPoint* netpoint = new BI_NetPoint(*netsegment, *topLayer, *via); // can throw
+            if (!netpoints.isEmpty()) {
+                netlines.append(new BI_NetLine(*netpoints.last(), *netpoint,
+                                               Length(250000))); // can throw
+            }
+            vias.append(via);
+            netpoints.append(netpoint);
+        }
+        netsegment->addElements(vias, netpoints, netlines); // can throw
+    }
+
+    // a row of devices with two THT pads between each row of vias, every pad connected
+    // to the net of its adjacent via row
+    createLargeBoardDevices(*board, netsignals); // can throw
+
+    // overlapping planes on both copper layers
+    foreach (const QString& layer, QStringList{GraphicsLayer::sTopCopper,
+                                               GraphicsLayer::sBotCopper}) {
+        for (int i = 0; i < sPlanesPerLayer; ++i) {
+            board->addPlane(*new BI_Plane(*board, Uuid::createRandom(), layer,
+                                          *netsignals[i % sNetCount], outline)); // can throw
+        }
+    }
+
+    mLargeBoardProject->save(true); // can throw
+    mLargeBoardFileContent = QString::fromUtf8(FileUtils::readFile(board->getFilePath())); // can throw
+    mLargeBoard = board;
+}
+
+void Corpus::createLargeBoardDevices(Board& board, const QList<NetSignal*>& netsignals)
+{
+    using namespace library;
+    Length pitch(2540000);
+
+    // library elements: a component with two signals and a package with two THT pads
+    Uuid signal1 = Uuid::createRandom(), signal2 = Uuid::createRandom();
+    Uuid symbVar = Uuid::createRandom();
+    Uuid pad1 = Uuid::createRandom(), pad2 = Uuid::createRandom();
+    Uuid footprintUuid = Uuid::createRandom();
+    Component* cmp = new Component(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                   "Benchmark", "Generated component", ""); // can throw
+    cmp->getSignals().append(std::make_shared<ComponentSignal>(signal1, "1"));
+    cmp->getSignals().append(std::make_shared<ComponentSignal>(signal2, "2"));
+    cmp->getSymbolVariants().append(std::make_shared<ComponentSymbolVariant>(
+        symbVar, "", "default", ""));
+    mLargeBoardProject->getLibrary().addComponent(*cmp); // can throw
+    Package* pkg = new Package(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                               "Benchmark", "Generated package", ""); // can throw
+    pkg->getPads().append(std::make_shared<PackagePad>(pad1, "1"));
+    pkg->getPads().append(std::make_shared<PackagePad>(pad2, "2"));
+    std::shared_ptr<Footprint> footprint =
+        std::make_shared<Footprint>(footprintUuid, "default", "");
+    foreach (const Uuid& pad, QList<Uuid>{pad1, pad2}) {
+        Point pos((pad == pad1) ? -pitch / 2 : pitch / 2, Length(0));
+        footprint->getPads().append(std::make_shared<FootprintPad>(pad, pos, Angle::deg0(),
+            FootprintPad::Shape::ROUND, Length(1200000), Length(1200000), Length(600000),
+            FootprintPad::BoardSide::THT));
+    }
+    pkg->getFootprints().append(footprint);
+    mLargeBoardProject->getLibrary().addPackage(*pkg); // can throw
+    Device* dev = new Device(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                             "Benchmark", "Generated device", ""); // can throw
+    dev->setComponentUuid(cmp->getUuid());
+    dev->setPackageUuid(pkg->getUuid());
+    dev->getPadSignalMap().append(std::make_shared<DevicePadSignalMapItem>(pad1, signal1));
+    dev->getPadSignalMap().append(std::make_shared<DevicePadSignalMapItem>(pad2, signal2));
+    mLargeBoardProject->getLibrary().addDevice(*dev); // can throw
+
+    // the pads are placed in the gaps between the vias of two rows
+    Circuit& circuit = mLargeBoardProject->getCircuit();
+    for (int row = 0; row < sViaGridSize - 1; ++row) {
+        for (int col = 0; col < sViaGridSize - 1; col += 2) {
+            ComponentInstance* cmpInst = new ComponentInstance(circuit, *cmp, symbVar,
+                QString("U%1").arg(circuit.getComponentInstances().count() + 1),
+                dev->getUuid()); // can throw
+            circuit.addComponentInstance(*cmpInst); // can throw
+            cmpInst->getSignalInstance(signal1)->setNetSignal(
+                netsignals[row % sNetCount]); // can throw
+            cmpInst->getSignalInstance(signal2)->setNetSignal(
+                netsignals[(row + 1) % sNetCount]); // can throw
+            Point pos(pitch * (col + 2), pitch * (row + 1) + pitch / 2);
+            BI_Device* device = new BI_Device(board, *cmpInst, dev->getUuid(),
+                footprintUuid, pos, Angle::deg0(), false); // can throw
+            board.addDeviceInstance(*device); // can throw
+        }
+    }
+}
+
+void Corpus::createLargeLibraryWorkspace()
+{
+    FilePath wsDir = mTmpDir.getPathTo("large_library_workspace");
+    workspace::Workspace::createNewWorkspace(wsDir); // can throw
+
+    // the library must exist before the workspace gets opened
+    FilePath libDir = wsDir.getPathTo("v" % qApp->getFileFormatVersion().toStr())
+                      .getPathTo("libraries/local/Benchmark.lplib");
+    library::Library lib(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                         "Benchmark", "Generated library for benchmarks", ""); // can throw
+    lib.saveTo(libDir); // can throw
+    library::LibraryElementBatchWriter writer;
+    for (int i = 0; i < sLibraryElementCount; ++i) {
+        library::Symbol symbol(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                               QString("Symbol %1").arg(i), "Generated symbol",
+                               "benchmark,symbol"); // can throw
+        for (int k = 0; k < 8; ++k) {
+            symbol.getPins().append(std::make_shared<library::SymbolPin>(
+                Uuid::createRandom(), QString::number(k + 1),
+                Point(Length(-5080000), Length(2540000 * k)), Length(2540000),
+                Angle::deg0()));
+        }
+        writer.addElementIntoParentDirectory(symbol, libDir.getPathTo("sym")); // can throw
+        library::Package package(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                 QString("Package %1").arg(i), "Generated package",
+                                 "benchmark,package"); // can throw
+        writer.addElementIntoParentDirectory(package, libDir.getPathTo("pkg")); // can throw
+    }
+    writer.commit(); // can throw
+
+    mLargeLibraryWorkspace.reset(new workspace::Workspace(wsDir)); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_BENCHMARKS_CORPUS_H
+#define LIBREPCB_BENCHMARKS_CORPUS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace project {
+class Project;
+class Board;
+class NetSignal;
+}
+
+namespace workspace {
+class Workspace;
+}
+
+namespace benchmarks {
+
+/*****************************************************************************************
+ *  Class Corpus
+ ****************************************************************************************/
+
+/**
+ * @brief The Corpus class generates the synthetic input data of all benchmarks
+ *
+ * The corpora are generated lazily in a temporary directory when they are needed the
+ * first time and are removed when the Corpus object is destroyed. Their sizes are
+ * defined by the constants below, so they only change with the source code and results
+ * of different commits stay comparable. Increment #sVersion whenever the generated
+ * content changes!
+ */
+class Corpus final
+{
+    public:
+
+        // Constructors / Destructor
+        Corpus() noexcept;
+        Corpus(const Corpus& other) = delete;
+        ~Corpus() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get a large board with many netsegments, vias, pads and dense planes
+         *
+         * The board contains a grid of #sViaGridSize x #sViaGridSize vias. The vias of
+         * each row are connected by netlines and belong to one of #sNetCount nets.
+         * Between two via rows there is a row of devices, each with two THT pads which
+         * are connected to the nets of the adjacent via rows. Each copper layer is
+         * filled by #sPlanesPerLayer overlapping planes.
+         */
+        project::Board& getLargeBoard();
+
+        /**
+         * @brief Get the S-Expression file content of the large board
+         */
+        const QString& getLargeBoardFileContent();
+
+        /**
+         * @brief Get a workspace with a library of #sLibraryElementCount symbols and
+         *        #sLibraryElementCount packages
+         */
+        workspace::Workspace& getLargeLibraryWorkspace();
+
+        // Static Methods
+        static Corpus& instance() noexcept;
+
+        // Operator Overloadings
+        Corpus& operator=(const Corpus& rhs) = delete;
+
+
+    public: // Constants
+        static constexpr int sVersion = 2;
+        static constexpr int sViaGridSize = 40;
+        static constexpr int sNetCount = 8;
+        static constexpr int sPlanesPerLayer = 2;
+        static constexpr int sLibraryElementCount = 1000;
+
+
+    private: // Methods
+        void createLargeBoard();
+        void createLargeBoardDevices(project::Board& board,
+                                     const QList<project::NetSignal*>& netsignals);
+        void createLargeLibraryWorkspace();
+
+
+    private: // Data
+        FilePath mTmpDir;
+        std::unique_ptr<project::Project> mLargeBoardProject;
+        project::Board* mLargeBoard;
+        QString mLargeBoardFileContent;
+        std::unique_ptr<workspace::Workspace> mLargeLibraryWorkspace;
+
+        static Corpus* sInstance;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
+
+#endif // LIBREPCB_BENCHMARKS_CORPUS_H
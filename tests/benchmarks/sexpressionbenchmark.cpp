@@ -0,0 +1,68 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "benchmark.h"
+#include "corpus.h"
+#include <librepcb/common/fileio/sexpression.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*****************************************************************************************
+ *  Benchmarks
+ ****************************************************************************************/
+
+LIBREPCB_BENCHMARK(SExpressionParseLargeBoard)
+{
+    const QString& content = Corpus::instance().getLargeBoardFileContent(); // can throw
+    FilePath fp = FilePath::getApplicationTempPath().getPathTo("board.lp");
+    while (state.keepRunning()) {
+        SExpression root = SExpression::parse(content, fp); // can throw
+        Q_UNUSED(root);
+    }
+    state.setItemsProcessed(state.getIterations() * content.toUtf8().size());
+    state.setLabel("bytes");
+}
+
+LIBREPCB_BENCHMARK(SExpressionSerializeLargeBoard)
+{
+    const QString& content = Corpus::instance().getLargeBoardFileContent(); // can throw
+    FilePath fp = FilePath::getApplicationTempPath().getPathTo("board.lp");
+    SExpression root = SExpression::parse(content, fp); // can throw
+    while (state.keepRunning()) {
+        QString str = root.toString(0); // can throw
+        Q_UNUSED(str);
+    }
+    state.setItemsProcessed(state.getIterations() * content.toUtf8().size());
+    state.setLabel("bytes");
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
@@ -0,0 +1,64 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "benchmark.h"
+#include "corpus.h"
+#include <librepcb/common/application.h>
+#include <librepcb/common/font/strokefont.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*****************************************************************************************
+ *  Benchmarks
+ ****************************************************************************************/
+
+LIBREPCB_BENCHMARK(StrokeFontStrokeMultiLineText)
+{
+    const StrokeFont& font = qApp->getDefaultStrokeFont();
+    QString text;
+    for (int i = 0; i < 20; ++i) {
+        text += QString("R%1 100k 1% 0603 {{NAME}} ÄÖÜ äöü µΩ\n").arg(i);
+    }
+    Point bottomLeft, topRight;
+    font.stroke("warm up", Length(1000000), Length(0), Length(0), Alignment(),
+                bottomLeft, topRight); // waits until the font is loaded
+    while (state.keepRunning()) {
+        QVector<Path> paths = font.stroke(text, Length(1000000), Length(100000),
+                                          Length(1500000), Alignment(), bottomLeft,
+                                          topRight);
+        Q_UNUSED(paths);
+    }
+    state.setItemsProcessed(state.getIterations() * text.length());
+    state.setLabel("characters");
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
@@ -0,0 +1,68 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "benchmark.h"
+#include "corpus.h"
+#include <librepcb/common/exceptions.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibraryscanner.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+using namespace workspace;
+
+/*****************************************************************************************
+ *  Benchmarks
+ ****************************************************************************************/
+
+LIBREPCB_BENCHMARK(WorkspaceLibraryScannerLargeLibrary)
+{
+    Workspace& ws = Corpus::instance().getLargeLibraryWorkspace(); // can throw
+    QString error;
+    int elementCount = 0;
+    while (state.keepRunning()) {
+        WorkspaceLibraryScanner scanner(ws);
+        QObject::connect(&scanner, &WorkspaceLibraryScanner::succeeded,
+                         [&elementCount](int count){elementCount = count;});
+        QObject::connect(&scanner, &WorkspaceLibraryScanner::failed,
+                         [&error](const QString& msg){error = msg;});
+        scanner.startFullScan();
+        scanner.wait();
+    }
+    if (!error.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, error);
+    }
+    state.setItemsProcessed(state.getIterations() * elementCount);
+    state.setLabel("elements");
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace benchmarks
+} // namespace librepcb
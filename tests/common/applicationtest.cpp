@@ -91,6 +91,39 @@ TEST(ApplicationTest, testExistenceOfResourceFiles)
     EXPECT_TRUE(qApp->getResourcesFilePath(".librepcb-resources").isExistingFile());
 }
 
+TEST(ApplicationTest, testUseOffscreenPlatformIfHeadless)
+{
+    QByteArray oldPlatform = qgetenv("QT_QPA_PLATFORM");
+    bool wasSet = qEnvironmentVariableIsSet("QT_QPA_PLATFORM");
+    auto run = [](QList<QByteArray> args){
+        QCommandLineParser parser;
+        parser.addPositionalArgument("files", "Files.", "[files...]");
+        QVector<char*> argv;
+        for (QByteArray& arg : args) argv.append(arg.data());
+        Application::useOffscreenPlatformIfHeadless(parser, argv.count(), argv.data());
+    };
+
+    // without positional arguments (graphical user interface), nothing is changed
+    qunsetenv("QT_QPA_PLATFORM");
+    run({"tool"});
+    EXPECT_FALSE(qEnvironmentVariableIsSet("QT_QPA_PLATFORM"));
+
+    // with positional arguments (headless), the offscreen platform is used
+    run({"tool", "file"});
+    EXPECT_EQ(QByteArray("offscreen"), qgetenv("QT_QPA_PLATFORM"));
+
+    // an explicitly chosen platform is not overridden
+    qputenv("QT_QPA_PLATFORM", "minimal");
+    run({"tool", "file"});
+    EXPECT_EQ(QByteArray("minimal"), qgetenv("QT_QPA_PLATFORM"));
+
+    if (wasSet) {
+        qputenv("QT_QPA_PLATFORM", oldPlatform);
+    } else {
+        qunsetenv("QT_QPA_PLATFORM");
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
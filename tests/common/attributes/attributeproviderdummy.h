@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/attributes/attributeprovider.h>
+#include <librepcb/common/attributes/attributesubstitutioncache.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -61,6 +62,45 @@ class AttributeProviderDummy final : public AttributeProvider
         void attributesChanged() override {}
 };
 
+/*****************************************************************************************
+ *  Class CachedAttributeProviderDummy
+ ****************************************************************************************/
+
+class CachedAttributeProviderDummy final : public QObject, public AttributeProvider
+{
+        Q_OBJECT
+
+    public:
+        explicit CachedAttributeProviderDummy(const AttributeProvider* parent = nullptr) noexcept :
+            QObject(nullptr), mCache(*this), mParent(parent) {}
+        CachedAttributeProviderDummy(const CachedAttributeProviderDummy& other) = delete;
+        CachedAttributeProviderDummy& operator=(const CachedAttributeProviderDummy& rhs) = delete;
+        ~CachedAttributeProviderDummy() noexcept {}
+
+        void setAttributeValue(const QString& key, const QString& value) noexcept {
+            mValues.insert(key, value);
+            emit attributesChanged();
+        }
+
+        QString getUserDefinedAttributeValue(const QString& key) const noexcept override {
+            return mValues.value(key);
+        }
+        QVector<const AttributeProvider*> getAttributeProviderParents() const noexcept override {
+            return QVector<const AttributeProvider*>{mParent};
+        }
+        AttributeSubstitutionCache* getAttributeSubstitutionCache() const noexcept override {
+            return &mCache;
+        }
+
+    signals:
+        void attributesChanged() override;
+
+    private:
+        mutable AttributeSubstitutionCache mCache;
+        const AttributeProvider* mParent;
+        QHash<QString, QString> mValues;
+};
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -62,6 +62,52 @@ TEST_P(AttributeSubstitutorTest, testData)
     EXPECT_EQ(data.output, output) << "Actual value: '" << qPrintable(output) << "'";
 }
 
+TEST_P(AttributeSubstitutorTest, testCachedDataIsIdenticalToUncached)
+{
+    const AttributeSubstitutorTestData& data = GetParam();
+
+    // the dummy provides its values as parent of the cached provider
+    AttributeProviderDummy parent;
+    CachedAttributeProviderDummy ap(&parent);
+    QString uncached = AttributeSubstitutor::substitute(data.input, &parent);
+    QString first = AttributeSubstitutor::substitute(data.input, &ap);  // cache miss
+    QString second = AttributeSubstitutor::substitute(data.input, &ap); // cache hit
+    EXPECT_EQ(uncached, first) << "Actual value: '" << qPrintable(first) << "'";
+    EXPECT_EQ(uncached, second) << "Actual value: '" << qPrintable(second) << "'";
+}
+
+TEST(AttributeSubstitutionCacheTest, testChangedAttributeIsSubstituted)
+{
+    CachedAttributeProviderDummy ap;
+    ap.setAttributeValue("KEY", "old");
+    EXPECT_EQ("old value", AttributeSubstitutor::substitute("{{KEY}} value", &ap));
+    EXPECT_EQ("old value", AttributeSubstitutor::substitute("{{KEY}} value", &ap));
+    ap.setAttributeValue("KEY", "new");
+    EXPECT_EQ("new value", AttributeSubstitutor::substitute("{{KEY}} value", &ap));
+}
+
+TEST(AttributeSubstitutionCacheTest, testChangedParentAttributeIsSubstituted)
+{
+    // the child's cache must be invalidated by the parent's attributesChanged() signal
+    // (generation counter), since the child itself doesn't emit any signal
+    CachedAttributeProviderDummy parent;
+    CachedAttributeProviderDummy child(&parent);
+    parent.setAttributeValue("KEY", "old");
+    EXPECT_EQ("old", AttributeSubstitutor::substitute("{{KEY}}", &child));
+    parent.setAttributeValue("KEY", "new");
+    EXPECT_EQ("new", AttributeSubstitutor::substitute("{{KEY}}", &child));
+}
+
+TEST(AttributeSubstitutionCacheTest, testFilteredSubstitutionIsNotCached)
+{
+    CachedAttributeProviderDummy ap;
+    ap.setAttributeValue("KEY", "value");
+    auto filter = [](const QString& str){return str.toUpper();};
+    EXPECT_EQ("value", AttributeSubstitutor::substitute("{{KEY}}", &ap));
+    EXPECT_EQ("VALUE", AttributeSubstitutor::substitute("{{KEY}}", &ap, filter));
+    EXPECT_EQ("value", AttributeSubstitutor::substitute("{{KEY}}", &ap));
+}
+
 /*****************************************************************************************
  *  Test Data
  ****************************************************************************************/
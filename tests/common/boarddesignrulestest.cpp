@@ -0,0 +1,68 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/boarddesignrules.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardDesignRulesTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(BoardDesignRulesTest, testDefaultCopperClearanceIsNotSerialized)
+{
+    BoardDesignRules rules;
+    SExpression sexpr = serializeToDomElement(rules, "design_rules");
+    EXPECT_EQ(nullptr, sexpr.tryGetChildByPath("copper_clearance"));
+    EXPECT_EQ(Length(200000), BoardDesignRules(sexpr).getCopperClearance());
+}
+
+TEST(BoardDesignRulesTest, testCustomCopperClearanceIsSerialized)
+{
+    BoardDesignRules rules;
+    rules.setCopperClearance(Length(150000));
+    SExpression sexpr = serializeToDomElement(rules, "design_rules");
+    EXPECT_NE(nullptr, sexpr.tryGetChildByPath("copper_clearance"));
+    EXPECT_EQ(Length(150000), BoardDesignRules(sexpr).getCopperClearance());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
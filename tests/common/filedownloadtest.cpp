@@ -21,6 +21,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtNetwork>
 #include <gtest/gtest.h>
 #include <librepcb/common/network/networkaccessmanager.h>
 #include <librepcb/common/network/filedownload.h>
@@ -209,6 +210,167 @@ INSTANTIATE_TEST_CASE_P(FileDownloadTest, FileDownloadTest, ::testing::Values(
                           false})
 ));
 
+/*****************************************************************************************
+ *  Test Class for Downloads from a local HTTP Server
+ ****************************************************************************************/
+
+/**
+ * @brief Downloads files from a minimal HTTP server running in the test process
+ *
+ * In contrast to the tests above (which use file:// URLs), this exercises the HTTP code
+ * paths of FileDownload: data arriving in several chunks, the Content-Length header and
+ * connections closed by the server.
+ */
+class FileDownloadHttpTest : public ::testing::Test
+{
+    public:
+
+        static void SetUpTestCase() {
+            sDownloadManager = new NetworkAccessManager();
+        }
+
+        static void TearDownTestCase() {
+            delete sDownloadManager;
+        }
+
+    protected:
+
+        QTcpServer mServer;
+        QByteArray mContent;        ///< the body sent by the server
+        qint64 mContentLength = -1; ///< the announced length (-1 = size of the body)
+        NetworkRequestBaseSignalReceiver mSignalReceiver;
+        FilePath mDestination;
+        FilePath mExtractToDir;
+        static NetworkAccessManager* sDownloadManager;
+
+        FileDownloadHttpTest() {
+            FilePath zip(TEST_DATA_DIR "/unit/FileDownloadTest/first_pcb.zip");
+            mContent = FileUtils::readFile(zip);
+            mDestination = FilePath::getApplicationTempPath().getPathTo("http_download.zip");
+            mExtractToDir = FilePath::getApplicationTempPath().getPathTo("http_download");
+            if (mDestination.isExistingFile()) {
+                FileUtils::removeFile(mDestination);
+            }
+            if (mExtractToDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mExtractToDir);
+            }
+
+            // answer every request with mContent, then close the connection
+            QObject::connect(&mServer, &QTcpServer::newConnection, [this](){
+                QTcpSocket* socket = mServer.nextPendingConnection();
+                QObject::connect(socket, &QTcpSocket::disconnected,
+                                 socket, &QTcpSocket::deleteLater);
+                QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket](){
+                    if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+                        return; // request header not complete yet
+                    }
+                    socket->readAll();
+                    qint64 length = (mContentLength >= 0) ? mContentLength : mContent.size();
+                    socket->write(QString("HTTP/1.1 200 OK\r\n"
+                                          "Content-Type: application/zip\r\n"
+                                          "Content-Length: %1\r\n"
+                                          "Connection: close\r\n\r\n")
+                                  .arg(length).toLatin1());
+                    socket->write(mContent);
+                    socket->disconnectFromHost();
+                });
+            });
+            EXPECT_TRUE(mServer.listen(QHostAddress::LocalHost));
+        }
+
+        QUrl getUrl() const {
+            return QUrl(QString("http://127.0.0.1:%1/first_pcb.zip").arg(mServer.serverPort()));
+        }
+
+        void download(const QByteArray& sha256, bool extract) {
+            FileDownload* dl = new FileDownload(getUrl(), mDestination);
+            if (extract) dl->setZipExtractionDirectory(mExtractToDir);
+            dl->setExpectedReplyContentSize(mContent.size());
+            dl->setExpectedChecksum(QCryptographicHash::Sha256, sha256);
+            QObject::connect(dl, &FileDownload::succeeded,
+                    &mSignalReceiver, &NetworkRequestBaseSignalReceiver::succeeded);
+            QObject::connect(dl, &FileDownload::errored,
+                    &mSignalReceiver, &NetworkRequestBaseSignalReceiver::errored);
+            QObject::connect(dl, &FileDownload::finished,
+                    &mSignalReceiver, &NetworkRequestBaseSignalReceiver::finished);
+            QObject::connect(dl, &FileDownload::fileDownloaded,
+                    &mSignalReceiver, &NetworkRequestBaseSignalReceiver::fileDownloaded);
+            QObject::connect(dl, &FileDownload::zipFileExtracted,
+                    &mSignalReceiver, &NetworkRequestBaseSignalReceiver::zipFileExtracted);
+            QObject::connect(dl, &FileDownload::destroyed,
+                    &mSignalReceiver, &NetworkRequestBaseSignalReceiver::destroyed);
+            dl->start();
+
+            // wait until download finished (with timeout), the server needs the event loop
+            QElapsedTimer timer;
+            timer.start();
+            while ((!mSignalReceiver.mDestroyed) && (timer.elapsed() < 30000)) {
+                qApp->processEvents(QEventLoop::AllEvents, 10);
+            }
+            EXPECT_TRUE(mSignalReceiver.mDestroyed) << "Download timed out!";
+            EXPECT_EQ(1, mSignalReceiver.mFinishedCallCount);
+        }
+
+        static QByteArray validChecksum() {
+            return QByteArray::fromHex(
+                "f6f18782790d2a185698f7028a83397d56ef6145679f646c8de5ddfc298d8f89");
+        }
+};
+
+NetworkAccessManager* FileDownloadHttpTest::sDownloadManager = nullptr;
+
+TEST_F(FileDownloadHttpTest, testSuccess)
+{
+    download(validChecksum(), true);
+    EXPECT_EQ(1, mSignalReceiver.mSucceededCallCount);
+    EXPECT_EQ(0, mSignalReceiver.mErroredCallCount)
+        << qPrintable(mSignalReceiver.mErrorMessage);
+    EXPECT_TRUE(mSignalReceiver.mFinishedSuccess);
+    EXPECT_EQ(mDestination, mSignalReceiver.mDownloadedToFilePath);
+    EXPECT_EQ(mExtractToDir, mSignalReceiver.mExtractedToFilePath);
+    EXPECT_EQ(1, mSignalReceiver.mZipFileExtractedCallCount);
+    EXPECT_FALSE(mDestination.isExistingFile()); // removed after extraction
+    EXPECT_TRUE(mExtractToDir.isExistingDir());
+    EXPECT_FALSE(mExtractToDir.isEmptyDir());
+}
+
+TEST_F(FileDownloadHttpTest, testSuccessWithoutExtraction)
+{
+    download(validChecksum(), false);
+    EXPECT_EQ(1, mSignalReceiver.mSucceededCallCount);
+    EXPECT_TRUE(mSignalReceiver.mFinishedSuccess);
+    ASSERT_TRUE(mDestination.isExistingFile());
+    EXPECT_EQ(mContent, FileUtils::readFile(mDestination));
+}
+
+TEST_F(FileDownloadHttpTest, testChecksumMismatch)
+{
+    QByteArray checksum = validChecksum();
+    checksum[0] = static_cast<char>(~checksum.at(0));
+    download(checksum, true);
+    EXPECT_EQ(0, mSignalReceiver.mSucceededCallCount);
+    EXPECT_EQ(1, mSignalReceiver.mErroredCallCount);
+    EXPECT_FALSE(mSignalReceiver.mErrorMessage.isEmpty());
+    EXPECT_FALSE(mSignalReceiver.mFinishedSuccess);
+    EXPECT_EQ(0, mSignalReceiver.mFileDownloadedCallCount);
+    EXPECT_FALSE(mDestination.isExistingFile());
+    EXPECT_FALSE(mExtractToDir.isExistingDir());
+}
+
+TEST_F(FileDownloadHttpTest, testSizeMismatch)
+{
+    // the server announces more data than it sends before closing the connection
+    mContentLength = mContent.size() + 1000;
+    download(validChecksum(), true);
+    EXPECT_EQ(0, mSignalReceiver.mSucceededCallCount);
+    EXPECT_EQ(1, mSignalReceiver.mErroredCallCount);
+    EXPECT_FALSE(mSignalReceiver.mErrorMessage.isEmpty());
+    EXPECT_FALSE(mSignalReceiver.mFinishedSuccess);
+    EXPECT_EQ(0, mSignalReceiver.mFileDownloadedCallCount);
+    EXPECT_FALSE(mDestination.isExistingFile());
+    EXPECT_FALSE(mExtractToDir.isExistingDir());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -0,0 +1,112 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class FileUtilsTest : public ::testing::TestWithParam<bool>
+{
+    protected:
+        FilePath mTmpDir;
+
+        FileUtilsTest() {
+            mTmpDir = FilePath::getRandomTempPath();
+        }
+
+        virtual ~FileUtilsTest() {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_P(FileUtilsTest, testCloneFile)
+{
+    FilePath source = mTmpDir.getPathTo("source.txt");
+    FilePath dest = mTmpDir.getPathTo("dest.txt");
+    FileUtils::writeFile(source, "foo bar");
+
+    FileUtils::CloneMethod method = FileUtils::cloneFile(source, dest, GetParam());
+    if (!GetParam()) {
+        EXPECT_NE(FileUtils::CloneMethod::HardLink, method);
+    }
+    EXPECT_EQ(QByteArray("foo bar"), FileUtils::readFile(dest));
+
+    // files are replaced by writeFile(), so the source must not be affected
+    FileUtils::writeFile(dest, "modified");
+    EXPECT_EQ(QByteArray("foo bar"), FileUtils::readFile(source));
+}
+
+TEST_P(FileUtilsTest, testCloneFileToExistingFileThrows)
+{
+    FilePath source = mTmpDir.getPathTo("source.txt");
+    FilePath dest = mTmpDir.getPathTo("dest.txt");
+    FileUtils::writeFile(source, "foo");
+    FileUtils::writeFile(dest, "bar");
+
+    EXPECT_THROW(FileUtils::cloneFile(source, dest, GetParam()), Exception);
+    EXPECT_EQ(QByteArray("bar"), FileUtils::readFile(dest));
+}
+
+TEST_P(FileUtilsTest, testCloneDirRecursively)
+{
+    FilePath source = mTmpDir.getPathTo("source");
+    FilePath dest = mTmpDir.getPathTo("dest");
+    FileUtils::writeFile(source.getPathTo("file.txt"), "foo");
+    FileUtils::writeFile(source.getPathTo(".hidden"), "bar");
+    FileUtils::writeFile(source.getPathTo("subdir/file.txt"), "baz");
+
+    int copiedFiles = FileUtils::cloneDirRecursively(source, dest, GetParam());
+    EXPECT_GE(copiedFiles, 0);
+    EXPECT_LE(copiedFiles, 3);
+    EXPECT_EQ(QByteArray("foo"), FileUtils::readFile(dest.getPathTo("file.txt")));
+    EXPECT_EQ(QByteArray("bar"), FileUtils::readFile(dest.getPathTo(".hidden")));
+    EXPECT_EQ(QByteArray("baz"), FileUtils::readFile(dest.getPathTo("subdir/file.txt")));
+}
+
+/*****************************************************************************************
+ *  Test Data
+ ****************************************************************************************/
+
+// parameter: allow hard links
+INSTANTIATE_TEST_CASE_P(FileUtilsTest, FileUtilsTest, ::testing::Values(false, true));
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,78 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SExpressionTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(SExpressionTest, testParseChildListsSkipsOtherLists)
+{
+    QString str = "(root \"token\"\n"
+                  " (name \"foo\")\n"
+                  " (skipped (nested \"a ) string with \\\" quote\") (name \"nested\"))\n"
+                  " (name (locale \"de_CH\") \"bar\")\n"
+                  " (other 42)\n"
+                  ")";
+    SExpression root = SExpression::parse(str, FilePath(), {"name"});
+    EXPECT_EQ("root", root.getName());
+    EXPECT_EQ("token", root.getChildByIndex(0).getValue<QString>(true));
+    QList<SExpression> names = root.getChildren("name");
+    ASSERT_EQ(2, names.count());
+    EXPECT_EQ("foo", names.at(0).getValueOfFirstChild<QString>(true));
+    EXPECT_EQ("bar", names.at(1).getChildByIndex(1).getValue<QString>(true));
+    EXPECT_EQ(nullptr, root.tryGetChildByPath("skipped"));
+    EXPECT_EQ(nullptr, root.tryGetChildByPath("other"));
+}
+
+TEST_F(SExpressionTest, testParseChildListsWithEmptyFilter)
+{
+    SExpression root = SExpression::parse("(root (a 1) (b 2))", FilePath(), {});
+    EXPECT_EQ("root", root.getName());
+    EXPECT_EQ(0, root.getChildren("a").count());
+    EXPECT_EQ(0, root.getChildren("b").count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,78 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/geometry/path.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PathTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PathTest, testCopyHasSamePainterPath)
+{
+    Path path = Path::rect(Point(0, 0), Point(1000000, 2000000));
+    QPainterPath expected = path.toQPainterPathPx();
+    Path copy(path);
+    EXPECT_EQ(path, copy);
+    EXPECT_EQ(expected, copy.toQPainterPathPx());
+    copy = Path::centeredRect(Length(1000000), Length(1000000));
+    EXPECT_NE(expected, copy.toQPainterPathPx());
+}
+
+TEST_F(PathTest, testTransformationInvalidatesPainterPath)
+{
+    Path path = Path::line(Point(0, 0), Point(1000000, 0));
+    QPainterPath original = path.toQPainterPathPx();
+    path.translate(Point(0, 1000000));
+    EXPECT_NE(original, path.toQPainterPathPx());
+    path.translate(Point(0, -1000000));
+    EXPECT_EQ(original, path.toQPainterPathPx());
+}
+
+TEST_F(PathTest, testSerializeAndDeserialize)
+{
+    Path path = Path::obround(Point(0, 0), Point(5000000, 1000000), Length(500000));
+    SExpression node = serializeToDomElement(path, "outline");
+    Path deserialized(node);
+    EXPECT_EQ(path, deserialized);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clipperpathcache.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class ClipperPathCacheTest : public ::testing::Test
+{
+    protected:
+        static ClipperLib::Path uncached(const Path& path, const Length& tolerance,
+                                         const Angle& rotation, const Point& translation) {
+            return ClipperHelpers::convert(path.rotated(rotation).translated(translation),
+                                           tolerance);
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ClipperPathCacheTest, testRotatedArcsAreEqualToUncached)
+{
+    QVector<Path> paths = {
+        Path::circle(Length(1000000)),
+        Path::obround(Length(2500000), Length(1200000)),
+        Path::obround(Point(-300000, 100000), Point(700000, 900000), Length(400000)),
+    };
+    QVector<Angle> rotations = {Angle::deg0(), Angle::deg45(), Angle::deg90(),
+                                Angle(33333333), Angle(-123456789)};
+    QVector<Point> translations = {Point(0, 0), Point(12345678, -7654321),
+                                   Point(-100000000, 250000000)};
+    Length tolerance(5000);
+    ClipperPathCache cache;
+    // convert everything twice to compare both the cache misses and the cache hits
+    for (int i = 0; i < 2; ++i) {
+        foreach (const Path& path, paths) {
+            foreach (const Angle& rotation, rotations) {
+                foreach (const Point& translation, translations) {
+                    EXPECT_EQ(uncached(path, tolerance, rotation, translation),
+                              cache.convert(path, tolerance, rotation, translation))
+                        << "rotation: " << qPrintable(rotation.toDegString())
+                        << ", translation: " << translation.getX().toNm() << "/"
+                        << translation.getY().toNm();
+                }
+            }
+        }
+    }
+    EXPECT_EQ(paths.count() * rotations.count(), cache.getCount());
+}
+
+TEST_F(ClipperPathCacheTest, testPathsWithoutArcsAreNotCached)
+{
+    Path path = Path::centeredRect(Length(1000000), Length(2000000));
+    ClipperPathCache cache;
+    EXPECT_EQ(uncached(path, Length(5000), Angle::deg45(), Point(1000, 2000)),
+              cache.convert(path, Length(5000), Angle::deg45(), Point(1000, 2000)));
+    EXPECT_EQ(0, cache.getCount());
+}
+
+TEST_F(ClipperPathCacheTest, testCacheIsBounded)
+{
+    ClipperPathCache cache(3);
+    for (int i = 1; i <= 10; ++i) {
+        Path path = Path::circle(Length(i * 100000));
+        EXPECT_EQ(uncached(path, Length(5000), Angle::deg0(), Point(0, 0)),
+                  cache.convert(path, Length(5000), Angle::deg0(), Point(0, 0)));
+        EXPECT_EQ(qMin(i, 3), cache.getCount());
+    }
+    cache.clear();
+    EXPECT_EQ(0, cache.getCount());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,212 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/connectivitygraph.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class ConnectivityGraphTest : public ::testing::Test
+{
+    protected:
+        /// Compare a graph with a graph built from scratch with only the given edges
+        static void expectSameGroupsAsRebuilt(const ConnectivityGraph<int>& graph,
+                                              const QList<int>& nodes,
+                                              const QList<QPair<int, int>>& edges) {
+            ConnectivityGraph<int> rebuilt;
+            foreach (int node, nodes) rebuilt.addNode(node);
+            foreach (const auto& edge, edges) rebuilt.addEdge(edge.first, edge.second);
+            EXPECT_EQ(rebuilt.getGroups(), graph.getGroups());
+            EXPECT_EQ(rebuilt.getGroupCount(), graph.getGroupCount());
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ConnectivityGraphTest, testEmpty)
+{
+    ConnectivityGraph<int> graph;
+    EXPECT_EQ(0, graph.getNodeCount());
+    EXPECT_EQ(0, graph.getGroupCount());
+    EXPECT_TRUE(graph.getGroups().isEmpty());
+    EXPECT_TRUE(graph.getConnectedNodes(1).isEmpty());
+    EXPECT_FALSE(graph.areConnected(1, 2));
+}
+
+TEST_F(ConnectivityGraphTest, testAddEdgesMergesGroups)
+{
+    ConnectivityGraph<int> graph;
+    for (int i = 0; i < 5; ++i) graph.addNode(i);
+    EXPECT_EQ(5, graph.getGroupCount());
+    graph.addEdge(0, 1);
+    graph.addEdge(3, 2);
+    EXPECT_EQ(3, graph.getGroupCount());
+    EXPECT_TRUE(graph.areConnected(1, 0));
+    EXPECT_FALSE(graph.areConnected(1, 2));
+    graph.addEdge(1, 2);
+    EXPECT_TRUE(graph.areConnected(0, 3));
+    EXPECT_EQ((QList<QList<int>>{{0, 1, 2, 3}, {4}}), graph.getGroups());
+}
+
+TEST_F(ConnectivityGraphTest, testAddEdgeAddsNodes)
+{
+    ConnectivityGraph<int> graph;
+    graph.addEdge(7, 3);
+    EXPECT_EQ(2, graph.getNodeCount());
+    EXPECT_TRUE(graph.containsNode(7));
+    EXPECT_TRUE(graph.containsNode(3));
+    EXPECT_EQ((QList<QList<int>>{{7, 3}}), graph.getGroups());
+}
+
+TEST_F(ConnectivityGraphTest, testRemoveEdgeSplitsGroup)
+{
+    ConnectivityGraph<int> graph;
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 3);
+    EXPECT_EQ(1, graph.getGroupCount());
+    graph.removeEdge(2, 1);
+    EXPECT_EQ(2, graph.getGroupCount());
+    EXPECT_FALSE(graph.areConnected(0, 3));
+    EXPECT_EQ((QList<QList<int>>{{0, 1}, {2, 3}}), graph.getGroups());
+    EXPECT_EQ(4, graph.getNodeCount());
+}
+
+TEST_F(ConnectivityGraphTest, testMultipleEdgesBetweenSameNodes)
+{
+    ConnectivityGraph<int> graph;
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 0);
+    EXPECT_EQ(2, graph.getEdgeCount(0, 1));
+    graph.removeEdge(0, 1);
+    EXPECT_EQ(1, graph.getEdgeCount(1, 0));
+    EXPECT_TRUE(graph.areConnected(0, 1)); // still connected by the second edge
+    graph.removeEdge(0, 1);
+    EXPECT_EQ(0, graph.getEdgeCount(0, 1));
+    EXPECT_FALSE(graph.areConnected(0, 1));
+}
+
+TEST_F(ConnectivityGraphTest, testRemoveNodeRemovesEdges)
+{
+    ConnectivityGraph<int> graph;
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.removeNode(1);
+    EXPECT_FALSE(graph.containsNode(1));
+    EXPECT_EQ(0, graph.getEdgeCount(0, 1));
+    EXPECT_EQ(0, graph.getEdgeCount(2, 1));
+    EXPECT_EQ((QList<QList<int>>{{0}, {2}}), graph.getGroups());
+
+    // adding the node again must not restore any edges
+    graph.addNode(1);
+    EXPECT_EQ(3, graph.getGroupCount());
+}
+
+TEST_F(ConnectivityGraphTest, testRemoveNonExistingItemsDoesNothing)
+{
+    ConnectivityGraph<int> graph;
+    graph.addEdge(0, 1);
+    graph.removeEdge(0, 2);
+    graph.removeEdge(3, 4);
+    graph.removeNode(5);
+    EXPECT_EQ(2, graph.getNodeCount());
+    EXPECT_EQ(1, graph.getEdgeCount(0, 1));
+    EXPECT_TRUE(graph.areConnected(0, 1));
+}
+
+TEST_F(ConnectivityGraphTest, testGetConnectedNodes)
+{
+    ConnectivityGraph<int> graph;
+    for (int i = 0; i < 6; ++i) graph.addNode(i);
+    graph.addEdge(4, 2);
+    graph.addEdge(2, 0);
+    graph.addEdge(1, 5);
+    EXPECT_EQ((QList<int>{0, 2, 4}), graph.getConnectedNodes(2));
+    EXPECT_EQ((QList<int>{1, 5}), graph.getConnectedNodes(5));
+    EXPECT_EQ((QList<int>{3}), graph.getConnectedNodes(3));
+}
+
+TEST_F(ConnectivityGraphTest, testIncrementalUpdatesAreSameAsRebuilt)
+{
+    // a ring of 20 nodes with a few chords, modified step by step
+    ConnectivityGraph<int> graph;
+    QList<int> nodes;
+    QList<QPair<int, int>> edges;
+    for (int i = 0; i < 20; ++i) {
+        nodes.append(i);
+        graph.addNode(i);
+    }
+    for (int i = 0; i < 20; ++i) {
+        edges.append(qMakePair(i, (i + 1) % 20));
+        graph.addEdge(i, (i + 1) % 20);
+        expectSameGroupsAsRebuilt(graph, nodes, edges);
+    }
+    edges.append(qMakePair(3, 13));
+    graph.addEdge(3, 13);
+    for (int i = 0; i < 20; i += 3) {
+        edges.removeOne(qMakePair(i, (i + 1) % 20));
+        graph.removeEdge(i, (i + 1) % 20);
+        expectSameGroupsAsRebuilt(graph, nodes, edges);
+    }
+    for (int i = 0; i < 20; i += 5) {
+        nodes.removeOne(i);
+        for (int k = edges.count() - 1; k >= 0; --k) {
+            if ((edges.at(k).first == i) || (edges.at(k).second == i)) edges.removeAt(k);
+        }
+        graph.removeNode(i);
+        expectSameGroupsAsRebuilt(graph, nodes, edges);
+    }
+    for (int i = 0; i < 20; i += 4) {
+        if (!nodes.contains(i)) continue;
+        edges.append(qMakePair(i, 19));
+        graph.addEdge(i, 19);
+        expectSameGroupsAsRebuilt(graph, nodes, edges);
+    }
+}
+
+TEST_F(ConnectivityGraphTest, testCopyIsIndependent)
+{
+    ConnectivityGraph<int> graph;
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    ConnectivityGraph<int> copy = graph;
+    copy.removeEdge(1, 2);
+    EXPECT_TRUE(graph.areConnected(0, 2));
+    EXPECT_FALSE(copy.areConnected(0, 2));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,244 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/geometrykernel.h>
+#include <librepcb/common/toolbox.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class GeometryKernelTest : public ::testing::Test
+{
+    protected:
+        // deterministic pseudo random points within +/-100mm
+        static QVector<Point> randomPoints(int count, uint seed) {
+            QVector<Point> points;
+            quint64 state = seed;
+            auto next = [&state]() {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                return Length(qint64(state >> 33) % 200000000 - 100000000);
+            };
+            for (int i = 0; i < count; ++i) {
+                Length x = next();
+                points.append(Point(x, next()));
+            }
+            return points;
+        }
+
+        // the arc flattening algorithm formerly implemented in Path::flatArc()
+        static QVector<Point> scalarFlatArc(const Point& p1, const Point& p2,
+                                            const Angle& angle, const Length& maxTolerance) {
+            Length radiusAbs = Toolbox::arcRadius(p1, p2, angle).abs();
+            if (radiusAbs <= maxTolerance.abs() / 2) {
+                return QVector<Point>{p1, p2};
+            }
+            qreal radiusAbsNm = static_cast<qreal>(radiusAbs.toNm());
+            qreal y = qBound(0.0, static_cast<qreal>(maxTolerance.toNm()), radiusAbsNm / 4);
+            qreal stepsPerRad = qMin(0.5 / qAcos(1 - y / radiusAbsNm), radiusAbsNm / 2);
+            int steps = qCeil(stepsPerRad * angle.abs().toRad());
+            qreal angleDelta = angle.toMicroDeg() / (qreal)steps;
+            Point center = Toolbox::arcCenter(p1, p2, angle);
+            QVector<Point> points{p1};
+            for (int i = 1; i < steps; ++i) {
+                points.append(p1.rotated(Angle(angleDelta * i), center));
+            }
+            points.append(p2);
+            return points;
+        }
+
+        static void expectNear(const Point& expected, const Point& actual, qint64 tolerance) {
+            EXPECT_LE(qAbs(expected.getX().toNm() - actual.getX().toNm()), tolerance)
+                << expected.getX().toNm() << "/" << expected.getY().toNm() << " vs. "
+                << actual.getX().toNm() << "/" << actual.getY().toNm();
+            EXPECT_LE(qAbs(expected.getY().toNm() - actual.getY().toNm()), tolerance)
+                << expected.getX().toNm() << "/" << expected.getY().toNm() << " vs. "
+                << actual.getX().toNm() << "/" << actual.getY().toNm();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GeometryKernelTest, testArcRadiusAndCenterMatchToolbox)
+{
+    QVector<Point> points = randomPoints(40, 1);
+    // (angles are not too small to keep the radius within the range of Toolbox)
+    QList<Angle> angles = {Angle::deg45(), -Angle::deg90(), Angle(135000000),
+                           Angle(-30000000), Angle(330000000)};
+    for (int i = 0; i + 1 < points.count(); i += 2) {
+        foreach (const Angle& angle, angles) {
+            const Point& p1 = points.at(i);
+            const Point& p2 = points.at(i + 1);
+            EXPECT_NEAR(Toolbox::arcRadius(p1, p2, angle).toNm(),
+                        GeometryKernel::arcRadiusNm(p1, p2, angle), 1.0);
+            QPointF center = GeometryKernel::arcCenterNm(p1, p2, angle);
+            expectNear(Toolbox::arcCenter(p1, p2, angle),
+                       Point(Length(qRound64(center.x())), Length(qRound64(center.y()))), 2);
+        }
+    }
+}
+
+TEST_F(GeometryKernelTest, testFlattenArcMatchesScalarImplementation)
+{
+    QVector<Point> points = randomPoints(20, 2);
+    QList<Angle> angles = {Angle::deg45(), -Angle::deg90(), Angle(170000000),
+                           Angle(-270000000), Angle(30000000)};
+    QList<Length> tolerances = {Length(1000), Length(5000), Length(100000000)};
+    QVector<Point> buffer;
+    for (int i = 0; i + 1 < points.count(); i += 2) {
+        foreach (const Angle& angle, angles) {
+            foreach (const Length& tolerance, tolerances) {
+                const Point& p1 = points.at(i);
+                const Point& p2 = points.at(i + 1);
+                QVector<Point> expected = scalarFlatArc(p1, p2, angle, tolerance);
+                int count = GeometryKernel::flattenArc(p1, p2, angle, tolerance, buffer);
+                ASSERT_EQ(expected.count(), count);
+                ASSERT_EQ(expected.count(), buffer.count());
+                EXPECT_EQ(p1, buffer.first());
+                EXPECT_EQ(p2, buffer.last());
+                for (int k = 0; k < count; ++k) {
+                    expectNear(expected.at(k), buffer.at(k), 3);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(GeometryKernelTest, testDistancesMatchToolbox)
+{
+    QVector<Point> ends = randomPoints(200, 3);
+    ends.append(Point(0, 0)); // zero-length segment
+    ends.append(Point(0, 0));
+    GeometryKernel::SegmentArray segments;
+    for (int i = 0; i + 1 < ends.count(); i += 2) {
+        segments.append(ends.at(i), ends.at(i + 1));
+    }
+    ASSERT_EQ(ends.count() / 2, segments.count());
+
+    QVector<qreal> distances(segments.count());
+    foreach (const Point& p, randomPoints(50, 4)) {
+        GeometryKernel::squaredDistancesToSegments(p, segments, distances.data());
+        int expectedIndex = -1;
+        Length expectedDistance;
+        Point expectedNearest;
+        for (int k = 0; k < segments.count(); ++k) {
+            Point nearest;
+            Length d = Toolbox::shortestDistanceBetweenPointAndLine(p, ends.at(2 * k),
+                                                                    ends.at(2 * k + 1), &nearest);
+            EXPECT_NEAR(d.toNm(), qSqrt(distances.at(k)), 2.0);
+            if ((expectedIndex < 0) || (d < expectedDistance)) {
+                expectedIndex = k;
+                expectedDistance = d;
+                expectedNearest = nearest;
+            }
+        }
+        Point nearest;
+        Length distance;
+        EXPECT_EQ(expectedIndex, GeometryKernel::nearestSegment(p, segments, &nearest, &distance));
+        EXPECT_NEAR(expectedDistance.toNm(), distance.toNm(), 2);
+        expectNear(expectedNearest, nearest, 2);
+    }
+}
+
+TEST_F(GeometryKernelTest, testNearestSegmentOfEmptyArray)
+{
+    Point nearest(1, 2);
+    EXPECT_EQ(-1, GeometryKernel::nearestSegment(Point(0, 0), GeometryKernel::SegmentArray(),
+                                                 &nearest));
+    EXPECT_EQ(Point(1, 2), nearest);
+}
+
+TEST_F(GeometryKernelTest, testOrientation)
+{
+    EXPECT_EQ(1, GeometryKernel::orientation(Point(0, 0), Point(10, 0), Point(5, 1)));
+    EXPECT_EQ(-1, GeometryKernel::orientation(Point(0, 0), Point(10, 0), Point(5, -1)));
+    EXPECT_EQ(0, GeometryKernel::orientation(Point(0, 0), Point(10, 0), Point(20, 0)));
+
+    // products far beyond 64 bits must still be exact
+    Length big(qint64(1) << 60);
+    EXPECT_EQ(0, GeometryKernel::orientation(Point(-big, -big), Point(0, 0), Point(big, big)));
+    EXPECT_EQ(1, GeometryKernel::orientation(Point(-big, -big), Point(0, 0),
+                                             Point(big, big + Length(1))));
+    EXPECT_EQ(-1, GeometryKernel::orientation(Point(-big, -big), Point(0, 0),
+                                              Point(big + Length(1), big)));
+}
+
+TEST_F(GeometryKernelTest, testIsPointOnSegment)
+{
+    EXPECT_TRUE(GeometryKernel::isPointOnSegment(Point(5, 5), Point(0, 0), Point(10, 10)));
+    EXPECT_TRUE(GeometryKernel::isPointOnSegment(Point(10, 10), Point(0, 0), Point(10, 10)));
+    EXPECT_FALSE(GeometryKernel::isPointOnSegment(Point(11, 11), Point(0, 0), Point(10, 10)));
+    EXPECT_FALSE(GeometryKernel::isPointOnSegment(Point(5, 6), Point(0, 0), Point(10, 10)));
+}
+
+TEST_F(GeometryKernelTest, testSegmentsIntersect)
+{
+    // crossing
+    EXPECT_TRUE(GeometryKernel::segmentsIntersect(Point(0, 0), Point(10, 10),
+                                                  Point(0, 10), Point(10, 0)));
+    // touching at an end point
+    EXPECT_TRUE(GeometryKernel::segmentsIntersect(Point(0, 0), Point(10, 0),
+                                                  Point(10, 0), Point(10, 10)));
+    // collinear and overlapping
+    EXPECT_TRUE(GeometryKernel::segmentsIntersect(Point(0, 0), Point(10, 0),
+                                                  Point(5, 0), Point(20, 0)));
+    // collinear but disjoint
+    EXPECT_FALSE(GeometryKernel::segmentsIntersect(Point(0, 0), Point(10, 0),
+                                                   Point(11, 0), Point(20, 0)));
+    // parallel
+    EXPECT_FALSE(GeometryKernel::segmentsIntersect(Point(0, 0), Point(10, 0),
+                                                   Point(0, 1), Point(10, 1)));
+    // nearly touching
+    EXPECT_FALSE(GeometryKernel::segmentsIntersect(Point(0, 0), Point(10, 10),
+                                                   Point(6, 5), Point(100, 5)));
+}
+
+TEST_F(GeometryKernelTest, testSquaredDistanceBetweenSegments)
+{
+    // crossing
+    EXPECT_EQ(0, GeometryKernel::squaredDistanceBetweenSegments(
+        Point(0, 0), Point(10, 10), Point(0, 10), Point(10, 0)));
+    // parallel
+    EXPECT_EQ(25, GeometryKernel::squaredDistanceBetweenSegments(
+        Point(0, 0), Point(10, 0), Point(-5, 5), Point(15, 5)));
+    // end point to end point
+    EXPECT_EQ(25, GeometryKernel::squaredDistanceBetweenSegments(
+        Point(0, 0), Point(10, 0), Point(13, 4), Point(20, 4)));
+    // segment to point
+    EXPECT_EQ(9, GeometryKernel::squaredDistanceBetweenSegments(
+        Point(0, 0), Point(10, 0), Point(4, -3), Point(4, -3)));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/hatchlattice.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class HatchLatticeTest : public ::testing::Test
+{
+    protected:
+        static ClipperLib::Path rect(ClipperLib::cInt x0, ClipperLib::cInt y0,
+                                     ClipperLib::cInt x1, ClipperLib::cInt y1) {
+            return ClipperLib::Path{ClipperLib::IntPoint(x0, y0), ClipperLib::IntPoint(x1, y0),
+                                    ClipperLib::IntPoint(x1, y1), ClipperLib::IntPoint(x0, y1)};
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(HatchLatticeTest, testInvalidLatticeHasNoOpenings)
+{
+    ClipperLib::Paths area = {rect(0, 0, 10000000, 10000000)};
+    EXPECT_FALSE(HatchLattice(Length(1000000), Length(1000000)).isValid());
+    EXPECT_TRUE(HatchLattice(Length(1000000), Length(1000000)).createOpenings(area).empty());
+    EXPECT_TRUE(HatchLattice(Length(0), Length(1000000)).createOpenings(area).empty());
+}
+
+TEST_F(HatchLatticeTest, testSquare)
+{
+    ClipperLib::Paths area = {rect(0, 0, 10000000, 10000000)};
+    HatchLattice lattice(Length(200000), Length(1000000));
+    ClipperLib::Paths openings = lattice.createOpenings(area);
+
+    // one run per column, each containing 10 openings of 0.8x0.8mm
+    EXPECT_EQ(10U, openings.size());
+    qreal totalArea = 0;
+    for (const ClipperLib::Path& path : openings) {
+        EXPECT_FALSE(ClipperLib::Orientation(path)); // holes
+        totalArea += qAbs(ClipperLib::Area(path));
+    }
+    EXPECT_EQ(100 * 800000.0 * 800000.0, totalArea);
+}
+
+TEST_F(HatchLatticeTest, testOpeningsAreInsideArea)
+{
+    ClipperLib::Path triangle = {ClipperLib::IntPoint(0, 0),
+                                 ClipperLib::IntPoint(20000000, 0),
+                                 ClipperLib::IntPoint(0, 20000000)};
+    ClipperLib::Paths openings = HatchLattice(Length(300000), Length(1500000))
+                                     .createOpenings({triangle});
+    EXPECT_FALSE(openings.empty());
+    for (const ClipperLib::Path& path : openings) {
+        ClipperLib::cInt minY = path.front().Y;
+        for (const ClipperLib::IntPoint& p : path) {
+            EXPECT_EQ(1, ClipperLib::PointInPolygon(p, triangle));
+            minY = qMin(minY, p.Y);
+        }
+        EXPECT_EQ(minY, path.front().Y); // connection point of the cut-in
+    }
+}
+
+TEST_F(HatchLatticeTest, testHolesAreSkipped)
+{
+    ClipperLib::Path hole = rect(3000000, 3000000, 7000000, 7000000);
+    ClipperLib::ReversePath(hole);
+    ClipperLib::Paths area = {rect(0, 0, 10000000, 10000000), hole};
+    ClipperLib::Paths openings = HatchLattice(Length(200000), Length(1000000))
+                                     .createOpenings(area);
+    EXPECT_FALSE(openings.empty());
+    for (const ClipperLib::Path& path : openings) {
+        for (const ClipperLib::IntPoint& p : path) {
+            EXPECT_EQ(0, ClipperLib::PointInPolygon(p, hole));
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
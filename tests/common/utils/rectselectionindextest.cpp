@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/rectselectionindex.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class RectSelectionIndexTest : public ::testing::Test
+{
+    protected:
+        static QPainterPath rect(qreal x, qreal y, qreal w, qreal h) {
+            QPainterPath p;
+            p.addRect(x, y, w, h);
+            return p;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(RectSelectionIndexTest, testEmpty)
+{
+    RectSelectionIndex<int> index;
+    index.build();
+    EXPECT_TRUE(index.isEmpty());
+    EXPECT_TRUE(index.query(QRectF(-100, -100, 200, 200)).isEmpty());
+}
+
+TEST_F(RectSelectionIndexTest, testEmptyAreasAreIgnored)
+{
+    RectSelectionIndex<int> index;
+    index.add(1, QPainterPath());
+    index.add(2, rect(0, 0, 10, 10));
+    index.build();
+    EXPECT_EQ(1, index.count());
+    EXPECT_EQ(QSet<int>({2}), index.query(QRectF(-100, -100, 200, 200)));
+}
+
+TEST_F(RectSelectionIndexTest, testExactIntersection)
+{
+    // a diagonal line whose bounding rect intersects the query but the line itself not
+    QPainterPath diagonal;
+    diagonal.moveTo(0, 0);
+    diagonal.lineTo(100, 100);
+    diagonal.lineTo(101, 100);
+    diagonal.lineTo(1, 0);
+    diagonal.closeSubpath();
+
+    RectSelectionIndex<int> index;
+    index.add(1, diagonal);
+    index.add(2, rect(80, 0, 10, 10));
+    index.build();
+    EXPECT_EQ(QSet<int>({2}), index.query(QRectF(70, 0, 25, 25)));
+    EXPECT_EQ(QSet<int>({1}), index.query(QRectF(45, 45, 10, 10)));
+    EXPECT_EQ(QSet<int>({1, 2}), index.query(QRectF(0, 0, 100, 100)));
+}
+
+TEST_F(RectSelectionIndexTest, testManyItemsMatchBruteForce)
+{
+    // enough items to run the exact tests in parallel
+    RectSelectionIndex<int> index;
+    QHash<int, QPainterPath> areas;
+    for (int i = 0; i < 2000; ++i) {
+        QPainterPath area = rect((i * 37) % 1000, (i * 91) % 1000, 1 + (i % 13), 1 + (i % 7));
+        areas.insert(i, area);
+        index.add(i, area);
+    }
+    index.build();
+    QList<QRectF> queries = {QRectF(0, 0, 1000, 1000), QRectF(100, 200, 300, 50),
+                             QRectF(990, 990, 100, 100), QRectF(-50, -50, 10, 10)};
+    foreach (const QRectF& query, queries) {
+        QSet<int> expected;
+        for (auto it = areas.constBegin(); it != areas.constEnd(); ++it) {
+            if (it.value().intersects(query)) expected.insert(it.key());
+        }
+        EXPECT_EQ(expected, index.query(query));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/unionfind.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+class UnionFindTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(UnionFindTest, testEmpty)
+{
+    UnionFind<int> uf;
+    EXPECT_EQ(0, uf.count());
+    EXPECT_EQ(0, uf.getGroupCount());
+    EXPECT_TRUE(uf.getGroups().isEmpty());
+    EXPECT_FALSE(uf.areConnected(1, 2));
+}
+
+TEST_F(UnionFindTest, testAddIsIdempotent)
+{
+    UnionFind<int> uf;
+    EXPECT_EQ(0, uf.add(42));
+    EXPECT_EQ(1, uf.add(7));
+    EXPECT_EQ(0, uf.add(42));
+    EXPECT_EQ(2, uf.count());
+    EXPECT_EQ(2, uf.getGroupCount());
+}
+
+TEST_F(UnionFindTest, testUnite)
+{
+    UnionFind<int> uf;
+    for (int i = 0; i < 6; ++i) uf.add(i);
+    EXPECT_TRUE(uf.unite(0, 1));
+    EXPECT_TRUE(uf.unite(2, 3));
+    EXPECT_TRUE(uf.unite(1, 3));
+    EXPECT_FALSE(uf.unite(0, 2)); // already connected
+    EXPECT_EQ(3, uf.getGroupCount());
+    EXPECT_TRUE(uf.areConnected(0, 3));
+    EXPECT_FALSE(uf.areConnected(0, 4));
+    EXPECT_FALSE(uf.areConnected(4, 5));
+    EXPECT_EQ(uf.find(0), uf.find(2));
+    EXPECT_NE(uf.find(0), uf.find(5));
+}
+
+TEST_F(UnionFindTest, testUniteAddsItems)
+{
+    UnionFind<QString> uf;
+    EXPECT_TRUE(uf.unite("a", "b"));
+    EXPECT_EQ(2, uf.count());
+    EXPECT_EQ(1, uf.getGroupCount());
+    EXPECT_TRUE(uf.areConnected("b", "a"));
+}
+
+TEST_F(UnionFindTest, testGroupsAreDeterministic)
+{
+    UnionFind<int> uf;
+    for (int i = 0; i < 6; ++i) uf.add(i);
+    uf.unite(5, 1);
+    uf.unite(4, 0);
+    uf.unite(3, 5);
+    QList<QList<int>> expected = {{0, 4}, {1, 3, 5}, {2}};
+    EXPECT_EQ(expected, uf.getGroups());
+}
+
+TEST_F(UnionFindTest, testLongChain)
+{
+    UnionFind<int> uf;
+    const int count = 10000;
+    for (int i = 1; i < count; ++i) {
+        EXPECT_TRUE(uf.unite(i - 1, i));
+    }
+    EXPECT_EQ(count, uf.count());
+    EXPECT_EQ(1, uf.getGroupCount());
+    EXPECT_TRUE(uf.areConnected(0, count - 1));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/libraryelementbatchwriter.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class LibraryElementBatchWriterTest : public ::testing::Test
+{
+    protected:
+        FilePath mTmpDir;
+
+        LibraryElementBatchWriterTest() {
+            mTmpDir = FilePath::getRandomTempPath();
+        }
+
+        virtual ~LibraryElementBatchWriterTest() {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        static std::unique_ptr<Symbol> createSymbol() {
+            return std::unique_ptr<Symbol>(new Symbol(Uuid::createRandom(), Version("0.1"),
+                "author", "name", "description", "keywords"));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(LibraryElementBatchWriterTest, testNewElementIsInMemory)
+{
+    std::unique_ptr<Symbol> symbol = createSymbol();
+    EXPECT_TRUE(symbol->isInMemory());
+    EXPECT_FALSE(symbol->getFilePath().isExistingDir());
+
+    symbol->saveIntoParentDirectory(mTmpDir);
+    EXPECT_FALSE(symbol->isInMemory());
+    EXPECT_EQ(mTmpDir.getPathTo(symbol->getUuid().toStr()), symbol->getFilePath());
+    EXPECT_TRUE(LibraryBaseElement::isValidElementDirectory<Symbol>(symbol->getFilePath()));
+}
+
+TEST_F(LibraryElementBatchWriterTest, testFailedSaveKeepsElementInMemory)
+{
+    std::unique_ptr<Symbol> symbol = createSymbol();
+    FilePath memoryDir = symbol->getFilePath();
+
+    // the parent "directory" is a file, so the element can't be written
+    FilePath parentDir = mTmpDir.getPathTo("file.txt");
+    FileUtils::writeFile(parentDir, "foo");
+    EXPECT_THROW(symbol->saveIntoParentDirectory(parentDir), Exception);
+    EXPECT_TRUE(symbol->isInMemory());
+    EXPECT_EQ(memoryDir, symbol->getFilePath());
+
+    // saving to a valid directory must still work afterwards
+    symbol->saveIntoParentDirectory(mTmpDir);
+    EXPECT_FALSE(symbol->isInMemory());
+    EXPECT_TRUE(LibraryBaseElement::isValidElementDirectory<Symbol>(symbol->getFilePath()));
+}
+
+TEST_F(LibraryElementBatchWriterTest, testWritesSameFilesAsSaveTo)
+{
+    std::unique_ptr<Symbol> symbol = createSymbol();
+    FilePath batchDir = mTmpDir.getPathTo("batch").getPathTo(symbol->getUuid().toStr());
+    FilePath saveDir = mTmpDir.getPathTo("save").getPathTo(symbol->getUuid().toStr());
+
+    LibraryElementBatchWriter writer;
+    writer.addElement(*symbol, batchDir);
+    EXPECT_EQ(1, writer.getPendingElementsCount());
+    EXPECT_FALSE(batchDir.isExistingDir());
+    writer.commit();
+    EXPECT_EQ(0, writer.getPendingElementsCount());
+    EXPECT_TRUE(symbol->isInMemory()); // the element is not modified by the writer
+
+    symbol->saveTo(saveDir);
+    foreach (const QString& filename, QStringList{"symbol.lp", ".librepcb-sym"}) {
+        EXPECT_EQ(FileUtils::readFile(saveDir.getPathTo(filename)),
+                  FileUtils::readFile(batchDir.getPathTo(filename))) << qPrintable(filename);
+    }
+
+    Symbol loaded(batchDir, true);
+    EXPECT_EQ(symbol->getUuid(), loaded.getUuid());
+}
+
+TEST_F(LibraryElementBatchWriterTest, testInvalidDirectoryNameThrows)
+{
+    std::unique_ptr<Symbol> symbol = createSymbol();
+    LibraryElementBatchWriter writer;
+    EXPECT_THROW(writer.addElement(*symbol, mTmpDir.getPathTo("foo")), Exception);
+    EXPECT_EQ(0, writer.getPendingElementsCount());
+}
+
+TEST_F(LibraryElementBatchWriterTest, testExistingDirectoryIsSkipped)
+{
+    std::unique_ptr<Symbol> symbol1 = createSymbol();
+    std::unique_ptr<Symbol> symbol2 = createSymbol();
+    FilePath dir1 = mTmpDir.getPathTo(symbol1->getUuid().toStr());
+    FilePath dir2 = mTmpDir.getPathTo(symbol2->getUuid().toStr());
+    FileUtils::makePath(dir1);
+
+    LibraryElementBatchWriter writer;
+    writer.addElement(*symbol1, dir1);
+    writer.addElement(*symbol2, dir2);
+    EXPECT_THROW(writer.commit(), Exception);
+    EXPECT_EQ(1, writer.getPendingElementsCount());
+    writer.commit();
+    EXPECT_FALSE(LibraryBaseElement::isValidElementDirectory<Symbol>(dir1));
+    EXPECT_TRUE(LibraryBaseElement::isValidElementDirectory<Symbol>(dir2));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace library
+} // namespace librepcb
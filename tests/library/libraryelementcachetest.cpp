@@ -0,0 +1,166 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtConcurrent/QtConcurrent>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/library/libraryelementcache.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class LibraryElementCacheTest : public ::testing::Test
+{
+    protected:
+        FilePath mTmpDir;
+        FilePath mSymbolDir;
+        LibraryElementCache mCache;
+
+        LibraryElementCacheTest() {
+            mTmpDir = FilePath::getRandomTempPath();
+            Symbol symbol(Uuid::createRandom(), Version("0.1"), "author", "name",
+                          "description", "keywords");
+            symbol.saveIntoParentDirectory(mTmpDir.getPathTo("lib1"));
+            mSymbolDir = symbol.getFilePath();
+        }
+
+        virtual ~LibraryElementCacheTest() {
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        /// Copy the symbol into another parent directory (e.g. another project)
+        FilePath copySymbol(const QString& parentDirName) {
+            FilePath dest = mTmpDir.getPathTo(parentDirName).getPathTo(mSymbolDir.getFilename());
+            FileUtils::copyDirRecursively(mSymbolDir, dest);
+            return dest;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(LibraryElementCacheTest, testSameDirectoryIsHit)
+{
+    std::shared_ptr<const Symbol> s1 = mCache.getElement<Symbol>(mSymbolDir);
+    std::shared_ptr<const Symbol> s2 = mCache.getElement<Symbol>(mSymbolDir);
+    ASSERT_TRUE(s1 != nullptr);
+    EXPECT_EQ(s1.get(), s2.get());
+    EXPECT_TRUE(s1->isOpenedReadOnly());
+    EXPECT_EQ(1, mCache.getElementCount());
+}
+
+TEST_F(LibraryElementCacheTest, testIdenticalElementInOtherDirectoryIsHit)
+{
+    FilePath copy = copySymbol("lib2");
+    std::shared_ptr<const Symbol> s1 = mCache.getElement<Symbol>(mSymbolDir);
+    std::shared_ptr<const Symbol> s2 = mCache.getElement<Symbol>(copy);
+    EXPECT_EQ(s1.get(), s2.get());
+    EXPECT_EQ(mSymbolDir, s2->getFilePath()); // refers to the directory loaded first
+    EXPECT_EQ(1, mCache.getElementCount());
+}
+
+TEST_F(LibraryElementCacheTest, testModifiedElementIsReloaded)
+{
+    FilePath copy = copySymbol("lib2");
+    std::shared_ptr<const Symbol> original = mCache.getElement<Symbol>(copy);
+
+    // modify the copy, e.g. by another project
+    {
+        Symbol symbol(copy, false);
+        symbol.setName("", "modified");
+        symbol.save();
+    }
+    EXPECT_NE(LibraryElementCache::calcContentHash(mSymbolDir, "sym"),
+              LibraryElementCache::calcContentHash(copy, "sym"));
+
+    std::shared_ptr<const Symbol> modified = mCache.getElement<Symbol>(copy);
+    EXPECT_NE(original.get(), modified.get());
+    EXPECT_EQ("modified", modified->getNames().getDefaultValue());
+    EXPECT_EQ("name", original->getNames().getDefaultValue()); // still valid
+    EXPECT_EQ(original.get(), mCache.getElement<Symbol>(mSymbolDir).get());
+}
+
+TEST_F(LibraryElementCacheTest, testUnusedElementsAreReleased)
+{
+    std::weak_ptr<const Symbol> weak = mCache.getElement<Symbol>(mSymbolDir);
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(0, mCache.getElementCount());
+
+    std::shared_ptr<const Symbol> symbol = mCache.getElement<Symbol>(mSymbolDir);
+    EXPECT_EQ(1, mCache.getElementCount());
+}
+
+TEST_F(LibraryElementCacheTest, testDisabledCacheLoadsPrivateInstances)
+{
+    mCache.setEnabled(false);
+    std::shared_ptr<const Symbol> s1 = mCache.getElement<Symbol>(mSymbolDir);
+    std::shared_ptr<const Symbol> s2 = mCache.getElement<Symbol>(mSymbolDir);
+    ASSERT_TRUE(s1 && s2);
+    EXPECT_NE(s1.get(), s2.get());
+    EXPECT_EQ(0, mCache.getElementCount());
+}
+
+TEST_F(LibraryElementCacheTest, testInvalidElementThrows)
+{
+    FileUtils::writeFile(mSymbolDir.getPathTo("symbol.lp"), "(librepcb_symbol");
+    EXPECT_THROW(mCache.getElement<Symbol>(mSymbolDir), Exception);
+    EXPECT_EQ(0, mCache.getElementCount());
+}
+
+TEST_F(LibraryElementCacheTest, testConcurrentAccessFromTwoDirectories)
+{
+    FilePath copy = copySymbol("lib2");
+    QList<QFuture<std::shared_ptr<const Symbol>>> futures;
+    for (int i = 0; i < 16; ++i) {
+        FilePath dir = (i % 2) ? copy : mSymbolDir;
+        futures.append(QtConcurrent::run([this, dir]() {
+            return mCache.getElement<Symbol>(dir);
+        }));
+    }
+    std::shared_ptr<const Symbol> first = futures.first().result();
+    ASSERT_TRUE(first != nullptr);
+    for (QFuture<std::shared_ptr<const Symbol>>& future : futures) {
+        EXPECT_EQ(first.get(), future.result().get());
+    }
+    EXPECT_EQ(1, mCache.getElementCount());
+    EXPECT_EQ(qApp->thread(), first->thread());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace library
+} // namespace librepcb
@@ -0,0 +1,262 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/librarymanager/librarydownload.h>
+#include <librepcb/librarymanager/librarydownloadqueue.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace library {
+namespace manager {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class FakeDownload
+ ****************************************************************************************/
+
+/**
+ * @brief A LibraryDownload which never accesses the network, it is finished manually
+ */
+class FakeDownload final : public LibraryDownload
+{
+    public:
+        FakeDownload(const QUrl& url, const FilePath& destDir) noexcept :
+            LibraryDownload(url, destDir), mUrl(url) {}
+        const QUrl& getUrl() const noexcept {return mUrl;}
+        bool isStarted() const noexcept {return mStarted;}
+        void start() noexcept override {mStarted = true;}
+        void abort() noexcept override {finish(false, QString());}
+        void finish(bool success, const QString& errMsg) noexcept {
+            if (mFinished) return;
+            mFinished = true;
+            emit finished(success, errMsg);
+        }
+
+    private:
+        QUrl mUrl;
+        bool mStarted = false;
+        bool mFinished = false;
+};
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class LibraryDownloadQueueTest : public ::testing::Test
+{
+    protected:
+        QList<QPointer<FakeDownload>> mDownloads; ///< all created downloads, in order
+        QList<qint64> mCreationTimes; ///< milliseconds since the test started
+        QElapsedTimer mTimer;
+        QList<QPair<FilePath, bool>> mFinished;
+        int mAllFinishedCount = 0;
+        QScopedPointer<LibraryDownloadQueue> mQueue;
+
+        static constexpr int sRetryBaseDelayMs = 50;
+
+        LibraryDownloadQueueTest() {
+            mTimer.start();
+            mQueue.reset(new LibraryDownloadQueue(
+                [this](const QUrl& url, const FilePath& destDir){
+                    FakeDownload* download = new FakeDownload(url, destDir);
+                    mDownloads.append(download);
+                    mCreationTimes.append(mTimer.elapsed());
+                    return download;
+                }, sRetryBaseDelayMs));
+            QObject::connect(mQueue.data(), &LibraryDownloadQueue::downloadFinished,
+                             [this](const FilePath& destDir, bool success, const QString&){
+                                 mFinished.append(qMakePair(destDir, success));
+                             });
+            QObject::connect(mQueue.data(), &LibraryDownloadQueue::allDownloadsFinished,
+                             [this](){mAllFinishedCount++;});
+        }
+
+        static FilePath dir(int i) {
+            return FilePath::getApplicationTempPath().getPathTo(
+                QString("LibraryDownloadQueueTest/%1").arg(i));
+        }
+
+        void enqueue(const QString& host, int i) {
+            mQueue->enqueue(QUrl(QString("https://%1/lib%2.zip").arg(host).arg(i)),
+                            dir(i), -1, QByteArray());
+        }
+
+        QList<FakeDownload*> running() const {
+            QList<FakeDownload*> list;
+            foreach (const QPointer<FakeDownload>& download, mDownloads) {
+                if (download && download->isStarted() && mQueue->contains(
+                        download->getDestinationDir())) {
+                    list.append(download.data());
+                }
+            }
+            return list;
+        }
+
+        int countRunning(const QString& host) const {
+            int count = 0;
+            foreach (const FakeDownload* download, running()) {
+                if (download->getUrl().host() == host) count++;
+            }
+            return count;
+        }
+
+        // the queue receives the signals of the downloads through queued connections
+        static void processEvents(int ms = 0) {
+            QElapsedTimer timer;
+            timer.start();
+            do {
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            } while (timer.elapsed() < ms);
+        }
+};
+
+constexpr int LibraryDownloadQueueTest::sRetryBaseDelayMs;
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(LibraryDownloadQueueTest, testParallelDownloadsAreLimitedPerHost)
+{
+    for (int i = 0; i < 5; ++i) {
+        enqueue("a.example.com", i);
+    }
+    enqueue("b.example.com", 5);
+    EXPECT_EQ(2, countRunning("a.example.com"));
+    EXPECT_EQ(1, countRunning("b.example.com"));
+    EXPECT_EQ(3, running().count());
+
+    // when a download of host a finishes, the next one of host a is started
+    FakeDownload* first = running().first();
+    ASSERT_EQ(QString("a.example.com"), first->getUrl().host());
+    first->finish(true, QString());
+    processEvents();
+    EXPECT_EQ(2, countRunning("a.example.com"));
+    EXPECT_EQ(1, countRunning("b.example.com"));
+    ASSERT_EQ(1, mFinished.count());
+    EXPECT_EQ(dir(0), mFinished.first().first);
+    EXPECT_TRUE(mFinished.first().second);
+    EXPECT_EQ(0, mAllFinishedCount);
+
+    // finish all downloads
+    while (!running().isEmpty()) {
+        running().first()->finish(true, QString());
+        processEvents();
+    }
+    EXPECT_EQ(6, mFinished.count());
+    EXPECT_EQ(1, mAllFinishedCount);
+    EXPECT_TRUE(mQueue->isIdle());
+}
+
+TEST_F(LibraryDownloadQueueTest, testFailedDownloadsAreRetriedWithBackoff)
+{
+    enqueue("a.example.com", 0);
+    ASSERT_EQ(1, mDownloads.count());
+
+    // first failure: retried after the base delay
+    mDownloads.last()->finish(false, "error 1");
+    processEvents();
+    EXPECT_EQ(1, mDownloads.count());
+    EXPECT_TRUE(mQueue->contains(dir(0)));
+    EXPECT_TRUE(mFinished.isEmpty());
+    processEvents(sRetryBaseDelayMs * 3);
+    ASSERT_EQ(2, mDownloads.count());
+    EXPECT_GE(mCreationTimes.at(1) - mCreationTimes.at(0), sRetryBaseDelayMs);
+
+    // second failure: retried after twice the base delay
+    mDownloads.last()->finish(false, "error 2");
+    processEvents(sRetryBaseDelayMs * 5);
+    ASSERT_EQ(3, mDownloads.count());
+    EXPECT_GE(mCreationTimes.at(2) - mCreationTimes.at(1), sRetryBaseDelayMs * 2);
+
+    // third failure: no more retries
+    mDownloads.last()->finish(false, "error 3");
+    processEvents(sRetryBaseDelayMs * 10);
+    EXPECT_EQ(3, mDownloads.count());
+    ASSERT_EQ(1, mFinished.count());
+    EXPECT_FALSE(mFinished.first().second);
+    EXPECT_EQ(1, mAllFinishedCount);
+    EXPECT_TRUE(mQueue->isIdle());
+}
+
+TEST_F(LibraryDownloadQueueTest, testAbortedDownloadsAreNotRetried)
+{
+    enqueue("a.example.com", 0);
+    mDownloads.last()->abort();
+    processEvents(sRetryBaseDelayMs * 3);
+    EXPECT_EQ(1, mDownloads.count());
+    ASSERT_EQ(1, mFinished.count());
+    EXPECT_FALSE(mFinished.first().second);
+    EXPECT_EQ(1, mAllFinishedCount);
+}
+
+TEST_F(LibraryDownloadQueueTest, testAbortAllDuringRetryDelay)
+{
+    enqueue("a.example.com", 0);
+    enqueue("a.example.com", 1);
+    mDownloads.at(0)->finish(false, "error");
+    processEvents();
+    EXPECT_TRUE(mQueue->contains(dir(0))); // waiting for retry
+    EXPECT_TRUE(mQueue->contains(dir(1))); // running
+
+    mQueue->abortAll();
+    processEvents();
+    EXPECT_TRUE(mQueue->isIdle());
+    EXPECT_EQ(2, mFinished.count());
+    EXPECT_EQ(1, mAllFinishedCount);
+
+    // the retry timer must not restart the aborted download
+    processEvents(sRetryBaseDelayMs * 3);
+    EXPECT_EQ(2, mDownloads.count());
+    EXPECT_TRUE(mQueue->isIdle());
+    EXPECT_EQ(1, mAllFinishedCount);
+}
+
+TEST_F(LibraryDownloadQueueTest, testAbortAllOnIdleQueueEmitsNothing)
+{
+    mQueue->abortAll();
+    processEvents();
+    EXPECT_TRUE(mFinished.isEmpty());
+    EXPECT_EQ(0, mAllFinishedCount);
+
+    enqueue("a.example.com", 0);
+    mQueue->abortAll();
+    processEvents();
+    EXPECT_EQ(1, mAllFinishedCount);
+    mQueue->abortAll();
+    processEvents();
+    EXPECT_EQ(1, mAllFinishedCount);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace manager
+} // namespace library
+} // namespace librepcb
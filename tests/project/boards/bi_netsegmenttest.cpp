@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include "testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BI_NetSegmentTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        NetSignal* mNet;
+
+        BI_NetSegmentTest() {
+            mNet = &mBoard.addNetSignal("NET");
+        }
+
+        /// The groups of a netsegment's connectivity graph built from scratch
+        static QList<QList<const BI_Base*>> getRebuiltGroups(const BI_NetSegment& segment) {
+            ConnectivityGraph<const BI_Base*> graph;
+            foreach (const BI_Via* via, segment.getVias()) {
+                graph.addNode(via);
+            }
+            foreach (const BI_NetPoint* netpoint, segment.getNetPoints()) {
+                graph.addNode(netpoint);
+                if (netpoint->getVia()) graph.addEdge(netpoint, netpoint->getVia());
+            }
+            foreach (const BI_NetLine* netline, segment.getNetLines()) {
+                graph.addEdge(&netline->getStartPoint(), &netline->getEndPoint());
+            }
+            return graph.getGroups();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BI_NetSegmentTest, testTraceIsConnected)
+{
+    BI_NetSegment& segment = mBoard.addTrace(*mNet, GraphicsLayer::sTopCopper,
+        {Point::fromMm(1, 1), Point::fromMm(5, 1), Point::fromMm(5, 5)}, Length(200000));
+    const ConnectivityGraph<const BI_Base*>& graph = segment.getConnectivity();
+    EXPECT_EQ(3, graph.getNodeCount());
+    EXPECT_EQ(1, graph.getGroupCount());
+    EXPECT_EQ(getRebuiltGroups(segment), graph.getGroups());
+}
+
+TEST_F(BI_NetSegmentTest, testNetPointsAreConnectedThroughVia)
+{
+    BI_Via& via = mBoard.addVia(*mNet, Point::fromMm(5, 5));
+    BI_NetSegment& segment = via.getNetSegment();
+    BI_NetPoint* top = new BI_NetPoint(segment, mBoard.getLayer(GraphicsLayer::sTopCopper), via);
+    BI_NetPoint* bot = new BI_NetPoint(segment, mBoard.getLayer(GraphicsLayer::sBotCopper), via);
+    segment.addElements({}, {top, bot}, {});
+    EXPECT_TRUE(segment.getConnectivity().areConnected(top, bot));
+    EXPECT_EQ(getRebuiltGroups(segment), segment.getConnectivity().getGroups());
+
+    // detaching a netpoint from the via disconnects it
+    top->setViaToAttach(nullptr);
+    EXPECT_FALSE(segment.getConnectivity().areConnected(top, bot));
+    EXPECT_EQ(getRebuiltGroups(segment), segment.getConnectivity().getGroups());
+    top->setViaToAttach(&via);
+    EXPECT_TRUE(segment.getConnectivity().areConnected(top, bot));
+}
+
+TEST_F(BI_NetSegmentTest, testAddAndRemoveElements)
+{
+    BI_NetSegment& segment = mBoard.addTrace(*mNet, GraphicsLayer::sTopCopper,
+        {Point::fromMm(1, 1), Point::fromMm(5, 1)}, Length(200000));
+    BI_NetPoint& end = *segment.getNetPoints().last();
+    BI_NetPoint* p = new BI_NetPoint(segment, mBoard.getLayer(GraphicsLayer::sTopCopper),
+                                     Point::fromMm(5, 5));
+    BI_NetLine* l = new BI_NetLine(end, *p, Length(200000));
+    segment.addElements({}, {p}, {l});
+    EXPECT_EQ(1, segment.getConnectivity().getGroupCount());
+    EXPECT_EQ(getRebuiltGroups(segment), segment.getConnectivity().getGroups());
+
+    segment.removeElements({}, {p}, {l});
+    EXPECT_FALSE(segment.getConnectivity().containsNode(p));
+    EXPECT_EQ(1, segment.getConnectivity().getGroupCount());
+    EXPECT_EQ(getRebuiltGroups(segment), segment.getConnectivity().getGroups());
+    delete l;
+    delete p;
+}
+
+TEST_F(BI_NetSegmentTest, testRemovingNetLineWhichSplitsSegmentFails)
+{
+    BI_NetSegment& segment = mBoard.addTrace(*mNet, GraphicsLayer::sTopCopper,
+        {Point::fromMm(1, 1), Point::fromMm(5, 1), Point::fromMm(5, 5)}, Length(200000));
+    BI_NetLine* netline = segment.getNetLines().first();
+    EXPECT_THROW(segment.removeElements({}, {}, {netline}), Exception);
+
+    // the netline and its connection must be restored
+    EXPECT_TRUE(segment.getNetLines().contains(netline));
+    EXPECT_EQ(1, segment.getConnectivity().getGroupCount());
+    EXPECT_EQ(getRebuiltGroups(segment), segment.getConnectivity().getGroups());
+}
+
+TEST_F(BI_NetSegmentTest, testConnectivityIsLoadedFromFile)
+{
+    BI_Via& via = mBoard.addVia(*mNet, Point::fromMm(5, 5));
+    BI_NetSegment& segment = via.getNetSegment();
+    BI_NetPoint* p1 = new BI_NetPoint(segment, mBoard.getLayer(GraphicsLayer::sTopCopper), via);
+    BI_NetPoint* p2 = new BI_NetPoint(segment, mBoard.getLayer(GraphicsLayer::sTopCopper),
+                                      Point::fromMm(1, 5));
+    BI_NetLine* l = new BI_NetLine(*p1, *p2, Length(200000));
+    segment.addElements({}, {p1, p2}, {l});
+
+    mBoard.reopen();
+    ASSERT_EQ(1, mBoard.getBoard().getNetSegments().count());
+    const BI_NetSegment& loaded = *mBoard.getBoard().getNetSegments().first();
+    EXPECT_EQ(3, loaded.getConnectivity().getNodeCount());
+    EXPECT_EQ(1, loaded.getConnectivity().getGroupCount());
+    EXPECT_EQ(getRebuiltGroups(loaded), loaded.getConnectivity().getGroups());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,160 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/project/boards/cmd/cmdboardplaneedit.h>
+#include "testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BI_PlaneTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        BI_Plane* mPlane;
+
+        BI_PlaneTest() {
+            mPlane = &mBoard.addPlane(mBoard.addNetSignal("GND"), GraphicsLayer::sTopCopper);
+        }
+
+        static QString serialize(const BI_Plane& plane) {
+            return serializeToDomElement(plane, "plane").toString(0);
+        }
+
+        BI_Plane& reopenAndGetPlane() {
+            mPlane = nullptr;
+            mBoard.reopen();
+            return *mBoard.getBoard().getPlanes().first();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BI_PlaneTest, testDefaultAttributesAreNotSerialized)
+{
+    QString sexpr = serialize(*mPlane);
+    foreach (const QString& name, QStringList{"thermal_gap_width", "thermal_spoke_width",
+                                              "fill_style", "hatch_width", "hatch_pitch"}) {
+        EXPECT_FALSE(sexpr.contains(name)) << qPrintable(name);
+    }
+}
+
+TEST_F(BI_PlaneTest, testNonDefaultAttributesAreSerialized)
+{
+    mPlane->setThermalGapWidth(Length(400000));
+    mPlane->setThermalSpokeWidth(Length(500000));
+    mPlane->setFillStyle(BI_Plane::FillStyle::Hatched);
+    mPlane->setHatchWidth(Length(600000));
+    mPlane->setHatchPitch(Length(3000000));
+    QString sexpr = serialize(*mPlane);
+    foreach (const QString& name, QStringList{"thermal_gap_width", "thermal_spoke_width",
+                                              "fill_style", "hatch_width", "hatch_pitch"}) {
+        EXPECT_TRUE(sexpr.contains(name)) << qPrintable(name);
+    }
+
+    BI_Plane& plane = reopenAndGetPlane();
+    EXPECT_EQ(Length(400000), plane.getThermalGapWidth());
+    EXPECT_EQ(Length(500000), plane.getThermalSpokeWidth());
+    EXPECT_EQ(BI_Plane::FillStyle::Hatched, plane.getFillStyle());
+    EXPECT_EQ(Length(600000), plane.getHatchWidth());
+    EXPECT_EQ(Length(3000000), plane.getHatchPitch());
+}
+
+TEST_F(BI_PlaneTest, testDefaultAttributesAreRestored)
+{
+    BI_Plane& plane = reopenAndGetPlane();
+    EXPECT_EQ(Length(300000), plane.getThermalGapWidth());
+    EXPECT_EQ(Length(300000), plane.getThermalSpokeWidth());
+    EXPECT_EQ(BI_Plane::FillStyle::Solid, plane.getFillStyle());
+    EXPECT_EQ(Length(500000), plane.getHatchWidth());
+    EXPECT_EQ(Length(2000000), plane.getHatchPitch());
+}
+
+TEST_F(BI_PlaneTest, testInvalidHatchValuesAreRejected)
+{
+    mPlane->setHatchWidth(Length(500000));
+    mPlane->setHatchPitch(Length(2000000));
+    EXPECT_THROW(mPlane->setHatchWidth(Length(0)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchWidth(Length(-100000)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchWidth(Length(2000000)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchWidth(Length(3000000)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchPitch(Length(0)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchPitch(Length(-2000000)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchPitch(Length(500000)), RuntimeError);
+    EXPECT_THROW(mPlane->setHatchPitch(Length(100000)), RuntimeError);
+    EXPECT_EQ(Length(500000), mPlane->getHatchWidth());
+    EXPECT_EQ(Length(2000000), mPlane->getHatchPitch());
+}
+
+TEST_F(BI_PlaneTest, testEditCommandAppliesCoarserAndFinerHatch)
+{
+    // both values grow beyond the old pitch, so the pitch must be applied first
+    CmdBoardPlaneEdit coarser(*mPlane, false);
+    coarser.setHatchWidth(Length(3000000));
+    coarser.setHatchPitch(Length(6000000));
+    EXPECT_TRUE(coarser.execute());
+    EXPECT_EQ(Length(3000000), mPlane->getHatchWidth());
+    EXPECT_EQ(Length(6000000), mPlane->getHatchPitch());
+
+    // undoing shrinks both values again, so the width must be applied first
+    coarser.undo();
+    EXPECT_EQ(Length(500000), mPlane->getHatchWidth());
+    EXPECT_EQ(Length(2000000), mPlane->getHatchPitch());
+    coarser.redo();
+    EXPECT_EQ(Length(3000000), mPlane->getHatchWidth());
+    EXPECT_EQ(Length(6000000), mPlane->getHatchPitch());
+}
+
+TEST_F(BI_PlaneTest, testLoadingInvalidHatchValuesFails)
+{
+    mPlane->setHatchWidth(Length(1000000));
+    mPlane->setHatchPitch(Length(1500000));
+    QString str = serialize(*mPlane);
+    QString validPitch = QString("(hatch_pitch %1)").arg(Length(1500000).toMmString());
+    QString invalidPitch = QString("(hatch_pitch %1)").arg(Length(1000000).toMmString());
+    ASSERT_TRUE(str.contains(validPitch));
+    str.replace(validPitch, invalidPitch);
+    SExpression sexpr = SExpression::parse(str, FilePath());
+    EXPECT_THROW(BI_Plane(mBoard.getBoard(), sexpr), RuntimeError);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/boarddesignrules.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardclearancematrix.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardClearanceMatrixTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(BoardClearanceMatrixTest, testDefaultMatrix)
+{
+    BoardClearanceMatrix matrix;
+    EXPECT_EQ(1, matrix.getSize());
+    EXPECT_EQ(0, matrix.getIndex(static_cast<const NetClass*>(nullptr)));
+    EXPECT_EQ(Length(0), matrix.getClearance(0, 0));
+}
+
+TEST(BoardClearanceMatrixTest, testNetClassClearances)
+{
+    FilePath testDataDir(TEST_DATA_DIR "/project/boards/BoardPlaneFragmentsBuilderTest");
+    FilePath projectFp = testDataDir.getPathTo("test_project/test_project.lpp");
+    QScopedPointer<Project> project(new Project(projectFp, true));
+    Board* board = project->getBoards().first();
+    Circuit& circuit = project->getCircuit();
+    ASSERT_FALSE(circuit.getNetClasses().isEmpty());
+    NetClass* netclass = circuit.getNetClasses().first();
+    board->getDesignRules().setCopperClearance(Length(200000));
+
+    // netclass clearance larger than the global clearance
+    circuit.setNetClassClearance(*netclass, Length(500000));
+    const BoardClearanceMatrix* matrix = &board->getClearanceMatrix();
+    int index = matrix->getIndex(netclass);
+    EXPECT_GT(index, 0);
+    EXPECT_EQ(Length(0), matrix->getNetClassClearance(0, 0));
+    EXPECT_EQ(Length(500000), matrix->getNetClassClearance(index, 0));
+    EXPECT_EQ(Length(500000), matrix->getNetClassClearance(0, index));
+    EXPECT_EQ(Length(200000), matrix->getClearance(0, 0));
+    EXPECT_EQ(Length(500000), matrix->getClearance(index, index));
+    EXPECT_EQ(Length(500000), matrix->getMaxClearance());
+
+    // modifying the netclass rebuilds the matrix
+    circuit.setNetClassClearance(*netclass, Length(100000));
+    matrix = &board->getClearanceMatrix();
+    EXPECT_EQ(Length(100000), matrix->getNetClassClearance(index, 0));
+    EXPECT_EQ(Length(200000), matrix->getClearance(index, 0));
+
+    // modifying the design rules rebuilds the matrix
+    board->getDesignRules().setCopperClearance(Length(300000));
+    matrix = &board->getClearanceMatrix();
+    EXPECT_EQ(Length(300000), matrix->getClearance(index, 0));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardobstacleindex.h>
+#include "testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardObstacleIndexTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        NetSignal* mNet1;
+        NetSignal* mNet2;
+
+        BoardObstacleIndexTest() {
+            mNet1 = &mBoard.addNetSignal("NET1");
+            mNet2 = &mBoard.addNetSignal("NET2");
+        }
+
+        /// The items colliding with a trace, independent of the obstacle IDs
+        static QList<BI_Base*> getCollidingItems(const BoardObstacleIndex& index,
+                                                 const Point& p1, const Point& p2,
+                                                 const NetSignal* netSignal = nullptr) {
+            QList<BI_Base*> items;
+            foreach (int id, index.findCollisions(GraphicsLayer::sTopCopper, p1, p2,
+                                                  Length(200000), netSignal)) {
+                BI_Base* item = index.getObstacle(id).item;
+                if (!items.contains(item)) items.append(item);
+            }
+            std::sort(items.begin(), items.end());
+            return items;
+        }
+
+        /// Compare an index with a rebuilt one by probing the whole board
+        void expectSameAsRebuilt(const BoardObstacleIndex& index) {
+            BoardObstacleIndex rebuilt(mBoard.getBoard());
+            for (int i = 0; i <= 40; ++i) {
+                qreal pos = i * 0.5;
+                Point h1 = Point::fromMm(0, pos), h2 = Point::fromMm(20, pos);
+                Point v1 = Point::fromMm(pos, 0), v2 = Point::fromMm(pos, 20);
+                EXPECT_EQ(getCollidingItems(rebuilt, h1, h2), getCollidingItems(index, h1, h2))
+                    << "Horizontal probe at y=" << pos << "mm";
+                EXPECT_EQ(getCollidingItems(rebuilt, v1, v2), getCollidingItems(index, v1, v2))
+                    << "Vertical probe at x=" << pos << "mm";
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardObstacleIndexTest, testForeignViaCollides)
+{
+    BI_Via& via = mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+
+    Point p1 = Point::fromMm(5, 10), p2 = Point::fromMm(15, 10);
+    EXPECT_EQ(QList<BI_Base*>{&via}, getCollidingItems(index, p1, p2, mNet1));
+    EXPECT_EQ(QList<BI_Base*>(), getCollidingItems(index, p1, p2, mNet2)); // same net
+
+    // a trace far enough from the via does not collide
+    Point p3 = Point::fromMm(5, 12), p4 = Point::fromMm(15, 12);
+    EXPECT_EQ(QList<BI_Base*>(), getCollidingItems(index, p3, p4, mNet1));
+}
+
+TEST_F(BoardObstacleIndexTest, testForeignTraceCollides)
+{
+    BI_NetSegment& segment = mBoard.addTrace(*mNet2, GraphicsLayer::sTopCopper,
+        {Point::fromMm(10, 5), Point::fromMm(10, 15)}, Length(250000));
+    BoardObstacleIndex index(mBoard.getBoard());
+
+    Point p1 = Point::fromMm(5, 10), p2 = Point::fromMm(15, 10);
+    EXPECT_EQ(QList<BI_Base*>{segment.getNetLines().first()},
+              getCollidingItems(index, p1, p2, mNet1));
+
+    // traces on other layers are no obstacles
+    EXPECT_TRUE(index.findCollisions(GraphicsLayer::sBotCopper, p1, p2, Length(200000),
+                                     mNet1).isEmpty());
+}
+
+TEST_F(BoardObstacleIndexTest, testUpdateNetSegmentIsSameAsRebuild)
+{
+    mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BI_NetSegment& segment = mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+        {Point::fromMm(2, 2), Point::fromMm(18, 2), Point::fromMm(18, 8)}, Length(250000));
+    BoardObstacleIndex index(mBoard.getBoard());
+    expectSameAsRebuilt(index);
+
+    // move a netpoint
+    segment.getNetPoints().first()->setPosition(Point::fromMm(2, 15));
+    index.updateNetSegment(segment);
+    expectSameAsRebuilt(index);
+
+    // add a via
+    BI_Via* via = new BI_Via(segment, Point::fromMm(6, 6), BI_Via::Shape::Round,
+                             Length(700000), Length(300000));
+    segment.addElements({via}, {}, {});
+    index.updateNetSegment(segment);
+    expectSameAsRebuilt(index);
+
+    // remove the whole net segment
+    mBoard.getBoard().removeNetSegment(segment);
+    index.updateNetSegment(segment);
+    expectSameAsRebuilt(index);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -23,9 +23,12 @@
 #include <QtCore>
 #include <gtest/gtest.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/project/project.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
 #include <librepcb/project/boards/items/bi_plane.h>
+#include "testboard.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -49,6 +52,61 @@ class BoardPlaneFragmentsBuilderTest : public ::testing::Test
 {
 };
 
+/**
+ * @brief The BoardPlaneFragmentsBuilderGeometryTest checks the fragments of a single
+ *        plane on a small board built by the test itself
+ */
+class BoardPlaneFragmentsBuilderGeometryTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        NetSignal* mGnd;
+        NetSignal* mSig;
+        BI_Plane* mPlane;
+
+        BoardPlaneFragmentsBuilderGeometryTest() {
+            mGnd = &mBoard.addNetSignal("GND");
+            mSig = &mBoard.addNetSignal("SIG");
+            mPlane = &mBoard.addPlane(*mGnd, GraphicsLayer::sTopCopper);
+            mPlane->setMinWidth(Length(200000));
+            mPlane->setMinClearance(Length(300000));
+        }
+
+        static ClipperLib::Path toClipper(const Path& path) {
+            return ClipperHelpers::convert(path, Length(5000));
+        }
+
+        static ClipperLib::Paths clip(const ClipperLib::Paths& subject,
+                                      const ClipperLib::Paths& clip,
+                                      ClipperLib::ClipType type) {
+            ClipperLib::Paths result;
+            ClipperLib::Clipper c;
+            c.AddPaths(subject, ClipperLib::ptSubject, true);
+            c.AddPaths(clip, ClipperLib::ptClip, true);
+            c.Execute(type, result, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+            return result;
+        }
+
+        /// The copper of the plane within an area
+        ClipperLib::Paths getCopperWithin(const ClipperLib::Paths& area) {
+            QVector<Path> fragments = BoardPlaneFragmentsBuilder(*mPlane).buildFragments();
+            return clip(ClipperHelpers::convert(fragments, Length(5000)), area,
+                        ClipperLib::ctIntersection);
+        }
+
+        /// The copper of the plane within the thermal gap around a pad
+        ClipperLib::Paths getCopperWithinThermalGap(const BI_FootprintPad& pad) {
+            ClipperLib::Paths gap = clip(
+                {toClipper(pad.getSceneOutline(mPlane->getThermalGapWidth()))},
+                {toClipper(pad.getSceneOutline())}, ClipperLib::ctDifference);
+            return getCopperWithin(gap);
+        }
+
+        static qreal getArea(const ClipperLib::Path& path) {
+            return qAbs(ClipperLib::Area(path));
+        }
+};
+
 /*****************************************************************************************
  *  Test Methods
  ****************************************************************************************/
@@ -79,7 +137,7 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments)
         SExpression child = SExpression::createList("plane");
         child.appendToken(uuid.toStr());
         foreach (const Path& fragment, actualPlaneFragments[uuid]) {
-            child.appendChild(fragment.serializeToDomElement("fragment"), true);
+            child.appendChild(serializeToDomElement(fragment, "fragment"), true);
         }
         actualSexpr.appendChild(child, true);
     }
@@ -100,6 +158,70 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments)
     EXPECT_EQ(expectedPlaneFragments, actualPlaneFragments);
 }
 
+TEST_F(BoardPlaneFragmentsBuilderGeometryTest, testThermalPadKeepsExactlyItsSpokes)
+{
+    mPlane->setConnectStyle(BI_Plane::ConnectStyle::Thermal);
+    mPlane->setThermalGapWidth(Length(500000));
+    mPlane->setThermalSpokeWidth(Length(400000));
+    BI_FootprintPad& pad = mBoard.addPad(*mGnd, Point::fromMm(10, 10),
+        library::FootprintPad::Shape::RECT, Length(2000000), Length(2000000));
+
+    // the only copper within the gap are the four spokes
+    qreal spokeArea = 0.4e6 * 0.5e6;
+    ClipperLib::Paths copper = getCopperWithinThermalGap(pad);
+    ASSERT_EQ(4u, copper.size());
+    for (const ClipperLib::Path& path : copper) {
+        EXPECT_NEAR(spokeArea, getArea(path), spokeArea * 0.1);
+    }
+}
+
+TEST_F(BoardPlaneFragmentsBuilderGeometryTest, testThermalSpokesAreClippedByForeignVia)
+{
+    mPlane->setConnectStyle(BI_Plane::ConnectStyle::Thermal);
+    mPlane->setThermalGapWidth(Length(500000));
+    mPlane->setThermalSpokeWidth(Length(400000));
+    BI_FootprintPad& pad = mBoard.addPad(*mGnd, Point::fromMm(10, 10),
+        library::FootprintPad::Shape::RECT, Length(2000000), Length(2000000));
+    BI_Via& via = mBoard.addVia(*mSig, Point::fromMm(11.9, 10)); // next to right spoke
+
+    // no copper within the clearance of the via (with some tolerance for arcs)
+    Length clearance = mPlane->getMinClearance() - Length(10000);
+    EXPECT_TRUE(getCopperWithin({toClipper(via.getSceneOutline(clearance))}).empty());
+
+    // three complete spokes, the right one is partly removed
+    qreal spokeArea = 0.4e6 * 0.5e6;
+    int completeSpokes = 0;
+    qreal totalArea = 0;
+    for (const ClipperLib::Path& path : getCopperWithinThermalGap(pad)) {
+        if (qAbs(getArea(path) - spokeArea) < spokeArea * 0.1) completeSpokes++;
+        totalArea += getArea(path);
+    }
+    EXPECT_EQ(3, completeSpokes);
+    EXPECT_LT(totalArea, spokeArea * 3.9);
+}
+
+TEST_F(BoardPlaneFragmentsBuilderGeometryTest, testHatchedPlaneConnectsViaInOpening)
+{
+    // openings of the lattice are between 0.25mm and 1.75mm (modulo 2mm)
+    mPlane->setFillStyle(BI_Plane::FillStyle::Hatched);
+    mPlane->setHatchWidth(Length(500000));
+    mPlane->setHatchPitch(Length(2000000));
+    BI_Via& via = mBoard.addVia(*mGnd, Point::fromMm(11, 11));
+
+    // the via and a border of one hatch width around it are solid copper
+    ClipperLib::Path solid = toClipper(via.getSceneOutline(Length(490000)));
+    qreal copperArea = 0;
+    for (const ClipperLib::Path& path : getCopperWithin({solid})) {
+        copperArea += getArea(path);
+    }
+    EXPECT_NEAR(getArea(solid), copperArea, getArea(solid) * 0.01);
+
+    // other openings are still there
+    ClipperLib::Path opening = toClipper(Path::rect(Point::fromMm(4.5, 4.5),
+                                                    Point::fromMm(5.5, 5.5)));
+    EXPECT_TRUE(getCopperWithin({opening}).empty());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
+#include <librepcb/project/boards/boardplanefragmentscache.h>
+#include "testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardPlaneFragmentsCacheTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        BI_Plane* mPlane;
+        BI_Via* mVia;
+
+        BoardPlaneFragmentsCacheTest() {
+            NetSignal& gnd = mBoard.addNetSignal("GND");
+            NetSignal& sig = mBoard.addNetSignal("SIG");
+            mPlane = &mBoard.addPlane(gnd, GraphicsLayer::sTopCopper);
+            mVia = &mBoard.addVia(sig, Point(5000000, 5000000));
+            mBoard.getBoard().rebuildAllPlanes();
+        }
+
+        BI_Plane& reopenAndGetPlane() {
+            mPlane = nullptr;
+            mVia = nullptr;
+            mBoard.reopen();
+            return *mBoard.getBoard().getPlanes().first();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardPlaneFragmentsCacheTest, testUpToDateFragmentsAreRestored)
+{
+    QVector<Path> fragments = mPlane->getFragments();
+    ASSERT_FALSE(fragments.isEmpty());
+
+    // the fragments must be available right after opening, without any rebuild
+    BI_Plane& plane = reopenAndGetPlane();
+    EXPECT_EQ(fragments, plane.getFragments());
+    EXPECT_FALSE(plane.getFragmentsInputHash().isEmpty());
+}
+
+TEST_F(BoardPlaneFragmentsCacheTest, testModifiedBoardIsRebuiltAfterReopen)
+{
+    QVector<Path> oldFragments = mPlane->getFragments();
+
+    // modify the board and save it without rebuilding the plane
+    mVia->setPosition(Point(10000000, 10000000));
+    EXPECT_EQ(oldFragments, mPlane->getFragments());
+    BI_Plane& plane = reopenAndGetPlane();
+
+    // the outdated fragments must not be restored...
+    EXPECT_TRUE(plane.getFragments().isEmpty());
+
+    // ...but the plane must be rebuilt as soon as the event loop is running
+    QCoreApplication::processEvents();
+    QVector<Path> expected = BoardPlaneFragmentsBuilder(plane).buildFragments();
+    EXPECT_NE(oldFragments, expected);
+    EXPECT_EQ(expected, plane.getFragments());
+}
+
+TEST_F(BoardPlaneFragmentsCacheTest, testClearedPlaneIsNotCached)
+{
+    mPlane->clear();
+    EXPECT_TRUE(mPlane->getFragmentsInputHash().isEmpty());
+    BI_Plane& plane = reopenAndGetPlane();
+    EXPECT_TRUE(plane.getFragments().isEmpty());
+    QCoreApplication::processEvents();
+    EXPECT_FALSE(plane.getFragments().isEmpty());
+}
+
+TEST_F(BoardPlaneFragmentsCacheTest, testNetClassClearanceIsPartOfInputHash)
+{
+    QByteArray hash = BoardPlaneFragmentsCache::calcInputHash(*mPlane);
+    EXPECT_EQ(hash, mPlane->getFragmentsInputHash());
+
+    // the netclass of the via, i.e. not part of any serialized board item
+    mVia->getNetSignalOfNetSegment().getNetClass().setClearance(Length(1000000));
+    EXPECT_NE(hash, BoardPlaneFragmentsCache::calcInputHash(*mPlane));
+    BI_Plane& plane = reopenAndGetPlane();
+    EXPECT_TRUE(plane.getFragments().isEmpty()); // outdated, rebuilt later
+}
+
+TEST_F(BoardPlaneFragmentsCacheTest, testBoardInputsAreHashedOncePerLayer)
+{
+    NetSignal& net = mBoard.addNetSignal("NET");
+    BI_Plane& other = mBoard.addPlane(net, GraphicsLayer::sTopCopper);
+    BI_Plane& bottom = mBoard.addPlane(net, GraphicsLayer::sBotCopper);
+
+    BoardPlaneFragmentsCache::BoardInputHashes hashes;
+    EXPECT_EQ(BoardPlaneFragmentsCache::calcInputHash(*mPlane),
+              BoardPlaneFragmentsCache::calcInputHash(*mPlane, hashes));
+    EXPECT_EQ(BoardPlaneFragmentsCache::calcInputHash(other),
+              BoardPlaneFragmentsCache::calcInputHash(other, hashes));
+    EXPECT_EQ(1, hashes.count());
+    EXPECT_EQ(BoardPlaneFragmentsCache::calcBoardInputHash(mBoard.getBoard(),
+                                                           GraphicsLayer::sTopCopper),
+              hashes.value(GraphicsLayer::sTopCopper));
+    BoardPlaneFragmentsCache::calcInputHash(bottom, hashes);
+    EXPECT_EQ(2, hashes.count());
+
+    // the planes of a layer still differ in their own inputs
+    EXPECT_NE(BoardPlaneFragmentsCache::calcInputHash(*mPlane),
+              BoardPlaneFragmentsCache::calcInputHash(other));
+}
+
+TEST_F(BoardPlaneFragmentsCacheTest, testRebuildAllPlanesCalculatesSameHashes)
+{
+    NetSignal& net = mBoard.addNetSignal("NET");
+    mBoard.addPlane(net, GraphicsLayer::sTopCopper).setPriority(1);
+    mBoard.addPlane(net, GraphicsLayer::sBotCopper);
+
+    // lower priority planes depend on the rebuilt fragments of the other planes
+    mBoard.getBoard().rebuildAllPlanes();
+    foreach (const BI_Plane* plane, mBoard.getBoard().getPlanes()) {
+        EXPECT_FALSE(plane->getFragmentsInputHash().isEmpty());
+        EXPECT_EQ(BoardPlaneFragmentsCache::calcInputHash(*plane),
+                  plane->getFragmentsInputHash());
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,251 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/boardstatistics.h>
+#include "testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardStatisticsTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        NetSignal* mNet1;
+        NetSignal* mNet2;
+
+        BoardStatisticsTest() {
+            mNet1 = &mBoard.addNetSignal("NET1");
+            mNet2 = &mBoard.addNetSignal("NET2");
+        }
+
+        BoardStatistics& getStatistics() noexcept {
+            return mBoard.getBoard().getStatistics();
+        }
+
+        static void expectEqual(const BoardStatistics::TraceStatistics& expected,
+                                const BoardStatistics::TraceStatistics& actual,
+                                const QString& context) {
+            EXPECT_EQ(expected.length, actual.length) << qPrintable(context);
+            EXPECT_EQ(expected.count, actual.count) << qPrintable(context);
+            EXPECT_NEAR(expected.area, actual.area, 1e-9) << qPrintable(context);
+        }
+
+        /**
+         * Compare the incrementally updated statistics of the board with statistics
+         * which are recalculated from scratch (a new object is in the same state as
+         * after BoardStatistics::invalidateAll(), but without any previous results)
+         */
+        void expectSameAsRecalculated() {
+            const BoardStatistics& incremental = getStatistics();
+            BoardStatistics recalculated(mBoard.getBoard());
+            QStringList expectedLayerNames = recalculated.getLayerNames();
+            QStringList actualLayerNames = incremental.getLayerNames();
+            std::sort(expectedLayerNames.begin(), expectedLayerNames.end());
+            std::sort(actualLayerNames.begin(), actualLayerNames.end());
+            EXPECT_EQ(expectedLayerNames, actualLayerNames);
+            foreach (const QString& layerName, expectedLayerNames) {
+                BoardStatistics::LayerStatistics expected =
+                    recalculated.getLayerStatistics(layerName);
+                BoardStatistics::LayerStatistics actual =
+                    incremental.getLayerStatistics(layerName);
+                expectEqual(expected.traces, actual.traces, "Layer " % layerName);
+                EXPECT_NEAR(expected.planeArea, actual.planeArea, 1e-9)
+                    << qPrintable(layerName);
+            }
+            foreach (const NetSignal* netsignal,
+                     mBoard.getProject().getCircuit().getNetSignals()) {
+                BoardStatistics::NetStatistics expected =
+                    recalculated.getNetStatistics(*netsignal);
+                BoardStatistics::NetStatistics actual =
+                    incremental.getNetStatistics(*netsignal);
+                QString context = "Net " % netsignal->getName();
+                expectEqual(expected.traces, actual.traces, context);
+                EXPECT_EQ(expected.tracesPerLayer.keys().toSet(),
+                          actual.tracesPerLayer.keys().toSet()) << qPrintable(context);
+                foreach (const QString& layerName, expected.tracesPerLayer.keys()) {
+                    expectEqual(expected.tracesPerLayer.value(layerName),
+                                actual.tracesPerLayer.value(layerName),
+                                context % " on " % layerName);
+                }
+                EXPECT_EQ(expected.viaCount, actual.viaCount) << qPrintable(context);
+                EXPECT_NEAR(expected.planeArea, actual.planeArea, 1e-9)
+                    << qPrintable(context);
+            }
+            foreach (const BI_Plane* plane, mBoard.getBoard().getPlanes()) {
+                EXPECT_NEAR(recalculated.getPlaneArea(*plane),
+                            incremental.getPlaneArea(*plane), 1e-9);
+            }
+            EXPECT_EQ(recalculated.getViaCount(), incremental.getViaCount());
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardStatisticsTest, testEmptyBoard)
+{
+    EXPECT_EQ(0, getStatistics().getViaCount());
+    EXPECT_EQ(QStringList(), getStatistics().getLayerNames());
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testAddTrace)
+{
+    getStatistics().getViaCount(); // make the statistics up to date
+    mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+                    {Point::fromMm(2, 2), Point::fromMm(12, 2), Point::fromMm(12, 5)},
+                    Length(500000));
+    BoardStatistics::NetStatistics net = getStatistics().getNetStatistics(*mNet1);
+    EXPECT_EQ(Length(13000000), net.traces.length);
+    EXPECT_EQ(2, net.traces.count);
+    EXPECT_NEAR(6.5, net.traces.area, 1e-9);
+    EXPECT_EQ(QStringList{GraphicsLayer::sTopCopper}, getStatistics().getLayerNames());
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testAddAndRemoveVias)
+{
+    getStatistics().getViaCount(); // make the statistics up to date
+    BI_Via& via1 = mBoard.addVia(*mNet1, Point::fromMm(5, 5));
+    mBoard.addVia(*mNet1, Point::fromMm(10, 5));
+    mBoard.addVia(*mNet2, Point::fromMm(15, 5));
+    EXPECT_EQ(3, getStatistics().getViaCount());
+    EXPECT_EQ(2, getStatistics().getNetStatistics(*mNet1).viaCount);
+    expectSameAsRecalculated();
+
+    BI_NetSegment& netsegment = via1.getNetSegment();
+    netsegment.removeElements({&via1}, {}, {});
+    delete &via1;
+    EXPECT_EQ(2, getStatistics().getViaCount());
+    EXPECT_EQ(1, getStatistics().getNetStatistics(*mNet1).viaCount);
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testRemoveNetLine)
+{
+    BI_NetSegment& netsegment = mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+        {Point::fromMm(2, 2), Point::fromMm(12, 2), Point::fromMm(12, 5)},
+        Length(500000));
+    mBoard.addTrace(*mNet2, GraphicsLayer::sBotCopper,
+                    {Point::fromMm(2, 8), Point::fromMm(12, 8)}, Length(300000));
+    expectSameAsRecalculated();
+
+    BI_NetLine* netline = netsegment.getNetLines().first();
+    netsegment.removeElements({}, {}, {netline});
+    delete netline;
+    EXPECT_EQ(1, getStatistics().getNetStatistics(*mNet1).traces.count);
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testRemoveNetSegment)
+{
+    BI_NetSegment& netsegment = mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+        {Point::fromMm(2, 2), Point::fromMm(12, 2)}, Length(500000));
+    mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+                    {Point::fromMm(2, 8), Point::fromMm(12, 8)}, Length(500000));
+    mBoard.addVia(*mNet1, Point::fromMm(15, 15));
+    expectSameAsRecalculated();
+
+    mBoard.getBoard().removeNetSegment(netsegment);
+    delete &netsegment;
+    EXPECT_EQ(Length(10000000), getStatistics().getNetStatistics(*mNet1).traces.length);
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testMoveNetPoint)
+{
+    BI_NetSegment& netsegment = mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+        {Point::fromMm(2, 2), Point::fromMm(12, 2), Point::fromMm(12, 5)},
+        Length(500000));
+    expectSameAsRecalculated();
+
+    netsegment.getNetPoints().at(2)->setPosition(Point::fromMm(12, 12));
+    EXPECT_EQ(Length(20000000),
+              getStatistics().getNetStatistics(*mNet1).traces.length);
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testChangeNetLineWidth)
+{
+    BI_NetSegment& netsegment = mBoard.addTrace(*mNet1, GraphicsLayer::sTopCopper,
+        {Point::fromMm(2, 2), Point::fromMm(12, 2)}, Length(500000));
+    expectSameAsRecalculated();
+
+    netsegment.getNetLines().first()->setWidth(Length(1000000));
+    EXPECT_NEAR(10.0, getStatistics().getNetStatistics(*mNet1).traces.area, 1e-9);
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testRebuildAndClearPlane)
+{
+    mBoard.addTrace(*mNet2, GraphicsLayer::sTopCopper,
+                    {Point::fromMm(2, 10), Point::fromMm(18, 10)}, Length(500000));
+    BI_Plane& plane = mBoard.addPlane(*mNet1, GraphicsLayer::sTopCopper);
+    plane.setKeepOrphans(true); // there are no items of NET1 to connect
+    expectSameAsRecalculated();
+    EXPECT_EQ(0, getStatistics().getPlaneArea(plane));
+
+    plane.rebuild();
+    EXPECT_GT(getStatistics().getPlaneArea(plane), 0);
+    EXPECT_NEAR(getStatistics().getPlaneArea(plane),
+                getStatistics().getNetStatistics(*mNet1).planeArea, 1e-9);
+    expectSameAsRecalculated();
+
+    plane.clear();
+    EXPECT_EQ(0, getStatistics().getPlaneArea(plane));
+    expectSameAsRecalculated();
+}
+
+TEST_F(BoardStatisticsTest, testInvalidatedIsEmittedOnce)
+{
+    getStatistics().getViaCount(); // make the statistics up to date
+    int count = 0;
+    QObject::connect(&getStatistics(), &BoardStatistics::invalidated, [&count](){++count;});
+    mBoard.addVia(*mNet1, Point::fromMm(5, 5));
+    mBoard.addVia(*mNet1, Point::fromMm(10, 5));
+    EXPECT_EQ(1, count);
+    getStatistics().getViaCount();
+    mBoard.addVia(*mNet2, Point::fromMm(15, 5));
+    EXPECT_EQ(2, count);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,199 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/geometrykernel.h>
+#include <librepcb/project/boards/boardobstacleindex.h>
+#include <librepcb/project/boards/boardtracerouter.h>
+#include "testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardTraceRouterTest : public ::testing::Test
+{
+    protected:
+        TestBoard mBoard;
+        NetSignal* mNet1;
+        NetSignal* mNet2;
+        Length mWidth;
+        Point mStart;
+        Point mEnd;
+
+        BoardTraceRouterTest() :
+            mWidth(250000), mStart(Point::fromMm(5, 10)), mEnd(Point::fromMm(15, 10))
+        {
+            mNet1 = &mBoard.addNetSignal("NET1");
+            mNet2 = &mBoard.addNetSignal("NET2");
+        }
+
+        BoardTraceRouter::Result route(const BoardObstacleIndex& index,
+                                       BoardTraceRouter::Mode mode, int timeBudget = -1) {
+            BoardTraceRouter router(index);
+            router.setTimeBudget(timeBudget);
+            return router.route(GraphicsLayer::sTopCopper, {mStart, mEnd}, mWidth,
+                                mNet1, mode);
+        }
+
+        void expectNoCollisions(const BoardObstacleIndex& index,
+                                const QVector<Point>& points) {
+            for (int i = 1; i < points.count(); ++i) {
+                EXPECT_TRUE(index.findCollisions(GraphicsLayer::sTopCopper,
+                    points.at(i - 1), points.at(i), mWidth, mNet1).isEmpty())
+                    << "Segment " << i << " collides";
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardTraceRouterTest, testIgnoreObstacles)
+{
+    mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::IgnoreObstacles);
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(QVector<Point>({mStart, mEnd}), result.points);
+}
+
+TEST_F(BoardTraceRouterTest, testWalkaroundForeignVia)
+{
+    mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::Walkaround);
+    EXPECT_TRUE(result.complete);
+    ASSERT_GT(result.points.count(), 2);
+    EXPECT_EQ(mStart, result.points.first());
+    EXPECT_EQ(mEnd, result.points.last());
+    EXPECT_TRUE(result.shovedNetPoints.isEmpty());
+    expectNoCollisions(index, result.points);
+}
+
+TEST_F(BoardTraceRouterTest, testWalkaroundIgnoresOwnVia)
+{
+    mBoard.addVia(*mNet1, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::Walkaround);
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(QVector<Point>({mStart, mEnd}), result.points);
+}
+
+TEST_F(BoardTraceRouterTest, testShoveForeignTrace)
+{
+    BI_NetSegment& segment = mBoard.addTrace(*mNet2, GraphicsLayer::sTopCopper,
+        {Point::fromMm(8, 10.2), Point::fromMm(12, 10.2)}, Length(250000));
+    BI_NetLine& netline = *segment.getNetLines().first();
+    BI_NetPoint* start = &netline.getStartPoint();
+    BI_NetPoint* end = &netline.getEndPoint();
+    BoardObstacleIndex index(mBoard.getBoard());
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::Shove);
+
+    // the trace is drawn directly, the foreign trace is pushed away upwards
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(QVector<Point>({mStart, mEnd}), result.points);
+    ASSERT_EQ(2, result.shovedNetPoints.count());
+    ASSERT_TRUE(result.shovedNetPoints.contains(start));
+    ASSERT_TRUE(result.shovedNetPoints.contains(end));
+    Point newStart = result.shovedNetPoints.value(start);
+    Point newEnd = result.shovedNetPoints.value(end);
+    EXPECT_EQ(start->getPosition().getX(), newStart.getX());
+    EXPECT_EQ(end->getPosition().getX(), newEnd.getX());
+    EXPECT_GT(newStart.getY(), start->getPosition().getY());
+    EXPECT_GT(newEnd.getY(), end->getPosition().getY());
+
+    // the shoved trace keeps the clearance
+    qreal distance = (mWidth / 2 + netline.getWidth() / 2
+                      + index.getClearance(mNet1, mNet2)).toNm();
+    EXPECT_GE(GeometryKernel::squaredDistanceBetweenSegments(mStart, mEnd, newStart, newEnd),
+              distance * distance);
+
+    // the board itself is not modified
+    EXPECT_EQ(Point::fromMm(8, 10.2), start->getPosition());
+    EXPECT_EQ(Point::fromMm(12, 10.2), end->getPosition());
+}
+
+TEST_F(BoardTraceRouterTest, testShoveWalksAroundVias)
+{
+    // vias can't be shoved, so the router must walk around them
+    mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::Shove);
+    EXPECT_TRUE(result.complete);
+    ASSERT_GT(result.points.count(), 2);
+    EXPECT_EQ(mEnd, result.points.last());
+    EXPECT_TRUE(result.shovedNetPoints.isEmpty());
+    expectNoCollisions(index, result.points);
+}
+
+TEST_F(BoardTraceRouterTest, testExceededTimeBudgetFallsBackToDirectLine)
+{
+    BI_Via& via = mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::Walkaround, 0);
+
+    // the trace ends on the direct line right before the via
+    EXPECT_FALSE(result.complete);
+    ASSERT_EQ(2, result.points.count());
+    EXPECT_EQ(mStart, result.points.first());
+    EXPECT_EQ(mStart.getY(), result.points.last().getY());
+    EXPECT_GT(result.points.last().getX(), mStart.getX());
+    EXPECT_LT(result.points.last().getX(), via.getPosition().getX() - via.getSize() / 2);
+    expectNoCollisions(index, result.points);
+}
+
+TEST_F(BoardTraceRouterTest, testUpdatedIndexGivesSameRouteAsRebuiltIndex)
+{
+    mBoard.addVia(*mNet2, Point::fromMm(10, 10));
+    BoardObstacleIndex index(mBoard.getBoard());
+
+    // add an obstacle after the index was built
+    BI_NetSegment& segment = mBoard.addTrace(*mNet2, GraphicsLayer::sTopCopper,
+        {Point::fromMm(12, 8), Point::fromMm(12, 12)}, Length(250000));
+    index.updateNetSegment(segment);
+    BoardObstacleIndex rebuilt(mBoard.getBoard());
+
+    BoardTraceRouter::Result result = route(index, BoardTraceRouter::Mode::Walkaround);
+    BoardTraceRouter::Result expected = route(rebuilt, BoardTraceRouter::Mode::Walkaround);
+    EXPECT_EQ(expected.complete, result.complete);
+    EXPECT_EQ(expected.points, result.points);
+    expectNoCollisions(rebuilt, result.points);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,220 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_TESTS_TESTBOARD_H
+#define LIBREPCB_PROJECT_TESTS_TESTBOARD_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <QtCore>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/library/projectlibrary.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/circuit/componentsignalinstance.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class TestBoard
+ ****************************************************************************************/
+
+/**
+ * @brief The TestBoard class creates a small project with one board in a temporary
+ *        directory to build boards item by item in tests
+ *
+ * The board has a rectangular outline with the lower left corner at (0, 0). All
+ * methods throw on errors, which lets the test fail.
+ */
+class TestBoard final
+{
+    public:
+        explicit TestBoard(const Length& size = Length(20000000)) :
+            mProjectDir(FilePath::getRandomTempPath()), mSize(size), mBoard(nullptr)
+        {
+            FilePath fp = mProjectDir.getPathTo("test_project/test_project.lpp");
+            mProject.reset(Project::create(fp)); // can throw
+            mBoard = mProject->createBoard("test_board"); // can throw
+            mProject->addBoard(*mBoard); // can throw
+            mBoard->addPolygon(*new BI_Polygon(*mBoard, Uuid::createRandom(),
+                GraphicsLayer::sBoardOutlines, Length(0), false, false,
+                getOutline())); // can throw
+        }
+        TestBoard(const TestBoard& other) = delete;
+        TestBoard& operator=(const TestBoard& rhs) = delete;
+        ~TestBoard() noexcept {
+            mProject.reset();
+            QDir(mProjectDir.toStr()).removeRecursively();
+        }
+
+        Project& getProject() noexcept {return *mProject;}
+        Board& getBoard() noexcept {return *mBoard;}
+        Path getOutline() const noexcept {return Path::rect(Point(0, 0), Point(mSize, mSize));}
+        GraphicsLayer& getLayer(const QString& name) const noexcept {
+            GraphicsLayer* layer = mBoard->getLayerStack().getLayer(name);
+            Q_ASSERT(layer);
+            return *layer;
+        }
+
+        NetSignal& addNetSignal(const QString& name) {
+            Circuit& circuit = mProject->getCircuit();
+            NetClass* netclass = circuit.getNetClassByName("default");
+            Q_ASSERT(netclass);
+            NetSignal* netsignal = new NetSignal(circuit, *netclass, name, false); // can throw
+            circuit.addNetSignal(*netsignal); // can throw
+            return *netsignal;
+        }
+
+        BI_Via& addVia(NetSignal& netsignal, const Point& pos,
+                       const Length& size = Length(700000),
+                       const Length& drill = Length(300000)) {
+            BI_NetSegment* netsegment = new BI_NetSegment(*mBoard, netsignal); // can throw
+            mBoard->addNetSegment(*netsegment); // can throw
+            BI_Via* via = new BI_Via(*netsegment, pos, BI_Via::Shape::Round, size, drill); // can throw
+            netsegment->addElements({via}, {}, {}); // can throw
+            return *via;
+        }
+
+        /// Add a netsegment with a trace through all points (at least two)
+        BI_NetSegment& addTrace(NetSignal& netsignal, const QString& layerName,
+                                const QVector<Point>& points, const Length& width) {
+            Q_ASSERT(points.count() >= 2);
+            BI_NetSegment* netsegment = new BI_NetSegment(*mBoard, netsignal); // can throw
+            mBoard->addNetSegment(*netsegment); // can throw
+            QList<BI_NetPoint*> netpoints;
+            QList<BI_NetLine*> netlines;
+            foreach (const Point& pos, points) {
+                netpoints.append(new BI_NetPoint(*netsegment, getLayer(layerName), pos)); // can throw
+                if (netpoints.count() > 1) {
+                    netlines.append(new BI_NetLine(*netpoints.at(netpoints.count() - 2),
+                                                   *netpoints.last(), width)); // can throw
+                }
+            }
+            netsegment->addElements({}, netpoints, netlines); // can throw
+            return *netsegment;
+        }
+
+        BI_Plane& addPlane(NetSignal& netsignal, const QString& layerName) {
+            BI_Plane* plane = new BI_Plane(*mBoard, Uuid::createRandom(), layerName,
+                                           netsignal, getOutline()); // can throw
+            mBoard->addPlane(*plane); // can throw
+            return *plane;
+        }
+
+        /// Add a device with a single pad which is connected to a net signal
+        BI_FootprintPad& addPad(NetSignal& netsignal, const Point& pos,
+                                library::FootprintPad::Shape shape,
+                                const Length& width, const Length& height,
+                                const Length& drill = Length(0)) {
+            using namespace library;
+            Uuid signalUuid = Uuid::createRandom();
+            Uuid symbVarUuid = Uuid::createRandom();
+            Uuid padUuid = Uuid::createRandom();
+            Uuid footprintUuid = Uuid::createRandom();
+            QString name = QString("U%1").arg(mProject->getCircuit()
+                                              .getComponentInstances().count() + 1);
+
+            Component* cmp = new Component(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                           name, "", ""); // can throw
+            cmp->getSignals().append(std::make_shared<ComponentSignal>(signalUuid, "1"));
+            cmp->getSymbolVariants().append(std::make_shared<ComponentSymbolVariant>(
+                symbVarUuid, "", "default", ""));
+            mProject->getLibrary().addComponent(*cmp); // can throw
+
+            Package* pkg = new Package(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                       name, "", ""); // can throw
+            pkg->getPads().append(std::make_shared<PackagePad>(padUuid, "1"));
+            std::shared_ptr<Footprint> footprint =
+                std::make_shared<Footprint>(footprintUuid, "default", "");
+            FootprintPad::BoardSide side = (drill > 0) ? FootprintPad::BoardSide::THT
+                                                       : FootprintPad::BoardSide::TOP;
+            footprint->getPads().append(std::make_shared<FootprintPad>(padUuid, Point(0, 0),
+                Angle::deg0(), shape, width, height, drill, side));
+            pkg->getFootprints().append(footprint);
+            mProject->getLibrary().addPackage(*pkg); // can throw
+
+            Device* dev = new Device(Uuid::createRandom(), Version("0.1"), "LibrePCB",
+                                     name, "", ""); // can throw
+            dev->setComponentUuid(cmp->getUuid());
+            dev->setPackageUuid(pkg->getUuid());
+            dev->getPadSignalMap().append(std::make_shared<DevicePadSignalMapItem>(
+                padUuid, signalUuid));
+            mProject->getLibrary().addDevice(*dev); // can throw
+
+            ComponentInstance* cmpInst = new ComponentInstance(mProject->getCircuit(),
+                *cmp, symbVarUuid, name, dev->getUuid()); // can throw
+            mProject->getCircuit().addComponentInstance(*cmpInst); // can throw
+            cmpInst->getSignalInstance(signalUuid)->setNetSignal(&netsignal); // can throw
+            BI_Device* device = new BI_Device(*mBoard, *cmpInst, dev->getUuid(),
+                                              footprintUuid, pos, Angle::deg0(),
+                                              false); // can throw
+            mBoard->addDeviceInstance(*device); // can throw
+            return *device->getFootprint().getPads().first();
+        }
+
+        /// Save the project, close it and open it again
+        void reopen() {
+            mProject->save(true); // can throw
+            FilePath fp = mProject->getFilepath();
+            mBoard = nullptr;
+            mProject.reset();
+            mProject.reset(new Project(fp, false)); // can throw
+            mBoard = mProject->getBoards().first();
+        }
+
+    private:
+        FilePath mProjectDir;
+        Length mSize;
+        std::unique_ptr<Project> mProject;
+        Board* mBoard;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_TESTS_TESTBOARD_H
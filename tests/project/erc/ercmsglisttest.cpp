@@ -0,0 +1,190 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/erc/ercmsg.h>
+#include <librepcb/project/erc/ercmsglist.h>
+#include <librepcb/project/erc/if_ercmsgprovider.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class FakeErcMsgProvider
+ ****************************************************************************************/
+
+/**
+ * @brief Provides one ERC message which is visible if the provider is in an error state
+ */
+class FakeErcMsgProvider final : public IF_ErcMsgProvider
+{
+        DECLARE_ERC_MSG_CLASS_NAME(FakeErcMsgProvider)
+
+    public:
+        FakeErcMsgProvider(Project& project, const QString& key) noexcept :
+            mErcMsgList(project.getErcMsgList()),
+            mErcMsg(new ErcMsg(project, *this, key, "Fake",
+                               ErcMsg::ErcMsgType_t::CircuitError, key)) {}
+        ~FakeErcMsgProvider() noexcept {
+            mErcMsgList.unscheduleUpdate(*this);
+        }
+
+        // changes the state and schedules the (expensive) update of the ERC message
+        void setError(bool error) noexcept {
+            mError = error;
+            mErcMsgList.scheduleUpdate(*this, [this](){
+                mUpdateCount++;
+                mErcMsg->setVisible(mError);
+            });
+        }
+
+        ErcMsgList& mErcMsgList;
+        QScopedPointer<ErcMsg> mErcMsg;
+        bool mError = false;
+        int mUpdateCount = 0;
+};
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ErcMsgListTest : public ::testing::Test
+{
+    protected:
+        FilePath mProjectDir;
+        QScopedPointer<Project> mProject;
+        QList<ErcMsg*> mAdded;
+        QList<ErcMsg*> mRemoved;
+
+        ErcMsgListTest() {
+            mProjectDir = FilePath::getRandomTempPath();
+            mProject.reset(Project::create(mProjectDir.getPathTo("test_project.lpp")));
+            processEvents(); // updates scheduled while creating the project
+            QObject::connect(&list(), &ErcMsgList::ercMsgAdded,
+                             [this](ErcMsg* msg){mAdded.append(msg);});
+            QObject::connect(&list(), &ErcMsgList::ercMsgRemoved,
+                             [this](ErcMsg* msg){mRemoved.append(msg);});
+        }
+
+        virtual ~ErcMsgListTest() {
+            mProject.reset();
+            QDir(mProjectDir.toStr()).removeRecursively();
+        }
+
+        ErcMsgList& list() noexcept {return mProject->getErcMsgList();}
+
+        // scheduled updates are executed when the control returns to the event loop
+        static void processEvents() noexcept {
+            QCoreApplication::processEvents();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ErcMsgListTest, testManyInvalidationsResultInOneUpdate)
+{
+    FakeErcMsgProvider provider(*mProject, "a");
+    provider.setError(true);
+    provider.setError(false);
+    provider.setError(true);
+    provider.setError(true);
+    EXPECT_EQ(0, provider.mUpdateCount); // nothing is evaluated before the event loop
+    EXPECT_FALSE(list().getItems().contains(provider.mErcMsg.data()));
+
+    processEvents();
+    EXPECT_EQ(1, provider.mUpdateCount);
+    EXPECT_TRUE(list().getItems().contains(provider.mErcMsg.data()));
+    EXPECT_EQ(QList<ErcMsg*>{provider.mErcMsg.data()}, mAdded);
+    EXPECT_TRUE(mRemoved.isEmpty());
+
+    // no further updates without new invalidations
+    processEvents();
+    EXPECT_EQ(1, provider.mUpdateCount);
+}
+
+TEST_F(ErcMsgListTest, testTransientMessagesAreNeverAdded)
+{
+    FakeErcMsgProvider a(*mProject, "a");
+    FakeErcMsgProvider b(*mProject, "b");
+    a.setError(true);
+    b.setError(true);
+    a.setError(false);
+    b.setError(false);
+    b.setError(true);
+    processEvents();
+    EXPECT_EQ(1, a.mUpdateCount);
+    EXPECT_EQ(1, b.mUpdateCount);
+    EXPECT_FALSE(list().getItems().contains(a.mErcMsg.data()));
+    EXPECT_TRUE(list().getItems().contains(b.mErcMsg.data()));
+    EXPECT_EQ(QList<ErcMsg*>{b.mErcMsg.data()}, mAdded);
+    EXPECT_TRUE(mRemoved.isEmpty());
+
+    // the final state of a second round is applied as well
+    a.setError(true);
+    b.setError(false);
+    processEvents();
+    EXPECT_EQ(2, a.mUpdateCount);
+    EXPECT_EQ(2, b.mUpdateCount);
+    EXPECT_TRUE(list().getItems().contains(a.mErcMsg.data()));
+    EXPECT_FALSE(list().getItems().contains(b.mErcMsg.data()));
+    EXPECT_EQ(QList<ErcMsg*>{b.mErcMsg.data()}, mRemoved);
+}
+
+TEST_F(ErcMsgListTest, testUpdateScheduledProvidersExecutesImmediately)
+{
+    FakeErcMsgProvider provider(*mProject, "a");
+    provider.setError(true);
+    provider.setError(true);
+    list().updateScheduledProviders();
+    EXPECT_EQ(1, provider.mUpdateCount);
+    EXPECT_TRUE(list().getItems().contains(provider.mErcMsg.data()));
+
+    // the queued call from scheduleUpdate() must not update the provider again
+    processEvents();
+    EXPECT_EQ(1, provider.mUpdateCount);
+}
+
+TEST_F(ErcMsgListTest, testUnscheduledProvidersAreNotUpdated)
+{
+    QScopedPointer<FakeErcMsgProvider> provider(new FakeErcMsgProvider(*mProject, "a"));
+    provider->setError(true);
+    provider.reset(); // unschedules the update
+    processEvents(); // would crash if the update function was still called
+    EXPECT_TRUE(mAdded.isEmpty());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
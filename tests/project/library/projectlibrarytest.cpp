@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/libraryelementcache.h>
+#include "../boards/testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ProjectLibraryTest : public ::testing::Test
+{
+    protected:
+        FilePath mTmpDir;
+        std::unique_ptr<TestBoard> mBoard;
+        Uuid mDeviceUuid;
+
+        ProjectLibraryTest() : mTmpDir(FilePath::getRandomTempPath()) {
+            // create a project which contains one device in its library
+            mBoard.reset(new TestBoard());
+            NetSignal& net = mBoard->addNetSignal("NET");
+            BI_FootprintPad& pad = mBoard->addPad(net, Point(0, 0),
+                library::FootprintPad::Shape::RECT, Length(1000000), Length(1000000));
+            mDeviceUuid = pad.getFootprint().getDeviceInstance().getLibDevice().getUuid();
+            mBoard->reopen(); // to load the elements from the library directory
+        }
+
+        virtual ~ProjectLibraryTest() {
+            mBoard.reset();
+            QDir(mTmpDir.toStr()).removeRecursively();
+        }
+
+        /// Copy the project of #mBoard (like a second checkout of the same project)
+        std::unique_ptr<Project> openCopyOfProject() {
+            FilePath src = mBoard->getProject().getPath();
+            FilePath dest = mTmpDir.getPathTo(src.getFilename());
+            FileUtils::copyDirRecursively(src, dest);
+            FileUtils::removeFile(dest.getPathTo(".lock"));
+            FilePath fp = dest.getPathTo(mBoard->getProject().getFilepath().getFilename());
+            return std::unique_ptr<Project>(new Project(fp, false));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ProjectLibraryTest, testIdenticalElementsAreSharedBetweenProjects)
+{
+    std::unique_ptr<Project> other = openCopyOfProject();
+    const library::Device* device = mBoard->getProject().getLibrary().getDevice(mDeviceUuid);
+    ASSERT_TRUE(device != nullptr);
+    EXPECT_EQ(device, other->getLibrary().getDevice(mDeviceUuid));
+    EXPECT_EQ(mBoard->getProject().getLibrary().getPackage(device->getPackageUuid()),
+              other->getLibrary().getPackage(device->getPackageUuid()));
+}
+
+TEST_F(ProjectLibraryTest, testSharedElementsAreSavedIntoOwnDirectory)
+{
+    std::unique_ptr<Project> other = openCopyOfProject();
+    FilePath ownDir = mBoard->getProject().getPath().getPathTo("library/dev")
+                      .getPathTo(mDeviceUuid.toStr());
+    FilePath otherDir = other->getPath().getPathTo("library/dev")
+                        .getPathTo(mDeviceUuid.toStr());
+    FileUtils::removeDirRecursively(otherDir);
+
+    other->save(true);
+    EXPECT_TRUE(library::LibraryBaseElement::isValidElementDirectory<library::Device>(otherDir));
+    EXPECT_EQ(FileUtils::readFile(ownDir.getPathTo("device.lp")),
+              FileUtils::readFile(otherDir.getPathTo("device.lp")));
+}
+
+TEST_F(ProjectLibraryTest, testSharedElementsOutliveOtherProject)
+{
+    std::unique_ptr<Project> other = openCopyOfProject();
+    const library::Device* device = other->getLibrary().getDevice(mDeviceUuid);
+    mBoard.reset(); // close the project which loaded the element first
+    EXPECT_EQ(mDeviceUuid, device->getUuid());
+    EXPECT_EQ(device, other->getLibrary().getDevice(mDeviceUuid));
+}
+
+TEST_F(ProjectLibraryTest, testModifiedElementIsNotShared)
+{
+    FilePath src = mBoard->getProject().getPath();
+    FilePath dest = mTmpDir.getPathTo(src.getFilename());
+    FileUtils::copyDirRecursively(src, dest);
+    FileUtils::removeFile(dest.getPathTo(".lock"));
+    FilePath devFile = dest.getPathTo("library/dev").getPathTo(mDeviceUuid.toStr())
+                       .getPathTo("device.lp");
+    FileUtils::writeFile(devFile, FileUtils::readFile(devFile).append("\n"));
+
+    Project other(dest.getPathTo(mBoard->getProject().getFilepath().getFilename()), false);
+    EXPECT_NE(mBoard->getProject().getLibrary().getDevice(mDeviceUuid),
+              other.getLibrary().getDevice(mDeviceUuid));
+}
+
+TEST_F(ProjectLibraryTest, testDisabledCacheDoesNotShareElements)
+{
+    library::LibraryElementCache::instance().setEnabled(false);
+    std::unique_ptr<Project> other = openCopyOfProject();
+    library::LibraryElementCache::instance().setEnabled(true);
+    ASSERT_TRUE(other->getLibrary().getDevice(mDeviceUuid) != nullptr);
+    EXPECT_NE(mBoard->getProject().getLibrary().getDevice(mDeviceUuid),
+              other->getLibrary().getDevice(mDeviceUuid));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <ProjectLibraryUpdater/projectlibraryupdater.h>
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/library.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include "../project/boards/testboard.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+using namespace library;
+using namespace project::tests;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ProjectLibraryUpdaterTest : public ::testing::Test
+{
+    protected:
+        FilePath mWsDir;
+        TestBoard mTestBoard;
+        FilePath mProjectFile;
+        FilePath mProjectLibDir;
+        FilePath mWsLibDir;
+        std::unique_ptr<workspace::Workspace> mWorkspace;
+
+        ProjectLibraryUpdaterTest() :
+            mWsDir(FilePath::getRandomTempPath().getPathTo("workspace"))
+        {
+            // a project with one device (component, package and device in its library)
+            NetSignal& net = mTestBoard.addNetSignal("GND");
+            mTestBoard.addPad(net, Point(5000000, 5000000), FootprintPad::Shape::ROUND,
+                              Length(1200000), Length(1200000), Length(600000));
+            mTestBoard.getProject().save(true);
+            mProjectFile = mTestBoard.getProject().getFilepath();
+            mProjectLibDir = mProjectFile.getParentDir().getPathTo("library");
+
+            // a workspace library containing the same elements (must exist before the
+            // workspace gets opened)
+            workspace::Workspace::createNewWorkspace(mWsDir);
+            mWsLibDir = mWsDir.getPathTo("v" % qApp->getFileFormatVersion().toStr())
+                        .getPathTo("libraries/local/Test.lplib");
+            Library lib(Uuid::createRandom(), Version("0.1"), "LibrePCB", "Test", "", "");
+            lib.saveTo(mWsLibDir);
+            foreach (const QString& type, QStringList{"pkg", "cmp", "dev"}) {
+                FileUtils::copyDirRecursively(mProjectLibDir.getPathTo(type),
+                                              mWsLibDir.getPathTo(type));
+            }
+            mWorkspace.reset(new workspace::Workspace(mWsDir));
+            rescanLibraries();
+        }
+
+        virtual ~ProjectLibraryUpdaterTest() {
+            mWorkspace.reset();
+            QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+        }
+
+        void rescanLibraries() {
+            workspace::WorkspaceLibraryDb& db = mWorkspace->getLibraryDb();
+            QEventLoop loop;
+            QObject::connect(&db, &workspace::WorkspaceLibraryDb::scanSucceeded,
+                             &loop, &QEventLoop::quit);
+            QObject::connect(&db, &workspace::WorkspaceLibraryDb::scanFailed,
+                             &loop, &QEventLoop::quit);
+            QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+            db.startLibraryRescan();
+            loop.exec();
+        }
+
+        FilePath getSingleElementDir(const FilePath& libDir, const QString& type) const {
+            QStringList dirs = QDir(libDir.getPathTo(type).toStr())
+                               .entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
+            EXPECT_EQ(1, dirs.count());
+            return libDir.getPathTo(type).getPathTo(dirs.value(0));
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ProjectLibraryUpdaterTest, testUpToDateElementsAreNotTouched)
+{
+    ProjectLibraryUpdater updater(*mWorkspace, false);
+    ProjectLibraryUpdater::Result result = updater.update({mProjectFile});
+    EXPECT_EQ(QStringList(), result.errors);
+    EXPECT_EQ(1, result.updatedProjects);
+    EXPECT_EQ(0, result.updatedElements);
+    EXPECT_EQ(3, result.unchangedElements);
+}
+
+TEST_F(ProjectLibraryUpdaterTest, testModifiedElementIsUpdated)
+{
+    FilePath wsDeviceDir = getSingleElementDir(mWsLibDir, "dev");
+    {
+        Device device(wsDeviceDir, false);
+        device.setDescription("", "Modified in the workspace library");
+        device.save();
+    }
+    rescanLibraries();
+
+    ProjectLibraryUpdater updater(*mWorkspace, false);
+    ProjectLibraryUpdater::Result result = updater.update({mProjectFile});
+    EXPECT_EQ(QStringList(), result.errors);
+    EXPECT_EQ(1, result.updatedProjects);
+    EXPECT_EQ(1, result.updatedElements);
+    EXPECT_EQ(2, result.unchangedElements);
+    EXPECT_EQ(1, result.log.count());
+
+    FilePath projectDeviceDir = getSingleElementDir(mProjectLibDir, "dev");
+    EXPECT_EQ(wsDeviceDir.getFilename(), projectDeviceDir.getFilename());
+    Device device(projectDeviceDir, true);
+    EXPECT_EQ("Modified in the workspace library", device.getDescriptions().getDefaultValue());
+
+    // a second run must not touch anything anymore
+    result = updater.update({mProjectFile});
+    EXPECT_EQ(0, result.updatedElements);
+    EXPECT_EQ(3, result.unchangedElements);
+}
+
+TEST_F(ProjectLibraryUpdaterTest, testMissingElementIsReported)
+{
+    FileUtils::removeDirRecursively(getSingleElementDir(mWsLibDir, "pkg"));
+    rescanLibraries();
+
+    ProjectLibraryUpdater updater(*mWorkspace, false);
+    ProjectLibraryUpdater::Result result = updater.update({mProjectFile});
+    EXPECT_EQ(1, result.errors.count());
+    EXPECT_EQ(0, result.updatedProjects);
+    EXPECT_EQ(0, result.updatedElements);
+
+    // the project library must not be modified
+    EXPECT_TRUE(getSingleElementDir(mProjectLibDir, "pkg").isExistingDir());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
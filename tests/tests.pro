@@ -25,6 +25,7 @@ LIBS += \
     -L$${DESTDIR} \
     -lgoogletest \
     -llibrepcbeagleimport \
+    -llibrepcblibrarymanager \
     -llibrepcbworkspace \
     -llibrepcbproject \
     -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
@@ -39,9 +40,11 @@ INCLUDEPATH += \
     ../libs/parseagle \
     ../libs/quazip \
     ../libs \
+    ../apps \
 
 DEPENDPATH += \
     ../libs/librepcb/eagleimport \
+    ../libs/librepcb/librarymanager \
     ../libs/librepcb/workspace \
     ../libs/librepcb/project \
     ../libs/librepcb/library \
@@ -54,6 +57,7 @@ DEPENDPATH += \
 PRE_TARGETDEPS += \
     $${DESTDIR}/libgoogletest.a \
     $${DESTDIR}/liblibrepcbeagleimport.a \
+    $${DESTDIR}/liblibrepcblibrarymanager.a \
     $${DESTDIR}/liblibrepcbworkspace.a \
     $${DESTDIR}/liblibrepcbproject.a \
     $${DESTDIR}/liblibrepcblibrary.a \
@@ -63,11 +67,16 @@ PRE_TARGETDEPS += \
     $${DESTDIR}/libclipper.a \
 
 SOURCES += \
+    ../apps/ProjectLibraryUpdater/projectlibraryupdater.cpp \
     common/applicationtest.cpp \
     common/attributes/attributesubstitutortest.cpp \
+    common/boarddesignrulestest.cpp \
     common/directorylocktest.cpp \
     common/filedownloadtest.cpp \
+    common/fileio/fileutilstest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sexpressiontest.cpp \
+    common/geometry/pathtest.cpp \
     common/filepathtest.cpp \
     common/networkrequesttest.cpp \
     common/pointtest.cpp \
@@ -76,21 +85,44 @@ SOURCES += \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/utils/clipperpathcachetest.cpp \
+    common/utils/connectivitygraphtest.cpp \
+    common/utils/geometrykerneltest.cpp \
+    common/utils/hatchlatticetest.cpp \
+    common/utils/rectselectionindextest.cpp \
+    common/utils/unionfindtest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     eagleimport/deviceconvertertest.cpp \
     eagleimport/devicesetconvertertest.cpp \
     eagleimport/packageconvertertest.cpp \
     eagleimport/symbolconvertertest.cpp \
+    library/libraryelementbatchwritertest.cpp \
+    library/libraryelementcachetest.cpp \
+    librarymanager/librarydownloadqueuetest.cpp \
     main.cpp \
+    project/boards/bi_netsegmenttest.cpp \
+    project/boards/bi_planetest.cpp \
+    project/boards/boardclearancematrixtest.cpp \
+    project/boards/boardobstacleindextest.cpp \
     project/boards/boardplanefragmentsbuildertest.cpp \
+    project/boards/boardplanefragmentscachetest.cpp \
+    project/boards/boardstatisticstest.cpp \
+    project/boards/boardtraceroutertest.cpp \
+    project/erc/ercmsglisttest.cpp \
+    project/library/projectlibrarytest.cpp \
     project/projecttest.cpp \
+    projectlibraryupdater/projectlibraryupdatertest.cpp \
+    workspace/library/workspacelibraryscannertest.cpp \
+    workspace/library/workspacelibrarywatchertest.cpp \
     workspace/workspacetest.cpp \
 
 HEADERS += \
+    ../apps/ProjectLibraryUpdater/projectlibraryupdater.h \
     common/attributes/attributeproviderdummy.h \
     common/fileio/serializableobjectmock.h \
     common/networkrequestbasesignalreceiver.h \
+    project/boards/testboard.h \
 
 FORMS += \
 
@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/library/library.h>
+#include <librepcb/library/sym/symbol.h>
+#include <librepcb/workspace/workspace.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace library;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+/**
+ * Tests the incremental updates of the library database, either triggered by the file
+ * system watcher of the database or explicitly
+ */
+class WorkspaceLibraryScannerTest : public ::testing::Test
+{
+    protected:
+        FilePath mWsDir;
+        FilePath mSymDir;
+        Uuid mSymbolUuid;
+        std::unique_ptr<Workspace> mWorkspace;
+
+        WorkspaceLibraryScannerTest() :
+            mWsDir(FilePath::getRandomTempPath().getPathTo("workspace")),
+            mSymbolUuid(Uuid::createRandom())
+        {
+            // a workspace library with one symbol (must exist before the workspace gets
+            // opened)
+            Workspace::createNewWorkspace(mWsDir);
+            FilePath libDir = mWsDir.getPathTo("v" % qApp->getFileFormatVersion().toStr())
+                              .getPathTo("libraries/local/Test.lplib");
+            Library lib(Uuid::createRandom(), Version("0.1"), "LibrePCB", "Test", "", "");
+            lib.saveTo(libDir);
+            mSymDir = libDir.getPathTo("sym");
+            addSymbol(mSymbolUuid);
+            mWorkspace.reset(new Workspace(mWsDir));
+            getDb().startLibraryRescan();
+            EXPECT_EQ(1, waitForScan());
+        }
+
+        virtual ~WorkspaceLibraryScannerTest() {
+            mWorkspace.reset();
+            QDir(mWsDir.getParentDir().toStr()).removeRecursively();
+        }
+
+        WorkspaceLibraryDb& getDb() noexcept {return mWorkspace->getLibraryDb();}
+
+        FilePath addSymbol(const Uuid& uuid, const Version& version = Version("0.1")) {
+            Symbol symbol(uuid, version, "LibrePCB", "Symbol", "", "");
+            symbol.saveIntoParentDirectory(mSymDir);
+            return mSymDir.getPathTo(uuid.toStr());
+        }
+
+        QList<Version> getSymbolVersionsInDb(const Uuid& uuid) {
+            return getDb().getSymbols(uuid).keys();
+        }
+
+        /// Wait until a scan has finished and return the count of scanned elements
+        int waitForScan(int timeoutMs = 30000) {
+            int count = -1;
+            QEventLoop loop;
+            QObject::connect(&getDb(), &WorkspaceLibraryDb::scanSucceeded, &loop,
+                             [&](int elementCount){count = elementCount; loop.quit();});
+            QObject::connect(&getDb(), &WorkspaceLibraryDb::scanFailed,
+                             &loop, &QEventLoop::quit);
+            QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+            loop.exec();
+            return count;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(WorkspaceLibraryScannerTest, testAddedElementIsAddedAutomatically)
+{
+    Uuid uuid = Uuid::createRandom();
+    addSymbol(uuid);
+    EXPECT_EQ(1, waitForScan()); // the existing symbol is not scanned again
+    EXPECT_EQ(QList<Version>{Version("0.1")}, getSymbolVersionsInDb(uuid));
+    EXPECT_EQ(QList<Version>{Version("0.1")}, getSymbolVersionsInDb(mSymbolUuid));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testRemovedElementIsRemovedAutomatically)
+{
+    FileUtils::removeDirRecursively(mSymDir.getPathTo(mSymbolUuid.toStr()));
+    EXPECT_EQ(0, waitForScan());
+    EXPECT_EQ(QList<Version>(), getSymbolVersionsInDb(mSymbolUuid));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testModifiedElementIsUpdatedByElementRescan)
+{
+    FilePath dir = mSymDir.getPathTo(mSymbolUuid.toStr());
+    {
+        Symbol symbol(dir, false);
+        symbol.setVersion(Version("0.2"));
+        symbol.save();
+    }
+    getDb().startElementRescan(dir);
+    EXPECT_EQ(1, waitForScan());
+    EXPECT_EQ(QList<Version>{Version("0.2")}, getSymbolVersionsInDb(mSymbolUuid));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testModifiedElementIsUpdatedWithTypeDirChange)
+{
+    // an element modified in place doesn't modify the type directory, but it must be
+    // updated as soon as the type directory gets rescanned
+    {
+        Symbol symbol(mSymDir.getPathTo(mSymbolUuid.toStr()), false);
+        symbol.setVersion(Version("0.2"));
+        symbol.save();
+    }
+    Uuid uuid = Uuid::createRandom();
+    addSymbol(uuid);
+    EXPECT_EQ(2, waitForScan());
+    EXPECT_EQ(QList<Version>{Version("0.2")}, getSymbolVersionsInDb(mSymbolUuid));
+    EXPECT_EQ(QList<Version>{Version("0.1")}, getSymbolVersionsInDb(uuid));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace workspace
+} // namespace librepcb
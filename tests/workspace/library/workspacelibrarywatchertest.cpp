@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/workspace/library/workspacelibrarywatcher.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class WorkspaceLibraryWatcherTest : public ::testing::Test
+{
+    protected:
+        FilePath mLibDir;
+        FilePath mSymDir;
+        WorkspaceLibraryWatcher mWatcher;
+        QList<QSet<FilePath>> mEmittedTypeDirs;
+
+        WorkspaceLibraryWatcherTest() :
+            mLibDir(FilePath::getRandomTempPath().getPathTo("Test.lplib")),
+            mSymDir(mLibDir.getPathTo("sym"))
+        {
+            FileUtils::makePath(mSymDir);
+            mWatcher.addLibrary(mLibDir);
+            QObject::connect(&mWatcher, &WorkspaceLibraryWatcher::typeDirsChanged,
+                             [this](const QSet<FilePath>& dirs){mEmittedTypeDirs.append(dirs);});
+        }
+
+        virtual ~WorkspaceLibraryWatcherTest() {
+            QDir(mLibDir.getParentDir().toStr()).removeRecursively();
+        }
+
+        /// Process events until the watcher emitted or the timeout expired
+        void waitForSignal(int timeoutMs = 10000) {
+            QEventLoop loop;
+            QObject::connect(&mWatcher, &WorkspaceLibraryWatcher::typeDirsChanged,
+                             &loop, &QEventLoop::quit, Qt::QueuedConnection);
+            QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(WorkspaceLibraryWatcherTest, testAddedElementDirIsReported)
+{
+    FileUtils::makePath(mSymDir.getPathTo("element"));
+    waitForSignal();
+    ASSERT_EQ(1, mEmittedTypeDirs.count());
+    EXPECT_EQ(QSet<FilePath>{mSymDir}, mEmittedTypeDirs.first());
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testRemovedElementDirIsReported)
+{
+    FileUtils::makePath(mSymDir.getPathTo("element"));
+    waitForSignal();
+    mEmittedTypeDirs.clear();
+
+    FileUtils::removeDirRecursively(mSymDir.getPathTo("element"));
+    waitForSignal();
+    ASSERT_EQ(1, mEmittedTypeDirs.count());
+    EXPECT_EQ(QSet<FilePath>{mSymDir}, mEmittedTypeDirs.first());
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testChangesAreDebounced)
+{
+    for (int i = 0; i < 10; ++i) {
+        FileUtils::makePath(mSymDir.getPathTo(QString("element%1").arg(i)));
+    }
+    waitForSignal();
+    waitForSignal(1000); // there must not be another signal
+    ASSERT_EQ(1, mEmittedTypeDirs.count());
+    EXPECT_EQ(QSet<FilePath>{mSymDir}, mEmittedTypeDirs.first());
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testAddedAndRemovedTypeDirsAreReported)
+{
+    FilePath pkgDir = mLibDir.getPathTo("pkg");
+    FileUtils::makePath(pkgDir.getPathTo("element"));
+    waitForSignal();
+    ASSERT_EQ(1, mEmittedTypeDirs.count());
+    EXPECT_EQ(QSet<FilePath>{pkgDir}, mEmittedTypeDirs.first());
+    mEmittedTypeDirs.clear();
+
+    // the added type directory must be watched too
+    FileUtils::makePath(pkgDir.getPathTo("element2"));
+    waitForSignal();
+    ASSERT_EQ(1, mEmittedTypeDirs.count());
+    EXPECT_EQ(QSet<FilePath>{pkgDir}, mEmittedTypeDirs.first());
+    mEmittedTypeDirs.clear();
+
+    FileUtils::removeDirRecursively(pkgDir);
+    waitForSignal();
+    ASSERT_EQ(1, mEmittedTypeDirs.count());
+    EXPECT_TRUE(mEmittedTypeDirs.first().contains(pkgDir));
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testFilesInUnknownDirsAreIgnored)
+{
+    FileUtils::makePath(mLibDir.getPathTo("unknown/element"));
+    FileUtils::writeFile(mLibDir.getPathTo("readme.md"), "Test");
+    waitForSignal(2000);
+    EXPECT_EQ(0, mEmittedTypeDirs.count());
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testChangesOfRemovedLibraryAreIgnored)
+{
+    FileUtils::makePath(mSymDir.getPathTo("element"));
+    mWatcher.removeLibrary(mLibDir);
+    waitForSignal(2000);
+    EXPECT_EQ(0, mEmittedTypeDirs.count());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace workspace
+} // namespace librepcb